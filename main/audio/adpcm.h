@@ -0,0 +1,46 @@
+/**
+ * @file adpcm.h
+ * @brief IMA-ADPCM 流式解码
+ *
+ * 提示音以 4:1 的 IMA-ADPCM 存放在提示音分区，播放任务每次只解码一块
+ * （与 I2S 写入块大小相同），不需要整段解码缓冲区。
+ * 码流格式与 tools/prompt_pack.py 的编码器一致：无分块头，解码状态从
+ * predictor=0、index=0 开始，每字节先低 4 位后高 4 位。
+ * 本模块不依赖 ESP-IDF，可在 Linux 主机上与 Python 参考实现逐位比对。
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 解码状态
+ */
+typedef struct {
+    int32_t predictor;  // 上一个输出样本
+    int32_t index;      // 步长表索引（0~88）
+} adpcm_state_t;
+
+/**
+ * @brief 复位解码状态（每个片段开始时调用）
+ * @param state 解码状态
+ */
+void adpcm_reset(adpcm_state_t *state);
+
+/**
+ * @brief 解码一段码流
+ * @param state 解码状态，跨块保持
+ * @param in 码流
+ * @param in_bytes 码流字节数
+ * @param out 输出样本，至少 2*in_bytes 个
+ */
+void adpcm_decode(adpcm_state_t *state, const uint8_t *in, size_t in_bytes, int16_t *out);
+
+#ifdef __cplusplus
+}
+#endif
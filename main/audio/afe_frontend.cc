@@ -0,0 +1,150 @@
+/**
+ * @file afe_frontend.cc
+ * @brief ESP-SR AFE 音频前端实现
+ */
+
+#include "afe_frontend.h"
+
+extern "C" {
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "bsp_board.h"
+}
+
+#include "system/trace.h"
+
+static const char *TAG = "AFE前端";
+
+// feed 任务栈大小（字节）
+static const uint32_t FEED_TASK_STACK_SIZE = 4096;
+
+// 静态成员初始化
+AfeFrontend* AfeFrontend::instance_ = nullptr;
+
+AfeFrontend* AfeFrontend::get_instance() {
+    if (instance_ == nullptr) {
+        instance_ = new AfeFrontend();
+    }
+    return instance_;
+}
+
+esp_err_t AfeFrontend::init(srmodel_list_t *models, const char *wakenet_model_name) {
+    if (afe_data_ != nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // "M" 表示单麦克风输入，无回采通道，因此不启用 AEC
+    afe_config_t *afe_config = afe_config_init("M", models, AFE_TYPE_SR, AFE_MODE_LOW_COST);
+    if (afe_config == nullptr) {
+        ESP_LOGE(TAG, "AFE 配置初始化失败");
+        return ESP_FAIL;
+    }
+
+    afe_config->aec_init = false;
+    afe_config->ns_init = true;
+    afe_config->vad_init = true;
+    afe_config->wakenet_init = true;
+    afe_config->wakenet_model_name = const_cast<char *>(wakenet_model_name);
+    afe_config->wakenet_mode = DET_MODE_90;
+    afe_config->memory_alloc_mode = AFE_MEMORY_ALLOC_MORE_PSRAM;
+
+    afe_handle_ = esp_afe_handle_from_config(afe_config);
+    if (afe_handle_ != nullptr) {
+        afe_data_ = afe_handle_->create_from_config(afe_config);
+    }
+    afe_config_free(afe_config);
+
+    if (afe_data_ == nullptr) {
+        ESP_LOGE(TAG, "创建 AFE 实例失败");
+        return ESP_FAIL;
+    }
+
+    int feed_samples = afe_handle_->get_feed_chunksize(afe_data_) * afe_handle_->get_feed_channel_num(afe_data_);
+    feed_chunk_bytes_ = feed_samples * sizeof(int16_t);
+    feed_buffer_ = (int16_t *)heap_caps_aligned_alloc(16, feed_chunk_bytes_, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (feed_buffer_ == nullptr) {
+        ESP_LOGE(TAG, "feed 缓冲区内存分配失败，需要 %d 字节", feed_chunk_bytes_);
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "✓ AFE 创建成功: feed %d 样本, fetch %d 样本",
+             feed_samples, afe_handle_->get_fetch_chunksize(afe_data_));
+    afe_handle_->print_pipeline(afe_data_);
+    return ESP_OK;
+}
+
+esp_err_t AfeFrontend::start(BaseType_t core_id, UBaseType_t priority) {
+    if (afe_data_ == nullptr) {
+        ESP_LOGE(TAG, "AFE 未初始化");
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (feed_task_ != nullptr) {
+        ESP_LOGW(TAG, "feed 任务已在运行");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    BaseType_t ret = xTaskCreatePinnedToCore(feed_task, "afe_feed", FEED_TASK_STACK_SIZE,
+                                             this, priority, &feed_task_, core_id);
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "创建 feed 任务失败");
+        feed_task_ = nullptr;
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "✓ feed 任务已启动: 核心=%d", (int)core_id);
+    return ESP_OK;
+}
+
+void AfeFrontend::feed_task(void *arg) {
+    static_cast<AfeFrontend *>(arg)->run_feed();
+    vTaskDelete(NULL);
+}
+
+void AfeFrontend::run_feed() {
+    while (1) {
+        int64_t read_start = esp_timer_get_time();
+        TRACE_BEGIN(CAPTURE_READ, 0);
+        esp_err_t ret = bsp_get_feed_data(false, feed_buffer_, feed_chunk_bytes_);
+        TRACE_END(CAPTURE_READ, ret);
+        if (ret != ESP_OK) {
+            read_errors_ = read_errors_ + 1;
+            vTaskDelay(pdMS_TO_TICKS(10)); // 等待10ms后重试
+            continue;
+        }
+
+        int64_t feed_start = esp_timer_get_time();
+        TRACE_BEGIN(AFE_FEED, 0);
+        afe_handle_->feed(afe_data_, feed_buffer_);
+        TRACE_END(AFE_FEED, 0);
+        int64_t feed_end = esp_timer_get_time();
+
+        read_timing_.add(static_cast<uint32_t>(feed_start - read_start));
+        feed_timing_.add(static_cast<uint32_t>(feed_end - feed_start));
+    }
+}
+
+afe_fetch_result_t* AfeFrontend::fetch() {
+    int64_t start = esp_timer_get_time();
+    TRACE_BEGIN(AFE_FETCH, 0);
+    afe_fetch_result_t *result = afe_handle_->fetch(afe_data_);
+    TRACE_END(AFE_FETCH, (result != nullptr) ? result->wakeup_state : 0);
+    fetch_timing_.add(static_cast<uint32_t>(esp_timer_get_time() - start));
+
+    if (result == nullptr || result->ret_value == ESP_FAIL) {
+        return nullptr;
+    }
+    return result;
+}
+
+int AfeFrontend::get_fetch_chunksize() const {
+    return afe_handle_->get_fetch_chunksize(afe_data_);
+}
+
+void AfeFrontend::enable_wakenet() {
+    afe_handle_->enable_wakenet(afe_data_);
+}
+
+void AfeFrontend::disable_wakenet() {
+    afe_handle_->disable_wakenet(afe_data_);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file afe_frontend.h
+ * @brief ESP-SR AFE 音频前端定义
+ *
+ * AFE（降噪、VAD、内置唤醒词检测）以两个任务并发运行：
+ * - feed 任务：绑定一个核心，从 INMP441 读取音频并送入 AFE
+ * - fetch 任务：即识别任务，在另一个核心上取出处理后的音频和唤醒状态
+ * 两个任务之间由 AFE 内部的环形缓冲区衔接。
+ */
+
+#pragma once
+
+#include "stage_timing.h"
+
+extern "C" {
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_afe_sr_iface.h"
+#include "esp_afe_sr_models.h"
+#include "model_path.h"
+}
+
+/**
+ * @brief AFE 音频前端管理类
+ *
+ * 单例模式。fetch() 只能由识别任务调用。
+ */
+class AfeFrontend {
+private:
+    static AfeFrontend* instance_;
+
+    esp_afe_sr_iface_t *afe_handle_ = nullptr;
+    esp_afe_sr_data_t *afe_data_ = nullptr;
+    int16_t *feed_buffer_ = nullptr;
+    int feed_chunk_bytes_ = 0;
+    TaskHandle_t feed_task_ = nullptr;
+    volatile uint32_t read_errors_ = 0;
+
+    StageTiming read_timing_;   // feed 任务等待 I2S 数据
+    StageTiming feed_timing_;   // feed 任务执行 afe->feed()
+    StageTiming fetch_timing_;  // 识别任务执行 afe->fetch()（含 NS/VAD/唤醒词）
+
+    /**
+     * @brief 私有构造函数（单例模式）
+     */
+    AfeFrontend() = default;
+
+    /**
+     * @brief feed 任务入口
+     * @param arg AfeFrontend 实例指针
+     */
+    static void feed_task(void *arg);
+
+    /**
+     * @brief feed 主循环
+     */
+    void run_feed();
+
+public:
+    /**
+     * @brief 获取单例实例
+     * @return AfeFrontend* 单例实例指针
+     */
+    static AfeFrontend* get_instance();
+
+    /**
+     * @brief 创建 AFE 实例（单麦克风，启用降噪、VAD 和唤醒词）
+     * @param models 已加载的模型列表
+     * @param wakenet_model_name 唤醒词模型名称
+     * @return esp_err_t 创建结果
+     */
+    esp_err_t init(srmodel_list_t *models, const char *wakenet_model_name);
+
+    /**
+     * @brief 启动 feed 任务
+     * @param core_id feed 任务绑定的CPU核
+     * @param priority feed 任务优先级
+     * @return esp_err_t 启动结果
+     */
+    esp_err_t start(BaseType_t core_id, UBaseType_t priority);
+
+    /**
+     * @brief 取出一帧处理后的音频（仅识别任务调用，阻塞直到有数据）
+     * @return afe_fetch_result_t* 结果，失败返回nullptr
+     */
+    afe_fetch_result_t* fetch();
+
+    /**
+     * @brief 每次 fetch() 返回的样本数
+     */
+    int get_fetch_chunksize() const;
+
+    /**
+     * @brief 开启 AFE 内置唤醒词检测
+     */
+    void enable_wakenet();
+
+    /**
+     * @brief 关闭 AFE 内置唤醒词检测（命令词识别期间节省 CPU）
+     */
+    void disable_wakenet();
+
+    /**
+     * @brief 各阶段耗时统计
+     */
+    const StageTiming& get_read_timing() const { return read_timing_; }
+    const StageTiming& get_feed_timing() const { return feed_timing_; }
+    const StageTiming& get_fetch_timing() const { return fetch_timing_; }
+
+    /**
+     * @brief I2S 读取失败次数
+     */
+    uint32_t get_read_errors() const { return read_errors_; }
+};
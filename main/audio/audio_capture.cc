@@ -0,0 +1,152 @@
+/**
+ * @file audio_capture.cc
+ * @brief 麦克风采集任务实现
+ */
+
+#include "audio_capture.h"
+#include <string.h>
+
+extern "C" {
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "bsp_board.h"
+}
+
+#include "system/trace.h"
+
+static const char *TAG = "音频采集";
+
+// 采集任务栈大小（字节）
+static const uint32_t CAPTURE_TASK_STACK_SIZE = 3072;
+
+// 静态成员初始化
+AudioCapture* AudioCapture::instance_ = nullptr;
+
+AudioCapture* AudioCapture::get_instance() {
+    if (instance_ == nullptr) {
+        instance_ = new AudioCapture();
+    }
+    return instance_;
+}
+
+esp_err_t AudioCapture::start(size_t frame_samples, size_t ring_frames, BaseType_t core_id, UBaseType_t priority) {
+    if (capture_task_ != nullptr) {
+        ESP_LOGW(TAG, "采集任务已在运行");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // 帧缓冲区放在内部RAM并按16字节对齐，便于DMA拷贝和向量化处理
+    size_t storage_bytes = frame_samples * ring_frames * sizeof(int16_t);
+    storage_ = (int16_t *)heap_caps_aligned_alloc(16, storage_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    scratch_ = (int16_t *)heap_caps_aligned_alloc(16, frame_samples * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (storage_ == nullptr || scratch_ == nullptr) {
+        ESP_LOGE(TAG, "帧缓冲区内存分配失败，需要 %zu 字节", storage_bytes);
+        heap_caps_free(storage_);
+        heap_caps_free(scratch_);
+        storage_ = nullptr;
+        scratch_ = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (!ring_.init(storage_, frame_samples, ring_frames)) {
+        ESP_LOGE(TAG, "帧缓冲区参数无效: 帧长=%zu, 帧数=%zu（必须是2的幂）", frame_samples, ring_frames);
+        heap_caps_free(storage_);
+        heap_caps_free(scratch_);
+        storage_ = nullptr;
+        scratch_ = nullptr;
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    BaseType_t ret = xTaskCreatePinnedToCore(capture_task, "audio_capture", CAPTURE_TASK_STACK_SIZE,
+                                             this, priority, &capture_task_, core_id);
+    if (ret != pdPASS) {
+        ESP_LOGE(TAG, "创建采集任务失败");
+        capture_task_ = nullptr;
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "✓ 采集任务已启动: 核心=%d, 帧长=%zu 样本, 缓冲 %zu 帧",
+             (int)core_id, frame_samples, ring_frames);
+    return ESP_OK;
+}
+
+void AudioCapture::capture_task(void *arg) {
+    static_cast<AudioCapture *>(arg)->run();
+    vTaskDelete(NULL);
+}
+
+void AudioCapture::run() {
+    const int frame_bytes = ring_.frame_samples() * sizeof(int16_t);
+
+    while (1) {
+        // 优先直接读入环形缓冲区的空闲槽，避免额外拷贝
+        int16_t *slot = ring_.acquire_write();
+        int16_t *target = (slot != nullptr) ? slot : scratch_;
+
+        TRACE_BEGIN(CAPTURE_READ, 0);
+        esp_err_t ret = bsp_get_feed_data(false, target, frame_bytes);
+        TRACE_END(CAPTURE_READ, ret);
+        if (ret != ESP_OK) {
+            read_errors_ = read_errors_ + 1;
+            vTaskDelay(pdMS_TO_TICKS(10)); // 等待10ms后重试
+            continue;
+        }
+
+        if (slot == nullptr) {
+            // 读取期间识别任务可能已经腾出空间，此时补一次拷贝，否则丢弃该帧
+            slot = ring_.acquire_write();
+            if (slot == nullptr) {
+                ring_.record_overrun();
+                TRACE_INSTANT(CAPTURE_OVERRUN, 0);
+                continue;
+            }
+            memcpy(slot, scratch_, frame_bytes);
+        }
+
+        ring_.commit_write();
+
+        TaskHandle_t consumer = consumer_task_.load(std::memory_order_acquire);
+        if (consumer != nullptr) {
+            xTaskNotifyGive(consumer);
+        }
+    }
+}
+
+const int16_t* AudioCapture::wait_frame(TickType_t timeout) {
+    if (consumer_task_.load(std::memory_order_relaxed) == nullptr) {
+        consumer_task_.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    }
+
+    const int16_t *frame = ring_.acquire_read();
+    if (frame != nullptr) {
+        return frame;
+    }
+
+    // 通知计数在消费者睡眠前到达也不会丢失，取回后再查一次缓冲区
+    ulTaskNotifyTake(pdTRUE, timeout);
+    return ring_.acquire_read();
+}
+
+void AudioCapture::release_frame() {
+    ring_.release_read();
+}
+
+size_t AudioCapture::get_pending_frames() const {
+    return ring_.size();
+}
+
+size_t AudioCapture::get_frame_samples() const {
+    return ring_.frame_samples();
+}
+
+audio_capture_stats_t AudioCapture::get_stats() const {
+    frame_ring_stats_t ring_stats = ring_.get_stats();
+    return {
+        .frames_captured = ring_stats.frames_written,
+        .frames_consumed = ring_stats.frames_read,
+        .overruns = ring_stats.overruns,
+        .read_errors = read_errors_,
+        .peak_fill = ring_stats.peak_fill,
+        .capacity = static_cast<uint32_t>(ring_.capacity())
+    };
+}
@@ -0,0 +1,109 @@
+/**
+ * @file audio_capture.h
+ * @brief 麦克风采集任务定义
+ *
+ * 独立的采集任务固定在一个CPU核上，持续从 INMP441 读取音频帧并写入
+ * 无锁帧环形缓冲区；识别任务在另一个核上从缓冲区取帧处理。
+ * 这样唤醒词/命令词检测或命令执行偶尔变慢时，麦克风数据不会丢失。
+ */
+
+#pragma once
+
+#include <atomic>
+#include "frame_ring.h"
+
+extern "C" {
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+}
+
+/**
+ * @brief 采集统计信息
+ */
+typedef struct {
+    uint32_t frames_captured;  // 已写入缓冲区的帧数
+    uint32_t frames_consumed;  // 识别任务已处理的帧数
+    uint32_t overruns;         // 缓冲区满被丢弃的帧数
+    uint32_t read_errors;      // I2S 读取失败次数
+    uint32_t peak_fill;        // 缓冲区历史最高占用帧数
+    uint32_t capacity;         // 缓冲区总帧数
+} audio_capture_stats_t;
+
+/**
+ * @brief 麦克风采集管理类
+ *
+ * 单例模式。采集任务是帧环形缓冲区唯一的生产者，
+ * 调用 wait_frame()/release_frame() 的识别任务是唯一的消费者。
+ */
+class AudioCapture {
+private:
+    static AudioCapture* instance_;
+
+    FrameRing ring_;
+    int16_t *storage_ = nullptr;
+    int16_t *scratch_ = nullptr;   // 缓冲区满时接收 I2S 数据，保证 DMA 不积压
+    TaskHandle_t capture_task_ = nullptr;
+    std::atomic<TaskHandle_t> consumer_task_{nullptr};  // 识别任务写入，采集任务在另一个核上读取
+    volatile uint32_t read_errors_ = 0;
+
+    /**
+     * @brief 私有构造函数（单例模式）
+     */
+    AudioCapture() = default;
+
+    /**
+     * @brief 采集任务入口
+     * @param arg AudioCapture 实例指针
+     */
+    static void capture_task(void *arg);
+
+    /**
+     * @brief 采集主循环
+     */
+    void run();
+
+public:
+    /**
+     * @brief 获取单例实例
+     * @return AudioCapture* 单例实例指针
+     */
+    static AudioCapture* get_instance();
+
+    /**
+     * @brief 分配帧缓冲区并启动采集任务
+     * @param frame_samples 每帧样本数（与唤醒词模型的块大小一致）
+     * @param ring_frames 缓冲区帧数，必须是2的幂
+     * @param core_id 采集任务绑定的CPU核
+     * @param priority 采集任务优先级
+     * @return esp_err_t 启动结果
+     */
+    esp_err_t start(size_t frame_samples, size_t ring_frames, BaseType_t core_id, UBaseType_t priority);
+
+    /**
+     * @brief 等待下一帧音频（仅识别任务调用）
+     * @param timeout 最长等待时间
+     * @return const int16_t* 帧指针，超时返回nullptr；处理完成后必须调用 release_frame()
+     */
+    const int16_t* wait_frame(TickType_t timeout);
+
+    /**
+     * @brief 释放 wait_frame() 返回的帧
+     */
+    void release_frame();
+
+    /**
+     * @brief 当前排队等待处理的帧数
+     */
+    size_t get_pending_frames() const;
+
+    /**
+     * @brief 每帧样本数
+     */
+    size_t get_frame_samples() const;
+
+    /**
+     * @brief 获取采集统计信息
+     */
+    audio_capture_stats_t get_stats() const;
+};
@@ -0,0 +1,38 @@
+/**
+ * @file audio_history.cc
+ * @brief 音频历史环形缓冲区实现
+ */
+
+#include "audio_history.h"
+#include <cstring>
+
+bool AudioHistory::init(int16_t *storage, size_t frame_samples, size_t capacity) {
+    if (storage == nullptr || frame_samples == 0 || capacity == 0) {
+        return false;
+    }
+
+    storage_ = storage;
+    frame_samples_ = frame_samples;
+    capacity_ = capacity;
+    total_ = 0;
+    return true;
+}
+
+uint32_t AudioHistory::push(const int16_t *frame) {
+    uint32_t index = total_;
+    int16_t *slot = storage_ + static_cast<size_t>(index % capacity_) * frame_samples_;
+    memcpy(slot, frame, frame_samples_ * sizeof(int16_t));
+    total_++;
+    return index;
+}
+
+const int16_t* AudioHistory::frame_at(uint32_t index) const {
+    if (storage_ == nullptr || index >= total_ || index < oldest_index()) {
+        return nullptr;
+    }
+    return storage_ + static_cast<size_t>(index % capacity_) * frame_samples_;
+}
+
+uint32_t AudioHistory::oldest_index() const {
+    return (total_ > capacity_) ? static_cast<uint32_t>(total_ - capacity_) : 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file audio_history.h
+ * @brief 音频历史环形缓冲区（预录音）
+ *
+ * 保存识别任务最近处理过的 N 帧调理后音频，每帧带一个单调递增的序号。
+ * 检测到唤醒词后可以按序号取回唤醒词结束前后的帧，快速回灌给命令词模型，
+ * 用户一口气说完"唤醒词+命令"也不会丢掉命令开头。
+ * 本模块只依赖 C++ 标准库，可以在 Linux 主机上用 WAV 数据测试。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 音频历史环形缓冲区
+ *
+ * 单线程使用（识别任务）。存储由调用者提供，ESP32 上放在 PSRAM。
+ */
+class AudioHistory {
+public:
+    AudioHistory() = default;
+
+    AudioHistory(const AudioHistory&) = delete;
+    AudioHistory& operator=(const AudioHistory&) = delete;
+
+    /**
+     * @brief 绑定帧存储
+     * @param storage 至少 frame_samples * capacity 个样本的存储区
+     * @param frame_samples 每帧样本数
+     * @param capacity 保存的帧数
+     * @return bool 参数合法返回true
+     */
+    bool init(int16_t *storage, size_t frame_samples, size_t capacity);
+
+    /**
+     * @brief 追加一帧，缓冲区满时覆盖最旧的帧
+     * @param frame 帧数据
+     * @return uint32_t 该帧的序号
+     */
+    uint32_t push(const int16_t *frame);
+
+    /**
+     * @brief 按序号取回一帧
+     * @param index 帧序号
+     * @return const int16_t* 帧指针，帧已被覆盖或尚未写入时返回nullptr
+     */
+    const int16_t* frame_at(uint32_t index) const;
+
+    /**
+     * @brief 已追加的帧总数（下一帧的序号）
+     */
+    uint32_t total_frames() const { return total_; }
+
+    /**
+     * @brief 仍可取回的最旧帧序号
+     */
+    uint32_t oldest_index() const;
+
+    /**
+     * @brief 每帧样本数
+     */
+    size_t frame_samples() const { return frame_samples_; }
+
+    /**
+     * @brief 保存的帧数
+     */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief 是否已绑定存储
+     */
+    bool is_ready() const { return storage_ != nullptr; }
+
+private:
+    int16_t *storage_ = nullptr;
+    size_t frame_samples_ = 0;
+    size_t capacity_ = 0;
+    uint32_t total_ = 0;
+};
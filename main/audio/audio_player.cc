@@ -0,0 +1,249 @@
+/**
+ * @file audio_player.cc
+ * @brief 非阻塞提示音播放器实现
+ */
+
+#include "audio_player.h"
+
+extern "C" {
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "bsp_board.h"
+}
+
+#include "system/dlog.h"
+#include "system/trace.h"
+
+static const char *TAG = "音频播放";
+
+// 播放任务配置
+static const uint32_t PLAYER_TASK_STACK_SIZE = 3072;
+static const UBaseType_t PLAYER_QUEUE_LENGTH = 8;
+static const uint32_t WRITE_TIMEOUT_MS = 1000;
+
+/**
+ * @brief 基于 I2S 发送通道的输出端
+ */
+class BspAudioSink : public PlaybackSink {
+public:
+    BspAudioSink(StageTiming &latency, std::atomic<uint32_t> &max_latency_us)
+        : latency_(latency), max_latency_us_(max_latency_us) {}
+
+    int write(const uint8_t *data, size_t len) override {
+        size_t bytes_written = 0;
+        TRACE_BEGIN(PLAY_WRITE, len);
+        esp_err_t ret = bsp_audio_write(data, len, &bytes_written, WRITE_TIMEOUT_MS);
+        TRACE_END(PLAY_WRITE, bytes_written);
+        if (ret != ESP_OK && ret != ESP_ERR_TIMEOUT) {
+            return -1;
+        }
+        return static_cast<int>(bytes_written);
+    }
+
+    void idle() override {
+        // 队列播放完毕后停止I2S输出以防止噪音
+        TRACE_INSTANT(PLAY_IDLE, 0);
+        esp_err_t ret = bsp_audio_stop();
+        if (ret != ESP_OK) {
+            DLOGW(TAG, "停止音频输出时出现警告: %s", esp_err_to_name(ret));
+        }
+    }
+
+    void clip_started(const playback_clip_t &clip) override {
+        TRACE_INSTANT(PLAY_START, clip.id);
+        uint32_t latency_us = static_cast<uint32_t>(esp_timer_get_time() - clip.enqueued_us);
+        latency_.add(latency_us);
+        if (latency_us > max_latency_us_.load()) {
+            max_latency_us_.store(latency_us);
+        }
+        DLOGD(TAG, "片段 %lu 启动延迟 %lu us", (unsigned long)clip.id, (unsigned long)latency_us);
+    }
+
+private:
+    StageTiming &latency_;
+    std::atomic<uint32_t> &max_latency_us_;
+};
+
+// 静态成员初始化
+AudioPlayer* AudioPlayer::instance_ = nullptr;
+
+AudioPlayer* AudioPlayer::get_instance() {
+    if (instance_ == nullptr) {
+        instance_ = new AudioPlayer();
+    }
+    return instance_;
+}
+
+esp_err_t AudioPlayer::start(BaseType_t core_id, UBaseType_t priority) {
+    if (task_ != nullptr) {
+        DLOGW(TAG, "播放任务已在运行");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    scheduler_.set_ramp(FADE_SAMPLES, scratch_, CHUNK_BYTES / sizeof(int16_t));
+
+    queue_ = xQueueCreate(PLAYER_QUEUE_LENGTH, sizeof(player_msg_t));
+    if (queue_ == nullptr) {
+        DLOGE(TAG, "创建播放消息队列失败");
+        return ESP_ERR_NO_MEM;
+    }
+
+    BaseType_t ret = xTaskCreatePinnedToCore(player_task, "audio_player", PLAYER_TASK_STACK_SIZE,
+                                             this, priority, &task_, core_id);
+    if (ret != pdPASS) {
+        DLOGE(TAG, "创建播放任务失败");
+        vQueueDelete(queue_);
+        queue_ = nullptr;
+        task_ = nullptr;
+        return ESP_FAIL;
+    }
+
+    DLOGI(TAG, "✓ 播放任务已启动: 核心=%d, 每块 %zu 字节", (int)core_id, CHUNK_BYTES);
+    return ESP_OK;
+}
+
+playback_id_t AudioPlayer::play(const uint8_t *data, size_t len, playback_callback_t callback, void *user_ctx) {
+    return submit(data, len, PLAYBACK_CODEC_PCM16, callback, user_ctx);
+}
+
+playback_id_t AudioPlayer::submit(const uint8_t *data, size_t len, playback_codec_t codec,
+                                  playback_callback_t callback, void *user_ctx) {
+    if (queue_ == nullptr) {
+        DLOGE(TAG, "播放任务未启动");
+        return 0;
+    }
+
+    if (data == nullptr || len == 0) {
+        DLOGE(TAG, "无效的音频数据");
+        return 0;
+    }
+
+    playback_id_t id = next_id_.fetch_add(1);
+    if (id == 0) {
+        id = next_id_.fetch_add(1); // 跳过回绕后的无效ID
+    }
+
+    player_msg_t msg = {
+        .type = PLAYER_MSG_PLAY,
+        .clip = {
+            .id = id,
+            .data = data,
+            .len = len,
+            .codec = codec,
+            .callback = callback,
+            .user_ctx = user_ctx,
+            .enqueued_us = esp_timer_get_time()
+        }
+    };
+
+    // 先计入已提交，保证 is_busy() 在消息到达播放任务前就返回true
+    submitted_.fetch_add(1);
+    if (xQueueSend(queue_, &msg, 0) != pdTRUE) {
+        submitted_.fetch_sub(1);
+        DLOGW(TAG, "播放队列已满，丢弃播放请求");
+        return 0;
+    }
+
+    TRACE_INSTANT(PLAY_SUBMIT, id);
+    return id;
+}
+
+playback_id_t AudioPlayer::play_prompt(prompt_id_t prompt, playback_callback_t callback, void *user_ctx) {
+    return play_view(PromptStore::name(prompt), PromptStore::get_instance()->get(prompt), callback, user_ctx);
+}
+
+playback_id_t AudioPlayer::play_prompt(const char *name, playback_callback_t callback, void *user_ctx) {
+    return play_view(name, PromptStore::get_instance()->find(name), callback, user_ctx);
+}
+
+playback_id_t AudioPlayer::play_view(const char *name, const prompt_view_t &view,
+                                     playback_callback_t callback, void *user_ctx) {
+    if (view.data == nullptr) {
+        DLOGE(TAG, "提示音 '%s' 不可用", name);
+        return 0;
+    }
+    if (view.codec != PLAYBACK_CODEC_PCM16 && view.codec != PLAYBACK_CODEC_IMA_ADPCM) {
+        DLOGE(TAG, "提示音 '%s' 编码不支持: %d", name, (int)view.codec);
+        return 0;
+    }
+    return submit(view.data, view.len, static_cast<playback_codec_t>(view.codec), callback, user_ctx);
+}
+
+esp_err_t AudioPlayer::cancel(playback_id_t id) {
+    if (queue_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    player_msg_t msg = {};
+    msg.type = PLAYER_MSG_CANCEL;
+    msg.clip.id = id;
+    return (xQueueSend(queue_, &msg, 0) == pdTRUE) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t AudioPlayer::cancel_all() {
+    if (queue_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    player_msg_t msg = {};
+    msg.type = PLAYER_MSG_CANCEL_ALL;
+    return (xQueueSend(queue_, &msg, 0) == pdTRUE) ? ESP_OK : ESP_FAIL;
+}
+
+bool AudioPlayer::is_busy() const {
+    return submitted_.load() != finished_.load();
+}
+
+void AudioPlayer::player_task(void *arg) {
+    static_cast<AudioPlayer *>(arg)->run();
+    vTaskDelete(NULL);
+}
+
+void AudioPlayer::run() {
+    BspAudioSink sink(start_latency_, max_start_latency_us_);
+    bool output_active = false;
+    player_msg_t msg;
+
+    while (1) {
+        // 空闲时阻塞等待新请求；播放中只取出已经到达的消息，不耽误写入下一块
+        TickType_t wait = scheduler_.busy() ? 0 : portMAX_DELAY;
+        while (xQueueReceive(queue_, &msg, wait) == pdTRUE) {
+            handle_message(msg);
+            wait = 0;
+        }
+
+        if (scheduler_.busy()) {
+            output_active = true;
+            // 播放完最后一个片段时 pump() 会调用 sink.idle()
+            if (!scheduler_.pump(sink, CHUNK_BYTES)) {
+                output_active = false;
+            }
+        } else if (output_active) {
+            // 播放中途被全部取消：衰减到 0 后再进入空闲
+            scheduler_.stop_output(sink);
+            output_active = false;
+        }
+
+        finished_.store(scheduler_.finished_count() + rejected_);
+    }
+}
+
+void AudioPlayer::handle_message(const player_msg_t &msg) {
+    switch (msg.type) {
+    case PLAYER_MSG_PLAY:
+        if (!scheduler_.enqueue(msg.clip)) {
+            DLOGW(TAG, "待播放片段过多，丢弃片段 %lu", (unsigned long)msg.clip.id);
+            rejected_++;
+            if (msg.clip.callback != nullptr) {
+                msg.clip.callback(msg.clip.id, PLAYBACK_EVENT_FAILED, msg.clip.user_ctx);
+            }
+        }
+        break;
+    case PLAYER_MSG_CANCEL:
+        scheduler_.cancel(msg.clip.id);
+        break;
+    case PLAYER_MSG_CANCEL_ALL:
+        scheduler_.cancel_all();
+        break;
+    }
+}
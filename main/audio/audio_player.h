@@ -0,0 +1,177 @@
+/**
+ * @file audio_player.h
+ * @brief 非阻塞提示音播放器定义
+ *
+ * 播放请求通过消息队列交给后台播放任务，由任务按DMA大小的块流式写入
+ * I2S 发送通道。调用者（识别任务、命令执行）立即返回，麦克风采集和
+ * 识别不会因为播放提示音而停顿。片段首尾做短暂淡入淡出，发送通道常开时
+ * 不会产生"咔哒"声。
+ */
+
+#pragma once
+
+#include <atomic>
+#include "playback_scheduler.h"
+#include "stage_timing.h"
+#include "prompt_store.h"
+
+extern "C" {
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+}
+
+/**
+ * @brief 非阻塞提示音播放器
+ *
+ * 单例模式。play()/cancel()/cancel_all() 可以在任意任务中调用，
+ * 完成回调在播放任务上下文中执行。
+ */
+class AudioPlayer {
+private:
+    static AudioPlayer* instance_;
+
+    /**
+     * @brief 播放任务消息类型
+     */
+    typedef enum {
+        PLAYER_MSG_PLAY = 0,   // 片段入队
+        PLAYER_MSG_CANCEL,     // 取消指定片段
+        PLAYER_MSG_CANCEL_ALL  // 取消全部片段
+    } player_msg_type_t;
+
+    /**
+     * @brief 播放任务消息
+     */
+    typedef struct {
+        player_msg_type_t type;
+        playback_clip_t clip;
+    } player_msg_t;
+
+    PlaybackScheduler scheduler_;
+    QueueHandle_t queue_ = nullptr;
+    TaskHandle_t task_ = nullptr;
+    std::atomic<uint32_t> next_id_{1};
+    std::atomic<uint32_t> submitted_{0};  // 已成功提交到播放任务的片段数
+    std::atomic<uint32_t> finished_{0};   // 已结束（完成/取消/失败）的片段数
+    uint32_t rejected_ = 0;               // 调度器队列已满被拒绝的片段数（仅播放任务访问）
+
+    StageTiming start_latency_;                 // 入队到第一块数据写入I2S的延迟
+    std::atomic<uint32_t> max_start_latency_us_{0};
+
+    /**
+     * @brief 私有构造函数（单例模式）
+     */
+    AudioPlayer() = default;
+
+    /**
+     * @brief 播放任务入口
+     * @param arg AudioPlayer 实例指针
+     */
+    static void player_task(void *arg);
+
+    /**
+     * @brief 播放主循环
+     */
+    void run();
+
+    /**
+     * @brief 在播放任务中处理一条消息
+     */
+    void handle_message(const player_msg_t &msg);
+
+    /**
+     * @brief 生成片段并发送到播放任务
+     */
+    playback_id_t submit(const uint8_t *data, size_t len, playback_codec_t codec,
+                         playback_callback_t callback, void *user_ctx);
+
+    /**
+     * @brief 检查提示音视图后提交播放
+     */
+    playback_id_t play_view(const char *name, const prompt_view_t &view,
+                            playback_callback_t callback, void *user_ctx);
+
+public:
+    static const size_t CHUNK_BYTES = 960;  // 每次写入的字节数（2个DMA缓冲，约30ms）
+    static const size_t FADE_SAMPLES = 80;  // 淡入淡出长度（16kHz下5ms）
+
+    /**
+     * @brief 获取单例实例
+     * @return AudioPlayer* 单例实例指针
+     */
+    static AudioPlayer* get_instance();
+
+    /**
+     * @brief 启动播放任务（需在 bsp_audio_init() 之后调用）
+     * @param core_id 播放任务绑定的CPU核
+     * @param priority 播放任务优先级
+     * @return esp_err_t 启动结果
+     */
+    esp_err_t start(BaseType_t core_id, UBaseType_t priority);
+
+    /**
+     * @brief 将一段PCM音频加入播放队列，立即返回
+     * @param data PCM数据，播放完成前必须保持有效
+     * @param len 数据长度（字节）
+     * @param callback 完成回调，可为nullptr
+     * @param user_ctx 回调用户参数
+     * @return playback_id_t 播放请求ID，入队失败返回0
+     */
+    playback_id_t play(const uint8_t *data, size_t len,
+                       playback_callback_t callback = nullptr, void *user_ctx = nullptr);
+
+    /**
+     * @brief 将提示音分区中的一个提示音加入播放队列，立即返回
+     * @param prompt 提示音ID
+     * @param callback 完成回调，可为nullptr
+     * @param user_ctx 回调用户参数
+     * @return playback_id_t 播放请求ID，提示音缺失或入队失败返回0
+     */
+    playback_id_t play_prompt(prompt_id_t prompt,
+                              playback_callback_t callback = nullptr, void *user_ctx = nullptr);
+
+    /**
+     * @brief 按名称将提示音分区中的一个提示音加入播放队列，立即返回
+     * @param name 提示音名称
+     * @param callback 完成回调，可为nullptr
+     * @param user_ctx 回调用户参数
+     * @return playback_id_t 播放请求ID，提示音缺失或入队失败返回0
+     */
+    playback_id_t play_prompt(const char *name,
+                              playback_callback_t callback = nullptr, void *user_ctx = nullptr);
+
+    /**
+     * @brief 取消指定片段（正在播放或排队中）
+     * @param id 播放请求ID
+     * @return esp_err_t 请求是否成功发送到播放任务
+     */
+    esp_err_t cancel(playback_id_t id);
+
+    /**
+     * @brief 取消所有正在播放和排队的片段
+     * @return esp_err_t 请求是否成功发送到播放任务
+     */
+    esp_err_t cancel_all();
+
+    /**
+     * @brief 是否有尚未播放完成的片段
+     */
+    bool is_busy() const;
+
+    /**
+     * @brief 启动延迟统计：play() 入队到第一块数据被I2S驱动接收
+     *
+     * 声音实际出现还要再加上DMA中已排队的数据时长。
+     */
+    const StageTiming& get_start_latency() const { return start_latency_; }
+
+    /**
+     * @brief 启动以来最大的启动延迟（微秒）
+     */
+    uint32_t get_max_start_latency_us() const { return max_start_latency_us_.load(); }
+
+private:
+    int16_t scratch_[CHUNK_BYTES / sizeof(int16_t)];  // 淡入淡出处理缓冲区（仅播放任务访问）
+};
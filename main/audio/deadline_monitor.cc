@@ -0,0 +1,117 @@
+/**
+ * @file deadline_monitor.cc
+ * @brief 逐帧实时预算监视实现
+ */
+
+#include "deadline_monitor.h"
+
+// 告警解除的回差，避免负载在告警线附近时反复告警
+static const uint32_t HYSTERESIS_PERMILLE = 50;
+
+void DeadlineMonitor::init(const deadline_monitor_config_t &config) {
+    config_ = config;
+    warned_ = false;
+    for (size_t i = 0; i <= DEADLINE_HIST_BINS; i++) {
+        bins_[i].store(0, std::memory_order_relaxed);
+    }
+    frames_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+    load_sum_.store(0, std::memory_order_relaxed);
+    max_cycles_.store(0, std::memory_order_relaxed);
+    smoothed_q8_.store(0, std::memory_order_relaxed);
+}
+
+deadline_event_t DeadlineMonitor::record(uint32_t cycles) {
+    if (config_.budget_cycles == 0) {
+        return DEADLINE_EVENT_NONE;
+    }
+
+    // 负载上限 65535‰，平滑运算的 Q8 定点值不会溢出
+    uint64_t load64 = uint64_t(cycles) * 1000 / config_.budget_cycles;
+    uint32_t load = (load64 > UINT16_MAX) ? UINT16_MAX : static_cast<uint32_t>(load64);
+
+    size_t bin = load / DEADLINE_HIST_BIN_PERMILLE;
+    bin = (bin > DEADLINE_HIST_BINS) ? DEADLINE_HIST_BINS : bin;
+    bins_[bin].fetch_add(1, std::memory_order_relaxed);
+    load_sum_.fetch_add(load, std::memory_order_relaxed);
+    if (cycles > config_.budget_cycles) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (cycles > max_cycles_.load(std::memory_order_relaxed)) {
+        max_cycles_.store(cycles, std::memory_order_relaxed);
+    }
+    // 帧数最后更新并带release：读到该帧数的快照一定包含对应的桶计数
+    frames_.fetch_add(1, std::memory_order_release);
+
+    // 一阶低通：偶发的单帧超时由采集缓冲吸收，持续的高负载才需要告警
+    int32_t smoothed = static_cast<int32_t>(smoothed_q8_.load(std::memory_order_relaxed));
+    smoothed += (static_cast<int32_t>(load << 8) - smoothed) >> config_.smoothing;
+    smoothed_q8_.store(static_cast<uint32_t>(smoothed), std::memory_order_relaxed);
+
+    if (config_.warn_headroom_permille == 0 || config_.warn_headroom_permille >= 1000) {
+        return DEADLINE_EVENT_NONE;
+    }
+
+    uint32_t warn_line = 1000 - config_.warn_headroom_permille;
+    uint32_t current = static_cast<uint32_t>(smoothed) >> 8;
+    if (!warned_ && current > warn_line) {
+        warned_ = true;
+        return DEADLINE_EVENT_HEADROOM_LOW;
+    }
+    if (warned_ && current + HYSTERESIS_PERMILLE < warn_line) {
+        warned_ = false;
+        return DEADLINE_EVENT_HEADROOM_OK;
+    }
+    return DEADLINE_EVENT_NONE;
+}
+
+void DeadlineMonitor::snapshot(deadline_snapshot_t *out) const {
+    out->frames = frames_.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= DEADLINE_HIST_BINS; i++) {
+        out->bins[i] = bins_[i].load(std::memory_order_relaxed);
+    }
+    out->misses = misses_.load(std::memory_order_relaxed);
+    out->load_sum = load_sum_.load(std::memory_order_relaxed);
+    out->max_cycles = max_cycles_.load(std::memory_order_relaxed);
+}
+
+deadline_window_t DeadlineMonitor::window(const deadline_snapshot_t &prev, const deadline_snapshot_t &now) {
+    deadline_window_t w = {};
+
+    // 快照之间写入方可能正在记录，桶计数之和可能略多于帧数，以桶计数为准
+    uint32_t total = 0;
+    for (size_t i = 0; i <= DEADLINE_HIST_BINS; i++) {
+        total += now.bins[i] - prev.bins[i];
+    }
+    if (total == 0) {
+        return w;
+    }
+
+    w.frames = total;
+    // 同理，两次快照各自可能有一帧的超时计数与桶计数不同步，超时帧数不超过窗口帧数
+    w.misses = now.misses - prev.misses;
+    w.misses = (w.misses > total) ? total : w.misses;
+    w.avg_permille = (now.load_sum - prev.load_sum) / total;
+
+    uint32_t p99_rank = total - total / 100;    // 第 p99_rank 帧（从1计）所在的桶
+    uint32_t seen = 0;
+    bool have_min = false;
+    for (size_t i = 0; i <= DEADLINE_HIST_BINS; i++) {
+        uint32_t n = now.bins[i] - prev.bins[i];
+        if (n == 0) {
+            continue;
+        }
+        uint32_t upper = (i == DEADLINE_HIST_BINS) ? DEADLINE_HIST_BINS * DEADLINE_HIST_BIN_PERMILLE
+                                                   : (i + 1) * DEADLINE_HIST_BIN_PERMILLE;
+        if (!have_min) {
+            w.min_permille = (i == DEADLINE_HIST_BINS) ? upper : i * DEADLINE_HIST_BIN_PERMILLE;
+            have_min = true;
+        }
+        if (seen < p99_rank && seen + n >= p99_rank) {
+            w.p99_permille = upper;
+        }
+        seen += n;
+        w.max_permille = upper;
+    }
+    return w;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file deadline_monitor.h
+ * @brief 逐帧实时预算监视
+ *
+ * 每帧音频必须在录下下一帧之前处理完。这里以 CPU 周期计数记录每帧的处理
+ * 耗时，换算为占帧时长的负载（千分比）记入直方图，统计超出预算的帧数；
+ * 平滑后的负载超过告警线时给出一次告警事件，回落后给出一次恢复事件。
+ *
+ * 写入方只有一个任务，计数器全部为原子变量，其他任务随时读取快照无需加锁。
+ * 计数器为 32 位并允许回绕，和 StageTiming 一样用两次快照的差值统计窗口。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#define DEADLINE_HIST_BINS 100            // 直方图桶数（另有一个溢出桶）
+#define DEADLINE_HIST_BIN_PERMILLE 20     // 每个桶的宽度（负载千分比），覆盖 0~200%
+
+/**
+ * @brief 实时预算监视配置
+ */
+typedef struct {
+    uint32_t budget_cycles;         // 一帧的周期预算（帧时长 × CPU 频率）
+    uint16_t warn_headroom_permille; // 平滑负载的余量低于该值时告警，0 表示不告警
+    uint8_t smoothing;              // 负载平滑系数（右移位数，越大越平滑）
+} deadline_monitor_config_t;
+
+/**
+ * @brief 默认配置：余量低于 20% 告警，约 16 帧的平滑
+ */
+#define DEADLINE_MONITOR_DEFAULT_CONFIG(budget) { \
+    .budget_cycles = (budget),                    \
+    .warn_headroom_permille = 200,                \
+    .smoothing = 4,                               \
+}
+
+/**
+ * @brief record() 返回的事件
+ */
+typedef enum {
+    DEADLINE_EVENT_NONE = 0,        // 无变化
+    DEADLINE_EVENT_HEADROOM_LOW,    // 平滑负载刚越过告警线
+    DEADLINE_EVENT_HEADROOM_OK,     // 平滑负载刚回落到告警线以下
+} deadline_event_t;
+
+/**
+ * @brief 累计值快照
+ */
+typedef struct {
+    uint32_t bins[DEADLINE_HIST_BINS + 1];  // 各负载区间的帧数，最后一个为溢出桶
+    uint32_t frames;                        // 累计帧数
+    uint32_t misses;                        // 累计超出预算的帧数
+    uint32_t load_sum;                      // 累计负载（千分比之和）
+    uint32_t max_cycles;                    // 启动以来单帧最大周期数
+} deadline_snapshot_t;
+
+/**
+ * @brief 两次快照之间的统计
+ *
+ * 最小、p99、最大值按直方图桶计算，精度为 DEADLINE_HIST_BIN_PERMILLE；
+ * 落入溢出桶时为 DEADLINE_HIST_BINS * DEADLINE_HIST_BIN_PERMILLE。
+ */
+typedef struct {
+    uint32_t frames;         // 帧数
+    uint32_t misses;         // 超出预算的帧数
+    uint32_t min_permille;   // 最小负载（所在桶下界）
+    uint32_t avg_permille;   // 平均负载
+    uint32_t p99_permille;   // 99 分位负载（所在桶上界）
+    uint32_t max_permille;   // 最大负载（所在桶上界）
+} deadline_window_t;
+
+/**
+ * @brief 逐帧实时预算监视器
+ */
+class DeadlineMonitor {
+public:
+    DeadlineMonitor() = default;
+
+    DeadlineMonitor(const DeadlineMonitor&) = delete;
+    DeadlineMonitor& operator=(const DeadlineMonitor&) = delete;
+
+    /**
+     * @brief 设置预算并清零统计（在写入方开始记录之前调用）
+     * @param config 配置
+     */
+    void init(const deadline_monitor_config_t &config);
+
+    /**
+     * @brief 记录一帧的处理耗时（仅由写入方任务调用）
+     * @param cycles 本帧处理消耗的 CPU 周期数
+     * @return deadline_event_t 告警状态变化事件
+     */
+    deadline_event_t record(uint32_t cycles);
+
+    /**
+     * @brief 读取累计值快照（任意任务）
+     * @param out 输出快照
+     */
+    void snapshot(deadline_snapshot_t *out) const;
+
+    /**
+     * @brief 计算两次快照之间的统计
+     */
+    static deadline_window_t window(const deadline_snapshot_t &prev, const deadline_snapshot_t &now);
+
+    /**
+     * @brief 当前平滑负载（千分比）
+     */
+    uint32_t smoothed_permille() const { return smoothed_q8_.load(std::memory_order_relaxed) >> 8; }
+
+    /**
+     * @brief 一帧的周期预算
+     */
+    uint32_t budget_cycles() const { return config_.budget_cycles; }
+
+private:
+    deadline_monitor_config_t config_ = {};
+    bool warned_ = false;   // 仅写入方访问
+
+    std::atomic<uint32_t> bins_[DEADLINE_HIST_BINS + 1] = {};
+    std::atomic<uint32_t> frames_{0};
+    std::atomic<uint32_t> misses_{0};
+    std::atomic<uint32_t> load_sum_{0};
+    std::atomic<uint32_t> max_cycles_{0};
+    std::atomic<uint32_t> smoothed_q8_{0};  // 平滑负载（千分比，Q8 定点）
+};
@@ -0,0 +1,73 @@
+/**
+ * @file frame_ring.cc
+ * @brief 单生产者/单消费者无锁音频帧环形缓冲区实现
+ */
+
+#include "frame_ring.h"
+
+bool FrameRing::init(int16_t *storage, size_t frame_samples, size_t capacity) {
+    if (storage == nullptr || frame_samples == 0 || capacity < 2 ||
+        (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+
+    storage_ = storage;
+    frame_samples_ = frame_samples;
+    capacity_ = capacity;
+    mask_ = static_cast<uint32_t>(capacity - 1);
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    overruns_.store(0, std::memory_order_relaxed);
+    peak_fill_.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+int16_t* FrameRing::acquire_write() {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    uint32_t tail = tail_.load(std::memory_order_acquire);
+    if (head - tail >= capacity_) {
+        return nullptr;
+    }
+    return storage_ + static_cast<size_t>(head & mask_) * frame_samples_;
+}
+
+void FrameRing::commit_write() {
+    uint32_t head = head_.load(std::memory_order_relaxed) + 1;
+    head_.store(head, std::memory_order_release);
+
+    // 峰值只由生产者更新，读到的 tail 略旧只会让峰值偏大一帧，足够用于诊断
+    uint32_t fill = head - tail_.load(std::memory_order_relaxed);
+    if (fill > peak_fill_.load(std::memory_order_relaxed)) {
+        peak_fill_.store(fill, std::memory_order_relaxed);
+    }
+}
+
+void FrameRing::record_overrun() {
+    overruns_.fetch_add(1, std::memory_order_relaxed);
+}
+
+const int16_t* FrameRing::acquire_read() {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    uint32_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) {
+        return nullptr;
+    }
+    return storage_ + static_cast<size_t>(tail & mask_) * frame_samples_;
+}
+
+void FrameRing::release_read() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+size_t FrameRing::size() const {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+frame_ring_stats_t FrameRing::get_stats() const {
+    return {
+        .frames_written = head_.load(std::memory_order_relaxed),
+        .frames_read = tail_.load(std::memory_order_relaxed),
+        .overruns = overruns_.load(std::memory_order_relaxed),
+        .peak_fill = peak_fill_.load(std::memory_order_relaxed)
+    };
+}
@@ -0,0 +1,112 @@
+/**
+ * @file frame_ring.h
+ * @brief 单生产者/单消费者无锁音频帧环形缓冲区
+ *
+ * 采集任务（生产者）与识别任务（消费者）之间传递固定长度的音频帧。
+ * 本模块只依赖 C++ 标准库，不依赖 FreeRTOS，可以直接在 Linux 主机上
+ * 编译并用合成数据做吞吐量和正确性压力测试。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 帧环形缓冲区统计信息
+ */
+typedef struct {
+    uint32_t frames_written;  // 生产者成功提交的帧数
+    uint32_t frames_read;     // 消费者已释放的帧数
+    uint32_t overruns;        // 缓冲区满时被丢弃的帧数
+    uint32_t peak_fill;       // 历史最高占用帧数
+} frame_ring_stats_t;
+
+/**
+ * @brief SPSC 无锁帧环形缓冲区
+ *
+ * 使用方式：
+ * - 生产者：acquire_write() 取得空闲帧 → 就地填充 → commit_write()
+ * - 消费者：acquire_read() 取得最旧的帧 → 就地处理 → release_read()
+ *
+ * 帧存储由调用者提供（ESP32 上放在内部 RAM，主机上可以是普通数组），
+ * 读写都在槽位上就地进行，不做额外拷贝。缓冲区满时丢弃新帧并计入
+ * overruns，保证已排队的音频保持连续。
+ */
+class FrameRing {
+public:
+    FrameRing() = default;
+
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+
+    /**
+     * @brief 绑定帧存储
+     * @param storage 至少 frame_samples * capacity 个样本的存储区
+     * @param frame_samples 每帧样本数
+     * @param capacity 帧槽数量，必须是2的幂
+     * @return bool 参数合法返回true
+     */
+    bool init(int16_t *storage, size_t frame_samples, size_t capacity);
+
+    /**
+     * @brief 获取一个可写的空闲帧（仅生产者调用）
+     * @return int16_t* 帧指针，缓冲区满时返回nullptr
+     */
+    int16_t* acquire_write();
+
+    /**
+     * @brief 提交 acquire_write() 取得的帧（仅生产者调用）
+     */
+    void commit_write();
+
+    /**
+     * @brief 记录一次因缓冲区满而丢弃的帧（仅生产者调用）
+     */
+    void record_overrun();
+
+    /**
+     * @brief 获取最旧的未读帧（仅消费者调用）
+     * @return const int16_t* 帧指针，缓冲区空时返回nullptr
+     */
+    const int16_t* acquire_read();
+
+    /**
+     * @brief 释放 acquire_read() 取得的帧（仅消费者调用）
+     */
+    void release_read();
+
+    /**
+     * @brief 当前已排队的帧数
+     */
+    size_t size() const;
+
+    /**
+     * @brief 每帧样本数
+     */
+    size_t frame_samples() const { return frame_samples_; }
+
+    /**
+     * @brief 帧槽数量
+     */
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief 获取统计信息快照
+     */
+    frame_ring_stats_t get_stats() const;
+
+private:
+    int16_t *storage_ = nullptr;
+    size_t frame_samples_ = 0;
+    size_t capacity_ = 0;
+    uint32_t mask_ = 0;
+
+    // 读写计数单调递增，槽位 = 计数 & mask_；两者分属不同缓存行避免伪共享
+    alignas(64) std::atomic<uint32_t> head_{0};  // 生产者写入计数
+    alignas(64) std::atomic<uint32_t> tail_{0};  // 消费者读取计数
+
+    std::atomic<uint32_t> overruns_{0};
+    std::atomic<uint32_t> peak_fill_{0};
+};
@@ -0,0 +1,44 @@
+/**
+ * @file pcm_ramp.cc
+ * @brief 提示音淡入淡出实现
+ */
+
+#include "pcm_ramp.h"
+
+bool pcm_ramp_needed(size_t clip_pos, size_t count, size_t clip_total, size_t ramp) {
+    if (ramp == 0 || count == 0) {
+        return false;
+    }
+    // 本块与开头 [0, ramp) 或结尾 [clip_total-ramp, clip_total) 有交集
+    return clip_pos < ramp || clip_pos + count + ramp > clip_total;
+}
+
+void pcm_ramp_apply(int16_t *samples, size_t count, size_t clip_pos, size_t clip_total, size_t ramp) {
+    if (ramp == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        size_t pos = clip_pos + i;
+        if (pos >= clip_total) {
+            break;
+        }
+
+        size_t gain = pos;
+        size_t tail = clip_total - 1 - pos;
+        if (tail < gain) {
+            gain = tail;
+        }
+        if (gain < ramp) {
+            samples[i] = static_cast<int16_t>(static_cast<int32_t>(samples[i]) * static_cast<int32_t>(gain) /
+                                              static_cast<int32_t>(ramp));
+        }
+    }
+}
+
+void pcm_ramp_decay(int16_t *out, size_t count, int16_t from) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = static_cast<int16_t>(static_cast<int32_t>(from) * static_cast<int32_t>(count - 1 - i) /
+                                      static_cast<int32_t>(count));
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * @file pcm_ramp.h
+ * @brief 提示音淡入淡出与停止时的归零衰减
+ *
+ * I2S 发送通道常开时，片段首尾的台阶会在功放上形成"咔哒"声。
+ * 播放任务按块写入时对片段首尾 ramp 个样本做线性淡入/淡出；
+ * 片段中途被取消时，从最后一个输出样本线性衰减到 0，再交给 DMA 自动填零。
+ * 本模块不依赖 ESP-IDF，可在 Linux 主机上编译。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 判断一块数据是否落在片段首尾的淡入/淡出区域内
+ * @param clip_pos 本块第一个样本在片段中的位置（样本）
+ * @param count 本块样本数
+ * @param clip_total 片段总样本数
+ * @param ramp 淡入/淡出长度（样本），0 表示不做淡入淡出
+ * @return bool 需要调用 pcm_ramp_apply() 返回true
+ */
+bool pcm_ramp_needed(size_t clip_pos, size_t count, size_t clip_total, size_t ramp);
+
+/**
+ * @brief 就地对一块样本施加淡入/淡出
+ *
+ * 第 i 个样本的增益为 min(i, clip_total-1-i, ramp) / ramp，片段首尾样本恰好为 0，
+ * 与 DMA 自动填零的静音无缝衔接。片段短于 2*ramp 时淡入和淡出衔接成三角形包络。
+ *
+ * @param samples 样本缓冲区
+ * @param count 样本数
+ * @param clip_pos 第一个样本在片段中的位置（样本）
+ * @param clip_total 片段总样本数
+ * @param ramp 淡入/淡出长度（样本）
+ */
+void pcm_ramp_apply(int16_t *samples, size_t count, size_t clip_pos, size_t clip_total, size_t ramp);
+
+/**
+ * @brief 生成从 from 线性衰减到 0 的样本
+ *
+ * 输出的最后一个样本恰好为 0，之后的 DMA 自动填零不会产生台阶。
+ *
+ * @param out 输出缓冲区
+ * @param count 样本数
+ * @param from 衰减起点（上一个已输出的样本）
+ */
+void pcm_ramp_decay(int16_t *out, size_t count, int16_t from);
+
+#ifdef __cplusplus
+}
+#endif
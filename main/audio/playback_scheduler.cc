@@ -0,0 +1,218 @@
+/**
+ * @file playback_scheduler.cc
+ * @brief 提示音播放调度器实现
+ */
+
+#include "playback_scheduler.h"
+#include <cstring>
+#include "pcm_ramp.h"
+
+void PlaybackScheduler::set_ramp(size_t ramp_samples, int16_t *scratch, size_t scratch_samples) {
+    if (scratch == nullptr || scratch_samples == 0) {
+        ramp_samples = 0;
+    }
+    ramp_samples_ = ramp_samples;
+    scratch_ = scratch;
+    scratch_samples_ = scratch_samples;
+}
+
+bool PlaybackScheduler::enqueue(const playback_clip_t &clip) {
+    if (pending_count_ >= MAX_PENDING || clip.data == nullptr || clip.len == 0) {
+        return false;
+    }
+
+    pending_[(pending_head_ + pending_count_) % MAX_PENDING] = clip;
+    pending_count_++;
+    return true;
+}
+
+bool PlaybackScheduler::cancel(playback_id_t id) {
+    if (active_ && current_.id == id) {
+        finish_current(PLAYBACK_EVENT_CANCELLED);
+        return true;
+    }
+
+    for (size_t i = 0; i < pending_count_; i++) {
+        size_t index = (pending_head_ + i) % MAX_PENDING;
+        if (pending_[index].id != id) {
+            continue;
+        }
+
+        playback_clip_t removed = pending_[index];
+
+        // 后面的片段依次前移，保持播放顺序
+        for (size_t j = i; j + 1 < pending_count_; j++) {
+            pending_[(pending_head_ + j) % MAX_PENDING] = pending_[(pending_head_ + j + 1) % MAX_PENDING];
+        }
+        pending_count_--;
+
+        notify_finished(removed, PLAYBACK_EVENT_CANCELLED);
+        return true;
+    }
+
+    return false;
+}
+
+void PlaybackScheduler::cancel_all() {
+    if (active_) {
+        finish_current(PLAYBACK_EVENT_CANCELLED);
+    }
+
+    while (pending_count_ > 0) {
+        playback_clip_t removed = pending_[pending_head_];
+        pending_head_ = (pending_head_ + 1) % MAX_PENDING;
+        pending_count_--;
+        notify_finished(removed, PLAYBACK_EVENT_CANCELLED);
+    }
+}
+
+bool PlaybackScheduler::pump(PlaybackSink &sink, size_t chunk_bytes) {
+    if (!active_) {
+        if (!start_next()) {
+            return false;
+        }
+        // 上一个片段被打断时先衰减到 0，新片段从 0 开始淡入
+        write_decay(sink);
+    }
+
+    int written = (current_.codec == PLAYBACK_CODEC_IMA_ADPCM) ? pump_adpcm(sink, chunk_bytes)
+                                                               : pump_pcm(sink, chunk_bytes);
+    if (written < 0) {
+        finish_current(PLAYBACK_EVENT_FAILED);
+    } else if (offset_ >= current_.len && decoded_pos_ >= decoded_len_) {
+        finish_current(PLAYBACK_EVENT_DONE);
+    }
+
+    if (!busy()) {
+        stop_output(sink);
+        return false;
+    }
+    return true;
+}
+
+int PlaybackScheduler::pump_pcm(PlaybackSink &sink, size_t chunk_bytes) {
+    size_t remaining = current_.len - offset_;
+    size_t len = (remaining < chunk_bytes) ? remaining : chunk_bytes;
+    const uint8_t *chunk = current_.data + offset_;
+
+    size_t clip_pos = offset_ / sizeof(int16_t);
+    size_t clip_total = current_.len / sizeof(int16_t);
+    if (pcm_ramp_needed(clip_pos, len / sizeof(int16_t), clip_total, ramp_samples_)) {
+        if (len > scratch_samples_ * sizeof(int16_t)) {
+            len = scratch_samples_ * sizeof(int16_t);
+        }
+        memcpy(scratch_, chunk, len);
+        pcm_ramp_apply(scratch_, len / sizeof(int16_t), clip_pos, clip_total, ramp_samples_);
+        chunk = reinterpret_cast<const uint8_t *>(scratch_);
+    }
+
+    int written = sink.write(chunk, len);
+    if (written > 0) {
+        note_written(sink, chunk, static_cast<size_t>(written));
+        offset_ += static_cast<size_t>(written);
+    }
+    return written;
+}
+
+int PlaybackScheduler::pump_adpcm(PlaybackSink &sink, size_t chunk_bytes) {
+    if (scratch_ == nullptr) {
+        return -1;
+    }
+
+    // 上一块已全部写出时才解码下一块，写入不完整时下次继续写剩余部分
+    if (decoded_pos_ >= decoded_len_) {
+        size_t max_samples = chunk_bytes / sizeof(int16_t);
+        if (max_samples > scratch_samples_) {
+            max_samples = scratch_samples_;
+        }
+        size_t remaining = current_.len - offset_;
+        size_t in_bytes = max_samples / 2;
+        if (in_bytes > remaining) {
+            in_bytes = remaining;
+        }
+        if (in_bytes == 0) {
+            return -1;
+        }
+
+        size_t count = in_bytes * 2;
+        adpcm_decode(&adpcm_, current_.data + offset_, in_bytes, scratch_);
+        if (pcm_ramp_needed(decoded_samples_, count, current_.len * 2, ramp_samples_)) {
+            pcm_ramp_apply(scratch_, count, decoded_samples_, current_.len * 2, ramp_samples_);
+        }
+
+        offset_ += in_bytes;
+        decoded_samples_ += count;
+        decoded_pos_ = 0;
+        decoded_len_ = count * sizeof(int16_t);
+    }
+
+    const uint8_t *chunk = reinterpret_cast<const uint8_t *>(scratch_) + decoded_pos_;
+    int written = sink.write(chunk, decoded_len_ - decoded_pos_);
+    if (written > 0) {
+        note_written(sink, chunk, static_cast<size_t>(written));
+        decoded_pos_ += static_cast<size_t>(written);
+    }
+    return written;
+}
+
+void PlaybackScheduler::note_written(PlaybackSink &sink, const uint8_t *chunk, size_t written) {
+    size_t whole = written & ~(sizeof(int16_t) - 1);
+    if (whole > 0) {
+        memcpy(&last_sample_, chunk + whole - sizeof(int16_t), sizeof(int16_t));
+    }
+    if (!started_) {
+        started_ = true;
+        sink.clip_started(current_);
+    }
+}
+
+void PlaybackScheduler::stop_output(PlaybackSink &sink) {
+    write_decay(sink);
+    sink.idle();
+}
+
+void PlaybackScheduler::write_decay(PlaybackSink &sink) {
+    if (last_sample_ != 0 && ramp_samples_ > 0) {
+        size_t count = (ramp_samples_ < scratch_samples_) ? ramp_samples_ : scratch_samples_;
+        pcm_ramp_decay(scratch_, count, last_sample_);
+        sink.write(reinterpret_cast<const uint8_t *>(scratch_), count * sizeof(int16_t));
+    }
+    last_sample_ = 0;
+}
+
+void PlaybackScheduler::finish_current(playback_event_t event) {
+    playback_clip_t finished = current_;
+    active_ = false;
+    started_ = false;
+    offset_ = 0;
+    decoded_samples_ = 0;
+    decoded_pos_ = 0;
+    decoded_len_ = 0;
+    current_ = {};
+    notify_finished(finished, event);
+}
+
+void PlaybackScheduler::notify_finished(const playback_clip_t &clip, playback_event_t event) {
+    finished_count_++;
+    if (clip.callback != nullptr) {
+        clip.callback(clip.id, event, clip.user_ctx);
+    }
+}
+
+bool PlaybackScheduler::start_next() {
+    if (pending_count_ == 0) {
+        return false;
+    }
+
+    current_ = pending_[pending_head_];
+    pending_head_ = (pending_head_ + 1) % MAX_PENDING;
+    pending_count_--;
+    offset_ = 0;
+    active_ = true;
+    started_ = false;
+    decoded_samples_ = 0;
+    decoded_pos_ = 0;
+    decoded_len_ = 0;
+    adpcm_reset(&adpcm_);
+    return true;
+}
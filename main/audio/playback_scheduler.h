@@ -0,0 +1,229 @@
+/**
+ * @file playback_scheduler.h
+ * @brief 提示音播放调度器定义
+ *
+ * 维护待播放片段队列，并按DMA大小的块把当前片段写入输出端。
+ * 本模块不依赖 FreeRTOS 和 I2S 驱动：输出端通过 PlaybackSink 接口注入，
+ * 在 Linux 主机上可以用假的 I2S 输出端测试排队顺序、取消、淡入淡出和延迟。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "adpcm.h"
+
+/**
+ * @brief 播放请求ID，0 表示无效
+ */
+typedef uint32_t playback_id_t;
+
+/**
+ * @brief 片段数据编码，取值与提示音包索引中的 codec 字段一致
+ */
+typedef enum {
+    PLAYBACK_CODEC_PCM16 = 0,      // 16位PCM，原样写出
+    PLAYBACK_CODEC_IMA_ADPCM = 1,  // IMA-ADPCM，每块边解码边写出
+} playback_codec_t;
+
+/**
+ * @brief 播放完成事件
+ */
+typedef enum {
+    PLAYBACK_EVENT_DONE = 0,    // 片段完整播放
+    PLAYBACK_EVENT_CANCELLED,   // 片段被取消（包括播放到一半被打断）
+    PLAYBACK_EVENT_FAILED       // 输出端写入失败
+} playback_event_t;
+
+/**
+ * @brief 播放完成回调，在播放任务上下文中调用，不应阻塞
+ * @param id 播放请求ID
+ * @param event 完成事件
+ * @param user_ctx 入队时传入的用户参数
+ */
+typedef void (*playback_callback_t)(playback_id_t id, playback_event_t event, void *user_ctx);
+
+/**
+ * @brief 待播放片段
+ */
+typedef struct {
+    playback_id_t id;          // 播放请求ID
+    const uint8_t *data;       // 音频数据（16kHz、单声道）
+    size_t len;                // 数据长度（字节）
+    playback_codec_t codec;    // 数据编码
+    playback_callback_t callback;  // 完成回调，可为nullptr
+    void *user_ctx;            // 回调用户参数
+    int64_t enqueued_us;       // 入队时间（微秒），用于统计启动延迟
+} playback_clip_t;
+
+/**
+ * @brief 音频输出端接口
+ *
+ * ESP32 上由 I2S 发送通道实现，主机测试时可以用假的输出端替代
+ */
+class PlaybackSink {
+public:
+    virtual ~PlaybackSink() = default;
+
+    /**
+     * @brief 写入一块PCM数据，阻塞到数据进入输出缓冲为止
+     * @param data 数据指针
+     * @param len 数据长度（字节）
+     * @return int 实际写入的字节数，负数表示写入失败
+     */
+    virtual int write(const uint8_t *data, size_t len) = 0;
+
+    /**
+     * @brief 队列播放完毕、进入空闲时调用
+     */
+    virtual void idle() = 0;
+
+    /**
+     * @brief 片段的第一块数据写入成功后调用，可用于统计启动延迟
+     * @param clip 刚开始播放的片段
+     */
+    virtual void clip_started(const playback_clip_t &/*clip*/) {}
+};
+
+/**
+ * @brief 提示音播放调度器
+ *
+ * 单线程使用：enqueue()/cancel()/pump() 必须在同一个上下文调用
+ * （ESP32 上即播放任务），跨任务的请求由上层通过消息队列转发。
+ */
+class PlaybackScheduler {
+public:
+    static const size_t MAX_PENDING = 8;  // 最大排队片段数
+
+    PlaybackScheduler() = default;
+
+    /**
+     * @brief 开启片段首尾淡入淡出
+     *
+     * 落在淡入/淡出区域的块先复制到 scratch 再处理，其余块直接从原数据写出。
+     * ADPCM 片段也在 scratch 中逐块解码，未设置 scratch 时无法播放。
+     *
+     * @param ramp_samples 淡入/淡出长度（样本），0 表示关闭
+     * @param scratch 处理用缓冲区，不小于每块的样本数
+     * @param scratch_samples 缓冲区样本数
+     */
+    void set_ramp(size_t ramp_samples, int16_t *scratch, size_t scratch_samples);
+
+    /**
+     * @brief 片段加入播放队列末尾
+     * @param clip 待播放片段
+     * @return bool 队列已满返回false
+     */
+    bool enqueue(const playback_clip_t &clip);
+
+    /**
+     * @brief 取消一个片段（正在播放或排队中）
+     * @param id 播放请求ID
+     * @return bool 找到并取消返回true
+     */
+    bool cancel(playback_id_t id);
+
+    /**
+     * @brief 取消当前片段和所有排队片段
+     */
+    void cancel_all();
+
+    /**
+     * @brief 向输出端写入下一块数据
+     *
+     * 当前片段播放完毕时触发完成回调并切换到下一个片段；
+     * 所有片段播放完毕时调用一次 sink.idle()。
+     *
+     * @param sink 输出端
+     * @param chunk_bytes 每次写入的最大字节数
+     * @return bool 还有数据待播放返回true
+     */
+    bool pump(PlaybackSink &sink, size_t chunk_bytes);
+
+    /**
+     * @brief 结束输出并进入空闲
+     *
+     * 片段中途被取消时先写出一段衰减到 0 的尾巴，再调用 sink.idle()。
+     *
+     * @param sink 输出端
+     */
+    void stop_output(PlaybackSink &sink);
+
+    /**
+     * @brief 是否有正在播放或排队的片段
+     */
+    bool busy() const { return active_ || pending_count_ > 0; }
+
+    /**
+     * @brief 排队中的片段数（不含正在播放的片段）
+     */
+    size_t pending() const { return pending_count_; }
+
+    /**
+     * @brief 当前正在播放的片段ID，空闲时返回0
+     */
+    playback_id_t current_id() const { return active_ ? current_.id : 0; }
+
+    /**
+     * @brief 累计已结束（完成/取消/失败）的片段数
+     */
+    uint32_t finished_count() const { return finished_count_; }
+
+private:
+    playback_clip_t current_ = {};
+    size_t offset_ = 0;          // 当前片段已写入的字节数
+    bool active_ = false;
+
+    playback_clip_t pending_[MAX_PENDING] = {};
+    size_t pending_head_ = 0;
+    size_t pending_count_ = 0;
+    uint32_t finished_count_ = 0;
+
+    size_t ramp_samples_ = 0;
+    int16_t *scratch_ = nullptr;
+    size_t scratch_samples_ = 0;
+    int16_t last_sample_ = 0;    // 最后写出的样本，用于取消后衰减
+    bool started_ = false;       // 当前片段是否已写出第一块
+
+    adpcm_state_t adpcm_ = {};   // 当前 ADPCM 片段的解码状态
+    size_t decoded_samples_ = 0; // 当前片段已解码的样本数
+    size_t decoded_pos_ = 0;     // scratch 中已写出的字节数
+    size_t decoded_len_ = 0;     // scratch 中已解码的字节数
+
+    /**
+     * @brief 写出 PCM 片段的下一块
+     * @return int 写入的字节数，负数表示失败
+     */
+    int pump_pcm(PlaybackSink &sink, size_t chunk_bytes);
+
+    /**
+     * @brief 解码并写出 ADPCM 片段的下一块
+     * @return int 写入的字节数，负数表示失败
+     */
+    int pump_adpcm(PlaybackSink &sink, size_t chunk_bytes);
+
+    /**
+     * @brief 记录已写出的数据（最后一个样本、片段开始通知）
+     */
+    void note_written(PlaybackSink &sink, const uint8_t *chunk, size_t written);
+
+    /**
+     * @brief 上一个输出样本不为 0 时写出衰减尾巴
+     */
+    void write_decay(PlaybackSink &sink);
+
+    /**
+     * @brief 结束当前片段并触发回调
+     */
+    void finish_current(playback_event_t event);
+
+    /**
+     * @brief 统计并通知一个已结束的片段
+     */
+    void notify_finished(const playback_clip_t &clip, playback_event_t event);
+
+    /**
+     * @brief 从队列头部取出下一个片段作为当前片段
+     */
+    bool start_next();
+};
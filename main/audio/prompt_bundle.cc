@@ -0,0 +1,101 @@
+/**
+ * @file prompt_bundle.cc
+ * @brief 提示音包解析实现
+ */
+
+#include "prompt_bundle.h"
+#include <cstring>
+
+// 与 tools/prompt_pack.py 保持一致
+static const uint8_t MAGIC[4] = {'Z', 'P', 'R', 'M'};
+static const size_t HEADER_SIZE = 16;
+static const size_t ENTRY_SIZE = 48;
+static const size_t ENTRY_NAME_SIZE = 20;
+
+static inline uint16_t read_u16(const uint8_t *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t read_u32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+bool PromptBundle::parse(const uint8_t *base, size_t size) {
+    base_ = nullptr;
+    count_ = 0;
+    total_size_ = 0;
+
+    if (base == nullptr || size < HEADER_SIZE || memcmp(base, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    if (read_u16(base + 4) != VERSION) {
+        return false;
+    }
+
+    size_t count = read_u16(base + 6);
+    size_t total = read_u32(base + 8);
+    if (total > size || HEADER_SIZE + ENTRY_SIZE * count > total) {
+        return false;
+    }
+
+    // 逐项检查数据范围，之后的 at() 无需再做边界检查
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *e = base + HEADER_SIZE + ENTRY_SIZE * i;
+        size_t offset = read_u32(e + ENTRY_NAME_SIZE);
+        size_t length = read_u32(e + ENTRY_NAME_SIZE + 4);
+        if (offset > total || length > total - offset || e[NAME_MAX] != '\0') {
+            return false;
+        }
+    }
+
+    base_ = base;
+    count_ = count;
+    total_size_ = total;
+    return true;
+}
+
+const uint8_t* PromptBundle::entry(size_t index) const {
+    if (base_ == nullptr || index >= count_) {
+        return nullptr;
+    }
+    return base_ + HEADER_SIZE + ENTRY_SIZE * index;
+}
+
+prompt_view_t PromptBundle::at(size_t index) const {
+    const uint8_t *e = entry(index);
+    if (e == nullptr) {
+        return {};
+    }
+
+    const uint8_t *fields = e + ENTRY_NAME_SIZE;
+    return {
+        .data = base_ + read_u32(fields),
+        .len = read_u32(fields + 4),
+        .sample_rate = read_u16(fields + 8),
+        .codec = read_u16(fields + 10),
+        .samples = read_u32(fields + 12),
+        .peak = read_u16(fields + 16),
+        .gain_q8 = read_u16(fields + 18),
+        .trim_head = read_u32(fields + 20),
+        .trim_tail = read_u32(fields + 24)
+    };
+}
+
+bool PromptBundle::name_at(size_t index, char *name) const {
+    const uint8_t *e = entry(index);
+    if (e == nullptr) {
+        return false;
+    }
+    memcpy(name, e, NAME_MAX + 1);
+    return true;
+}
+
+int PromptBundle::find(const char *name) const {
+    for (size_t i = 0; i < count_; i++) {
+        if (strncmp(reinterpret_cast<const char *>(entry(i)), name, NAME_MAX + 1) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file prompt_bundle.h
+ * @brief 提示音包解析
+ *
+ * 提示音包由 tools/prompt_pack.py 生成并烧录到 prompts 数据分区，
+ * 格式见该脚本的说明。解析只做边界检查，返回的视图直接指向包内数据，
+ * 不复制 PCM。本模块只依赖 C++ 标准库，可在 Linux 主机上解析打包结果。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 提示音视图（零拷贝）
+ */
+typedef struct {
+    const uint8_t *data;   // 音频数据，包未映射或提示音不存在时为nullptr
+    size_t len;            // 数据长度（字节）
+    uint16_t sample_rate;  // 采样率（Hz）
+    uint16_t codec;        // 编码（0=PCM16，1=IMA-ADPCM），与 playback_codec_t 取值一致
+    uint32_t samples;      // 解码后的样本数
+    uint16_t peak;         // 处理后的峰值（样本绝对值）
+    uint16_t gain_q8;      // 构建时的响度归一化增益（256 表示 1 倍）
+    uint32_t trim_head;    // 构建时裁掉的开头静音（样本）
+    uint32_t trim_tail;    // 构建时裁掉的结尾静音（样本）
+} prompt_view_t;
+
+/**
+ * @brief 提示音包解析器
+ */
+class PromptBundle {
+public:
+    static const size_t NAME_MAX = 19;      // 名称最大字节数
+    static const uint16_t VERSION = 2;      // 支持的格式版本
+
+    PromptBundle() = default;
+
+    /**
+     * @brief 解析提示音包
+     * @param base 包数据起始地址（映射后的分区）
+     * @param size 可访问的字节数
+     * @return bool 格式正确且所有索引项都在范围内返回true
+     */
+    bool parse(const uint8_t *base, size_t size);
+
+    /**
+     * @brief 提示音数量
+     */
+    size_t count() const { return count_; }
+
+    /**
+     * @brief 按索引取提示音
+     * @param index 索引
+     * @return prompt_view_t 视图，索引越界时 data 为nullptr
+     */
+    prompt_view_t at(size_t index) const;
+
+    /**
+     * @brief 按索引取提示音名称
+     * @param index 索引
+     * @param name 输出缓冲区，至少 NAME_MAX+1 字节
+     * @return bool 索引有效返回true
+     */
+    bool name_at(size_t index, char *name) const;
+
+    /**
+     * @brief 按名称查找提示音索引
+     * @param name 提示音名称
+     * @return int 索引，未找到返回-1
+     */
+    int find(const char *name) const;
+
+    /**
+     * @brief 提示音时长（毫秒）
+     */
+    static uint32_t duration_ms(const prompt_view_t &view) {
+        return (view.sample_rate == 0) ? 0 : static_cast<uint32_t>(uint64_t(view.samples) * 1000 / view.sample_rate);
+    }
+
+    /**
+     * @brief 包的总字节数
+     */
+    size_t total_size() const { return total_size_; }
+
+private:
+    const uint8_t *base_ = nullptr;
+    size_t count_ = 0;
+    size_t total_size_ = 0;
+
+    const uint8_t *entry(size_t index) const;
+};
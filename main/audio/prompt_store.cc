@@ -0,0 +1,106 @@
+/**
+ * @file prompt_store.cc
+ * @brief 提示音存储实现
+ */
+
+#include "prompt_store.h"
+
+extern "C" {
+#include "esp_log.h"
+}
+
+static const char *TAG = "提示音";
+
+// 与 prompt_id_t 一一对应
+static const char *const PROMPT_NAMES[PROMPT_COUNT] = {
+    "welcome",
+    "light_on",
+    "light_off",
+    "byebye",
+    "say_again",
+};
+
+// 静态成员初始化
+PromptStore* PromptStore::instance_ = nullptr;
+
+PromptStore::PromptStore() {
+    for (int i = 0; i < PROMPT_COUNT; i++) {
+        index_[i] = -1;
+    }
+}
+
+PromptStore* PromptStore::get_instance() {
+    if (instance_ == nullptr) {
+        instance_ = new PromptStore();
+    }
+    return instance_;
+}
+
+esp_err_t PromptStore::init(const char *partition_label) {
+    if (mapped_) {
+        ESP_LOGW(TAG, "提示音分区已映射");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                                ESP_PARTITION_SUBTYPE_ANY, partition_label);
+    if (partition == nullptr) {
+        ESP_LOGE(TAG, "未找到提示音分区 '%s'，请检查分区表", partition_label);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const void *base = nullptr;
+    esp_err_t ret = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                                       &base, &mmap_handle_);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "映射提示音分区失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    mapped_ = true;
+
+    if (!bundle_.parse(static_cast<const uint8_t *>(base), partition->size)) {
+        ESP_LOGE(TAG, "提示音分区内容无效，请执行 'idf.py flash' 烧录提示音包");
+        esp_partition_munmap(mmap_handle_);
+        mapped_ = false;
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    ESP_LOGI(TAG, "✓ 提示音分区已映射: %d 个提示音, %d 字节", (int)bundle_.count(), (int)bundle_.total_size());
+
+    for (int i = 0; i < PROMPT_COUNT; i++) {
+        index_[i] = bundle_.find(PROMPT_NAMES[i]);
+        if (index_[i] < 0) {
+            ESP_LOGW(TAG, "提示音包中缺少 '%s'", PROMPT_NAMES[i]);
+            continue;
+        }
+
+        prompt_view_t view = bundle_.at(static_cast<size_t>(index_[i]));
+        ESP_LOGI(TAG, "  - %s: %lu ms, 峰值 %u, 增益 %u/256, 已裁剪静音 前 %lu ms / 后 %lu ms",
+                 PROMPT_NAMES[i], (unsigned long)PromptBundle::duration_ms(view), view.peak, view.gain_q8,
+                 (unsigned long)(view.sample_rate ? view.trim_head * 1000 / view.sample_rate : 0),
+                 (unsigned long)(view.sample_rate ? view.trim_tail * 1000 / view.sample_rate : 0));
+    }
+    return ESP_OK;
+}
+
+prompt_view_t PromptStore::get(prompt_id_t id) const {
+    if (!mapped_ || id < 0 || id >= PROMPT_COUNT || index_[id] < 0) {
+        return {};
+    }
+    return bundle_.at(static_cast<size_t>(index_[id]));
+}
+
+prompt_view_t PromptStore::find(const char *name) const {
+    int index = mapped_ ? bundle_.find(name) : -1;
+    if (index < 0) {
+        return {};
+    }
+    return bundle_.at(static_cast<size_t>(index));
+}
+
+const char* PromptStore::name(prompt_id_t id) {
+    if (id < 0 || id >= PROMPT_COUNT) {
+        return "unknown";
+    }
+    return PROMPT_NAMES[id];
+}
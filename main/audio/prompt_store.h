@@ -0,0 +1,84 @@
+/**
+ * @file prompt_store.h
+ * @brief 提示音存储定义
+ *
+ * 提示音不再编译进应用程序，而是由构建步骤打包到 prompts 数据分区。
+ * 启动时把分区 mmap 到地址空间，之后按提示音 ID 取得指向 Flash 的
+ * 零拷贝视图，直接交给 AudioPlayer 播放。
+ */
+
+#pragma once
+
+#include "prompt_bundle.h"
+
+extern "C" {
+#include "esp_err.h"
+#include "esp_partition.h"
+}
+
+/**
+ * @brief 提示音ID
+ *
+ * 名称与 main/assets/voices/ 下的 WAV 文件名一致，见 prompt_store.cc
+ */
+typedef enum {
+    PROMPT_WELCOME = 0,  // 唤醒后的欢迎语
+    PROMPT_LIGHT_ON,     // 开灯确认
+    PROMPT_LIGHT_OFF,    // 关灯确认
+    PROMPT_BYE_BYE,      // 再见
+    PROMPT_SAY_AGAIN,    // 没听清，请再说一遍（命令仲裁未通过时播放）
+    PROMPT_COUNT
+} prompt_id_t;
+
+/**
+ * @brief 提示音存储
+ *
+ * 单例模式。init() 之后只读，可在任意任务中调用 get()。
+ */
+class PromptStore {
+private:
+    static PromptStore* instance_;
+
+    PromptBundle bundle_;
+    esp_partition_mmap_handle_t mmap_handle_ = 0;
+    bool mapped_ = false;
+    int index_[PROMPT_COUNT];  // 提示音ID到包内索引的映射，-1 表示缺失
+
+    /**
+     * @brief 私有构造函数（单例模式）
+     */
+    PromptStore();
+
+public:
+    /**
+     * @brief 获取单例实例
+     * @return PromptStore* 单例实例指针
+     */
+    static PromptStore* get_instance();
+
+    /**
+     * @brief 映射提示音分区并解析索引
+     * @param partition_label 分区名称
+     * @return esp_err_t 初始化结果，个别提示音缺失只输出警告
+     */
+    esp_err_t init(const char *partition_label);
+
+    /**
+     * @brief 取得提示音视图
+     * @param id 提示音ID
+     * @return prompt_view_t 视图，未映射或提示音缺失时 data 为nullptr
+     */
+    prompt_view_t get(prompt_id_t id) const;
+
+    /**
+     * @brief 按名称取得提示音视图（命令清单按名称引用提示音）
+     * @param name 提示音名称
+     * @return prompt_view_t 视图，未映射或提示音缺失时 data 为nullptr
+     */
+    prompt_view_t find(const char *name) const;
+
+    /**
+     * @brief 提示音ID对应的名称
+     */
+    static const char* name(prompt_id_t id);
+};
@@ -0,0 +1,135 @@
+/**
+ * @file sample_conditioner.cc
+ * @brief 麦克风采样调理内核实现
+ */
+
+#include "sample_conditioner.h"
+
+// 增益移位上限，8 倍增益已足以把 INMP441 的弱信号提升到识别所需电平
+static const int MAX_GAIN_SHIFT = 3;
+// 直流平滑系数上限
+static const int MAX_DC_SMOOTHING = 15;
+
+static inline int16_t saturate_s16(int32_t value) {
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return static_cast<int16_t>(value);
+}
+
+void sample_conditioner_init(sample_conditioner_t *conditioner, const sample_conditioner_config_t *config) {
+    conditioner->config = *config;
+
+    if (conditioner->config.gain_shift < 0) {
+        conditioner->config.gain_shift = 0;
+    } else if (conditioner->config.gain_shift > MAX_GAIN_SHIFT) {
+        conditioner->config.gain_shift = MAX_GAIN_SHIFT;
+    }
+    if (conditioner->config.clamp_limit < 1) {
+        conditioner->config.clamp_limit = 1;
+    }
+    if (conditioner->config.dc_smoothing < 0) {
+        conditioner->config.dc_smoothing = 0;
+    } else if (conditioner->config.dc_smoothing > MAX_DC_SMOOTHING) {
+        conditioner->config.dc_smoothing = MAX_DC_SMOOTHING;
+    }
+
+    conditioner->dc_estimate_q8 = 0;
+}
+
+/**
+ * @brief 调理一个样本
+ *
+ * 减法结果先饱和到 int16，再左移 gain_shift 位（最多 2^18，不会溢出 int32），
+ * 最后限幅到 [lo, hi]。lo/hi 本身在 int16 范围内，这等价于向量实现的
+ * 逐次饱和加倍（ee.vadds.s16）。无分支，编译器可以自动向量化。
+ */
+static inline int16_t condition_one(int16_t x, int32_t dc, int gain_shift, int32_t hi, int32_t lo) {
+    int32_t sample = static_cast<int32_t>(x) - dc;
+    sample = (sample > INT16_MAX) ? INT16_MAX : sample;
+    sample = (sample < INT16_MIN) ? INT16_MIN : sample;
+    sample = static_cast<int32_t>(static_cast<uint32_t>(sample) << gain_shift);
+    sample = (sample > hi) ? hi : sample;
+    sample = (sample < lo) ? lo : sample;
+    return static_cast<int16_t>(sample);
+}
+
+void sample_condition_s16_ansi(int16_t *samples, size_t count, int16_t dc, int gain_shift, int16_t hi, int16_t lo) {
+    // 与向量实现一样按 8 样本块处理：内层循环次数固定，-O2 下也能向量化
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        for (size_t j = 0; j < 8; j++) {
+            samples[i + j] = condition_one(samples[i + j], dc, gain_shift, hi, lo);
+        }
+    }
+    for (; i < count; i++) {
+        samples[i] = condition_one(samples[i], dc, gain_shift, hi, lo);
+    }
+}
+
+static inline int16_t convert_one(int32_t slot, int shift) {
+    int32_t sample = slot >> shift;
+    sample = (sample > INT16_MAX) ? INT16_MAX : sample;
+    sample = (sample < INT16_MIN) ? INT16_MIN : sample;
+    return static_cast<int16_t>(sample);
+}
+
+void sample_convert_s32_to_s16(const int32_t *__restrict in, int16_t *__restrict out, size_t count, int shift) {
+    // 同样按 8 样本块处理，-O2 下内层循环可以向量化
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        for (size_t j = 0; j < 8; j++) {
+            out[i + j] = convert_one(in[i + j], shift);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = convert_one(in[i], shift);
+    }
+}
+
+/**
+ * @brief 用本帧均值更新直流估计，返回本帧要减去的直流值
+ */
+static int16_t update_dc_estimate(sample_conditioner_t *conditioner, const int16_t *samples, size_t count) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+
+    int32_t mean_q8 = (sum / static_cast<int32_t>(count)) * 256;
+    conditioner->dc_estimate_q8 += (mean_q8 - conditioner->dc_estimate_q8) >> conditioner->config.dc_smoothing;
+    return saturate_s16((conditioner->dc_estimate_q8 + 128) >> 8);
+}
+
+void sample_conditioner_process(sample_conditioner_t *conditioner, int16_t *samples, size_t count) {
+    if (samples == nullptr || count == 0) {
+        return;
+    }
+
+    const sample_conditioner_config_t *config = &conditioner->config;
+    int16_t hi = config->clamp_limit;
+    int16_t lo = static_cast<int16_t>(-config->clamp_limit - 1);
+    int16_t dc = config->dc_removal ? update_dc_estimate(conditioner, samples, count) : 0;
+
+    // 恒等变换：int16 样本本身已在合法范围内，无需遍历
+    if (dc == 0 && config->gain_shift == 0 && hi == INT16_MAX) {
+        return;
+    }
+
+#if CONFIG_IDF_TARGET_ESP32S3
+    if ((reinterpret_cast<uintptr_t>(samples) & 0xF) == 0 && count >= 8) {
+        const int16_t params[3] = {dc, hi, lo};
+        size_t vector_count = count & ~static_cast<size_t>(7);
+        sample_condition_s16_aes3(samples, static_cast<int>(vector_count / 8), params, config->gain_shift);
+        samples += vector_count;
+        count -= vector_count;
+    }
+#endif
+
+    if (count > 0) {
+        sample_condition_s16_ansi(samples, count, dc, config->gain_shift, hi, lo);
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file sample_conditioner.h
+ * @brief 麦克风采样调理内核（去直流、增益、限幅）
+ *
+ * 每一帧麦克风数据在送入识别模型前都要经过这里，因此提供两种实现：
+ * - ESP32-S3：PIE 128 位向量指令，每次处理 8 个样本
+ * - 其他平台：可移植的标量实现，同时作为参考实现
+ * 两种实现逐位一致。可移植部分不依赖 ESP-IDF，可在 Linux 主机上编译。
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 采样调理配置
+ */
+typedef struct {
+    int gain_shift;        // 增益为 2^gain_shift 倍（0~3，即 1/2/4/8 倍），溢出时饱和
+    int16_t clamp_limit;   // 输出限幅，范围为 [-(clamp_limit+1), clamp_limit]，32767 表示不额外限幅
+    bool dc_removal;       // 是否去除直流偏置
+    int dc_smoothing;      // 直流估计的帧级平滑系数（右移位数，越大越平滑）
+} sample_conditioner_config_t;
+
+/**
+ * @brief 采样调理状态
+ */
+typedef struct {
+    sample_conditioner_config_t config;
+    int32_t dc_estimate_q8;  // 直流估计值（Q8 定点）
+} sample_conditioner_t;
+
+/**
+ * @brief 默认配置：不加增益、不额外限幅、关闭去直流
+ */
+#define SAMPLE_CONDITIONER_DEFAULT_CONFIG() { \
+    .gain_shift = 0,                          \
+    .clamp_limit = INT16_MAX,                 \
+    .dc_removal = false,                      \
+    .dc_smoothing = 4,                        \
+}
+
+/**
+ * @brief 初始化调理状态
+ * @param conditioner 调理状态
+ * @param config 调理配置，参数超出范围时会被截断到合法值
+ */
+void sample_conditioner_init(sample_conditioner_t *conditioner, const sample_conditioner_config_t *config);
+
+/**
+ * @brief 就地调理一帧样本
+ *
+ * 处理顺序：减去直流估计（饱和） → 逐次饱和加倍 gain_shift 次 → 限幅。
+ * 配置为恒等变换时直接返回，不遍历数据。
+ *
+ * @param conditioner 调理状态
+ * @param samples 样本缓冲区，16 字节对齐且长度为 8 的倍数时使用向量实现
+ * @param count 样本数
+ */
+void sample_conditioner_process(sample_conditioner_t *conditioner, int16_t *samples, size_t count);
+
+/**
+ * @brief 标量参考内核
+ * @param samples 样本缓冲区
+ * @param count 样本数
+ * @param dc 要减去的直流值
+ * @param gain_shift 增益移位数
+ * @param hi 上限
+ * @param lo 下限
+ */
+void sample_condition_s16_ansi(int16_t *samples, size_t count, int16_t dc, int gain_shift, int16_t hi, int16_t lo);
+
+/**
+ * @brief 将 32 位 I2S 槽数据转换为 16 位样本
+ *
+ * INMP441 在 32 位槽中输出左对齐的 24 位数据，右移 shift 位后饱和到
+ * int16：shift=16 取最高 16 位，shift 越小保留的低位越多、增益越大。
+ * 单遍无分支实现，输入输出可以是不同缓冲区（不可重叠）。
+ *
+ * @param in 32 位输入样本
+ * @param out 16 位输出样本
+ * @param count 样本数
+ * @param shift 右移位数（8~16）
+ */
+void sample_convert_s32_to_s16(const int32_t *in, int16_t *out, size_t count, int shift);
+
+#if CONFIG_IDF_TARGET_ESP32S3
+/**
+ * @brief ESP32-S3 PIE 向量内核
+ * @param samples 样本缓冲区，必须 16 字节对齐
+ * @param blocks 8 样本块数
+ * @param params 参数表 {dc, hi, lo}
+ * @param gain_shift 增益移位数
+ */
+void sample_condition_s16_aes3(int16_t *samples, int blocks, const int16_t *params, int gain_shift);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
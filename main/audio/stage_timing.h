@@ -0,0 +1,52 @@
+/**
+ * @file stage_timing.h
+ * @brief 音频处理阶段耗时统计
+ *
+ * 每个阶段由一个任务写入、可由其他任务读取快照。计数器为 32 位并允许回绕，
+ * 读取方用两次快照的差值计算窗口内的平均耗时和 CPU 占比。
+ * 本模块只依赖 C++ 标准库，可在 Linux 主机上编译。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief 阶段耗时快照
+ */
+typedef struct {
+    uint32_t total_us;  // 累计耗时（微秒，允许回绕）
+    uint32_t count;     // 累计次数（允许回绕）
+} stage_timing_snapshot_t;
+
+/**
+ * @brief 单个处理阶段的耗时累加器
+ */
+class StageTiming {
+public:
+    StageTiming() = default;
+
+    /**
+     * @brief 记录一次阶段耗时（仅由该阶段所在任务调用）
+     * @param elapsed_us 本次耗时（微秒）
+     */
+    void add(uint32_t elapsed_us) {
+        total_us_.fetch_add(elapsed_us, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief 获取累计值快照
+     */
+    stage_timing_snapshot_t snapshot() const {
+        return {
+            .total_us = total_us_.load(std::memory_order_relaxed),
+            .count = count_.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+    std::atomic<uint32_t> total_us_{0};
+    std::atomic<uint32_t> count_{0};
+};
@@ -0,0 +1,137 @@
+/**
+ * @file vad_gate.cc
+ * @brief 能量/过零率语音门控实现
+ */
+
+#include "vad_gate.h"
+
+// 门控打开期间噪声底额外放慢的位数：持续的环境噪声抬升时门控最终仍会关闭
+static const int OPEN_FLOOR_EXTRA_SMOOTHING = 6;
+
+void VadGate::init(const vad_gate_config_t &config) {
+    config_ = config;
+    if (config_.attack_frames < 1) {
+        config_.attack_frames = 1;
+    }
+    if (config_.hangover_frames < 0) {
+        config_.hangover_frames = 0;
+    }
+    if (config_.floor_smoothing < 0) {
+        config_.floor_smoothing = 0;
+    }
+
+    noise_floor_ = config_.min_energy;
+    frames_processed_ = 0;
+    frames_skipped_ = 0;
+    opens_ = 0;
+    reset();
+}
+
+void VadGate::reset() {
+    open_ = false;
+    active_run_ = 0;
+    silent_run_ = 0;
+}
+
+uint32_t VadGate::frame_energy(const int16_t *frame, size_t samples) {
+    if (samples == 0) {
+        return 0;
+    }
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < samples; i++) {
+        int32_t s = frame[i];
+        sum += static_cast<uint64_t>(s * s);
+    }
+    return static_cast<uint32_t>(sum / samples);
+}
+
+uint32_t VadGate::zero_crossing_permille(const int16_t *frame, size_t samples) {
+    if (samples < 2) {
+        return 0;
+    }
+
+    uint32_t crossings = 0;
+    for (size_t i = 1; i < samples; i++) {
+        crossings += static_cast<uint32_t>((frame[i - 1] < 0) != (frame[i] < 0));
+    }
+    return static_cast<uint32_t>(static_cast<uint64_t>(crossings) * 1000 / (samples - 1));
+}
+
+bool VadGate::is_active(uint32_t energy, uint32_t zcr) const {
+    uint64_t threshold = static_cast<uint64_t>(noise_floor_) * config_.ratio_q4 / 16;
+    if (threshold < config_.min_energy) {
+        threshold = config_.min_energy;
+    }
+
+    // 浊音：能量明显高于噪声底
+    if (energy > threshold) {
+        return true;
+    }
+    // 清音（如"小"的声母）：能量较低但过零率高
+    return zcr >= config_.zcr_min_permille && energy > threshold / 2;
+}
+
+void VadGate::update_floor(uint32_t energy, int smoothing) {
+    if (energy > noise_floor_) {
+        noise_floor_ += (energy - noise_floor_) >> smoothing;
+    } else {
+        noise_floor_ -= (noise_floor_ - energy) >> smoothing;
+    }
+    if (noise_floor_ == 0) {
+        noise_floor_ = 1;
+    }
+}
+
+vad_gate_result_t VadGate::process(const int16_t *frame, size_t samples) {
+    uint32_t energy = frame_energy(frame, samples);
+    uint32_t zcr = zero_crossing_permille(frame, samples);
+    bool active = is_active(energy, zcr);
+
+    if (active) {
+        active_run_++;
+        silent_run_ = 0;
+    } else {
+        silent_run_++;
+        active_run_ = 0;
+    }
+
+    // 静音帧跟踪噪声底；门控打开期间以更慢的速度跟踪，避免噪声抬升后门控常开
+    if (!active) {
+        update_floor(energy, config_.floor_smoothing);
+    } else if (open_) {
+        update_floor(energy, config_.floor_smoothing + OPEN_FLOOR_EXTRA_SMOOTHING);
+    }
+
+    vad_gate_result_t result;
+    if (!open_) {
+        if (active_run_ >= config_.attack_frames) {
+            open_ = true;
+            opens_++;
+            result = VAD_GATE_OPENED;
+        } else {
+            result = VAD_GATE_CLOSED;
+        }
+    } else if (silent_run_ > config_.hangover_frames) {
+        open_ = false;
+        result = VAD_GATE_CLOSED;
+    } else {
+        result = VAD_GATE_OPEN;
+    }
+
+    if (result == VAD_GATE_CLOSED) {
+        frames_skipped_++;
+    } else {
+        frames_processed_++;
+    }
+    return result;
+}
+
+vad_gate_stats_t VadGate::get_stats() const {
+    return {
+        .frames_processed = frames_processed_,
+        .frames_skipped = frames_skipped_,
+        .opens = opens_,
+        .noise_floor = noise_floor_
+    };
+}
@@ -0,0 +1,122 @@
+/**
+ * @file vad_gate.h
+ * @brief 唤醒词检测前的能量/过零率语音门控
+ *
+ * 设备大部分时间处于安静环境，对静音帧运行 WakeNet 只是浪费 CPU 和电量。
+ * 门控根据帧能量（相对自适应噪声底）和过零率判断每帧是否可能含有语音：
+ * - 连续 attack_frames 帧活动后打开，打开时调用者应先回灌最近的历史帧，
+ *   保证唤醒词的第一个音节不会丢失
+ * - 连续 hangover_frames 帧静音后关闭
+ * 本模块只依赖 C++ 标准库，可在 Linux 主机上用录制的 WAV 数据验证。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 门控配置
+ */
+typedef struct {
+    uint32_t min_energy;        // 活动判决的绝对能量下限（均方值）
+    uint32_t ratio_q4;          // 浊音判决阈值 = 噪声底 * ratio_q4 / 16
+    uint32_t zcr_min_permille;  // 清音判决的过零率下限（千分比），能量阈值减半
+    int attack_frames;          // 连续多少帧活动后打开门控
+    int hangover_frames;        // 连续多少帧静音后关闭门控
+    int floor_smoothing;        // 噪声底平滑系数（右移位数，越大越平滑）
+} vad_gate_config_t;
+
+/**
+ * @brief 默认配置（32ms 帧：约 64ms 起音，约 640ms 拖尾）
+ */
+#define VAD_GATE_DEFAULT_CONFIG() { \
+    .min_energy = 400,              \
+    .ratio_q4 = 48,                 \
+    .zcr_min_permille = 250,        \
+    .attack_frames = 2,             \
+    .hangover_frames = 20,          \
+    .floor_smoothing = 4,           \
+}
+
+/**
+ * @brief 单帧判决结果
+ */
+typedef enum {
+    VAD_GATE_CLOSED = 0,  // 静音，跳过唤醒词检测
+    VAD_GATE_OPENED,      // 本帧刚打开门控，需要先回灌历史帧
+    VAD_GATE_OPEN,        // 门控保持打开
+} vad_gate_result_t;
+
+/**
+ * @brief 门控统计
+ */
+typedef struct {
+    uint32_t frames_processed;  // 送入唤醒词检测的帧数
+    uint32_t frames_skipped;    // 被门控跳过的帧数
+    uint32_t opens;             // 门控打开次数
+    uint32_t noise_floor;       // 当前噪声底（均方值）
+} vad_gate_stats_t;
+
+/**
+ * @brief 能量/过零率语音门控
+ *
+ * 单线程使用（识别任务）。
+ */
+class VadGate {
+public:
+    VadGate() = default;
+
+    /**
+     * @brief 设置配置并复位状态
+     * @param config 门控配置
+     */
+    void init(const vad_gate_config_t &config);
+
+    /**
+     * @brief 判决一帧音频
+     * @param frame 帧数据
+     * @param samples 样本数
+     * @return vad_gate_result_t 判决结果
+     */
+    vad_gate_result_t process(const int16_t *frame, size_t samples);
+
+    /**
+     * @brief 强制关闭门控（离开唤醒词检测状态时调用）
+     */
+    void reset();
+
+    /**
+     * @brief 门控当前是否打开
+     */
+    bool is_open() const { return open_; }
+
+    /**
+     * @brief 获取统计
+     */
+    vad_gate_stats_t get_stats() const;
+
+    /**
+     * @brief 计算一帧的均方能量
+     */
+    static uint32_t frame_energy(const int16_t *frame, size_t samples);
+
+    /**
+     * @brief 计算一帧的过零率（千分比）
+     */
+    static uint32_t zero_crossing_permille(const int16_t *frame, size_t samples);
+
+private:
+    vad_gate_config_t config_ = VAD_GATE_DEFAULT_CONFIG();
+    uint32_t noise_floor_ = 0;
+    int active_run_ = 0;
+    int silent_run_ = 0;
+    bool open_ = false;
+
+    uint32_t frames_processed_ = 0;
+    uint32_t frames_skipped_ = 0;
+    uint32_t opens_ = 0;
+
+    bool is_active(uint32_t energy, uint32_t zcr) const;
+    void update_floor(uint32_t energy, int smoothing);
+};
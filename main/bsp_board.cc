@@ -25,6 +25,10 @@
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "sdkconfig.h"
+#include "audio/sample_conditioner.h"
+#include "system/dlog.h"
 
 // INMP441 I2S 引脚配置
 // INMP441 是一个数字 MEMS 麦克风，通过 I2S 接口与 ESP32-S3 通信
@@ -53,6 +57,18 @@ static i2s_chan_handle_t rx_handle = nullptr;
 static i2s_chan_handle_t tx_handle = nullptr;
 // I2S 发送通道状态标志
 static bool tx_channel_enabled = false;
+// 麦克风 I2S 槽位宽（16 或 32）
+static int rx_bits_per_chan = 16;
+// 32 位槽右移位数，转换为 16 位样本时使用
+static int rx_shift = 16;
+// 32 位采集模式下的内部 DMA 接收缓冲区
+static int32_t *rx_buffer32 = nullptr;
+static size_t rx_buffer32_samples = 0;
+// 麦克风采样调理状态（去直流/增益/限幅）
+static sample_conditioner_t feed_conditioner = {
+    .config = SAMPLE_CONDITIONER_DEFAULT_CONFIG(),
+    .dc_estimate_q8 = 0,
+};
 
 /**
  * @brief 初始化 I2S 接口用于 INMP441 麦克风
@@ -60,7 +76,7 @@ static bool tx_channel_enabled = false;
  * INMP441 是一个数字 MEMS 麦克风，需要特定的 I2S 配置：
  * - 使用标准 I2S 协议 (Philips 格式)
  * - 单声道模式，只使用左声道
- * - 16 位数据宽度
+ * - 16 位数据宽度，或 32 位槽完整保留 24 位数据
  *
  * @param sample_rate 采样率 (Hz)
  * @param channel_format 声道数 (1=单声道, 2=立体声)
@@ -77,12 +93,13 @@ static esp_err_t bsp_i2s_init(uint32_t sample_rate, int channel_format, int bits
     ret = i2s_new_channel(&chan_cfg, nullptr, &rx_handle);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "创建 I2S 通道失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "创建 I2S 通道失败: %s", esp_err_to_name(ret));
         return ret;
     }
 
     // 确定正确的数据位宽度枚举值
     i2s_data_bit_width_t bit_width = (bits_per_chan == 32) ? I2S_DATA_BIT_WIDTH_32BIT : I2S_DATA_BIT_WIDTH_16BIT;
+    rx_bits_per_chan = (bits_per_chan == 32) ? 32 : 16;
 
     // 配置 I2S 标准模式，专门针对 INMP441 优化
     i2s_std_config_t std_cfg = {
@@ -115,7 +132,7 @@ static esp_err_t bsp_i2s_init(uint32_t sample_rate, int channel_format, int bits
     ret = i2s_channel_init_std_mode(rx_handle, &std_cfg);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "初始化 I2S 标准模式失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "初始化 I2S 标准模式失败: %s", esp_err_to_name(ret));
         return ret;
     }
 
@@ -123,11 +140,11 @@ static esp_err_t bsp_i2s_init(uint32_t sample_rate, int channel_format, int bits
     ret = i2s_channel_enable(rx_handle);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "启用 I2S 通道失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "启用 I2S 通道失败: %s", esp_err_to_name(ret));
         return ret;
     }
 
-    ESP_LOGI(TAG, "I2S 初始化成功");
+    DLOGI(TAG, "I2S 初始化成功");
     return ESP_OK;
 }
 
@@ -143,13 +160,60 @@ static esp_err_t bsp_i2s_init(uint32_t sample_rate, int channel_format, int bits
  */
 esp_err_t bsp_board_init(uint32_t sample_rate, int channel_format, int bits_per_chan)
 {
-    ESP_LOGI(TAG, "正在初始化 ESP32-S3-DevKitC-1 配合 INMP441 麦克风");
-    ESP_LOGI(TAG, "音频参数: 采样率=%ld Hz, 声道数=%d, 位深=%d",
-             sample_rate, channel_format, bits_per_chan);
+    DLOGI(TAG, "正在初始化 ESP32-S3-DevKitC-1 配合 INMP441 麦克风");
+    DLOGI(TAG, "音频参数: 采样率=%ld Hz, 声道数=%d, 位深=%d",
+          sample_rate, channel_format, bits_per_chan);
 
     return bsp_i2s_init(sample_rate, channel_format, bits_per_chan);
 }
 
+/**
+ * @brief 以 32 位槽读取 INMP441 数据并转换为 16 位样本
+ *
+ * INMP441 输出 24 位数据在 32 位帧中，左对齐。数据先由 DMA 读入内部 RAM
+ * 中的 32 位接收缓冲区，再按 rx_shift 右移并饱和，直接写入调用者的缓冲区，
+ * 不做额外的整帧拷贝。
+ *
+ * @param buffer 16 位输出缓冲区
+ * @param samples 需要读取的样本数
+ * @param samples_read 实际读取的样本数
+ * @return esp_err_t 读取结果
+ */
+static esp_err_t bsp_read_s32_as_s16(int16_t *buffer, int samples, int *samples_read)
+{
+    if (rx_buffer32_samples < (size_t)samples)
+    {
+        heap_caps_free(rx_buffer32);
+        rx_buffer32 = (int32_t *)heap_caps_aligned_alloc(16, samples * sizeof(int32_t),
+                                                         MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+        if (rx_buffer32 == nullptr)
+        {
+            rx_buffer32_samples = 0;
+            DLOGE(TAG, "32 位接收缓冲区分配失败，需要 %d 字节", (int)(samples * sizeof(int32_t)));
+            return ESP_ERR_NO_MEM;
+        }
+        rx_buffer32_samples = samples;
+    }
+
+    size_t bytes_read = 0;
+    size_t bytes_wanted = samples * sizeof(int32_t);
+    esp_err_t ret = i2s_channel_read(rx_handle, rx_buffer32, bytes_wanted, &bytes_read, portMAX_DELAY);
+    if (ret != ESP_OK)
+    {
+        DLOGE(TAG, "读取 I2S 数据失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (bytes_read != bytes_wanted)
+    {
+        DLOGW(TAG, "预期读取 %d 字节，实际读取 %d 字节", (int)bytes_wanted, (int)bytes_read);
+    }
+
+    *samples_read = bytes_read / sizeof(int32_t);
+    sample_convert_s32_to_s16(rx_buffer32, buffer, *samples_read, rx_shift);
+    return ESP_OK;
+}
+
 /**
  * @brief 从麦克风获取音频数据
  *
@@ -167,55 +231,83 @@ esp_err_t bsp_get_feed_data(bool is_get_raw_channel, int16_t *buffer, int buffer
 {
     esp_err_t ret = ESP_OK;
     size_t bytes_read = 0;
+    int samples = buffer_len / sizeof(int16_t);
 
-    // 从 I2S 通道读取音频数据
-    ret = i2s_channel_read(rx_handle, buffer, buffer_len, &bytes_read, portMAX_DELAY);
-
-    if (ret != ESP_OK)
+    if (rx_bits_per_chan == 32)
     {
-        ESP_LOGE(TAG, "读取 I2S 数据失败: %s", esp_err_to_name(ret));
-        return ret;
+        // 32 位槽：读入内部 DMA 缓冲区，再单遍转换到调用者的 16 位缓冲区
+        ret = bsp_read_s32_as_s16(buffer, samples, &samples);
+        if (ret != ESP_OK)
+        {
+            return ret;
+        }
     }
-
-    // 检查读取的数据长度是否符合预期
-    if (bytes_read != buffer_len)
+    else
     {
-        ESP_LOGW(TAG, "预期读取 %d 字节，实际读取 %d 字节", buffer_len, bytes_read);
+        // 从 I2S 通道读取音频数据
+        ret = i2s_channel_read(rx_handle, buffer, buffer_len, &bytes_read, portMAX_DELAY);
+
+        if (ret != ESP_OK)
+        {
+            DLOGE(TAG, "读取 I2S 数据失败: %s", esp_err_to_name(ret));
+            return ret;
+        }
+
+        // 检查读取的数据长度是否符合预期
+        if (bytes_read != buffer_len)
+        {
+            DLOGW(TAG, "预期读取 %d 字节，实际读取 %d 字节", buffer_len, bytes_read);
+        }
+        samples = bytes_read / sizeof(int16_t);
     }
 
     // INMP441 特定的数据处理
-    // INMP441 输出 24 位数据在 32 位帧中，左对齐
-    // 我们需要提取最高有效的 16 位用于 16 位音频处理
+    // 对信号进行去直流、增益调整和限幅，默认配置下为恒等变换，不遍历数据
     if (!is_get_raw_channel)
     {
-        int samples = buffer_len / sizeof(int16_t);
+        sample_conditioner_process(&feed_conditioner, buffer, samples);
+    }
 
-        // 对 INMP441 的数据进行处理
-        // 麦克风输出左对齐数据，进行信号电平调整
-        for (int i = 0; i < samples; i++)
-        {
-            // 当前使用原始信号电平（无增益）
-            // 测试表明原始电平已足够满足唤醒词检测需求
-            int32_t sample = static_cast<int32_t>(buffer[i]);
-
-            // 可选：应用 2 倍增益以提升信号强度（当前已禁用）
-            // 如果发现信号电平不足，可以取消下面这行的注释
-            // sample = sample * 2;
-
-            // 限制在 16 位有符号整数范围内
-            if (sample > 32767)
-            {
-                sample = 32767;
-            }
-            if (sample < -32768)
-            {
-                sample = -32768;
-            }
-
-            buffer[i] = static_cast<int16_t>(sample);
-        }
+    return ESP_OK;
+}
+
+/**
+ * @brief 设置 32 位采集模式的右移位数
+ *
+ * @param shift 右移位数（8~16），16 等同于 16 位槽的结果
+ * @return esp_err_t 设置结果
+ */
+esp_err_t bsp_set_feed_shift(int shift)
+{
+    if (shift < 8 || shift > 16)
+    {
+        return ESP_ERR_INVALID_ARG;
     }
 
+    rx_shift = shift;
+    DLOGI(TAG, "32 位采集右移位数: %d（相对 16 位槽增益 %d dB）", shift, (16 - shift) * 6);
+    return ESP_OK;
+}
+
+/**
+ * @brief 设置麦克风采样调理参数
+ *
+ * 应在采集任务启动前调用，避免与 bsp_get_feed_data() 并发修改状态。
+ *
+ * @param config 调理配置
+ * @return esp_err_t 设置结果
+ */
+esp_err_t bsp_set_feed_conditioning(const sample_conditioner_config_t *config)
+{
+    if (config == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sample_conditioner_init(&feed_conditioner, config);
+    DLOGI(TAG, "采样调理配置: 增益=%d倍, 限幅=%d, 去直流=%s",
+          1 << feed_conditioner.config.gain_shift, feed_conditioner.config.clamp_limit,
+          feed_conditioner.config.dc_removal ? "开启" : "关闭");
     return ESP_OK;
 }
 
@@ -249,10 +341,14 @@ esp_err_t bsp_audio_init(uint32_t sample_rate, int channel_format, int bits_per_
     // 创建 I2S 发送通道配置
     // 设置为主模式，ESP32-S3 作为时钟源
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_PORT_TX, I2S_ROLE_MASTER);
+#if CONFIG_ZAPMYCO_AUDIO_TX_PERSISTENT
+    // 发送通道常开：没有新数据时 DMA 自动填零输出静音，播放时无需重新启用通道
+    chan_cfg.auto_clear = true;
+#endif
     ret = i2s_new_channel(&chan_cfg, &tx_handle, nullptr);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "创建 I2S 发送通道失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "创建 I2S 发送通道失败: %s", esp_err_to_name(ret));
         return ret;
     }
 
@@ -286,7 +382,7 @@ esp_err_t bsp_audio_init(uint32_t sample_rate, int channel_format, int bits_per_
     ret = i2s_channel_init_std_mode(tx_handle, &std_cfg);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "初始化 I2S 发送标准模式失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "初始化 I2S 发送标准模式失败: %s", esp_err_to_name(ret));
         return ret;
     }
 
@@ -294,17 +390,82 @@ esp_err_t bsp_audio_init(uint32_t sample_rate, int channel_format, int bits_per_
     ret = i2s_channel_enable(tx_handle);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "启用 I2S 发送通道失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "启用 I2S 发送通道失败: %s", esp_err_to_name(ret));
         return ret;
     }
 
     // 设置通道状态标志
     tx_channel_enabled = true;
 
-    ESP_LOGI(TAG, "I2S 音频播放初始化成功");
+    DLOGI(TAG, "I2S 音频播放初始化成功");
     return ESP_OK;
 }
 
+/**
+ * @brief 向 I2S 发送通道写入一块音频数据
+ *
+ * 供播放任务分块流式输出使用：只阻塞到数据进入 DMA 缓冲区，
+ * 不会在写入后停止通道。
+ *
+ * @param audio_data 指向音频数据块的指针
+ * @param data_len 数据块长度（字节）
+ * @param bytes_written 实际写入的字节数
+ * @param timeout_ms 等待 DMA 缓冲区空闲的最长时间（毫秒）
+ * @return esp_err_t 写入结果
+ */
+esp_err_t bsp_audio_write(const uint8_t *audio_data, size_t data_len, size_t *bytes_written, uint32_t timeout_ms)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (tx_handle == nullptr)
+    {
+        DLOGE(TAG, "I2S 发送通道未初始化");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (audio_data == nullptr || data_len == 0 || bytes_written == nullptr)
+    {
+        DLOGE(TAG, "无效的音频数据");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 通道被停止过：先把数据预装入 DMA 缓冲区再启用，第一个样本随时钟一起输出
+    size_t preloaded = 0;
+    if (!tx_channel_enabled)
+    {
+        ret = i2s_channel_preload_data(tx_handle, audio_data, data_len, &preloaded);
+        if (ret != ESP_OK)
+        {
+            DLOGW(TAG, "预装 I2S 音频数据失败: %s", esp_err_to_name(ret));
+            preloaded = 0;
+        }
+
+        ret = i2s_channel_enable(tx_handle);
+        if (ret != ESP_OK)
+        {
+            DLOGE(TAG, "启用 I2S 发送通道失败: %s", esp_err_to_name(ret));
+            return ret;
+        }
+        tx_channel_enabled = true;
+        DLOGD(TAG, "I2S 发送通道已重新启用，预装 %zu 字节", preloaded);
+    }
+
+    *bytes_written = preloaded;
+    if (preloaded >= data_len)
+    {
+        return ESP_OK;
+    }
+
+    size_t written = 0;
+    ret = i2s_channel_write(tx_handle, audio_data + preloaded, data_len - preloaded, &written, timeout_ms);
+    *bytes_written += written;
+    if (ret != ESP_OK && ret != ESP_ERR_TIMEOUT)
+    {
+        DLOGE(TAG, "写入 I2S 音频数据失败: %s", esp_err_to_name(ret));
+    }
+    return ret;
+}
+
 /**
  * @brief 通过 I2S 播放音频数据
  *
@@ -323,13 +484,13 @@ esp_err_t bsp_play_audio(const uint8_t *audio_data, size_t data_len)
 
     if (tx_handle == nullptr)
     {
-        ESP_LOGE(TAG, "I2S 发送通道未初始化");
+        DLOGE(TAG, "I2S 发送通道未初始化");
         return ESP_ERR_INVALID_STATE;
     }
 
     if (audio_data == nullptr || data_len == 0)
     {
-        ESP_LOGE(TAG, "无效的音频数据");
+        DLOGE(TAG, "无效的音频数据");
         return ESP_ERR_INVALID_ARG;
     }
 
@@ -339,11 +500,11 @@ esp_err_t bsp_play_audio(const uint8_t *audio_data, size_t data_len)
         ret = i2s_channel_enable(tx_handle);
         if (ret != ESP_OK)
         {
-            ESP_LOGE(TAG, "启用 I2S 发送通道失败: %s", esp_err_to_name(ret));
+            DLOGE(TAG, "启用 I2S 发送通道失败: %s", esp_err_to_name(ret));
             return ret;
         }
         tx_channel_enabled = true;
-        ESP_LOGD(TAG, "I2S 发送通道已重新启用");
+        DLOGD(TAG, "I2S 发送通道已重新启用");
     }
 
     // 将音频数据写入 I2S 发送通道
@@ -351,24 +512,24 @@ esp_err_t bsp_play_audio(const uint8_t *audio_data, size_t data_len)
 
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "写入 I2S 音频数据失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "写入 I2S 音频数据失败: %s", esp_err_to_name(ret));
         return ret;
     }
 
     // 检查写入的数据长度是否符合预期
     if (bytes_written != data_len)
     {
-        ESP_LOGW(TAG, "预期写入 %d 字节，实际写入 %d 字节", data_len, bytes_written);
+        DLOGW(TAG, "预期写入 %d 字节，实际写入 %d 字节", data_len, bytes_written);
     }
 
     // 播放完成后停止I2S输出以防止噪音
     esp_err_t stop_ret = bsp_audio_stop();
     if (stop_ret != ESP_OK)
     {
-        ESP_LOGW(TAG, "停止音频输出时出现警告: %s", esp_err_to_name(stop_ret));
+        DLOGW(TAG, "停止音频输出时出现警告: %s", esp_err_to_name(stop_ret));
     }
 
-    ESP_LOGI(TAG, "音频播放完成，播放了 %d 字节", bytes_written);
+    DLOGI(TAG, "音频播放完成，播放了 %d 字节", bytes_written);
     return ESP_OK;
 }
 
@@ -379,34 +540,39 @@ esp_err_t bsp_play_audio(const uint8_t *audio_data, size_t data_len)
  * 从而消除播放完成后的噪音。当需要再次播放音频时，
  * 可以重新启用通道。
  *
+ * 发送通道常开模式下 DMA 自动填零，通道保持运行，本函数不做任何操作，
+ * 下一个片段也就不必承担重新启用通道和 DMA 启动的延迟。
+ *
  * @return esp_err_t 停止结果
  */
 esp_err_t bsp_audio_stop(void)
 {
-    esp_err_t ret = ESP_OK;
-
     if (tx_handle == nullptr)
     {
-        ESP_LOGW(TAG, "I2S 发送通道未初始化，无需停止");
+        DLOGW(TAG, "I2S 发送通道未初始化，无需停止");
         return ESP_OK;
     }
 
+#if CONFIG_ZAPMYCO_AUDIO_TX_PERSISTENT
+    DLOGD(TAG, "发送通道常开，DMA 自动填零输出静音");
+#else
     // 只有在通道启用时才禁用它
     if (tx_channel_enabled)
     {
-        ret = i2s_channel_disable(tx_handle);
+        esp_err_t ret = i2s_channel_disable(tx_handle);
         if (ret != ESP_OK)
         {
-            ESP_LOGE(TAG, "禁用 I2S 发送通道失败: %s", esp_err_to_name(ret));
+            DLOGE(TAG, "禁用 I2S 发送通道失败: %s", esp_err_to_name(ret));
             return ret;
         }
         tx_channel_enabled = false;
-        ESP_LOGI(TAG, "I2S 音频输出已停止");
+        DLOGI(TAG, "I2S 音频输出已停止");
     }
     else
     {
-        ESP_LOGD(TAG, "I2S 发送通道已经是禁用状态");
+        DLOGD(TAG, "I2S 发送通道已经是禁用状态");
     }
+#endif
 
     return ESP_OK;
 }
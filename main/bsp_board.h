@@ -21,6 +21,7 @@
 #include <stdbool.h>
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
+#include "audio/sample_conditioner.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +51,32 @@ esp_err_t bsp_board_init(uint32_t sample_rate, int channel_format, int bits_per_
  */
 esp_err_t bsp_get_feed_data(bool is_get_raw_channel, int16_t *buffer, int buffer_len);
 
+/**
+ * @brief Configure the DC removal / gain / clamp stage applied by bsp_get_feed_data()
+ *
+ * Must be called before the capture task starts reading.
+ *
+ * @param config Conditioning configuration
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: config is NULL
+ */
+esp_err_t bsp_set_feed_conditioning(const sample_conditioner_config_t *config);
+
+/**
+ * @brief Set the right shift used to convert 32-bit slots to 16-bit samples
+ *
+ * Only used when the board was initialized with 32 bits per channel.
+ * INMP441 data is 24-bit left-aligned; a shift of 16 keeps the top 16 bits,
+ * each step below 16 adds 6 dB of gain using bits a 16-bit slot discards.
+ *
+ * @param shift Right shift in bits (8..16)
+ * @return
+ *    - ESP_OK: Success
+ *    - ESP_ERR_INVALID_ARG: shift out of range
+ */
+esp_err_t bsp_set_feed_shift(int shift);
+
 /**
  * @brief Get the number of feed channels
  *
@@ -69,9 +96,31 @@ int bsp_get_feed_channel(void);
  */
 esp_err_t bsp_audio_init(uint32_t sample_rate, int channel_format, int bits_per_chan);
 
+/**
+ * @brief Write one chunk of audio data to the I2S output
+ *
+ * Enables the TX channel if it was stopped, preloading the chunk into the
+ * DMA buffers first so the first sample goes out with the first clock.
+ * Blocks only until the chunk has been copied into the DMA buffers, so
+ * callers can stream a clip in small pieces and stay responsive between
+ * chunks.
+ *
+ * @param audio_data Pointer to audio data chunk
+ * @param data_len Length of the chunk in bytes
+ * @param bytes_written Number of bytes actually written
+ * @param timeout_ms Maximum time to wait for DMA buffer space
+ * @return
+ *    - ESP_OK: Success
+ *    - Others: Fail
+ */
+esp_err_t bsp_audio_write(const uint8_t *audio_data, size_t data_len, size_t *bytes_written, uint32_t timeout_ms);
+
 /**
  * @brief Play audio data through I2S output
  *
+ * Blocks until the whole clip has been written. Use AudioPlayer for
+ * non-blocking playback from latency-sensitive tasks.
+ *
  * @param audio_data Pointer to audio data buffer
  * @param data_len Length of audio data in bytes
  * @return
@@ -83,6 +132,9 @@ esp_err_t bsp_play_audio(const uint8_t *audio_data, size_t data_len);
 /**
  * @brief Stop I2S audio output to prevent noise
  *
+ * No-op when CONFIG_ZAPMYCO_AUDIO_TX_PERSISTENT is set: the TX channel
+ * keeps running and DMA auto-clear outputs silence between clips.
+ *
  * @return
  *    - ESP_OK: Success
  *    - Others: Fail
@@ -0,0 +1,72 @@
+/**
+ * @file command_action.cc
+ * @brief 命令动作执行实现
+ */
+
+#include "command_action.h"
+#include "command_manifest.h"
+#include "audio/audio_player.h"
+#include "system/dlog.h"
+#include "system/trace.h"
+
+extern "C" {
+#include "driver/gpio.h"
+}
+
+static const char *TAG = "命令动作";
+
+esp_err_t command_action_execute(const command_entry_t *entry) {
+    DLOGI(TAG, "执行命令: %s", entry->description);
+
+    if (entry->action == COMMAND_ACTION_GPIO) {
+        esp_err_t ret = gpio_set_level(static_cast<gpio_num_t>(entry->gpio), entry->level);
+        if (ret != ESP_OK) {
+            DLOGE(TAG, "GPIO%d 设置失败: %s", entry->gpio, esp_err_to_name(ret));
+            return ret;
+        }
+        TRACE_INSTANT(GPIO_SET, entry->level);
+        DLOGI(TAG, "GPIO%d 输出%s电平", entry->gpio, entry->level ? "高" : "低");
+    }
+
+    // 交给播放任务异步播放，立即返回
+    if (entry->prompt != nullptr) {
+        playback_id_t play_id = AudioPlayer::get_instance()->play_prompt(entry->prompt);
+        if (play_id != 0) {
+            DLOGI(TAG, "✓ 确认音频 '%s' 已加入播放队列", entry->prompt);
+        } else {
+            DLOGE(TAG, "确认音频 '%s' 播放失败", entry->prompt);
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t command_action_init_gpio(const CommandManifest *manifest) {
+    uint64_t mask = 0;
+    command_entry_t entry;
+    {
+        CommandTableReadGuard guard;     // 遍历当前命令表期间不被替换
+        for (size_t i = 0; (manifest != nullptr) ? manifest->at(i, &entry) : command_table_at(i, &entry); i++) {
+            if (entry.action != COMMAND_ACTION_GPIO) {
+                continue;
+            }
+            if (!GPIO_IS_VALID_OUTPUT_GPIO(entry.gpio)) {
+                DLOGE(TAG, "命令 [%d] 的 GPIO%d 不能用作输出", entry.id, entry.gpio);
+                return ESP_ERR_INVALID_ARG;
+            }
+            mask |= 1ULL << entry.gpio;
+        }
+    }
+    if (mask == 0) {
+        return ESP_OK;
+    }
+
+    gpio_config_t io_conf = {
+        .pin_bit_mask = mask,
+        .mode = GPIO_MODE_OUTPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE
+    };
+    return gpio_config(&io_conf);
+}
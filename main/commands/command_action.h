@@ -0,0 +1,32 @@
+/**
+ * @file command_action.h
+ * @brief 命令动作执行
+ */
+
+#pragma once
+
+#include "command_table.h"
+
+extern "C" {
+#include "esp_err.h"
+}
+
+/**
+ * @brief 按表项执行命令：执行动作（如设置 GPIO 电平），再播放确认提示音
+ *
+ * 提示音交给播放任务异步播放，立即返回；提示音缺失不算执行失败。
+ *
+ * @param entry 命令表项
+ * @return esp_err_t 执行结果
+ */
+esp_err_t command_action_execute(const command_entry_t *entry);
+
+/**
+ * @brief 把命令表中用到的 GPIO 配置为输出
+ *
+ * 替换命令表前先为新清单调用，表中有无效 GPIO 时不替换。
+ *
+ * @param manifest 命令清单，nullptr 表示当前命令表
+ * @return esp_err_t 配置结果，表中有无效 GPIO 时返回 ESP_ERR_INVALID_ARG
+ */
+esp_err_t command_action_init_gpio(const CommandManifest *manifest = nullptr);
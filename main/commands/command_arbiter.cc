@@ -0,0 +1,106 @@
+/**
+ * @file command_arbiter.cc
+ * @brief 命令识别结果仲裁实现
+ */
+
+#include "command_arbiter.h"
+#include <cmath>
+
+static const char *const REASON_NAMES[ARBITER_REASON_COUNT] = {
+    "达到门限",
+    "无候选",
+    "置信度不足",
+    "领先不足",
+};
+
+/**
+ * @brief 置信度换算为千分比并四舍五入，门限比较不受浮点误差影响（0.45 - 0.35 按 10% 计）
+ */
+static int permille(float prob) {
+    if (!(prob > 0.0f)) {
+        return 0;   // 含 NaN
+    }
+    return (prob >= 1.0f) ? 1000 : static_cast<int>(lroundf(prob * 1000.0f));
+}
+
+CommandArbiter::CommandArbiter(uint8_t say_again_limit, lookup_t lookup)
+    : say_again_limit_(say_again_limit), lookup_(lookup) {
+}
+
+const char* CommandArbiter::reason_name(arbiter_reason_t reason) {
+    return (reason < ARBITER_REASON_COUNT) ? REASON_NAMES[reason] : "未知";
+}
+
+arbiter_decision_t CommandArbiter::finish(arbiter_decision_t decision) {
+    counts_[decision.verdict]++;
+    return decision;
+}
+
+arbiter_decision_t CommandArbiter::decide(const command_candidate_t *candidates, size_t count) {
+    // 合并同一命令的候选，忽略不在命令表中的命令；门限在此时取出，
+    // 之后命令表被替换也按同一份表项判定
+    int ids[MAX_CANDIDATES];
+    float probs[MAX_CANDIDATES];
+    command_entry_t entries[MAX_CANDIDATES];
+    size_t merged = 0;
+    for (size_t i = 0; i < count && i < MAX_CANDIDATES; i++) {
+        const command_candidate_t &c = candidates[i];
+        size_t j = 0;
+        while (j < merged && ids[j] != c.command_id) {
+            j++;
+        }
+        if (j < merged) {
+            probs[j] = (c.prob > probs[j]) ? c.prob : probs[j];
+        } else if (lookup_(c.command_id, &entries[merged])) {
+            ids[merged] = c.command_id;
+            probs[merged] = c.prob;
+            merged++;
+        }
+    }
+
+    arbiter_decision_t decision = {ARBITER_IGNORE, ARBITER_REASON_NO_CANDIDATE, -1, 0.0f, -1, 0.0f, retries_};
+    if (merged == 0) {
+        return finish(decision);
+    }
+
+    // 最佳和第二候选，置信度相同时先出现的优先
+    size_t best = 0;
+    for (size_t j = 1; j < merged; j++) {
+        best = (permille(probs[j]) > permille(probs[best])) ? j : best;
+    }
+    size_t runner_up = merged;
+    for (size_t j = 0; j < merged; j++) {
+        if (j != best && (runner_up == merged || permille(probs[j]) > permille(probs[runner_up]))) {
+            runner_up = j;
+        }
+    }
+
+    decision.command_id = ids[best];
+    decision.prob = probs[best];
+    if (runner_up < merged) {
+        decision.runner_up_id = ids[runner_up];
+        decision.runner_up_prob = probs[runner_up];
+    }
+
+    const command_entry_t &entry = entries[best];
+    int margin = permille(decision.prob) - permille(decision.runner_up_prob);
+    if (permille(decision.prob) < entry.min_confidence * 10) {
+        decision.reason = ARBITER_REASON_LOW_CONFIDENCE;
+    } else if (margin < entry.min_margin * 10) {
+        decision.reason = ARBITER_REASON_AMBIGUOUS;
+    } else {
+        retries_ = 0;
+        decision.verdict = ARBITER_ACCEPT;
+        decision.reason = ARBITER_REASON_OK;
+        decision.retries = 0;
+        return finish(decision);
+    }
+
+    // 未被接受：未到上限时请用户重说，之后静默忽略
+    if (retries_ < UINT8_MAX) {
+        retries_++;
+    }
+    decision.retries = retries_;
+    decision.verdict = (retries_ <= say_again_limit_) ? ARBITER_SAY_AGAIN : ARBITER_IGNORE;
+    return finish(decision);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file command_arbiter.h
+ * @brief 命令识别结果仲裁
+ *
+ * MultiNet 每次检测给出按置信度排序的 N-best 候选。仲裁综合全部候选决定是否
+ * 执行：同一命令的多个命令词合并为一个候选，取最高置信度；最佳候选的置信度
+ * 必须达到其命令表项的 min_confidence，并且领先第二候选命令至少 min_margin，
+ * 否则请用户再说一遍，而不是冒险执行一个可能错误的动作（例如开灯听成关灯）。
+ * 连续请求重说达到上限后不再提示，静默忽略，直到命令被接受或新一轮交互开始。
+ *
+ * 判定只取决于输入的候选序列和命令表，不读时钟也没有随机性，同样的识别结果
+ * 序列总是得到同样的判定。本模块只依赖 C++ 标准库，可在 Linux 主机上用录制的
+ * 识别结果回放测试。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "command_table.h"
+
+/**
+ * @brief 识别候选（MultiNet N-best 结果中的一项）
+ */
+typedef struct {
+    int command_id;     // 命令ID
+    float prob;         // 置信度 [0, 1]
+} command_candidate_t;
+
+/**
+ * @brief 仲裁结论
+ */
+typedef enum {
+    ARBITER_ACCEPT = 0,     // 执行 command_id
+    ARBITER_SAY_AGAIN,      // 请用户再说一遍
+    ARBITER_IGNORE,         // 忽略本次结果，不提示
+} arbiter_verdict_t;
+
+/**
+ * @brief 仲裁原因
+ */
+typedef enum {
+    ARBITER_REASON_OK = 0,          // 达到门限
+    ARBITER_REASON_NO_CANDIDATE,    // 没有命令表中的候选
+    ARBITER_REASON_LOW_CONFIDENCE,  // 最佳候选置信度低于 min_confidence
+    ARBITER_REASON_AMBIGUOUS,       // 领先第二候选不足 min_margin
+    ARBITER_REASON_COUNT
+} arbiter_reason_t;
+
+/**
+ * @brief 仲裁结果
+ */
+typedef struct {
+    arbiter_verdict_t verdict;
+    arbiter_reason_t reason;
+    int command_id;             // 最佳候选命令ID，没有候选时为-1
+    float prob;                 // 最佳候选置信度
+    int runner_up_id;           // 第二候选命令ID，没有时为-1
+    float runner_up_prob;       // 第二候选置信度，没有时为0
+    uint8_t retries;            // 本轮交互中连续未被接受的次数（含本次）
+} arbiter_decision_t;
+
+/**
+ * @brief 命令识别结果仲裁器
+ *
+ * 不是线程安全的，只在识别任务中使用。
+ */
+class CommandArbiter {
+public:
+    /**
+     * @brief 按命令ID查找表项，默认查当前命令表（测试时可以换成固定的表）
+     */
+    typedef bool (*lookup_t)(int id, command_entry_t *entry);
+
+    static const size_t MAX_CANDIDATES = 8;     // 参与仲裁的候选数上限，多出的忽略
+
+    /**
+     * @brief 构造仲裁器
+     * @param say_again_limit 一轮交互中最多请用户重说的次数，0 表示从不请求重说
+     * @param lookup 表项查找函数
+     */
+    explicit CommandArbiter(uint8_t say_again_limit = 2, lookup_t lookup = command_table_find);
+
+    /**
+     * @brief 对一次检测的 N-best 候选做出判定
+     *
+     * 不在命令表中的候选被忽略。同一命令出现多次时取最高置信度；置信度相同时
+     * 排在前面的候选优先（与 MultiNet 的排序一致）。
+     *
+     * @param candidates 候选列表（MultiNet 按置信度从高到低排列，但不要求有序）
+     * @param count 候选数量
+     * @return arbiter_decision_t 判定
+     */
+    arbiter_decision_t decide(const command_candidate_t *candidates, size_t count);
+
+    /**
+     * @brief 开始新一轮交互（唤醒时调用），清除连续重说计数
+     */
+    void reset() { retries_ = 0; }
+
+    /**
+     * @brief 各判定的累计次数
+     */
+    uint32_t get_count(arbiter_verdict_t verdict) const { return counts_[verdict]; }
+
+    /**
+     * @brief 判定原因的名称（用于日志）
+     */
+    static const char* reason_name(arbiter_reason_t reason);
+
+private:
+    uint8_t say_again_limit_;
+    lookup_t lookup_;
+    uint8_t retries_ = 0;
+    uint32_t counts_[3] = {0, 0, 0};    // 按 arbiter_verdict_t 计数
+
+    /**
+     * @brief 记录判定并返回
+     */
+    arbiter_decision_t finish(arbiter_decision_t decision);
+};
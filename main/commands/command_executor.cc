@@ -0,0 +1,146 @@
+/**
+ * @file command_executor.cc
+ * @brief 异步命令执行器实现
+ */
+
+#include "command_executor.h"
+#include "system/dlog.h"
+#include "system/trace.h"
+
+extern "C" {
+#include "esp_timer.h"
+}
+
+static const char *TAG = "命令执行";
+
+static portMUX_TYPE pending_lock = portMUX_INITIALIZER_UNLOCKED;  // 识别任务和执行任务在不同核心上访问队列
+
+// 静态成员初始化
+CommandExecutor* CommandExecutor::instance_ = nullptr;
+
+CommandExecutor* CommandExecutor::get_instance() {
+    if (instance_ == nullptr) {
+        instance_ = new CommandExecutor();
+    }
+    return instance_;
+}
+
+esp_err_t CommandExecutor::start(BaseType_t core_id, UBaseType_t priority, uint32_t stack_size) {
+    if (task_ != nullptr) {
+        DLOGW(TAG, "执行任务已在运行");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    events_ = xQueueCreate(EVENT_QUEUE_LENGTH, sizeof(command_event_t));
+    if (events_ == nullptr) {
+        DLOGE(TAG, "创建命令事件队列失败");
+        return ESP_ERR_NO_MEM;
+    }
+
+    BaseType_t ret = xTaskCreatePinnedToCore(executor_task, "cmd_exec", stack_size, this, priority, &task_, core_id);
+    if (ret != pdPASS) {
+        DLOGE(TAG, "创建执行任务失败");
+        vQueueDelete(events_);
+        events_ = nullptr;
+        task_ = nullptr;
+        return ESP_ERR_NO_MEM;
+    }
+
+    DLOGI(TAG, "✓ 执行任务已启动: 核心=%d, 最多排队 %d 条命令", (int)core_id, (int)CommandQueue::CAPACITY);
+    return ESP_OK;
+}
+
+esp_err_t CommandExecutor::submit(int command_id, uint32_t *ticket) {
+    if (task_ == nullptr) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    command_entry_t entry;
+    if (!command_table_find(command_id, &entry)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    command_job_t job = {
+        .ticket = 0,
+        .command_id = command_id,
+        .priority = entry.priority,
+        .submitted_us = esp_timer_get_time()
+    };
+
+    portENTER_CRITICAL(&pending_lock);
+    job.ticket = next_ticket_;
+    bool queued = pending_.push(job);
+    if (queued) {
+        next_ticket_ = (next_ticket_ + 1 == 0) ? 1 : next_ticket_ + 1;
+    }
+    portEXIT_CRITICAL(&pending_lock);
+
+    if (!queued) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return ESP_ERR_NO_MEM;
+    }
+
+    TRACE_INSTANT(COMMAND_SUBMIT, command_id);
+    if (ticket != nullptr) {
+        *ticket = job.ticket;
+    }
+    xTaskNotifyGive(task_);
+    return ESP_OK;
+}
+
+bool CommandExecutor::poll_event(command_event_t *event) {
+    return events_ != nullptr && xQueueReceive(events_, event, 0) == pdTRUE;
+}
+
+size_t CommandExecutor::cancel_pending(uint32_t after_ticket) {
+    portENTER_CRITICAL(&pending_lock);
+    size_t dropped = (after_ticket != 0) ? pending_.clear_after(after_ticket) : pending_.clear();
+    portEXIT_CRITICAL(&pending_lock);
+    return dropped;
+}
+
+void CommandExecutor::executor_task(void *arg) {
+    static_cast<CommandExecutor *>(arg)->run();
+}
+
+void CommandExecutor::run() {
+    CommandManager *manager = CommandManager::get_instance();
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (1) {
+            command_job_t job;
+            portENTER_CRITICAL(&pending_lock);
+            bool got = pending_.pop(&job);
+            portEXIT_CRITICAL(&pending_lock);
+            if (!got) {
+                break;
+            }
+
+            int64_t start_us = esp_timer_get_time();
+            uint32_t wait_us = static_cast<uint32_t>(start_us - job.submitted_us);
+            wait_timing_.add(wait_us);
+            if (wait_us > max_wait_us_.load(std::memory_order_relaxed)) {
+                max_wait_us_.store(wait_us, std::memory_order_relaxed);
+            }
+
+            TRACE_BEGIN(COMMAND_EXECUTE, job.command_id);
+            command_result_t result = manager->execute_command(job.command_id);
+            TRACE_END(COMMAND_EXECUTE, result);
+            uint32_t run_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+            run_timing_.add(run_us);
+
+            command_event_t event = {
+                .ticket = job.ticket,
+                .command_id = job.command_id,
+                .result = result,
+                .wait_us = wait_us,
+                .run_us = run_us
+            };
+            if (xQueueSend(events_, &event, 0) != pdTRUE) {
+                events_dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file command_executor.h
+ * @brief 异步命令执行器
+ *
+ * 识别任务识别出命令后只把命令ID提交到执行器，立即返回继续处理音频帧；
+ * 执行任务按命令表中的优先级依次执行命令，结束后把结果作为事件发回，
+ * 由识别任务在处理下一帧前取出（例如"拜拜"执行成功后返回等待唤醒）。
+ */
+
+#pragma once
+
+#include <atomic>
+#include "command_manager.h"
+#include "command_queue.h"
+#include "audio/stage_timing.h"
+
+extern "C" {
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+}
+
+/**
+ * @brief 命令执行完成事件
+ */
+typedef struct {
+    uint32_t ticket;            // 提交序号
+    int command_id;             // 命令ID
+    command_result_t result;    // 执行结果
+    uint32_t wait_us;           // 提交到开始执行的等待时间
+    uint32_t run_us;            // 执行耗时
+} command_event_t;
+
+/**
+ * @brief 异步命令执行器
+ *
+ * 单例模式。submit()/poll_event() 可以在任意任务中调用，命令在执行任务中运行。
+ */
+class CommandExecutor {
+private:
+    static CommandExecutor* instance_;
+
+    CommandQueue pending_;                    // 待执行命令（受 command_executor.cc 中的锁保护）
+    uint32_t next_ticket_ = 1;                // 下一个提交序号（受锁保护）
+    QueueHandle_t events_ = nullptr;
+    TaskHandle_t task_ = nullptr;
+
+    StageTiming wait_timing_;                 // 提交到开始执行的等待时间
+    StageTiming run_timing_;                  // 命令执行耗时
+    std::atomic<uint32_t> max_wait_us_{0};
+    std::atomic<uint32_t> rejected_{0};       // 队列已满被拒绝的命令数
+    std::atomic<uint32_t> events_dropped_{0}; // 事件队列已满丢弃的事件数
+
+    /**
+     * @brief 私有构造函数（单例模式）
+     */
+    CommandExecutor() = default;
+
+    /**
+     * @brief 执行任务入口
+     * @param arg CommandExecutor 实例指针
+     */
+    static void executor_task(void *arg);
+
+    /**
+     * @brief 执行主循环
+     */
+    void run();
+
+public:
+    static const size_t EVENT_QUEUE_LENGTH = 8;   // 完成事件队列长度
+
+    /**
+     * @brief 获取单例实例
+     * @return CommandExecutor* 单例实例指针
+     */
+    static CommandExecutor* get_instance();
+
+    /**
+     * @brief 启动执行任务
+     * @param core_id 执行任务绑定的CPU核
+     * @param priority 执行任务优先级
+     * @param stack_size 执行任务栈大小（字节）
+     * @return esp_err_t 启动结果
+     */
+    esp_err_t start(BaseType_t core_id, UBaseType_t priority, uint32_t stack_size);
+
+    /**
+     * @brief 提交一条命令，立即返回
+     * @param command_id 命令ID
+     * @param ticket 输出提交序号，可为nullptr
+     * @return esp_err_t ESP_OK 已排队；ESP_ERR_NOT_FOUND 命令不在命令表中；
+     *         ESP_ERR_NO_MEM 队列已满；ESP_ERR_INVALID_STATE 执行任务未启动
+     */
+    esp_err_t submit(int command_id, uint32_t *ticket = nullptr);
+
+    /**
+     * @brief 取出一个完成事件，不等待
+     * @param event 输出事件
+     * @return bool 取到事件返回true
+     */
+    bool poll_event(command_event_t *event);
+
+    /**
+     * @brief 丢弃尚未开始执行的命令（正在执行的命令不受影响）
+     * @param after_ticket 只丢弃在此序号之后提交的命令（结束交互的命令的序号，
+     *                     其前提交的动作仍然执行）；0 表示全部丢弃
+     * @return size_t 丢弃的命令数
+     */
+    size_t cancel_pending(uint32_t after_ticket = 0);
+
+    /**
+     * @brief 等待时间统计
+     */
+    const StageTiming& get_wait_timing() const { return wait_timing_; }
+
+    /**
+     * @brief 最大等待时间（微秒）
+     */
+    uint32_t get_max_wait_us() const { return max_wait_us_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 执行耗时统计
+     */
+    const StageTiming& get_run_timing() const { return run_timing_; }
+
+    /**
+     * @brief 队列已满被拒绝的命令数
+     */
+    uint32_t get_rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 事件队列已满丢弃的事件数
+     */
+    uint32_t get_events_dropped() const { return events_dropped_.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,87 @@
+/**
+ * @file command_index.h
+ * @brief 编译期命令索引
+ *
+ * 命令表是 constexpr 数组，表项至少包含 int id 字段。CommandIndex 在编译期
+ * 按 [最小ID, 最大ID] 建一张稠密的下标表，查找只做一次减法、一次比较和一次
+ * 数组访问，与命令数量无关。ID 重复在编译期由 command_ids_unique() 检查。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 命令表中的最小ID
+ */
+template <typename Entry, size_t N>
+constexpr int command_min_id(const Entry (&table)[N]) {
+    int min = table[0].id;
+    for (size_t i = 1; i < N; i++) {
+        min = (table[i].id < min) ? table[i].id : min;
+    }
+    return min;
+}
+
+/**
+ * @brief 命令表中的最大ID
+ */
+template <typename Entry, size_t N>
+constexpr int command_max_id(const Entry (&table)[N]) {
+    int max = table[0].id;
+    for (size_t i = 1; i < N; i++) {
+        max = (table[i].id > max) ? table[i].id : max;
+    }
+    return max;
+}
+
+/**
+ * @brief 检查命令ID是否两两不同（编译期使用）
+ */
+template <typename Entry, size_t N>
+constexpr bool command_ids_unique(const Entry (&table)[N]) {
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = i + 1; j < N; j++) {
+            if (table[i].id == table[j].id) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 命令ID到表下标的稠密索引
+ *
+ * @tparam MinId 命令表中的最小ID
+ * @tparam MaxId 命令表中的最大ID
+ * @tparam N 命令数量
+ */
+template <int MinId, int MaxId, size_t N>
+class CommandIndex {
+public:
+    static_assert(MinId >= 0 && MinId <= MaxId, "命令ID范围无效");
+    static_assert(N < UINT16_MAX, "命令数量过多");
+
+    static constexpr size_t SPAN = static_cast<size_t>(MaxId - MinId) + 1;
+
+    template <typename Entry>
+    constexpr explicit CommandIndex(const Entry (&table)[N]) : slots_{} {
+        for (size_t i = 0; i < N; i++) {
+            slots_[table[i].id - MinId] = static_cast<uint16_t>(i + 1);
+        }
+    }
+
+    /**
+     * @brief 按命令ID查找表下标
+     * @return int 表下标，ID不在表中返回-1
+     */
+    constexpr int find(int id) const {
+        size_t offset = static_cast<size_t>(static_cast<unsigned>(id - MinId));
+        return (offset < SPAN) ? static_cast<int>(slots_[offset]) - 1 : -1;
+    }
+
+private:
+    uint16_t slots_[SPAN];  // 0 表示空，否则为表下标+1
+};
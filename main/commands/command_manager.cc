@@ -4,79 +4,264 @@
  */
 
 #include "command_manager.h"
-#include "light_on_command.h"
-#include "light_off_command.h"
-#include "bye_bye_command.h"
+#include "command_action.h"
+#include "system/dlog.h"
 
-static const char *TAG = "命令管理器";
+#include <cstring>
+#include <new>
 
-// 静态成员初始化
-CommandManager* CommandManager::instance_ = nullptr;
+extern "C" {
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+}
+
+static const char *TAG = "命令管理器";
 
 CommandManager::CommandManager() {
-    // 私有构造函数
+    reload_lock_ = xSemaphoreCreateMutex();
 }
 
 CommandManager* CommandManager::get_instance() {
-    if (instance_ == nullptr) {
-        instance_ = new CommandManager();
+    // 局部静态变量的初始化由编译器加锁保护，识别任务和执行任务同时首次调用也只创建一个实例
+    static CommandManager *instance = new CommandManager();
+    return instance;
+}
+
+/**
+ * @brief 等待命令表读者退出时让出CPU（读临界区很短，读者优先级都更高）
+ */
+static void rcu_wait(void) {
+    vTaskDelay(1);
+}
+
+esp_err_t CommandManager::initialize(const char *partition_label) {
+    if (load_manifest(partition_label) != ESP_OK) {
+        DLOGW(TAG, "命令清单不可用，使用内置命令表");
     }
-    return instance_;
+
+    // 命令清单的 GPIO 已在 load_manifest() 中配置
+    if (!command_table_from_manifest()) {
+        esp_err_t ret = command_action_init_gpio();
+        if (ret != ESP_OK) {
+            DLOGE(TAG, "命令GPIO配置失败: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+
+    // 默认命令词即命令表，拼音在读临界区内复制到词表
+    size_t ignored;
+    {
+        CommandTableReadGuard guard;
+        ignored = target_.assign(command_table_size(), [](size_t i) {
+            command_entry_t entry = {};
+            command_table_at(i, &entry);
+            return vocabulary_phrase_t{entry.id, entry.pinyin};
+        });
+    }
+    if (ignored > 0) {
+        DLOGW(TAG, "命令表中有 %zu 个拼音为空或重复，已忽略", ignored);
+    }
+
+    DLOGI(TAG, "✓ 命令管理器初始化完成，命令表共 %zu 个命令（%s）", command_table_size(),
+          command_table_from_manifest() ? "命令清单" : "内置");
+    return ESP_OK;
 }
 
-void CommandManager::initialize() {
-    ESP_LOGI(TAG, "正在初始化命令管理器...");
-    
-    // 注册所有命令
-    register_command(std::make_unique<LightOnCommand>());
-    register_command(std::make_unique<LightOffCommand>());
-    register_command(std::make_unique<ByeByeCommand>());
-    
-    ESP_LOGI(TAG, "✓ 命令管理器初始化完成，共注册 %zu 个命令", commands_.size());
+esp_err_t CommandManager::load_manifest(const char *partition_label) {
+    const esp_partition_t *partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                                ESP_PARTITION_SUBTYPE_ANY, partition_label);
+    if (partition == nullptr) {
+        DLOGW(TAG, "未找到命令清单分区 '%s'", partition_label);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const void *base = nullptr;
+    esp_err_t ret = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                                       &base, &mmap_handle_);
+    if (ret != ESP_OK) {
+        DLOGE(TAG, "映射命令清单分区失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (!manifest_.parse(static_cast<const uint8_t *>(base), partition->size)) {
+        DLOGE(TAG, "命令清单内容无效，请执行 'idf.py flash' 烧录命令清单");
+        esp_partition_munmap(mmap_handle_);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    // 与 reload_commands() 相同：GPIO 无效的清单不发布，继续使用内置命令表
+    ret = command_action_init_gpio(&manifest_);
+    if (ret != ESP_OK) {
+        DLOGE(TAG, "命令清单的GPIO无效: %s", esp_err_to_name(ret));
+        esp_partition_munmap(mmap_handle_);
+        return ret;
+    }
+    command_table_publish(&manifest_);    // 初始化时还没有读者，不用等待宽限期
+
+    DLOGI(TAG, "✓ 命令清单已加载: %zu 个命令, %zu 字节", manifest_.count(), manifest_.total_size());
+    return ESP_OK;
 }
 
-esp_err_t CommandManager::configure_commands(esp_mn_iface_t *multinet, model_iface_data_t *mn_model_data) {
-    ESP_LOGI(TAG, "开始配置自定义命令词...");
+esp_err_t CommandManager::reload_commands(const uint8_t *data, size_t size) {
+    if (data == nullptr || size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 新快照自带数据，不依赖调用者的缓冲区
+    uint8_t *copy = static_cast<uint8_t *>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM));
+    CommandManifest *next = new (std::nothrow) CommandManifest();
+    if (copy == nullptr || next == nullptr) {
+        DLOGE(TAG, "替换命令表失败: 内存不足（%zu 字节）", size);
+        heap_caps_free(copy);
+        delete next;
+        return ESP_ERR_NO_MEM;
+    }
+    memcpy(copy, data, size);
 
-    // 首先尝试从sdkconfig加载默认命令词配置
-    esp_mn_commands_update_from_sdkconfig(multinet, mn_model_data);
+    esp_err_t ret = next->parse(copy, size) ? command_action_init_gpio(next) : ESP_ERR_INVALID_ARG;
+    if (ret != ESP_OK) {
+        DLOGE(TAG, "替换命令表失败: 命令清单或GPIO无效（%s）", esp_err_to_name(ret));
+        heap_caps_free(copy);
+        delete next;
+        return ret;
+    }
+
+    size_t count = next->count();   // 释放锁后 next 可能被下一次替换回收
+    xSemaphoreTake(reload_lock_, portMAX_DELAY);
+    int64_t start_us = esp_timer_get_time();
+    const CommandManifest *old = command_table_publish(next);
+    uint32_t waits = command_table_synchronize(rcu_wait);
+    dlog_sync();    // 读临界区内提交的延迟日志可能引用旧表中的字符串
+    int64_t grace_us = esp_timer_get_time() - start_us;
+    retire_manifest(old);
+    xSemaphoreGive(reload_lock_);
+
+    DLOGI(TAG, "✓ 命令表已替换: %zu 个命令, %zu 字节, 宽限期 %lld us（等待 %lu 次）",
+          count, size, (long long)grace_us, (unsigned long)waits);
+    return ESP_OK;
+}
 
-    // 清除现有命令词，重新开始
-    esp_mn_commands_clear();
+void CommandManager::retire_manifest(const CommandManifest *manifest) {
+    if (manifest == nullptr || manifest == &manifest_) {
+        return;
+    }
+    heap_caps_free(const_cast<uint8_t *>(manifest->data()));
+    delete manifest;
+}
 
-    // 分配命令词管理结构
+esp_err_t CommandManager::configure_commands(esp_mn_iface_t *multinet, model_iface_data_t *mn_model_data) {
+    DLOGI(TAG, "开始配置自定义命令词...");
+
+    // 新模型从空命令词表开始（不再先加载 sdkconfig 中的默认命令词再清空）
     esp_err_t ret = esp_mn_commands_alloc(multinet, mn_model_data);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "命令词管理结构分配失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "命令词管理结构分配失败: %s", esp_err_to_name(ret));
         return ESP_FAIL;
     }
+    multinet_ = multinet;
+    mn_model_data_ = mn_model_data;
+    active_.clear();
 
-    // 添加所有注册的命令词
-    int success_count = 0;
-    int fail_count = 0;
+    ret = apply_vocabulary();
 
-    for (const auto& command : commands_) {
-        command_config_t config = command->get_config();
-        
-        ESP_LOGI(TAG, "添加命令词 [%d]: %s (%s)",
-                 config.command_id, config.description, config.pinyin);
+    // 打印激活的命令词
+    ESP_LOGI(TAG, "当前激活的命令词列表:"); // 与模型直接打印的列表保持顺序
+    multinet->print_active_speech_commands(mn_model_data);
+
+    // 打印支持的命令列表
+    print_supported_commands();
+
+    return ret;
+}
+
+esp_err_t CommandManager::update_commands(const Vocabulary &vocabulary) {
+    command_entry_t entry;
+    for (size_t i = 0; i < vocabulary.size(); i++) {
+        vocabulary_phrase_t item = vocabulary.at(i);
+        if (!command_table_find(item.id, &entry)) {
+            // 命令词字符串属于调用者的词表，直接输出
+            ESP_LOGE(TAG, "命令词 '%s' 的命令ID %d 不在命令表中", item.phrase, item.id);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    target_ = vocabulary;
+    if (multinet_ == nullptr) {
+        DLOGI(TAG, "命令词模型未加载，%zu 个命令词将在加载时生效", target_.size());
+        return ESP_OK;
+    }
+    return apply_vocabulary();
+}
+
+void CommandManager::detach_commands() {
+    if (multinet_ == nullptr) {
+        return;
+    }
+    esp_mn_commands_free();
+    multinet_ = nullptr;
+    mn_model_data_ = nullptr;
+    active_.clear();
+}
+
+esp_err_t CommandManager::apply_vocabulary() {
+    std::vector<vocabulary_op_t> ops;
+    active_.diff(target_, &ops);
+    if (ops.empty()) {
+        DLOGI(TAG, "命令词无变化");
+        return ESP_OK;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    int counts[3] = {0, 0, 0};  // 按 vocabulary_op_type_t 计数
+
+    // 命令词字符串属于 active_ 和 target_，随词表更新失效，日志直接输出
+    std::vector<size_t> failed;
+    for (size_t i = 0; i < ops.size(); i++) {
+        const vocabulary_op_t &op = ops[i];
+        esp_err_t ret;
+        switch (op.type) {
+        case VOCABULARY_OP_REMOVE:
+            ESP_LOGD(TAG, "删除命令词 [%d]: %s", op.id, op.old_phrase);
+            ret = esp_mn_commands_remove(op.old_phrase);
+            break;
+        case VOCABULARY_OP_MODIFY:
+            ESP_LOGD(TAG, "修改命令词 [%d]: %s -> %s", op.id, op.old_phrase, op.phrase);
+            ret = esp_mn_commands_modify(op.old_phrase, op.phrase);
+            break;
+        default:
+            ESP_LOGD(TAG, "添加命令词 [%d]: %s", op.id, op.phrase);
+            ret = esp_mn_commands_add(op.id, op.phrase);
+            break;
+        }
 
-        // 添加命令词
-        esp_err_t ret_cmd = esp_mn_commands_add(config.command_id, config.pinyin);
-        if (ret_cmd == ESP_OK) {
-            success_count++;
-            ESP_LOGI(TAG, "✓ 命令词 [%d] 添加成功", config.command_id);
+        if (ret == ESP_OK) {
+            counts[op.type]++;
         } else {
-            fail_count++;
-            ESP_LOGE(TAG, "✗ 命令词 [%d] 添加失败: %s",
-                     config.command_id, esp_err_to_name(ret_cmd));
+            failed.push_back(i);
+            ESP_LOGE(TAG, "✗ 命令词 [%d] %s 提交失败: %s", op.id,
+                     (op.type == VOCABULARY_OP_REMOVE) ? op.old_phrase : op.phrase, esp_err_to_name(ret));
         }
     }
 
+    // 操作中的字符串指向 active_ 和 target_，全部提交后再更新 active_：
+    // 从目标表出发，按相反顺序撤销失败的操作，得到 esp_mn 命令词表的实际内容
+    Vocabulary next = target_;
+    for (auto it = failed.rbegin(); it != failed.rend(); ++it) {
+        const vocabulary_op_t &op = ops[*it];
+        if (op.type != VOCABULARY_OP_REMOVE) {
+            next.remove(op.phrase);
+        }
+        if (op.type != VOCABULARY_OP_ADD) {
+            next.add(active_.find(op.old_phrase), op.old_phrase);
+        }
+    }
+    active_ = std::move(next);
+    int fail_count = static_cast<int>(failed.size());
+
     // 更新命令词到模型
-    ESP_LOGI(TAG, "更新命令词到模型...");
     esp_mn_error_t *error_phrases = esp_mn_commands_update();
     if (error_phrases != NULL && error_phrases->num > 0) {
+        // 失败的命令词字符串属于模型内部缓冲区，直接输出
         ESP_LOGW(TAG, "有 %d 个命令词更新失败:", error_phrases->num);
         for (int i = 0; i < error_phrases->num; i++) {
             ESP_LOGW(TAG, "  失败命令 %d: %s",
@@ -85,68 +270,41 @@ esp_err_t CommandManager::configure_commands(esp_mn_iface_t *multinet, model_ifa
         }
     }
 
-    // 打印配置结果
-    ESP_LOGI(TAG, "命令词配置完成: 成功 %d 个, 失败 %d 个", success_count, fail_count);
-
-    // 打印激活的命令词
-    ESP_LOGI(TAG, "当前激活的命令词列表:");
-    multinet->print_active_speech_commands(mn_model_data);
-
-    // 打印支持的命令列表
-    print_supported_commands();
+    DLOGI(TAG, "命令词更新完成: 删除 %d 个, 修改 %d 个, 新增 %d 个, 失败 %d 个, 共 %zu 个, 耗时 %lld ms",
+          counts[VOCABULARY_OP_REMOVE], counts[VOCABULARY_OP_MODIFY], counts[VOCABULARY_OP_ADD],
+          fail_count, active_.size(), (long long)((esp_timer_get_time() - start_us) / 1000));
 
     return (fail_count == 0) ? ESP_OK : ESP_FAIL;
 }
 
 command_result_t CommandManager::execute_command(int command_id) {
-    CommandBase* command = find_command(command_id);
-    if (command == nullptr) {
-        ESP_LOGW(TAG, "⚠️  未知命令ID: %d", command_id);
+    CommandTableReadGuard guard;    // 执行期间表项中的描述和提示音名称有效
+    command_entry_t entry;
+    if (!command_table_find(command_id, &entry)) {
+        DLOGW(TAG, "⚠️  未知命令ID: %d", command_id);
         return COMMAND_RESULT_NOT_FOUND;
     }
 
-    // 特殊处理拜拜命令
-    if (command_id == 314) { // ByeByeCommand::COMMAND_ID
-        esp_err_t result = command->execute();
-        return (result == ESP_OK) ? COMMAND_RESULT_EXIT_REQUESTED : COMMAND_RESULT_EXECUTE_FAILED;
+    if (command_action_execute(&entry) != ESP_OK) {
+        return COMMAND_RESULT_EXECUTE_FAILED;
     }
-
-    // 执行其他命令
-    esp_err_t result = command->execute();
-    return (result == ESP_OK) ? COMMAND_RESULT_SUCCESS : COMMAND_RESULT_EXECUTE_FAILED;
+    return (entry.flow == COMMAND_FLOW_EXIT) ? COMMAND_RESULT_EXIT_REQUESTED : COMMAND_RESULT_SUCCESS;
 }
 
 const char* CommandManager::get_command_description(int command_id) {
-    CommandBase* command = find_command(command_id);
-    if (command != nullptr) {
-        return command->get_description();
-    }
-    return "未知命令";
+    command_entry_t entry;
+    return command_table_find(command_id, &entry) ? entry.description : "未知命令";
 }
 
 size_t CommandManager::get_command_count() const {
-    return commands_.size();
+    return command_table_size();
 }
 
 void CommandManager::print_supported_commands() const {
-    ESP_LOGI(TAG, "支持的语音命令:");
-    for (const auto& command : commands_) {
-        command_config_t config = command->get_config();
-        ESP_LOGI(TAG, "  ID=%d: '%s'", config.command_id, config.description);
-    }
-}
-
-void CommandManager::register_command(std::unique_ptr<CommandBase> command) {
-    if (command != nullptr) {
-        commands_.push_back(std::move(command));
-    }
-}
-
-CommandBase* CommandManager::find_command(int command_id) {
-    for (const auto& command : commands_) {
-        if (command->get_command_id() == command_id) {
-            return command.get();
-        }
+    DLOGI(TAG, "支持的语音命令:");
+    CommandTableReadGuard guard;
+    command_entry_t entry;
+    for (size_t i = 0; command_table_at(i, &entry); i++) {
+        DLOGI(TAG, "  ID=%d: '%s'", entry.id, entry.description);
     }
-    return nullptr;
 }
@@ -2,21 +2,26 @@
  * @file command_manager.h
  * @brief 命令管理器类定义
  * 
- * 负责管理所有语音命令，包括注册、查找和执行命令
+ * 负责加载命令表（command_table.h），把命令词配置到语音识别模型，并按命令ID执行命令。
+ * 命令词可以在运行时增删改，只把与模型当前命令词表的差异提交给 MultiNet。
+ * 命令表本身也可以在运行时整体替换，查询和执行命令不加锁（RCU，见 command_table.h）。
  */
 
 #pragma once
 
-#include "command_base.h"
-#include <vector>
-#include <memory>
+#include "command_manifest.h"
+#include "command_table.h"
+#include "vocabulary.h"
 
 extern "C" {
 #include "esp_err.h"
+#include "esp_partition.h"
 #include "esp_mn_iface.h"
 #include "esp_mn_models.h"
 #include "esp_mn_speech_commands.h"
 #include "esp_process_sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 }
 
 /**
@@ -36,17 +41,34 @@ typedef enum {
  */
 class CommandManager {
 private:
-    std::vector<std::unique_ptr<CommandBase>> commands_;
-    static CommandManager* instance_;
+    CommandManifest manifest_;                      // 命令清单，表项字符串指向映射后的分区
+    esp_partition_mmap_handle_t mmap_handle_ = 0;
+    SemaphoreHandle_t reload_lock_ = nullptr;       // 串行替换命令表的写者
+
+    esp_mn_iface_t *multinet_ = nullptr;            // 已配置的命令词模型，未加载时为nullptr
+    model_iface_data_t *mn_model_data_ = nullptr;
+    Vocabulary active_;                             // 模型中当前的命令词（与 esp_mn 命令词表一致）
+    Vocabulary target_;                             // 期望的命令词，模型重新加载后据此恢复
 
     /**
      * @brief 私有构造函数（单例模式）
      */
     CommandManager();
 
+    /**
+     * @brief 把 target_ 与 active_ 的差异提交到模型
+     * @return esp_err_t 全部操作成功返回ESP_OK
+     */
+    esp_err_t apply_vocabulary();
+
+    /**
+     * @brief 释放宽限期已结束的命令表快照（映射的分区和内置命令表不释放）
+     */
+    void retire_manifest(const CommandManifest *manifest);
+
 public:
     /**
-     * @brief 获取单例实例
+     * @brief 获取单例实例（首次调用时创建，多个任务同时调用也只创建一次）
      * @return CommandManager* 单例实例指针
      */
     static CommandManager* get_instance();
@@ -58,18 +80,64 @@ public:
 
     /**
      * @brief 初始化命令管理器
-     * 注册所有可用的命令
+     *
+     * 映射命令清单分区并加载命令表，分区缺失或内容无效时使用内置命令表；
+     * 然后把命令用到的 GPIO 配置为输出。
+     *
+     * @param partition_label 命令清单分区名称
+     * @return esp_err_t 初始化结果，只有 GPIO 配置失败时返回错误
      */
-    void initialize();
+    esp_err_t initialize(const char *partition_label);
 
     /**
-     * @brief 配置命令词到语音识别模型
+     * @brief 映射命令清单分区并加载到命令表（只在初始化时调用）
+     * @return esp_err_t 加载结果，失败时命令表不变
+     */
+    esp_err_t load_manifest(const char *partition_label);
+
+    /**
+     * @brief 运行时替换命令表
+     *
+     * 把命令清单（格式见 tools/command_pack.py）复制到PSRAM并解析，配置其中的
+     * GPIO 后发布为新的命令表，等待宽限期结束和此前的延迟日志输出完后释放旧表。
+     * 正在查询或执行命令的任务不受阻塞，之后的查询立即使用新表。
+     * 会阻塞数个tick，不能在识别任务、执行任务和命令表读临界区中调用；
+     * 模型中的命令词不随之改变，需要时在识别任务中调用 update_commands()。
+     *
+     * @param data 命令清单数据，返回后可以释放
+     * @param size 数据字节数
+     * @return esp_err_t ESP_OK 成功；ESP_ERR_INVALID_ARG 清单无效或含无效GPIO；ESP_ERR_NO_MEM 内存不足；其他为GPIO配置错误
+     */
+    esp_err_t reload_commands(const uint8_t *data, size_t size);
+
+    /**
+     * @brief 配置命令词到新加载的语音识别模型
+     *
+     * 模型从空命令词表开始，一次性添加期望的命令词（默认即命令表）。
+     *
      * @param multinet 命令词识别接口指针
      * @param mn_model_data 命令词模型数据指针
      * @return esp_err_t 配置结果
      */
     esp_err_t configure_commands(esp_mn_iface_t *multinet, model_iface_data_t *mn_model_data);
 
+    /**
+     * @brief 运行时更新命令词
+     *
+     * 只提交新增、删除和修改的命令词，不重新创建模型。必须在识别任务中、
+     * 两次识别之间调用（MultiNet 不能同时识别和更新）。模型未加载时只记录
+     * 期望的命令词，下次加载时生效。
+     *
+     * @param vocabulary 期望的完整命令词表，命令ID必须在命令表中
+     * @return esp_err_t ESP_OK 成功；ESP_ERR_INVALID_ARG 含未知命令ID；ESP_FAIL 部分命令词提交失败
+     */
+    esp_err_t update_commands(const Vocabulary &vocabulary);
+
+    /**
+     * @brief 模型即将释放，丢弃命令词表与模型的关联
+     */
+    void detach_commands();
+
     /**
      * @brief 根据命令ID执行命令
      * @param command_id 命令ID
@@ -80,7 +148,7 @@ public:
     /**
      * @brief 根据命令ID获取命令描述
      * @param command_id 命令ID
-     * @return const char* 命令描述，如果未找到返回"未知命令"
+     * @return const char* 命令描述，在调用者的 CommandTableReadGuard 内有效；如果未找到返回"未知命令"
      */
     const char* get_command_description(int command_id);
 
@@ -94,18 +162,4 @@ public:
      * @brief 打印所有支持的命令
      */
     void print_supported_commands() const;
-
-private:
-    /**
-     * @brief 注册一个命令
-     * @param command 命令对象的智能指针
-     */
-    void register_command(std::unique_ptr<CommandBase> command);
-
-    /**
-     * @brief 根据命令ID查找命令
-     * @param command_id 命令ID
-     * @return CommandBase* 命令对象指针，如果未找到返回nullptr
-     */
-    CommandBase* find_command(int command_id);
 };
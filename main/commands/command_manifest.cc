@@ -0,0 +1,116 @@
+/**
+ * @file command_manifest.cc
+ * @brief 命令清单解析实现
+ */
+
+#include "command_manifest.h"
+#include <cstring>
+
+// 与 tools/command_pack.py 保持一致
+static const uint8_t MAGIC[4] = {'Z', 'C', 'M', 'D'};
+static const size_t HEADER_SIZE = 16;
+static const size_t ENTRY_SIZE = 24;
+static const uint8_t MAX_PERCENT = 100;   // 置信度门限（百分比）上限
+static const uint32_t NO_PROMPT = 0;        // 提示音偏移为 0 表示不播放
+
+static inline uint16_t read_u16(const uint8_t *p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t read_u32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+bool CommandManifest::valid_string(const uint8_t *base, size_t strings, size_t total, size_t offset) const {
+    if (offset < strings || offset >= total) {
+        return false;
+    }
+    const void *end = memchr(base + offset, '\0', total - offset);
+    return end != nullptr && end != base + offset;
+}
+
+bool CommandManifest::parse(const uint8_t *base, size_t size) {
+    base_ = nullptr;
+    count_ = 0;
+    total_size_ = 0;
+
+    if (base == nullptr || size < HEADER_SIZE || memcmp(base, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    if (read_u16(base + 4) != VERSION) {
+        return false;
+    }
+
+    size_t count = read_u16(base + 6);
+    size_t total = read_u32(base + 8);
+    size_t strings = HEADER_SIZE + ENTRY_SIZE * count;
+    if (total > size || strings > total) {
+        return false;
+    }
+
+    // 逐项检查，之后的 at() 无需再做检查
+    int last_id = -1;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *e = base + HEADER_SIZE + ENTRY_SIZE * i;
+        int id = read_u16(e);
+        if (id <= last_id || e[2] >= COMMAND_ACTION_COUNT || e[3] > COMMAND_FLOW_EXIT ||
+            e[7] > MAX_PERCENT || e[8] > MAX_PERCENT) {
+            return false;
+        }
+        uint32_t prompt = read_u32(e + 20);
+        if (!valid_string(base, strings, total, read_u32(e + 12)) ||
+            !valid_string(base, strings, total, read_u32(e + 16)) ||
+            (prompt != NO_PROMPT && !valid_string(base, strings, total, prompt))) {
+            return false;
+        }
+        last_id = id;
+    }
+
+    base_ = base;
+    count_ = count;
+    total_size_ = total;
+    return true;
+}
+
+bool CommandManifest::at(size_t index, command_entry_t *entry) const {
+    if (base_ == nullptr || index >= count_) {
+        return false;
+    }
+
+    const uint8_t *e = base_ + HEADER_SIZE + ENTRY_SIZE * index;
+    uint32_t prompt = read_u32(e + 20);
+    *entry = {
+        .id = read_u16(e),
+        .pinyin = reinterpret_cast<const char *>(base_ + read_u32(e + 12)),
+        .description = reinterpret_cast<const char *>(base_ + read_u32(e + 16)),
+        .action = static_cast<command_action_t>(e[2]),
+        .gpio = e[5],
+        .level = e[6],
+        .prompt = (prompt == NO_PROMPT) ? nullptr : reinterpret_cast<const char *>(base_ + prompt),
+        .flow = static_cast<command_flow_t>(e[3]),
+        .priority = e[4],
+        .min_confidence = e[7],
+        .min_margin = e[8]
+    };
+    return true;
+}
+
+bool CommandManifest::find(int id, command_entry_t *entry) const {
+    // 命令按ID升序排列（parse 时已检查），记录定长，直接二分
+    size_t lo = 0;
+    size_t hi = count_;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int mid_id = read_u16(base_ + HEADER_SIZE + ENTRY_SIZE * mid);
+        if (mid_id == id) {
+            return at(mid, entry);
+        }
+        if (mid_id < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
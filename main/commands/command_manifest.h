@@ -0,0 +1,78 @@
+/**
+ * @file command_manifest.h
+ * @brief 命令清单解析
+ *
+ * 命令清单由 tools/command_pack.py 从 main/assets/commands.json 生成并烧录到
+ * commands 数据分区，格式见该脚本的说明。解析只做边界和取值检查，不复制
+ * 数据也不分配内存，表项中的字符串直接指向清单数据。
+ * 本模块只依赖 C++ 标准库，可在 Linux 主机上解析打包结果。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "command_table.h"
+
+/**
+ * @brief 命令清单解析器
+ */
+class CommandManifest {
+public:
+    static const uint16_t VERSION = 2;      // 支持的格式版本
+
+    CommandManifest() = default;
+
+    /**
+     * @brief 解析命令清单
+     *
+     * 检查通过的条件：头部和版本正确，命令ID严格递增，动作和流程取值有效，
+     * 置信度门限不超过100，所有字符串都非空、以 '\0' 结尾且位于字符串区内。
+     *
+     * @param base 清单数据起始地址（映射后的分区）
+     * @param size 可访问的字节数
+     * @return bool 清单有效返回true
+     */
+    bool parse(const uint8_t *base, size_t size);
+
+    /**
+     * @brief 命令数量
+     */
+    size_t count() const { return count_; }
+
+    /**
+     * @brief 按索引取命令（按ID升序）
+     * @param index 索引
+     * @param entry 输出表项，字符串指向清单数据
+     * @return bool 索引有效返回true
+     */
+    bool at(size_t index, command_entry_t *entry) const;
+
+    /**
+     * @brief 按命令ID查找命令（二分查找）
+     * @param id 命令ID
+     * @param entry 输出表项，字符串指向清单数据
+     * @return bool 找到返回true
+     */
+    bool find(int id, command_entry_t *entry) const;
+
+    /**
+     * @brief 清单的总字节数
+     */
+    size_t total_size() const { return total_size_; }
+
+    /**
+     * @brief 清单数据起始地址，未解析时为nullptr
+     */
+    const uint8_t* data() const { return base_; }
+
+private:
+    const uint8_t *base_ = nullptr;
+    size_t count_ = 0;
+    size_t total_size_ = 0;
+
+    /**
+     * @brief 检查字符串偏移：位于 [strings, total) 内、非空且以 '\0' 结尾
+     */
+    bool valid_string(const uint8_t *base, size_t strings, size_t total, size_t offset) const;
+};
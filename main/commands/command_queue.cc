@@ -0,0 +1,56 @@
+/**
+ * @file command_queue.cc
+ * @brief 待执行命令队列实现
+ */
+
+#include "command_queue.h"
+
+bool CommandQueue::push(const command_job_t &job) {
+    if (count_ >= CAPACITY) {
+        return false;
+    }
+    jobs_[count_++] = job;
+    return true;
+}
+
+bool CommandQueue::pop(command_job_t *out) {
+    if (count_ == 0) {
+        return false;
+    }
+
+    // 队列很短，直接线性查找；提交序号允许回绕，按差值比较先后
+    size_t best = 0;
+    for (size_t i = 1; i < count_; i++) {
+        const command_job_t &job = jobs_[i];
+        const command_job_t &cur = jobs_[best];
+        if (job.priority > cur.priority ||
+            (job.priority == cur.priority && static_cast<int32_t>(job.ticket - cur.ticket) < 0)) {
+            best = i;
+        }
+    }
+
+    *out = jobs_[best];
+    for (size_t i = best + 1; i < count_; i++) {
+        jobs_[i - 1] = jobs_[i];
+    }
+    count_--;
+    return true;
+}
+
+size_t CommandQueue::clear() {
+    size_t dropped = count_;
+    count_ = 0;
+    return dropped;
+}
+
+size_t CommandQueue::clear_after(uint32_t ticket) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count_; i++) {
+        if (static_cast<int32_t>(jobs_[i].ticket - ticket) <= 0) {
+            jobs_[kept++] = jobs_[i];
+        }
+    }
+    size_t dropped = count_ - kept;
+    count_ = kept;
+    return dropped;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file command_queue.h
+ * @brief 待执行命令队列
+ *
+ * 有界队列，按优先级出队，同优先级按提交顺序。只保存命令ID和提交时间，
+ * 不执行命令；跨任务使用时由调用者加锁（见 command_executor.h）。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 待执行命令
+ */
+typedef struct {
+    uint32_t ticket;        // 提交序号（从1开始递增，0 表示无效）
+    int command_id;         // 命令ID
+    uint8_t priority;       // 优先级，数值越大越先执行
+    int64_t submitted_us;   // 提交时间（微秒）
+} command_job_t;
+
+/**
+ * @brief 待执行命令队列
+ */
+class CommandQueue {
+public:
+    static const size_t CAPACITY = 8;   // 最多排队的命令数
+
+    CommandQueue() = default;
+
+    /**
+     * @brief 加入一条命令
+     * @return bool 队列已满返回false
+     */
+    bool push(const command_job_t &job);
+
+    /**
+     * @brief 取出优先级最高、其中最早提交的命令
+     * @return bool 队列为空返回false
+     */
+    bool pop(command_job_t *out);
+
+    /**
+     * @brief 排队中的命令数
+     */
+    size_t size() const { return count_; }
+
+    /**
+     * @brief 丢弃所有排队的命令
+     * @return size_t 丢弃的命令数
+     */
+    size_t clear();
+
+    /**
+     * @brief 丢弃在 ticket 之后提交的命令，之前提交的保留（按提交序号比较，允许回绕）
+     * @param ticket 提交序号
+     * @return size_t 丢弃的命令数
+     */
+    size_t clear_after(uint32_t ticket);
+
+private:
+    command_job_t jobs_[CAPACITY] = {};
+    size_t count_ = 0;
+};
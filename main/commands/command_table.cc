@@ -0,0 +1,86 @@
+/**
+ * @file command_table.cc
+ * @brief 命令表实现
+ */
+
+#include "command_table.h"
+#include "command_index.h"
+#include "command_manifest.h"
+#include "system/rcu.h"
+#include <atomic>
+
+static const uint8_t LED_GPIO = 21; // 外接LED，与 main.cc 中的初始化一致
+
+// 内置命令表，命令清单不可用时使用
+// 结束交互的命令优先执行，排在它之前提交的动作随后照常执行，之后提交的被取消
+// 开关灯互为易混的候选，驱动 GPIO 的命令要求更高的置信度和领先幅度
+static constexpr command_entry_t COMMAND_TABLE[] = {
+    {309, "bang wo kai deng", "帮我开灯", COMMAND_ACTION_GPIO, LED_GPIO, 1, "light_on", COMMAND_FLOW_CONTINUE, 1, 35, 10},
+    {308, "bang wo guan deng", "帮我关灯", COMMAND_ACTION_GPIO, LED_GPIO, 0, "light_off", COMMAND_FLOW_CONTINUE, 1, 35, 10},
+    {314, "bai bai", "拜拜", COMMAND_ACTION_NONE, 0, 0, "byebye", COMMAND_FLOW_EXIT, 2, 25, 5},
+};
+
+static constexpr size_t COMMAND_COUNT = sizeof(COMMAND_TABLE) / sizeof(COMMAND_TABLE[0]);
+
+static_assert(command_ids_unique(COMMAND_TABLE), "命令表中有重复的命令ID");
+
+static constexpr CommandIndex<command_min_id(COMMAND_TABLE), command_max_id(COMMAND_TABLE), COMMAND_COUNT>
+    COMMAND_INDEX(COMMAND_TABLE);
+
+// 当前命令表快照（命令清单），为nullptr时使用内置命令表
+static std::atomic<const CommandManifest *> manifest{nullptr};
+static RcuDomain rcu;
+
+CommandTableReadGuard::CommandTableReadGuard() : phase_(rcu.read_lock()) {
+}
+
+CommandTableReadGuard::~CommandTableReadGuard() {
+    rcu.read_unlock(phase_);
+}
+
+const CommandManifest* command_table_publish(const CommandManifest *next) {
+    return manifest.exchange(next, std::memory_order_seq_cst);
+}
+
+uint32_t command_table_synchronize(void (*wait)(void)) {
+    return rcu.synchronize(wait);
+}
+
+bool command_table_from_manifest(void) {
+    return manifest.load(std::memory_order_acquire) != nullptr;
+}
+
+// 以下查询各自进入读临界区，同一次查询只看到一个快照
+bool command_table_find(int id, command_entry_t *entry) {
+    CommandTableReadGuard guard;
+    const CommandManifest *current = manifest.load(std::memory_order_seq_cst);
+    if (current != nullptr) {
+        return current->find(id, entry);
+    }
+
+    int index = COMMAND_INDEX.find(id);
+    if (index < 0) {
+        return false;
+    }
+    *entry = COMMAND_TABLE[index];
+    return true;
+}
+
+size_t command_table_size(void) {
+    CommandTableReadGuard guard;
+    const CommandManifest *current = manifest.load(std::memory_order_seq_cst);
+    return (current != nullptr) ? current->count() : COMMAND_COUNT;
+}
+
+bool command_table_at(size_t index, command_entry_t *entry) {
+    CommandTableReadGuard guard;
+    const CommandManifest *current = manifest.load(std::memory_order_seq_cst);
+    if (current != nullptr) {
+        return current->at(index, entry);
+    }
+    if (index >= COMMAND_COUNT) {
+        return false;
+    }
+    *entry = COMMAND_TABLE[index];
+    return true;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file command_table.h
+ * @brief 命令表
+ *
+ * 命令由数据描述（ID、拼音、描述、动作及参数、确认提示音、执行后的流程、
+ * 执行优先级和识别置信度门限），不再为每条命令单独写处理函数。启动时从 commands 数据分区
+ * 加载命令清单（tools/command_pack.py 生成，见 command_manifest.h）；分区缺失
+ * 或内容无效时使用 command_table.cc 中编译期生成的内置命令表。
+ * 清单不复制到内存：命令记录和字符串区是映射后分区中的一块连续数据，
+ * 查询时按需取出表项，命令数多时也不占用内部RAM。
+ *
+ * 运行时可以整体替换命令表（RCU，见 system/rcu.h）：当前命令表是一个不可变
+ * 快照，通过原子指针发布。读者（识别任务、执行任务）不加锁，写者发布新快照后
+ * 等待宽限期结束再释放旧快照。表项中的字符串只在读临界区内有效，需要在查询
+ * 之后继续使用字符串（记日志、播放提示音）时，用 CommandTableReadGuard 把
+ * 查询和使用包在同一个临界区内。
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class CommandManifest;
+
+/**
+ * @brief 命令动作
+ */
+typedef enum {
+    COMMAND_ACTION_NONE = 0,    // 只播放确认提示音
+    COMMAND_ACTION_GPIO,        // 设置 GPIO 电平后播放确认提示音
+    COMMAND_ACTION_COUNT
+} command_action_t;
+
+/**
+ * @brief 命令执行成功后的流程
+ */
+typedef enum {
+    COMMAND_FLOW_CONTINUE = 0,  // 继续等待下一条命令
+    COMMAND_FLOW_EXIT,          // 结束本轮交互，返回等待唤醒
+} command_flow_t;
+
+/**
+ * @brief 命令表项
+ */
+typedef struct {
+    int id;                     // 命令ID（MultiNet 返回的 command_id）
+    const char *pinyin;         // 拼音表示
+    const char *description;    // 中文描述
+    command_action_t action;    // 动作
+    uint8_t gpio;               // COMMAND_ACTION_GPIO：GPIO 编号
+    uint8_t level;              // COMMAND_ACTION_GPIO：输出电平
+    const char *prompt;         // 确认提示音名称（提示音包中的名称），nullptr 表示不播放
+    command_flow_t flow;        // 执行成功后的流程
+    uint8_t priority;           // 执行优先级，排队时数值大的先执行
+    uint8_t min_confidence;     // 最低识别置信度（百分比），低于此值请用户再说一遍
+    uint8_t min_margin;         // 领先第二候选命令的最小置信度差（百分点），不足时请用户再说一遍
+} command_entry_t;
+
+/**
+ * @brief 命令表读临界区（RAII，无锁，可嵌套）
+ *
+ * 临界区内取出的表项及其字符串在临界区结束前有效；其间提交的延迟日志
+ * 在旧快照释放前输出完（见 CommandManager::reload_commands()）。
+ * 临界区内不能阻塞等待，也不能替换命令表。
+ */
+class CommandTableReadGuard {
+public:
+    CommandTableReadGuard();
+    ~CommandTableReadGuard();
+
+    CommandTableReadGuard(const CommandTableReadGuard&) = delete;
+    CommandTableReadGuard& operator=(const CommandTableReadGuard&) = delete;
+
+private:
+    uint32_t phase_;
+};
+
+/**
+ * @brief 发布新的命令表快照
+ *
+ * 写者之间必须串行。返回后新的读临界区看到新快照，旧快照可能仍有读者，
+ * 调用 command_table_synchronize() 后才能释放。
+ *
+ * @param manifest 解析成功的命令清单，nullptr 表示内置命令表；
+ *                 清单对象及其数据在被替换并经过宽限期之前必须有效
+ * @return const CommandManifest* 被替换的清单，内置命令表为nullptr
+ */
+const CommandManifest* command_table_publish(const CommandManifest *manifest);
+
+/**
+ * @brief 等待宽限期结束：此前进入的命令表读临界区全部退出
+ *
+ * 不能在读临界区内调用。
+ *
+ * @param wait 仍有读者时调用一次，让出CPU
+ * @return uint32_t 调用 wait 的次数
+ */
+uint32_t command_table_synchronize(void (*wait)(void));
+
+/**
+ * @brief 当前命令表是否来自命令清单
+ */
+bool command_table_from_manifest(void);
+
+/**
+ * @brief 按命令ID查找表项（内置表 O(1)，清单 O(log n)）
+ * @param id 命令ID
+ * @param entry 输出表项，字符串在调用者的读临界区内有效
+ * @return bool 找到返回true
+ */
+bool command_table_find(int id, command_entry_t *entry);
+
+/**
+ * @brief 命令数量（表可能随时被替换，遍历请用 command_table_at() 的返回值判断结束）
+ */
+size_t command_table_size(void);
+
+/**
+ * @brief 按下标取表项（清单按ID升序）
+ * @param index 下标
+ * @param entry 输出表项，字符串在调用者的读临界区内有效
+ * @return bool 下标有效返回true
+ */
+bool command_table_at(size_t index, command_entry_t *entry);
@@ -0,0 +1,159 @@
+/**
+ * @file vocabulary.cc
+ * @brief 命令词表及差分实现
+ */
+
+#include "vocabulary.h"
+#include <algorithm>
+#include <string>
+
+size_t Vocabulary::lower_bound(const char *phrase) const {
+    auto it = std::lower_bound(records_.begin(), records_.end(), phrase,
+                               [this](const record_t &r, const char *p) { return strcmp(phrase_of(r), p) < 0; });
+    return static_cast<size_t>(it - records_.begin());
+}
+
+uint32_t Vocabulary::append(const char *phrase) {
+    // 参数指向本表字符区时，扩容会使其失效，先复制
+    if (phrase >= arena_.data() && phrase < arena_.data() + arena_.size()) {
+        std::string copy(phrase);
+        return append(copy.c_str());
+    }
+    uint32_t offset = static_cast<uint32_t>(arena_.size());
+    arena_.insert(arena_.end(), phrase, phrase + strlen(phrase) + 1);
+    return offset;
+}
+
+void Vocabulary::erase(size_t index) {
+    garbage_ += strlen(phrase_of(records_[index])) + 1;
+    records_.erase(records_.begin() + index);
+    if (garbage_ * 2 <= arena_.size()) {
+        return;
+    }
+
+    // 按记录顺序重新排列字符区
+    std::vector<char> compacted;
+    compacted.reserve(arena_.size() - garbage_);
+    for (record_t &record : records_) {
+        const char *phrase = phrase_of(record);
+        record.offset = static_cast<uint32_t>(compacted.size());
+        compacted.insert(compacted.end(), phrase, phrase + strlen(phrase) + 1);
+    }
+    arena_.swap(compacted);
+    garbage_ = 0;
+}
+
+size_t Vocabulary::sort_unique() {
+    // 稳定排序，重复的拼音保留先出现的一项
+    std::stable_sort(records_.begin(), records_.end(), [this](const record_t &a, const record_t &b) {
+        return strcmp(phrase_of(a), phrase_of(b)) < 0;
+    });
+    auto last = std::unique(records_.begin(), records_.end(), [this](const record_t &a, const record_t &b) {
+        return strcmp(phrase_of(a), phrase_of(b)) == 0;
+    });
+    size_t removed = static_cast<size_t>(records_.end() - last);
+    for (auto it = last; it != records_.end(); ++it) {
+        garbage_ += strlen(phrase_of(*it)) + 1;
+    }
+    records_.erase(last, records_.end());
+    return removed;
+}
+
+void Vocabulary::clear() {
+    records_.clear();
+    arena_.clear();
+    garbage_ = 0;
+}
+
+bool Vocabulary::add(int id, const char *phrase) {
+    size_t pos = lower_bound(phrase);
+    if (phrase[0] == '\0' || (pos < records_.size() && strcmp(phrase_of(records_[pos]), phrase) == 0)) {
+        return false;
+    }
+    records_.insert(records_.begin() + pos, record_t{id, append(phrase)});
+    return true;
+}
+
+bool Vocabulary::remove(const char *phrase) {
+    size_t pos = lower_bound(phrase);
+    if (pos >= records_.size() || strcmp(phrase_of(records_[pos]), phrase) != 0) {
+        return false;
+    }
+    erase(pos);
+    return true;
+}
+
+bool Vocabulary::modify(const char *old_phrase, const char *phrase) {
+    size_t pos = lower_bound(old_phrase);
+    if (pos >= records_.size() || strcmp(phrase_of(records_[pos]), old_phrase) != 0 ||
+        phrase[0] == '\0' || find(phrase) >= 0) {
+        return false;
+    }
+    int id = records_[pos].id;
+    erase(pos);
+    return add(id, phrase);
+}
+
+int Vocabulary::find(const char *phrase) const {
+    size_t pos = lower_bound(phrase);
+    if (pos >= records_.size() || strcmp(phrase_of(records_[pos]), phrase) != 0) {
+        return -1;
+    }
+    return records_[pos].id;
+}
+
+void Vocabulary::diff(const Vocabulary &target, std::vector<vocabulary_op_t> *ops) const {
+    ops->clear();
+
+    // 两表都按拼音排序，归并一遍找出只在一侧的命令词
+    std::vector<vocabulary_phrase_t> removed;   // 只在本表中（可改为修改）
+    std::vector<vocabulary_phrase_t> added;     // 只在目标表中（可改为修改）
+    std::vector<vocabulary_op_t> moved;         // 拼音相同、命令ID不同
+    size_t i = 0;
+    size_t j = 0;
+    while (i < size() || j < target.size()) {
+        int cmp = (i >= size()) ? 1 : (j >= target.size()) ? -1 : strcmp(at(i).phrase, target.at(j).phrase);
+        if (cmp < 0) {
+            removed.push_back(at(i++));
+        } else if (cmp > 0) {
+            added.push_back(target.at(j++));
+        } else {
+            if (records_[i].id != target.records_[j].id) {
+                moved.push_back({VOCABULARY_OP_ADD, target.records_[j].id, at(i).phrase, target.at(j).phrase});
+            }
+            i++;
+            j++;
+        }
+    }
+
+    // 同一命令ID的删除和新增配对为修改（拼音分别只在一侧出现，修改不会撞名）
+    auto by_id = [](const vocabulary_phrase_t &a, const vocabulary_phrase_t &b) { return a.id < b.id; };
+    std::stable_sort(removed.begin(), removed.end(), by_id);
+    std::stable_sort(added.begin(), added.end(), by_id);
+
+    std::vector<vocabulary_op_t> modifies;
+    std::vector<vocabulary_op_t> adds;
+    size_t r = 0;
+    size_t a = 0;
+    while (r < removed.size() || a < added.size()) {
+        if (a >= added.size() || (r < removed.size() && removed[r].id < added[a].id)) {
+            ops->push_back({VOCABULARY_OP_REMOVE, removed[r].id, removed[r].phrase, nullptr});
+            r++;
+        } else if (r >= removed.size() || added[a].id < removed[r].id) {
+            adds.push_back({VOCABULARY_OP_ADD, added[a].id, nullptr, added[a].phrase});
+            a++;
+        } else {
+            modifies.push_back({VOCABULARY_OP_MODIFY, added[a].id, removed[r].phrase, added[a].phrase});
+            r++;
+            a++;
+        }
+    }
+
+    for (const vocabulary_op_t &op : moved) {
+        ops->push_back({VOCABULARY_OP_REMOVE, find(op.old_phrase), op.old_phrase, nullptr});
+        adds.push_back({VOCABULARY_OP_ADD, op.id, nullptr, op.phrase});
+    }
+
+    ops->insert(ops->end(), modifies.begin(), modifies.end());
+    ops->insert(ops->end(), adds.begin(), adds.end());
+}
@@ -0,0 +1,189 @@
+/**
+ * @file vocabulary.h
+ * @brief 命令词表及差分
+ *
+ * 保存一组命令词（拼音 -> 命令ID），并与期望的命令词表比较，生成把当前表
+ * 变成期望表所需的最少操作（删除、修改、新增），用于运行时更新 MultiNet
+ * 命令词而不清空重建。
+ *
+ * 拼音字符串连续存放在一块字符区中，每个命令词只占一条 8 字节的记录
+ * （命令ID + 字符区偏移），几百个命令词也只有两次内存分配。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief 命令词（同一命令ID可以对应多个命令词）
+ */
+typedef struct {
+    int id;                 // 命令ID
+    const char *phrase;     // 拼音表示
+} vocabulary_phrase_t;
+
+/**
+ * @brief 命令词操作类型（按此顺序执行不会产生重复命令词）
+ */
+typedef enum {
+    VOCABULARY_OP_REMOVE = 0,   // 删除 old_phrase
+    VOCABULARY_OP_MODIFY,       // 把 old_phrase 改为 phrase，命令ID不变
+    VOCABULARY_OP_ADD,          // 新增 phrase，命令ID为 id
+} vocabulary_op_type_t;
+
+/**
+ * @brief 命令词操作
+ *
+ * 字符串指向参与差分的两个命令词表，两表修改前有效。
+ */
+typedef struct {
+    vocabulary_op_type_t type;
+    int id;                     // 命令ID
+    const char *old_phrase;     // 删除/修改：原命令词（指向原表）
+    const char *phrase;         // 修改/新增：新命令词（指向目标表）
+} vocabulary_op_t;
+
+/**
+ * @brief 命令词表
+ *
+ * 命令词按拼音排序保存，查找 O(log n)，差分 O(n log n)。
+ * 拼音是唯一键：同一拼音只能属于一个命令ID（与 MultiNet 命令词表一致）。
+ */
+class Vocabulary {
+public:
+    Vocabulary() = default;
+
+    /**
+     * @brief 批量设置命令词（先清空）
+     *
+     * 一次分配字符区和记录，整体排序一次，比逐条 add() 快。
+     * 拼音为空或与前面的命令词重复的项被忽略。
+     *
+     * @param count 命令词数量
+     * @param source 可调用对象，source(i) 返回第 i 个 vocabulary_phrase_t
+     * @return size_t 被忽略的命令词数
+     */
+    template <typename Source>
+    size_t assign(size_t count, Source source);
+
+    /**
+     * @brief 添加命令词
+     * @return bool 拼音为空或已存在时返回false
+     */
+    bool add(int id, const char *phrase);
+
+    /**
+     * @brief 删除命令词
+     * @return bool 命令词不存在时返回false
+     */
+    bool remove(const char *phrase);
+
+    /**
+     * @brief 修改命令词拼音，命令ID不变
+     * @return bool 原命令词不存在或新拼音已存在时返回false
+     */
+    bool modify(const char *old_phrase, const char *phrase);
+
+    /**
+     * @brief 按拼音查找命令ID
+     * @return int 命令ID，未找到返回-1
+     */
+    int find(const char *phrase) const;
+
+    /**
+     * @brief 清空
+     */
+    void clear();
+
+    /**
+     * @brief 命令词数量
+     */
+    size_t size() const { return records_.size(); }
+
+    /**
+     * @brief 按下标取命令词（按拼音排序），字符串在本表修改前有效
+     */
+    vocabulary_phrase_t at(size_t index) const {
+        return {records_[index].id, phrase_of(records_[index])};
+    }
+
+    /**
+     * @brief 占用的内存（记录和字符区的容量，字节）
+     */
+    size_t memory_usage() const {
+        return records_.capacity() * sizeof(record_t) + arena_.capacity();
+    }
+
+    /**
+     * @brief 计算把本表变成目标表所需的操作
+     *
+     * 删除和新增同一命令ID的命令词合并为一次修改。拼音不变只是命令ID变化时
+     * 拆成删除加新增。操作按 删除、修改、新增 排序，依次执行时任何时刻都
+     * 不会出现重复的拼音。
+     *
+     * @param target 目标命令词表
+     * @param ops 输出操作列表（先清空），两表相同时为空
+     */
+    void diff(const Vocabulary &target, std::vector<vocabulary_op_t> *ops) const;
+
+private:
+    typedef struct {
+        int32_t id;             // 命令ID
+        uint32_t offset;        // 拼音在字符区中的偏移
+    } record_t;
+
+    std::vector<record_t> records_;   // 按拼音排序
+    std::vector<char> arena_;         // 以 '\0' 结尾的拼音，依次存放
+    size_t garbage_ = 0;              // 已删除命令词在字符区中占用的字节数
+
+    const char* phrase_of(const record_t &record) const { return arena_.data() + record.offset; }
+
+    /**
+     * @brief 第一个拼音不小于 phrase 的下标
+     */
+    size_t lower_bound(const char *phrase) const;
+
+    /**
+     * @brief 把拼音追加到字符区
+     * @return uint32_t 偏移
+     */
+    uint32_t append(const char *phrase);
+
+    /**
+     * @brief 删除记录并回收字符区（废弃字节过半时整理）
+     */
+    void erase(size_t index);
+
+    /**
+     * @brief assign() 收尾：排序并去掉重复的拼音
+     * @return size_t 去掉的记录数
+     */
+    size_t sort_unique();
+};
+
+template <typename Source>
+size_t Vocabulary::assign(size_t count, Source source) {
+    clear();
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        const char *phrase = source(i).phrase;
+        bytes += (phrase != nullptr) ? strlen(phrase) + 1 : 0;
+    }
+    arena_.reserve(bytes);
+    records_.reserve(count);
+
+    size_t ignored = 0;
+    for (size_t i = 0; i < count; i++) {
+        vocabulary_phrase_t item = source(i);
+        if (item.phrase == nullptr || item.phrase[0] == '\0') {
+            ignored++;
+            continue;
+        }
+        records_.push_back({item.id, append(item.phrase)});
+    }
+    return ignored + sort_unique();
+}
@@ -13,11 +13,31 @@ extern "C"
 #include "model_path.h"              // 模型路径定义
 #include "bsp_board.h"               // 板级支持包，INMP441麦克风驱动
 #include "esp_log.h"                 // ESP日志系统
-#include "assets/voices/welcome.h"   // 欢迎音频数据文件
+#include "esp_timer.h"               // 高精度计时
+#include "esp_cpu.h"                 // CPU周期计数
+#include "esp_rom_sys.h"             // CPU频率
 #include "driver/gpio.h"             // GPIO驱动
 }
 
+#include "commands/command_arbiter.h"
+#include "commands/command_executor.h"
 #include "commands/command_manager.h"
+#include "audio/audio_capture.h"
+#include "audio/audio_player.h"
+#include "audio/prompt_store.h"
+#include "audio/audio_history.h"
+#include "audio/stage_timing.h"
+#include "audio/vad_gate.h"
+#include "audio/deadline_monitor.h"
+#include "system/boot_trace.h"
+#include "system/dlog.h"
+#include "system/init_runner.h"
+#include "system/trace.h"
+#if CONFIG_ZAPMYCO_USE_AFE
+#include "audio/afe_frontend.h"
+#endif
+
+#include <atomic>
 
 static const char *TAG = "语音识别"; // 日志标签
 
@@ -31,10 +51,80 @@ typedef enum
     STATE_WAITING_COMMAND = 1, // 等待命令词
 } system_state_t;
 
+// 麦克风I2S槽位宽：32位槽保留INMP441完整的24位数据
+#if CONFIG_ZAPMYCO_MIC_32BIT_CAPTURE
+#define MIC_SLOT_BITS 32
+#else
+#define MIC_SLOT_BITS 16
+#endif
+
+// 任务配置：采集（AFE模式下为feed）任务与识别任务分别绑定到不同核心，互不阻塞
+#define CAPTURE_TASK_CORE 0              // 采集任务所在核心
+#define CAPTURE_TASK_PRIORITY 10         // 采集任务优先级（高于识别任务）
+#define CAPTURE_RING_FRAMES 8            // 采集缓冲帧数（2的幂，约256ms）
+#define RECOGNITION_TASK_CORE 1          // 识别任务所在核心
+#define RECOGNITION_TASK_PRIORITY 5      // 识别任务优先级
+#define RECOGNITION_TASK_STACK_SIZE 8192 // 识别任务栈大小（字节）
+#define MULTINET_LOADER_CORE 0           // 命令词模型加载任务所在核心
+#define MULTINET_LOADER_PRIORITY 1       // 加载任务优先级（与app_main相同，不抢占采集和播放）
+#define MULTINET_LOADER_STACK_SIZE 10240 // 加载任务栈大小（与主任务相同）
+#define INIT_HELPER_CORE 1               // 初始化辅助任务所在核心（app_main在核心0）
+#define INIT_HELPER_PRIORITY 1           // 初始化辅助任务优先级（与app_main相同）
+#define INIT_HELPER_STACK_SIZE 10240     // 初始化辅助任务栈大小（任一步骤都可能在其中执行）
+#define PLAYER_TASK_CORE 0               // 播放任务所在核心
+#define PLAYER_TASK_PRIORITY 8           // 播放任务优先级（低于采集任务）
+#define COMMAND_TASK_CORE 0              // 命令执行任务所在核心（与识别任务分开）
+#define COMMAND_TASK_PRIORITY 6          // 命令执行任务优先级（低于播放任务，高于加载任务）
+#define COMMAND_TASK_STACK_SIZE 4096     // 命令执行任务栈大小
+#define PROMPT_PARTITION_LABEL "prompts" // 提示音包所在分区
+#define COMMAND_PARTITION_LABEL "commands" // 命令清单所在分区
+#define STATS_REPORT_FRAMES 500          // 每处理多少帧检查一次采集统计
+
+// 预录音配置
+#define AUDIO_SAMPLE_RATE 16000          // 音频采样率（Hz）
+#define PREROLL_HISTORY_MS 2000          // PSRAM中保存的历史音频时长
+#define WAKE_REPLAY_MS 480               // 唤醒后回灌给命令词模型的音频时长
+#define VAD_LOOKBACK_MS 320              // 语音门控打开时回灌给唤醒词模型的音频时长
+
+// 命令词模型加载状态
+typedef enum
+{
+    MULTINET_UNLOADED = 0, // 未加载
+    MULTINET_LOADING = 1,  // 后台加载中
+    MULTINET_READY = 2,    // 可以识别
+    MULTINET_FAILED = 3,   // 加载失败
+} multinet_state_t;
+
 // 全局变量
 static system_state_t current_state = STATE_WAITING_WAKEUP;
+static esp_wn_iface_t *wakenet = NULL;
+static model_iface_data_t *wn_model_data = NULL;
+static const char *wn_model_name = NULL;
 static esp_mn_iface_t *multinet = NULL;
 static model_iface_data_t *mn_model_data = NULL;
+static const char *mn_model_name = NULL;
+static srmodel_list_t *sr_models = NULL;
+static int recognition_chunk_samples = 0;   // 识别任务每帧样本数
+// 加载任务写入 multinet/mn_model_data 后以release发布READY，识别任务acquire读取
+static std::atomic<int> multinet_state{MULTINET_UNLOADED};
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+static TaskHandle_t multinet_loader = NULL;
+#endif
+static bool command_deferred = false;       // 唤醒时命令词模型未就绪，命令阶段音频暂存在历史缓冲区
+static uint32_t deferred_wake_index = 0;    // 延迟识别时触发唤醒的帧序号
+static uint32_t session_first_ticket = 0;   // 本轮交互第一条提交的命令序号，0 表示本轮尚未提交命令
+static AudioHistory audio_history;
+#if !CONFIG_ZAPMYCO_USE_AFE
+static StageTiming wakenet_timing;  // 唤醒词检测耗时
+#endif
+#if CONFIG_ZAPMYCO_VAD_GATE
+static VadGate vad_gate;            // 唤醒词检测前的语音门控
+static uint32_t wakenet_next_index = 0; // 唤醒词模型尚未处理过的第一帧序号，门控打开时从这里之后回灌
+#endif
+static StageTiming multinet_timing; // 命令词识别耗时
+static CommandArbiter command_arbiter(CONFIG_ZAPMYCO_COMMAND_SAY_AGAIN_LIMIT); // 命令词识别结果仲裁
+static DeadlineMonitor frame_deadline[2]; // 按系统状态分别统计的逐帧实时预算
+static const char *const STATE_NAMES[2] = {"等待唤醒", "等待命令"};
 static TickType_t command_timeout_start = 0;
 static const TickType_t COMMAND_TIMEOUT_MS = 5000; // 5秒超时
 
@@ -42,10 +132,12 @@ static const TickType_t COMMAND_TIMEOUT_MS = 5000; // 5秒超时
  * @brief 初始化外接LED GPIO
  *
  * 配置GPIO21为输出模式，用于控制外接LED灯珠
+ *
+ * @return esp_err_t ESP_OK表示成功
  */
-static void init_led(void)
+static esp_err_t init_led(void)
 {
-    ESP_LOGI(TAG, "正在初始化外接LED (GPIO21)...");
+    DLOGI(TAG, "正在初始化外接LED (GPIO21)...");
 
     // 配置GPIO21为输出模式
     gpio_config_t io_conf = {
@@ -59,92 +151,984 @@ static void init_led(void)
     esp_err_t ret = gpio_config(&io_conf);
     if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "外接LED GPIO初始化失败: %s", esp_err_to_name(ret));
-        return;
+        DLOGE(TAG, "外接LED GPIO初始化失败: %s", esp_err_to_name(ret));
+        return ret;
     }
 
     // 初始状态设置为关闭（低电平）
     gpio_set_level(LED_GPIO, 0);
-    ESP_LOGI(TAG, "✓ 外接LED初始化成功，初始状态：关闭");
+    DLOGI(TAG, "✓ 外接LED初始化成功，初始状态：关闭");
+    return ESP_OK;
 }
 
+/**
+ * @brief 创建并配置命令词识别模型
+ *
+ * 成功后发布 MULTINET_READY，识别任务从下一帧起即可使用。
+ * 失败时已创建的模型会被释放，不修改全局模型指针。
+ *
+ * @return esp_err_t ESP_OK表示模型可用
+ */
+static esp_err_t load_multinet(void)
+{
+    int64_t load_start = esp_timer_get_time();
+
+    // 获取中文命令词识别模型（MultiNet7）
+    char *mn_name = esp_srmodel_filter(sr_models, ESP_MN_PREFIX, ESP_MN_CHINESE);
+    if (mn_name == NULL)
+    {
+        DLOGE(TAG, "未找到中文命令词识别模型！");
+        DLOGE(TAG, "请确保已正确配置并烧录MultiNet7中文模型");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    DLOGI(TAG, "✓ 选择命令词模型: %s", mn_name);
+
+    // 获取命令词识别接口
+    esp_mn_iface_t *iface = esp_mn_handle_from_name(mn_name);
+    if (iface == NULL)
+    {
+        DLOGE(TAG, "获取命令词识别接口失败，模型: %s", mn_name);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // 创建命令词模型数据实例
+    model_iface_data_t *data = iface->create(mn_name, 6000);
+    if (data == NULL)
+    {
+        DLOGE(TAG, "创建命令词模型数据失败");
+        return ESP_ERR_NO_MEM;
+    }
+
+#if CONFIG_ZAPMYCO_USE_AFE
+    // AFE输出的每帧直接送入命令词模型，两者块大小必须一致
+    if (iface->get_samp_chunksize(data) != recognition_chunk_samples)
+    {
+        DLOGE(TAG, "AFE输出块大小(%d)与命令词模型块大小(%d)不一致",
+              recognition_chunk_samples, iface->get_samp_chunksize(data));
+        iface->destroy(data);
+        return ESP_ERR_INVALID_SIZE;
+    }
+#endif
+
+    // 配置自定义命令词
+    DLOGI(TAG, "正在配置命令词...");
+    esp_err_t ret = CommandManager::get_instance()->configure_commands(iface, data);
+    if (ret != ESP_OK)
+    {
+        DLOGE(TAG, "命令词配置失败");
+        CommandManager::get_instance()->detach_commands();
+        iface->destroy(data);
+        return ret;
+    }
+    DLOGI(TAG, "✓ 命令词配置完成");
+
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+    bool first_load = (mn_model_name == NULL);
+#endif
+    multinet = iface;
+    mn_model_data = data;
+    mn_model_name = mn_name;
+    multinet_state.store(MULTINET_READY, std::memory_order_release);
+
+    DLOGI(TAG, "✓ 命令词模型就绪，加载耗时 %lld ms", (long long)((esp_timer_get_time() - load_start) / 1000));
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+    // 同步加载时由初始化步骤打点
+    if (first_load)
+    {
+        boot_trace_mark("命令词模型");
+    }
+#endif
+    return ESP_OK;
+}
+
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+/**
+ * @brief 命令词模型加载任务
+ *
+ * 收到通知后在后台创建命令词模型，唤醒词检测不必等待
+ *
+ * @param arg 未使用
+ */
+static void multinet_loader_task(void *arg)
+{
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (load_multinet() != ESP_OK)
+        {
+            multinet_state.store(MULTINET_FAILED, std::memory_order_release);
+            DLOGE(TAG, "命令词模型加载失败，下次唤醒时重试");
+        }
+    }
+}
+
+/**
+ * @brief 请求后台加载命令词模型
+ *
+ * 模型已就绪或正在加载时不做任何事，可以重复调用
+ */
+static void request_multinet_load(void)
+{
+    int state = multinet_state.load(std::memory_order_acquire);
+    do
+    {
+        if (state == MULTINET_READY || state == MULTINET_LOADING)
+        {
+            return;
+        }
+    } while (!multinet_state.compare_exchange_weak(state, MULTINET_LOADING));
+
+    xTaskNotifyGive(multinet_loader);
+}
+#endif
+
+#if CONFIG_ZAPMYCO_MULTINET_RELEASE_IDLE
+/**
+ * @brief 释放命令词模型
+ *
+ * 只在识别任务中调用（此时加载任务空闲），下次唤醒时重新加载
+ */
+static void release_multinet(void)
+{
+    if (multinet_state.load(std::memory_order_acquire) != MULTINET_READY)
+    {
+        return;
+    }
+
+    multinet_state.store(MULTINET_UNLOADED, std::memory_order_release);
+    CommandManager::get_instance()->detach_commands();
+    multinet->destroy(mn_model_data);
+    mn_model_data = NULL;
+    DLOGI(TAG, "已释放命令词模型，PSRAM剩余 %zu KB", heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 1024);
+}
+#endif
+
 
 
 /**
  * @brief 执行退出逻辑
  *
  * 返回等待唤醒状态
+ *
+ * @param exit_ticket 结束交互的命令的提交序号：在它之前提交的命令（优先级较低，
+ *                    排在它之后执行）照常执行，之后提交的取消；0 表示超时等原因
+ *                    结束交互，取消所有排队的命令
  */
-static void execute_exit_logic(void)
+static void execute_exit_logic(uint32_t exit_ticket)
 {
     current_state = STATE_WAITING_WAKEUP;
-    ESP_LOGI(TAG, "返回等待唤醒状态，请说出唤醒词 '你好小智'");
+    command_deferred = false;
+    session_first_ticket = 0; // 此后到达的本轮命令事件都按过期处理
+    size_t cancelled = CommandExecutor::get_instance()->cancel_pending(exit_ticket);
+    if (cancelled > 0)
+    {
+        DLOGI(TAG, "交互结束，取消 %zu 条尚未执行的命令", cancelled);
+    }
+#if CONFIG_ZAPMYCO_USE_AFE
+    AfeFrontend::get_instance()->enable_wakenet();
+#endif
+#if CONFIG_ZAPMYCO_VAD_GATE
+    vad_gate.reset();
+#endif
+#if CONFIG_ZAPMYCO_MULTINET_RELEASE_IDLE
+    release_multinet();
+#endif
+#if CONFIG_ZAPMYCO_TRACE_DUMP_ON_IDLE
+    trace_request_dump(); // 一轮交互结束，输出唤醒到播放的完整跟踪
+#endif
+    DLOGI(TAG, "返回等待唤醒状态，请说出唤醒词 '你好小智'");
 }
 
 /**
- * @brief 应用程序主入口函数
+ * @brief 命令词识别处理一帧音频
  *
- * 初始化INMP441麦克风硬件，加载唤醒词检测模型，
- * 然后进入主循环进行实时音频采集和唤醒词检测。
+ * @param buffer 一帧音频数据（唤醒词模型块大小）
+ * @return bool 本帧识别出命令词返回true
  */
-extern "C" void app_main(void)
+static bool process_command_frame(int16_t *buffer)
 {
-    // ========== 第一步：初始化外接LED ==========
-    init_led();
+    CommandManager *cmd_manager = CommandManager::get_instance();
+
+    // 第二阶段：命令词识别
+    int64_t detect_start = esp_timer_get_time();
+    TRACE_BEGIN(COMMAND_DETECT, 0);
+    esp_mn_state_t mn_state = multinet->detect(mn_model_data, buffer);
+    TRACE_END(COMMAND_DETECT, mn_state);
+    multinet_timing.add((uint32_t)(esp_timer_get_time() - detect_start));
 
-    // ========== 第二步：初始化命令管理器 ==========
-    ESP_LOGI(TAG, "正在初始化命令管理器...");
-    CommandManager* cmd_manager = CommandManager::get_instance();
-    cmd_manager->initialize();
-    ESP_LOGI(TAG, "✓ 命令管理器初始化完成");
+    if (mn_state == ESP_MN_STATE_DETECTED)
+    {
+        // 获取识别结果，综合全部 N-best 候选仲裁，不只看第一名
+        esp_mn_results_t *mn_result = multinet->get_results(mn_model_data);
+        command_candidate_t candidates[CommandArbiter::MAX_CANDIDATES];
+        size_t count = 0;
+        for (int i = 0; i < mn_result->num && count < CommandArbiter::MAX_CANDIDATES; i++)
+        {
+            candidates[count++] = {mn_result->command_id[i], mn_result->prob[i]};
+        }
+        arbiter_decision_t decision = command_arbiter.decide(candidates, count);
+        int command_id = decision.command_id;
 
-    // ========== 第二步：初始化INMP441麦克风硬件 ==========
-    ESP_LOGI(TAG, "正在初始化INMP441数字麦克风...");
-    ESP_LOGI(TAG, "音频参数: 采样率16kHz, 单声道, 16位深度");
+        TRACE_INSTANT(COMMAND_RECOGNIZED, command_id);
+        {
+            // 识别结果中的字符串随下一次检测改变，延迟日志只记录命令表中的描述；
+            // 命令表替换后旧描述在延迟日志输出完才释放
+            CommandTableReadGuard guard;
+            const char *cmd_desc = cmd_manager->get_command_description(command_id);
+            DLOGI(TAG, "🎯 检测到命令词: ID=%d, 置信度=%.2f, 命令='%s'（第二候选 ID=%d, 置信度=%.2f, 共 %d 个候选）",
+                  command_id, decision.prob, cmd_desc, decision.runner_up_id, decision.runner_up_prob,
+                  mn_result->num);
+        }
 
-    esp_err_t ret = bsp_board_init(16000, 1, 16); // 16kHz, 单声道, 16位
-    if (ret != ESP_OK)
+        if (decision.verdict == ARBITER_ACCEPT)
+        {
+            // 交给执行任务异步执行，结果在 handle_command_events() 中处理
+            uint32_t ticket = 0;
+            esp_err_t ret = CommandExecutor::get_instance()->submit(command_id, &ticket);
+            if (ret == ESP_OK && session_first_ticket == 0)
+            {
+                session_first_ticket = ticket;
+            }
+            else if (ret == ESP_ERR_NOT_FOUND)
+            {
+                DLOGW(TAG, "⚠️  未知命令ID: %d", command_id);
+            }
+            else if (ret != ESP_OK)
+            {
+                DLOGE(TAG, "❌ 命令提交失败: ID=%d, %s", command_id, esp_err_to_name(ret));
+            }
+        }
+        else if (decision.verdict == ARBITER_SAY_AGAIN)
+        {
+            // 宁可请用户重说，也不执行可能听错的动作
+            DLOGW(TAG, "🤔 %s，请再说一遍 (%u/%d)", CommandArbiter::reason_name(decision.reason),
+                  (unsigned)decision.retries, CONFIG_ZAPMYCO_COMMAND_SAY_AGAIN_LIMIT);
+            if (AudioPlayer::get_instance()->play_prompt(PROMPT_SAY_AGAIN) == 0)
+            {
+                DLOGE(TAG, "重说提示音播放失败");
+            }
+        }
+        else
+        {
+            DLOGW(TAG, "忽略识别结果: %s", CommandArbiter::reason_name(decision.reason));
+        }
+
+        // 本次结果处理完成，重新开始5秒倒计时，继续等待下一个命令
+        command_timeout_start = xTaskGetTickCount();
+        multinet->clean(mn_model_data); // 清理命令词识别缓冲区
+        DLOGI(TAG, "重新开始5秒倒计时，可以继续说出指令: '帮我开灯'、'帮我关灯' 或 '拜拜'");
+        return true;
+    }
+    else if (mn_state == ESP_MN_STATE_TIMEOUT)
+    {
+        DLOGW(TAG, "⏰ 命令词识别超时");
+        execute_exit_logic(0);
+    }
+    else
+    {
+        // 提示音播放期间不计入等待时间，从播放结束开始倒计时
+        if (AudioPlayer::get_instance()->is_busy())
+        {
+            command_timeout_start = xTaskGetTickCount();
+            return false;
+        }
+
+        // 检查手动超时
+        TickType_t current_time = xTaskGetTickCount();
+        if ((current_time - command_timeout_start) > pdMS_TO_TICKS(COMMAND_TIMEOUT_MS))
+        {
+            DLOGW(TAG, "⏰ 命令词等待超时 (%lu秒)", (unsigned long)(COMMAND_TIMEOUT_MS / 1000));
+            execute_exit_logic(0);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 完成事件是否属于当前这一轮交互
+ *
+ * 提交序号单调递增（允许回绕），本轮提交的命令序号不小于本轮第一条的序号。
+ * 上一轮提交、在本轮才执行完的命令（例如超时返回后又被唤醒，上一轮的"拜拜"
+ * 才执行完）不属于本轮。
+ */
+static bool command_event_current(const command_event_t &event)
+{
+    return session_first_ticket != 0 && static_cast<int32_t>(event.ticket - session_first_ticket) >= 0;
+}
+
+/**
+ * @brief 处理命令执行任务发回的完成事件
+ *
+ * 每帧处理前调用。本轮交互中结束交互的命令执行成功后返回等待唤醒；
+ * 上一轮交互迟到的事件只记录日志，不影响当前状态。
+ */
+static void handle_command_events(void)
+{
+    command_event_t event;
+    while (CommandExecutor::get_instance()->poll_event(&event))
+    {
+        if (!command_event_current(event))
+        {
+            DLOGI(TAG, "忽略上一轮交互的命令事件: ID=%d, 序号=%lu, 结果=%d", event.command_id,
+                  (unsigned long)event.ticket, (int)event.result);
+        }
+        else if (event.result == COMMAND_RESULT_EXIT_REQUESTED)
+        {
+            DLOGI(TAG, "👋 拜拜命令执行完成，退出命令模式");
+            execute_exit_logic(event.ticket);
+        }
+        else if (event.result == COMMAND_RESULT_EXECUTE_FAILED)
+        {
+            DLOGE(TAG, "❌ 命令执行失败: ID=%d", event.command_id);
+        }
+        else if (event.result == COMMAND_RESULT_SUCCESS)
+        {
+            DLOGI(TAG, "命令执行完成: ID=%d, 等待 %lu us, 执行 %lu us", event.command_id,
+                  (unsigned long)event.wait_us, (unsigned long)event.run_us);
+        }
+    }
+}
+
+/**
+ * @brief 将唤醒词结束前后的历史音频快速回灌给命令词模型
+ *
+ * 唤醒词模型在唤醒词说完后若干帧才触发，紧接着说出的命令开头已经
+ * 被处理过。这里从历史缓冲区取回触发前 WAKE_REPLAY_MS 的音频，
+ * 在处理实时帧之前先送入命令词模型。命令词模型延迟就绪时，
+ * 唤醒之后暂存的帧也一并回灌。
+ *
+ * @param wake_index 触发唤醒的帧序号
+ * @param last_index 回灌的最后一帧序号（含）
+ * @return bool 回灌过程中识别出命令词返回true
+ */
+static bool replay_preroll(uint32_t wake_index, uint32_t last_index)
+{
+    if (!audio_history.is_ready())
+    {
+        return false;
+    }
+
+    uint32_t frame_ms = audio_history.frame_samples() * 1000 / AUDIO_SAMPLE_RATE;
+    uint32_t replay_frames = (WAKE_REPLAY_MS + frame_ms - 1) / frame_ms;
+    uint32_t first = (wake_index + 1 > replay_frames) ? wake_index + 1 - replay_frames : 0;
+    if (first < audio_history.oldest_index())
+    {
+        first = audio_history.oldest_index();
+    }
+
+    for (uint32_t index = first; index <= last_index; index++)
+    {
+        const int16_t *frame = audio_history.frame_at(index);
+        if (frame == NULL || current_state != STATE_WAITING_COMMAND)
+        {
+            break;
+        }
+
+        if (process_command_frame(const_cast<int16_t *>(frame)))
+        {
+            DLOGI(TAG, "✓ 预录音中识别到命令词（回灌 %lu 帧）", (unsigned long)(index - first + 1));
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 唤醒词触发后切换到命令词识别
+ *
+ * @param frame_index 触发唤醒的帧在历史缓冲区中的序号
+ * @param last_index 已写入历史缓冲区的最新帧序号（含）。在历史帧中检测到唤醒时，
+ *                   触发帧之后的帧和当前帧也一并回灌给命令词模型
+ */
+static void on_wake_detected(uint32_t frame_index, uint32_t last_index)
+{
+    TRACE_INSTANT(WAKE_TRIGGERED, frame_index);
+    DLOGI(TAG, "🎉 检测到唤醒词 '你好小智'！");
+    DLOGI(TAG, "=== 唤醒词检测成功！模型: %s ===", wn_model_name);
+
+    // 切换到命令词识别状态
+    current_state = STATE_WAITING_COMMAND;
+    command_timeout_start = xTaskGetTickCount();
+    command_arbiter.reset();
+    session_first_ticket = 0;
+#if CONFIG_ZAPMYCO_USE_AFE
+    AfeFrontend::get_instance()->disable_wakenet(); // 命令词识别期间关闭AFE内置唤醒词
+#endif
+
+    AudioPlayer *player = AudioPlayer::get_instance();
+    if (multinet_state.load(std::memory_order_acquire) == MULTINET_READY)
+    {
+        multinet->clean(mn_model_data); // 清理命令词识别缓冲区
+
+        // 先回灌唤醒词结束附近的音频，用户一口气说出的命令无需等待提示音
+        if (replay_preroll(frame_index, last_index))
+        {
+            return;
+        }
+    }
+    else
+    {
+        // 命令词模型还在加载：之后的音频照常记入历史缓冲区，就绪后从唤醒前开始一并回灌
+        DLOGW(TAG, "命令词模型尚未就绪，暂存音频等待加载完成");
+        command_deferred = true;
+        deferred_wake_index = frame_index;
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+        request_multinet_load();
+#endif
+    }
+
+    // 播放欢迎音频（异步，打断尚未播完的提示音）
+    // 命令词识别与播放同时进行，超时计时在播放结束后才开始
+    prompt_view_t welcome = PromptStore::get_instance()->get(PROMPT_WELCOME);
+    DLOGI(TAG, "播放欢迎音频 (%lu ms)...", (unsigned long)PromptBundle::duration_ms(welcome));
+    player->cancel_all();
+    if (player->play_prompt(PROMPT_WELCOME) == 0)
+    {
+        DLOGE(TAG, "欢迎音频播放失败");
+    }
+
+    DLOGI(TAG, "进入命令词识别模式，请说出指令...");
+    DLOGI(TAG, "支持的指令: '帮我开灯'、'帮我关灯' 或 '拜拜'");
+}
+
+/**
+ * @brief 命令词阶段处理一帧音频
+ *
+ * 唤醒时命令词模型未就绪的情况下，先等待加载完成（不计入超时），
+ * 就绪后回灌唤醒以来暂存在历史缓冲区中的音频，再处理当前帧。
+ * 等待最多持续到历史缓冲区写满一轮，超过后按超时退出命令词识别。
+ *
+ * @param buffer 一帧音频数据（唤醒词模型块大小）
+ * @param frame_index 该帧在历史缓冲区中的序号
+ */
+static void process_command_stage(int16_t *buffer, uint32_t frame_index)
+{
+    if (command_deferred)
+    {
+        int state = multinet_state.load(std::memory_order_acquire);
+        if (state == MULTINET_FAILED)
+        {
+            DLOGE(TAG, "命令词模型不可用，无法识别命令");
+            execute_exit_logic(0);
+            return;
+        }
+        if (state != MULTINET_READY)
+        {
+            // 唤醒帧即将被历史缓冲区覆盖，再等也无法完整回灌，结束本轮交互
+            if (frame_index - deferred_wake_index >= audio_history.capacity())
+            {
+                DLOGW(TAG, "命令词模型 %d ms 内未就绪，放弃本轮命令识别", PREROLL_HISTORY_MS);
+                execute_exit_logic(0);
+                return;
+            }
+            command_timeout_start = xTaskGetTickCount();
+            return;
+        }
+
+        command_deferred = false;
+        multinet->clean(mn_model_data);
+        DLOGI(TAG, "命令词模型已就绪，回灌唤醒后暂存的 %lu 帧", (unsigned long)(frame_index - deferred_wake_index));
+        if (frame_index > deferred_wake_index && replay_preroll(deferred_wake_index, frame_index - 1))
+        {
+            return;
+        }
+    }
+
+    process_command_frame(buffer);
+}
+
+#if !CONFIG_ZAPMYCO_USE_AFE
+/**
+ * @brief 对一帧音频运行唤醒词模型
+ *
+ * @param buffer 一帧音频数据（唤醒词模型块大小）
+ * @return true 检测到唤醒词
+ */
+static bool detect_wakeup(int16_t *buffer)
+{
+    int64_t detect_start = esp_timer_get_time();
+    TRACE_BEGIN(WAKE_DETECT, 0);
+    wakenet_state_t wn_state = wakenet->detect(wn_model_data, buffer);
+    TRACE_END(WAKE_DETECT, wn_state);
+    wakenet_timing.add((uint32_t)(esp_timer_get_time() - detect_start));
+    return wn_state == WAKENET_DETECTED;
+}
+
+/**
+ * @brief 唤醒词检测处理一帧音频
+ *
+ * @param buffer 一帧音频数据（唤醒词模型块大小）
+ * @param frame_index 该帧在历史缓冲区中的序号
+ */
+static void process_wakeup_frame(int16_t *buffer, uint32_t frame_index)
+{
+#if CONFIG_ZAPMYCO_VAD_GATE
+    // 静音帧直接跳过唤醒词检测
+    vad_gate_result_t gate = vad_gate.process(buffer, AudioCapture::get_instance()->get_frame_samples());
+    if (gate == VAD_GATE_CLOSED)
     {
-        ESP_LOGE(TAG, "INMP441麦克风初始化失败: %s", esp_err_to_name(ret));
-        ESP_LOGE(TAG, "请检查硬件连接: VDD->3.3V, GND->GND, SD->GPIO6, WS->GPIO4, SCK->GPIO5");
         return;
     }
-    ESP_LOGI(TAG, "✓ INMP441麦克风初始化成功");
 
-    // ========== 第三步：初始化音频播放功能 ==========
-    ESP_LOGI(TAG, "正在初始化音频播放功能...");
-    ESP_LOGI(TAG, "音频播放参数: 采样率16kHz, 单声道, 16位深度");
+    // 门控刚打开：先把之前的几帧送入唤醒词模型，补上被门控挡掉的起音
+    if (gate == VAD_GATE_OPENED && audio_history.is_ready())
+    {
+        uint32_t lookback = VAD_LOOKBACK_MS * AUDIO_SAMPLE_RATE / 1000 / audio_history.frame_samples();
+        uint32_t first = (frame_index > lookback) ? frame_index - lookback : 0;
+        if (first < audio_history.oldest_index())
+        {
+            first = audio_history.oldest_index();
+        }
+        // 拖尾期间重新打开时，模型已处理过的帧不再重复送入
+        if (first < wakenet_next_index)
+        {
+            first = wakenet_next_index;
+        }
 
-    ret = bsp_audio_init(16000, 1, 16); // 16kHz, 单声道, 16位
-    if (ret != ESP_OK)
+        for (uint32_t index = first; index < frame_index; index++)
+        {
+            const int16_t *frame = audio_history.frame_at(index);
+            if (frame == NULL)
+            {
+                continue;
+            }
+            wakenet_next_index = index + 1;
+            if (detect_wakeup(const_cast<int16_t *>(frame)))
+            {
+                // 触发帧之后直到当前帧都已在历史缓冲区中，一并回灌给命令词模型
+                on_wake_detected(index, frame_index);
+                return;
+            }
+        }
+    }
+    wakenet_next_index = frame_index + 1;
+#endif
+
+    // 第一阶段：唤醒词检测
+    if (detect_wakeup(buffer))
+    {
+        on_wake_detected(frame_index, frame_index);
+    }
+}
+
+/**
+ * @brief 处理一帧音频数据
+ *
+ * 根据当前状态执行唤醒词检测或命令词识别
+ *
+ * @param buffer 一帧音频数据（唤醒词模型块大小）
+ * @param frame_index 该帧在历史缓冲区中的序号
+ */
+static void process_audio_frame(int16_t *buffer, uint32_t frame_index)
+{
+    if (current_state == STATE_WAITING_WAKEUP)
+    {
+        process_wakeup_frame(buffer, frame_index);
+    }
+    else if (current_state == STATE_WAITING_COMMAND)
+    {
+        process_command_stage(buffer, frame_index);
+    }
+}
+#endif
+
+/**
+ * @brief 流水线统计报告状态
+ */
+typedef struct
+{
+    uint32_t reported_overruns;           // 上次报告时的丢帧数
+    int64_t last_timing_us;               // 上次输出阶段耗时的时间
+    stage_timing_snapshot_t prev[4];      // 各阶段上次报告时的快照
+    deadline_snapshot_t deadline_prev[2]; // 各状态实时预算上次报告时的快照
+    bool boot_reported;                   // 是否已输出启动剖析
+} pipeline_report_t;
+
+/**
+ * @brief 输出一个处理阶段在统计窗口内的平均耗时和CPU占比
+ *
+ * @param name 阶段名称
+ * @param timing 阶段耗时累加器
+ * @param prev 上次报告时的快照，输出后更新
+ * @param window_us 统计窗口长度（微秒）
+ */
+static void report_stage(const char *name, const StageTiming &timing, stage_timing_snapshot_t *prev, uint32_t window_us)
+{
+    stage_timing_snapshot_t now = timing.snapshot();
+    uint32_t count = now.count - prev->count;
+    uint32_t total_us = now.total_us - prev->total_us;
+    *prev = now;
+
+    if (count == 0 || window_us == 0)
     {
-        ESP_LOGE(TAG, "音频播放初始化失败: %s", esp_err_to_name(ret));
-        ESP_LOGE(TAG, "请检查MAX98357A硬件连接: DIN->GPIO7, BCLK->GPIO15, LRC->GPIO16");
         return;
     }
-    ESP_LOGI(TAG, "✓ 音频播放初始化成功");
 
-    // ========== 第四步：初始化语音识别模型 ==========
-    ESP_LOGI(TAG, "正在初始化唤醒词检测模型...");
+    uint32_t permille = (uint32_t)((uint64_t)total_us * 1000 / window_us);
+    DLOGI(TAG, "  - %s: 平均 %lu us/帧, %lu 帧, 占用单核 %lu.%lu%%", name,
+          (unsigned long)(total_us / count), (unsigned long)count,
+          (unsigned long)(permille / 10), (unsigned long)(permille % 10));
+}
+
+/**
+ * @brief 检查采集统计和各阶段耗时
+ *
+ * 出现新的丢帧时输出警告；按配置的间隔输出各阶段的CPU耗时分布。
+ *
+ * @param report 报告状态，报告后更新
+ */
+static void report_pipeline_stats(pipeline_report_t *report)
+{
+    // 第一次检查时启动（包括后台加载命令词模型）早已完成
+    if (!report->boot_reported)
+    {
+        boot_trace_report();
+        report->boot_reported = true;
+    }
+
+#if !CONFIG_ZAPMYCO_USE_AFE
+    audio_capture_stats_t stats = AudioCapture::get_instance()->get_stats();
+    if (stats.overruns != report->reported_overruns)
+    {
+        DLOGW(TAG, "⚠️  采集缓冲区溢出: 累计丢帧 %lu, 峰值占用 %lu/%lu 帧, 读取错误 %lu",
+              (unsigned long)stats.overruns, (unsigned long)stats.peak_fill,
+              (unsigned long)stats.capacity, (unsigned long)stats.read_errors);
+        report->reported_overruns = stats.overruns;
+    }
+#endif
+
+#if CONFIG_ZAPMYCO_STAGE_REPORT_INTERVAL_S > 0
+    int64_t now_us = esp_timer_get_time();
+    uint32_t window_us = (uint32_t)(now_us - report->last_timing_us);
+    if (window_us < CONFIG_ZAPMYCO_STAGE_REPORT_INTERVAL_S * 1000000ULL)
+    {
+        return;
+    }
+    report->last_timing_us = now_us;
+
+    DLOGI(TAG, "各阶段耗时（最近 %lu 秒）:", (unsigned long)(window_us / 1000000));
+#if CONFIG_ZAPMYCO_USE_AFE
+    AfeFrontend *afe = AfeFrontend::get_instance();
+    report_stage("I2S读取等待", afe->get_read_timing(), &report->prev[0], window_us);
+    report_stage("AFE feed", afe->get_feed_timing(), &report->prev[1], window_us);
+    report_stage("AFE fetch(降噪/VAD/唤醒词)", afe->get_fetch_timing(), &report->prev[2], window_us);
+#else
+    report_stage("唤醒词检测", wakenet_timing, &report->prev[0], window_us);
+#endif
+#if CONFIG_ZAPMYCO_VAD_GATE
+    vad_gate_stats_t gate = vad_gate.get_stats();
+    uint32_t gate_total = gate.frames_processed + gate.frames_skipped;
+    DLOGI(TAG, "  - 语音门控: 检测 %lu 帧, 跳过 %lu 帧 (%lu%%), 打开 %lu 次, 噪声底 %lu",
+          (unsigned long)gate.frames_processed, (unsigned long)gate.frames_skipped,
+          (unsigned long)(gate_total ? (uint64_t)gate.frames_skipped * 100 / gate_total : 0),
+          (unsigned long)gate.opens, (unsigned long)gate.noise_floor);
+#endif
+    report_stage("命令词识别", multinet_timing, &report->prev[3], window_us);
+
+#if CONFIG_ZAPMYCO_USE_AFE
+    // 等待唤醒状态不统计实时预算，见 recognition_task()
+    DLOGI(TAG, "  - 实时预算(等待唤醒): 唤醒词检测在AFE fetch内完成，见上面的AFE fetch耗时");
+    static const char *const BUDGET_SCOPE = ", 不含AFE fetch";
+#else
+    static const char *const BUDGET_SCOPE = "";
+#endif
+    // 快照含直方图，放在静态区避免占用识别任务栈
+    static deadline_snapshot_t deadline_now;
+    for (int state = 0; state < 2; state++)
+    {
+        frame_deadline[state].snapshot(&deadline_now);
+        deadline_window_t w = DeadlineMonitor::window(report->deadline_prev[state], deadline_now);
+        report->deadline_prev[state] = deadline_now;
+        if (w.frames == 0)
+        {
+            continue;
+        }
+        DLOGI(TAG, "  - 实时预算(%s%s): 负载 最小 %lu%% / 平均 %lu%% / p99 %lu%% / 最大 %lu%%, 超时 %lu/%lu 帧",
+              STATE_NAMES[state], BUDGET_SCOPE,
+              (unsigned long)(w.min_permille / 10), (unsigned long)(w.avg_permille / 10),
+              (unsigned long)(w.p99_permille / 10), (unsigned long)(w.max_permille / 10),
+              (unsigned long)w.misses, (unsigned long)w.frames);
+    }
+
+    stage_timing_snapshot_t latency = AudioPlayer::get_instance()->get_start_latency().snapshot();
+    if (latency.count > 0)
+    {
+        DLOGI(TAG, "  - 提示音启动延迟: 平均 %lu us, 最大 %lu us (%lu 个片段)",
+              (unsigned long)(latency.total_us / latency.count),
+              (unsigned long)AudioPlayer::get_instance()->get_max_start_latency_us(),
+              (unsigned long)latency.count);
+    }
+#endif
+
+    uint32_t accepted = command_arbiter.get_count(ARBITER_ACCEPT);
+    uint32_t say_again = command_arbiter.get_count(ARBITER_SAY_AGAIN);
+    uint32_t ignored = command_arbiter.get_count(ARBITER_IGNORE);
+    if (accepted + say_again + ignored > 0)
+    {
+        DLOGI(TAG, "  - 命令仲裁: 接受 %lu 次, 请求重说 %lu 次, 忽略 %lu 次",
+              (unsigned long)accepted, (unsigned long)say_again, (unsigned long)ignored);
+    }
+
+    CommandExecutor *executor = CommandExecutor::get_instance();
+    stage_timing_snapshot_t wait = executor->get_wait_timing().snapshot();
+    stage_timing_snapshot_t run = executor->get_run_timing().snapshot();
+    if (run.count > 0)
+    {
+        DLOGI(TAG, "  - 命令执行: %lu 条, 排队 平均 %lu us / 最大 %lu us, 执行 平均 %lu us, 拒绝 %lu 条",
+              (unsigned long)run.count, (unsigned long)(wait.count ? wait.total_us / wait.count : 0),
+              (unsigned long)executor->get_max_wait_us(), (unsigned long)(run.total_us / run.count),
+              (unsigned long)executor->get_rejected());
+    }
+}
+
+/**
+ * @brief 记录一帧的处理耗时，实时余量告警状态变化时输出日志
+ *
+ * @param state 处理该帧时的系统状态
+ * @param cycles 处理该帧消耗的CPU周期数
+ */
+static void record_frame_cycles(system_state_t state, uint32_t cycles)
+{
+    DeadlineMonitor &monitor = frame_deadline[state];
+    deadline_event_t event = monitor.record(cycles);
+    if (event == DEADLINE_EVENT_HEADROOM_LOW)
+    {
+        DLOGW(TAG, "⚠️  实时余量不足: %s 状态平滑负载 %lu%%，采集缓冲区将开始积压",
+              STATE_NAMES[state], (unsigned long)(monitor.smoothed_permille() / 10));
+    }
+    else if (event == DEADLINE_EVENT_HEADROOM_OK)
+    {
+        DLOGI(TAG, "实时余量恢复: %s 状态平滑负载 %lu%%",
+              STATE_NAMES[state], (unsigned long)(monitor.smoothed_permille() / 10));
+    }
+}
+
+/**
+ * @brief 识别任务
+ *
+ * 从采集环形缓冲区逐帧取出音频，执行唤醒词检测和命令词识别。
+ * 采集在另一个核心上独立进行，本任务处理变慢时音频会在缓冲区中排队。
+ * 每帧从取到音频到处理完的CPU周期数与帧时长比较，记入实时预算统计。
+ *
+ * @param arg 未使用
+ */
+static void recognition_task(void *arg)
+{
+    static pipeline_report_t report = {}; // 含直方图快照，放在静态区避免占用任务栈
+    report.last_timing_us = esp_timer_get_time();
+    uint32_t frame_count = 0;
+#if CONFIG_ZAPMYCO_USE_AFE
+    uint32_t fetch_failures = 0;
+    TickType_t last_fetch_error_log = xTaskGetTickCount() - pdMS_TO_TICKS(1000);
+#endif
+
+    while (1)
+    {
+        handle_command_events();
+
+#if CONFIG_ZAPMYCO_USE_AFE
+        // 从AFE取出降噪后的音频和唤醒状态（唤醒词检测在AFE内部完成）
+        afe_fetch_result_t *result = AfeFrontend::get_instance()->fetch();
+        if (result == NULL)
+        {
+            // 持续失败时每秒只记一次日志，并让出CPU，避免空转占满识别核心
+            fetch_failures++;
+            TickType_t now = xTaskGetTickCount();
+            if (now - last_fetch_error_log >= pdMS_TO_TICKS(1000))
+            {
+                DLOGE(TAG, "AFE音频数据获取失败（累计 %lu 次）", (unsigned long)fetch_failures);
+                last_fetch_error_log = now;
+            }
+            vTaskDelay(1);
+            continue;
+        }
+        system_state_t frame_state = current_state;
+        uint32_t frame_start = esp_cpu_get_cycle_count();
+
+        // 记入历史缓冲区，唤醒后可回灌给命令词模型
+        uint32_t frame_index = audio_history.is_ready() ? audio_history.push(result->data) : 0;
+
+        if (current_state == STATE_WAITING_WAKEUP)
+        {
+            if (result->wakeup_state == WAKENET_DETECTED)
+            {
+                on_wake_detected(frame_index, frame_index);
+            }
+        }
+        else if (current_state == STATE_WAITING_COMMAND)
+        {
+            process_command_stage(result->data, frame_index);
+        }
+#else
+        // 从采集缓冲区获取一帧音频数据
+        AudioCapture *capture = AudioCapture::get_instance();
+        const int16_t *frame = capture->wait_frame(pdMS_TO_TICKS(1000));
+        if (frame == NULL)
+        {
+            DLOGE(TAG, "麦克风音频数据获取超时");
+            DLOGE(TAG, "请检查INMP441硬件连接");
+            continue;
+        }
+        system_state_t frame_state = current_state;
+        uint32_t frame_start = esp_cpu_get_cycle_count();
+
+        // 记入历史缓冲区，唤醒后可回灌给命令词模型
+        uint32_t frame_index = audio_history.is_ready() ? audio_history.push(frame) : 0;
+
+        // 模型接口要求非const指针，但不会修改输入数据
+        process_audio_frame(const_cast<int16_t *>(frame), frame_index);
+        capture->release_frame();
+#endif
+        uint32_t frame_cycles = esp_cpu_get_cycle_count() - frame_start;
+#if CONFIG_ZAPMYCO_USE_AFE
+        // 唤醒词检测在 fetch() 内完成，而 fetch() 的耗时又包含等待 feed 的时间，
+        // 等待唤醒状态没有可按帧统计的处理耗时；等待命令状态只统计 fetch() 之后的识别
+        if (frame_state == STATE_WAITING_COMMAND)
+        {
+            record_frame_cycles(frame_state, frame_cycles);
+        }
+#else
+        record_frame_cycles(frame_state, frame_cycles);
+#endif
+
+        if (frame_count == 0)
+        {
+            boot_trace_mark("开始监听");
+        }
+        if (++frame_count % STATS_REPORT_FRAMES == 0)
+        {
+            report_pipeline_stats(&report);
+        }
+    }
+}
+
+/**
+ * @brief 初始化步骤：外接LED（可选）
+ */
+static esp_err_t init_step_led(void *arg)
+{
+    return init_led();
+}
+
+/**
+ * @brief 初始化步骤：命令管理器
+ */
+static esp_err_t init_step_commands(void *arg)
+{
+    DLOGI(TAG, "正在初始化命令管理器...");
+    esp_err_t ret = CommandManager::get_instance()->initialize(COMMAND_PARTITION_LABEL);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    ret = CommandExecutor::get_instance()->start(COMMAND_TASK_CORE, COMMAND_TASK_PRIORITY,
+                                                           COMMAND_TASK_STACK_SIZE);
+    if (ret != ESP_OK)
+    {
+        DLOGE(TAG, "命令执行任务启动失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    DLOGI(TAG, "✓ 命令管理器初始化完成");
+    return ESP_OK;
+}
+
+/**
+ * @brief 初始化步骤：INMP441麦克风（I2S RX）
+ */
+static esp_err_t init_step_microphone(void *arg)
+{
+    DLOGI(TAG, "正在初始化INMP441数字麦克风...");
+    DLOGI(TAG, "音频参数: 采样率16kHz, 单声道, %d位I2S槽", MIC_SLOT_BITS);
+
+    esp_err_t ret = bsp_board_init(16000, 1, MIC_SLOT_BITS); // 16kHz, 单声道
+    if (ret != ESP_OK)
+    {
+        DLOGE(TAG, "INMP441麦克风初始化失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "请检查硬件连接: VDD->3.3V, GND->GND, SD->GPIO6, WS->GPIO4, SCK->GPIO5");
+        return ret;
+    }
+#if CONFIG_ZAPMYCO_MIC_32BIT_CAPTURE
+    bsp_set_feed_shift(CONFIG_ZAPMYCO_MIC_32BIT_SHIFT);
+#endif
+    sample_conditioner_config_t conditioning = SAMPLE_CONDITIONER_DEFAULT_CONFIG();
+    conditioning.gain_shift = CONFIG_ZAPMYCO_MIC_GAIN_SHIFT;
+    conditioning.clamp_limit = CONFIG_ZAPMYCO_MIC_CLAMP_LIMIT;
+#if CONFIG_ZAPMYCO_MIC_DC_REMOVAL
+    conditioning.dc_removal = true;
+#endif
+    bsp_set_feed_conditioning(&conditioning);
+    DLOGI(TAG, "✓ INMP441麦克风初始化成功");
+    return ESP_OK;
+}
+
+/**
+ * @brief 初始化步骤：MAX98357A功放（I2S TX）和播放任务
+ */
+static esp_err_t init_step_speaker(void *arg)
+{
+    DLOGI(TAG, "正在初始化音频播放功能...");
+    DLOGI(TAG, "音频播放参数: 采样率16kHz, 单声道, 16位深度");
+
+    esp_err_t ret = bsp_audio_init(16000, 1, 16); // 16kHz, 单声道, 16位
+    if (ret != ESP_OK)
+    {
+        DLOGE(TAG, "音频播放初始化失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "请检查MAX98357A硬件连接: DIN->GPIO7, BCLK->GPIO15, LRC->GPIO16");
+        return ret;
+    }
+
+    // 播放任务在后台按块输出提示音，调用者无需等待播放结束
+    ret = AudioPlayer::get_instance()->start(PLAYER_TASK_CORE, PLAYER_TASK_PRIORITY);
+    if (ret != ESP_OK)
+    {
+        DLOGE(TAG, "音频播放任务启动失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    DLOGI(TAG, "✓ 音频播放初始化成功");
+    return ESP_OK;
+}
+
+/**
+ * @brief 初始化步骤：提示音分区（可选）
+ *
+ * 提示音放在独立的数据分区，映射后零拷贝播放；分区缺失时只是没有提示音
+ */
+static esp_err_t init_step_prompts(void *arg)
+{
+    esp_err_t ret = PromptStore::get_instance()->init(PROMPT_PARTITION_LABEL);
+    if (ret != ESP_OK)
+    {
+        DLOGW(TAG, "提示音不可用，将静默执行命令");
+    }
+    return ret;
+}
 
+/**
+ * @brief 初始化步骤：从模型分区加载模型列表并选择唤醒词模型
+ */
+static esp_err_t init_step_models(void *arg)
+{
     // 检查内存状态
     size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
     size_t free_internal = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
     size_t free_spiram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
 
-    ESP_LOGI(TAG, "内存状态检查:");
-    ESP_LOGI(TAG, "  - 总可用内存: %zu KB", free_heap / 1024);
-    ESP_LOGI(TAG, "  - 内部RAM: %zu KB", free_internal / 1024);
-    ESP_LOGI(TAG, "  - PSRAM: %zu KB", free_spiram / 1024);
+    DLOGI(TAG, "内存状态检查:");
+    DLOGI(TAG, "  - 总可用内存: %zu KB", free_heap / 1024);
+    DLOGI(TAG, "  - 内部RAM: %zu KB", free_internal / 1024);
+    DLOGI(TAG, "  - PSRAM: %zu KB", free_spiram / 1024);
 
     if (free_heap < 100 * 1024)
     {
-        ESP_LOGE(TAG, "可用内存不足，需要至少100KB");
-        return;
+        DLOGE(TAG, "可用内存不足，需要至少100KB");
+        return ESP_ERR_NO_MEM;
     }
 
     // 从模型目录加载所有可用的语音识别模型
-    ESP_LOGI(TAG, "开始加载模型文件...");
+    DLOGI(TAG, "开始加载模型文件...");
 
     // 临时添加错误处理和重试机制
     srmodel_list_t *models = NULL;
@@ -153,248 +1137,261 @@ extern "C" void app_main(void)
 
     while (models == NULL && retry_count < max_retries)
     {
-        ESP_LOGI(TAG, "尝试加载模型 (第%d次)...", retry_count + 1);
+        DLOGI(TAG, "尝试加载模型 (第%d次)...", retry_count + 1);
 
         // 在每次重试前等待一下
         if (retry_count > 0)
         {
             vTaskDelay(pdMS_TO_TICKS(1000));
+            boot_trace_mark("重试等待");
         }
 
         models = esp_srmodel_init("model");
 
         if (models == NULL)
         {
-            ESP_LOGW(TAG, "模型加载失败，准备重试...");
+            boot_trace_mark("模型分区(失败)");
+            DLOGW(TAG, "模型加载失败，准备重试...");
             retry_count++;
         }
     }
     if (models == NULL)
     {
-        ESP_LOGE(TAG, "语音识别模型初始化失败");
-        ESP_LOGE(TAG, "请检查模型文件是否正确烧录到Flash分区");
-        return;
+        DLOGE(TAG, "语音识别模型初始化失败");
+        DLOGE(TAG, "请检查模型文件是否正确烧录到Flash分区");
+        return ESP_ERR_NOT_FOUND;
     }
 
     // 自动选择sdkconfig中配置的唤醒词模型（如果配置了多个模型则选择第一个）
     char *model_name = esp_srmodel_filter(models, ESP_WN_PREFIX, NULL);
     if (model_name == NULL)
     {
-        ESP_LOGE(TAG, "未找到任何唤醒词模型！");
-        ESP_LOGE(TAG, "请确保已正确配置并烧录唤醒词模型文件");
-        ESP_LOGE(TAG, "可通过 'idf.py menuconfig' 配置唤醒词模型");
-        return;
+        DLOGE(TAG, "未找到任何唤醒词模型！");
+        DLOGE(TAG, "请确保已正确配置并烧录唤醒词模型文件");
+        DLOGE(TAG, "可通过 'idf.py menuconfig' 配置唤醒词模型");
+        return ESP_ERR_NOT_FOUND;
     }
 
-    ESP_LOGI(TAG, "✓ 选择唤醒词模型: %s", model_name);
+    DLOGI(TAG, "✓ 选择唤醒词模型: %s", model_name);
+    sr_models = models;
+    wn_model_name = model_name;
+    return ESP_OK;
+}
+
+/**
+ * @brief 初始化步骤：创建唤醒词模型（AFE模式下创建AFE）
+ */
+static esp_err_t init_step_wakenet(void *arg)
+{
+    DLOGI(TAG, "正在初始化唤醒词检测模型...");
 
+#if CONFIG_ZAPMYCO_USE_AFE
+    // AFE内部创建唤醒词模型，降噪和VAD在唤醒词检测之前完成
+    AfeFrontend *afe = AfeFrontend::get_instance();
+    esp_err_t ret = afe->init(sr_models, wn_model_name);
+    if (ret != ESP_OK)
+    {
+        DLOGE(TAG, "AFE音频前端初始化失败: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    recognition_chunk_samples = afe->get_fetch_chunksize();
+#else
     // 获取唤醒词检测接口
-    esp_wn_iface_t *wakenet = (esp_wn_iface_t *)esp_wn_handle_from_name(model_name);
+    wakenet = (esp_wn_iface_t *)esp_wn_handle_from_name(wn_model_name);
     if (wakenet == NULL)
     {
-        ESP_LOGE(TAG, "获取唤醒词接口失败，模型: %s", model_name);
-        return;
+        DLOGE(TAG, "获取唤醒词接口失败，模型: %s", wn_model_name);
+        return ESP_ERR_NOT_FOUND;
     }
 
     // 创建唤醒词模型数据实例
     // DET_MODE_90: 检测模式，90%置信度阈值，平衡准确率和误触发率
-    model_iface_data_t *model_data = wakenet->create(model_name, DET_MODE_90);
-    if (model_data == NULL)
+    wn_model_data = wakenet->create(wn_model_name, DET_MODE_90);
+    if (wn_model_data == NULL)
     {
-        ESP_LOGE(TAG, "创建唤醒词模型数据失败");
-        return;
+        DLOGE(TAG, "创建唤醒词模型数据失败");
+        return ESP_ERR_NO_MEM;
     }
 
-    // ========== 第五步：初始化命令词识别模型 ==========
-    ESP_LOGI(TAG, "正在初始化命令词识别模型...");
+    // 获取模型要求的音频数据块大小（样本数）
+    recognition_chunk_samples = wakenet->get_samp_chunksize(wn_model_data);
+#endif
+    return ESP_OK;
+}
 
-    // 获取中文命令词识别模型（MultiNet7）
-    char *mn_name = esp_srmodel_filter(models, ESP_MN_PREFIX, ESP_MN_CHINESE);
-    if (mn_name == NULL)
+/**
+ * @brief 初始化步骤：命令词识别模型
+ *
+ * 后台加载模式下只创建加载任务，识别任务启动后再通知加载
+ */
+static esp_err_t init_step_multinet(void *arg)
+{
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+    // 命令词模型在后台创建，唤醒词检测先开始监听
+    BaseType_t ret = xTaskCreatePinnedToCore(multinet_loader_task, "mn_loader", MULTINET_LOADER_STACK_SIZE,
+                                             NULL, MULTINET_LOADER_PRIORITY, &multinet_loader,
+                                             MULTINET_LOADER_CORE);
+    if (ret != pdPASS)
     {
-        ESP_LOGE(TAG, "未找到中文命令词识别模型！");
-        ESP_LOGE(TAG, "请确保已正确配置并烧录MultiNet7中文模型");
-        return;
+        DLOGE(TAG, "命令词模型加载任务创建失败");
+        return ESP_ERR_NO_MEM;
     }
+    return ESP_OK;
+#else
+    DLOGI(TAG, "正在初始化命令词识别模型...");
+    return load_multinet();
+#endif
+}
 
-    ESP_LOGI(TAG, "✓ 选择命令词模型: %s", mn_name);
-
-    // 获取命令词识别接口
-    multinet = esp_mn_handle_from_name(mn_name);
-    if (multinet == NULL)
+/**
+ * @brief 初始化步骤：启动麦克风采集任务（AFE模式下为feed任务）
+ */
+static esp_err_t init_step_capture(void *arg)
+{
+#if CONFIG_ZAPMYCO_USE_AFE
+    // feed任务独占一个核心，持续把麦克风音频送入AFE
+    esp_err_t ret = AfeFrontend::get_instance()->start(CAPTURE_TASK_CORE, CAPTURE_TASK_PRIORITY);
+#else
+    // 采集任务独占一个核心，持续把音频帧写入无锁环形缓冲区
+    esp_err_t ret = AudioCapture::get_instance()->start(recognition_chunk_samples, CAPTURE_RING_FRAMES,
+                                                        CAPTURE_TASK_CORE, CAPTURE_TASK_PRIORITY);
+#endif
+    if (ret != ESP_OK)
     {
-        ESP_LOGE(TAG, "获取命令词识别接口失败，模型: %s", mn_name);
-        return;
+        DLOGE(TAG, "麦克风采集任务启动失败: %s", esp_err_to_name(ret));
+        DLOGE(TAG, "请检查系统可用内存");
     }
+    return ret;
+}
 
-    // 创建命令词模型数据实例
-    mn_model_data = multinet->create(mn_name, 6000);
-    if (mn_model_data == NULL)
+/**
+ * @brief 初始化步骤：预录音缓冲区和语音门控
+ */
+static esp_err_t init_step_history(void *arg)
+{
+    // 预录音缓冲区放在PSRAM，分配失败时只是关闭回灌功能
+    size_t history_frames = PREROLL_HISTORY_MS * AUDIO_SAMPLE_RATE / 1000 / recognition_chunk_samples;
+    int16_t *history_storage = (int16_t *)heap_caps_malloc(history_frames * recognition_chunk_samples * sizeof(int16_t),
+                                                           MALLOC_CAP_SPIRAM);
+    if (history_storage == NULL || !audio_history.init(history_storage, recognition_chunk_samples, history_frames))
     {
-        ESP_LOGE(TAG, "创建命令词模型数据失败");
-        return;
+        DLOGW(TAG, "预录音缓冲区分配失败，唤醒后不回灌历史音频");
     }
 
-    // 配置自定义命令词
-    ESP_LOGI(TAG, "正在配置命令词...");
-    esp_err_t cmd_config_ret = cmd_manager->configure_commands(multinet, mn_model_data);
-    if (cmd_config_ret != ESP_OK)
-    {
-        ESP_LOGE(TAG, "命令词配置失败");
-        return;
-    }
-    ESP_LOGI(TAG, "✓ 命令词配置完成");
+#if CONFIG_ZAPMYCO_VAD_GATE
+    vad_gate_config_t gate_config = VAD_GATE_DEFAULT_CONFIG();
+    vad_gate.init(gate_config);
+#endif
+    return ESP_OK;
+}
 
-    // ========== 第六步：准备音频缓冲区 ==========
-    // 获取模型要求的音频数据块大小（样本数 × 每样本字节数）
-    int audio_chunksize = wakenet->get_samp_chunksize(model_data) * sizeof(int16_t);
+/**
+ * @brief 初始化步骤：启动识别任务
+ */
+static esp_err_t init_step_recognition(void *arg)
+{
+    // 显示系统配置信息
+    DLOGI(TAG, "✓ 智能语音助手系统配置完成:");
+    DLOGI(TAG, "  - 唤醒词模型: %s", wn_model_name);
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+    DLOGI(TAG, "  - 命令词模型: 后台加载（唤醒词先开始监听）");
+#else
+    DLOGI(TAG, "  - 命令词模型: %s", mn_model_name);
+#endif
+    DLOGI(TAG, "  - 音频块大小: %d 字节", (int)(recognition_chunk_samples * sizeof(int16_t)));
+#if CONFIG_ZAPMYCO_USE_AFE
+    DLOGI(TAG, "  - 音频前端: AFE (降噪+VAD+唤醒词), feed核心%d, fetch/识别核心%d",
+          CAPTURE_TASK_CORE, RECOGNITION_TASK_CORE);
+#else
+    DLOGI(TAG, "  - 音频前端: 直接识别, 采集缓冲 %d 帧 (核心%d), 识别任务核心%d",
+          CAPTURE_RING_FRAMES, CAPTURE_TASK_CORE, RECOGNITION_TASK_CORE);
+#endif
+    DLOGI(TAG, "  - 预录音: %zu 帧 (PSRAM), 唤醒后回灌 %d ms", audio_history.capacity(), WAKE_REPLAY_MS);
+#if CONFIG_ZAPMYCO_VAD_GATE
+    DLOGI(TAG, "  - 语音门控: 开启, 打开时回灌 %d ms", VAD_LOOKBACK_MS);
+#endif
+    DLOGI(TAG, "  - 检测置信度: 90%%");
+    DLOGI(TAG, "正在启动智能语音助手...");
+    DLOGI(TAG, "请对着麦克风说出唤醒词 '你好小智'");
 
-    // 分配音频数据缓冲区内存
-    int16_t *buffer = (int16_t *)malloc(audio_chunksize);
-    if (buffer == NULL)
+    // 每帧的周期预算：帧时长 × CPU频率；识别任务绑定在一个核心上，周期计数不会跨核
+    uint32_t frame_us = (uint32_t)((uint64_t)recognition_chunk_samples * 1000000 / AUDIO_SAMPLE_RATE);
+    deadline_monitor_config_t deadline_config = DEADLINE_MONITOR_DEFAULT_CONFIG(frame_us * esp_rom_get_cpu_ticks_per_us());
+    deadline_config.warn_headroom_permille = CONFIG_ZAPMYCO_DEADLINE_WARN_HEADROOM_PCT * 10;
+    for (int state = 0; state < 2; state++)
     {
-        ESP_LOGE(TAG, "音频缓冲区内存分配失败，需要 %d 字节", audio_chunksize);
-        ESP_LOGE(TAG, "请检查系统可用内存");
-        return;
+        frame_deadline[state].init(deadline_config);
     }
+    DLOGI(TAG, "  - 实时预算: 每帧 %lu us, 余量低于 %d%% 时告警", (unsigned long)frame_us,
+          CONFIG_ZAPMYCO_DEADLINE_WARN_HEADROOM_PCT);
 
-    // 显示系统配置信息
-    ESP_LOGI(TAG, "✓ 智能语音助手系统配置完成:");
-    ESP_LOGI(TAG, "  - 唤醒词模型: %s", model_name);
-    ESP_LOGI(TAG, "  - 命令词模型: %s", mn_name);
-    ESP_LOGI(TAG, "  - 音频块大小: %d 字节", audio_chunksize);
-    ESP_LOGI(TAG, "  - 检测置信度: 90%%");
-    ESP_LOGI(TAG, "正在启动智能语音助手...");
-    ESP_LOGI(TAG, "请对着麦克风说出唤醒词 '你好小智'");
-
-    // ========== 第七步：主循环 - 实时音频采集与语音识别 ==========
-    ESP_LOGI(TAG, "系统启动完成，等待唤醒词 '你好小智'...");
-
-    while (1)
+    BaseType_t task_ret = xTaskCreatePinnedToCore(recognition_task, "recognition", RECOGNITION_TASK_STACK_SIZE,
+                                                  NULL, RECOGNITION_TASK_PRIORITY, NULL, RECOGNITION_TASK_CORE);
+    if (task_ret != pdPASS)
     {
-        // 从INMP441麦克风获取一帧音频数据
-        // false参数表示获取处理后的音频数据（非原始通道数据）
-        esp_err_t ret = bsp_get_feed_data(false, buffer, audio_chunksize);
-        if (ret != ESP_OK)
-        {
-            ESP_LOGE(TAG, "麦克风音频数据获取失败: %s", esp_err_to_name(ret));
-            ESP_LOGE(TAG, "请检查INMP441硬件连接");
-            vTaskDelay(pdMS_TO_TICKS(10)); // 等待10ms后重试
-            continue;
-        }
-
-        if (current_state == STATE_WAITING_WAKEUP)
-        {
-            // 第一阶段：唤醒词检测
-            wakenet_state_t wn_state = wakenet->detect(model_data, buffer);
-
-            if (wn_state == WAKENET_DETECTED)
-            {
-                ESP_LOGI(TAG, "🎉 检测到唤醒词 '你好小智'！");
-                printf("=== 唤醒词检测成功！模型: %s ===\n", model_name);
-
-                // 播放欢迎音频
-                ESP_LOGI(TAG, "播放欢迎音频...");
-                esp_err_t audio_ret = bsp_play_audio(welcome, welcome_len);
-                if (audio_ret != ESP_OK)
-                {
-                    ESP_LOGE(TAG, "音频播放失败: %s", esp_err_to_name(audio_ret));
-                }
-                else
-                {
-                    ESP_LOGI(TAG, "✓ 欢迎音频播放成功");
-                }
-
-                // 切换到命令词识别状态
-                current_state = STATE_WAITING_COMMAND;
-                command_timeout_start = xTaskGetTickCount();
-                multinet->clean(mn_model_data); // 清理命令词识别缓冲区
-                ESP_LOGI(TAG, "进入命令词识别模式，请说出指令...");
-                ESP_LOGI(TAG, "支持的指令: '帮我开灯'、'帮我关灯' 或 '拜拜'");
-            }
-        }
-        else if (current_state == STATE_WAITING_COMMAND)
-        {
-            // 第二阶段：命令词识别
-            esp_mn_state_t mn_state = multinet->detect(mn_model_data, buffer);
-
-            if (mn_state == ESP_MN_STATE_DETECTED)
-            {
-                // 获取识别结果
-                esp_mn_results_t *mn_result = multinet->get_results(mn_model_data);
-                if (mn_result->num > 0)
-                {
-                    int command_id = mn_result->command_id[0];
-                    float prob = mn_result->prob[0];
-
-                    const char *cmd_desc = cmd_manager->get_command_description(command_id);
-                    ESP_LOGI(TAG, "🎯 检测到命令词: ID=%d, 置信度=%.2f, 内容=%s, 命令='%s'",
-                             command_id, prob, mn_result->string, cmd_desc);
-
-                    // 执行命令
-                    command_result_t result = cmd_manager->execute_command(command_id);
-
-                    if (result == COMMAND_RESULT_EXIT_REQUESTED)
-                    {
-                        ESP_LOGI(TAG, "� 检测到拜拜命令，立即退出");
-                        execute_exit_logic();
-                        continue; // 跳过后续的超时重置逻辑，直接进入下一次循环
-                    }
-                    else if (result == COMMAND_RESULT_NOT_FOUND)
-                    {
-                        ESP_LOGW(TAG, "⚠️  未知命令ID: %d", command_id);
-                    }
-                    else if (result == COMMAND_RESULT_EXECUTE_FAILED)
-                    {
-                        ESP_LOGE(TAG, "❌ 命令执行失败: ID=%d", command_id);
-                    }
-                    // COMMAND_RESULT_SUCCESS 情况下不需要额外处理
-                }
-
-                // 命令处理完成，重新开始5秒倒计时，继续等待下一个命令
-                command_timeout_start = xTaskGetTickCount();
-                multinet->clean(mn_model_data); // 清理命令词识别缓冲区
-                ESP_LOGI(TAG, "命令执行完成，重新开始5秒倒计时");
-                ESP_LOGI(TAG, "可以继续说出指令: '帮我开灯'、'帮我关灯' 或 '拜拜'");
-            }
-            else if (mn_state == ESP_MN_STATE_TIMEOUT)
-            {
-                ESP_LOGW(TAG, "⏰ 命令词识别超时");
-                execute_exit_logic();
-            }
-            else
-            {
-                // 检查手动超时
-                TickType_t current_time = xTaskGetTickCount();
-                if ((current_time - command_timeout_start) > pdMS_TO_TICKS(COMMAND_TIMEOUT_MS))
-                {
-                    ESP_LOGW(TAG, "⏰ 命令词等待超时 (%lu秒)", (unsigned long)(COMMAND_TIMEOUT_MS / 1000));
-                    execute_exit_logic();
-                }
-            }
-        }
-
-        // 短暂延时，避免CPU占用过高，同时保证实时性
-        vTaskDelay(pdMS_TO_TICKS(1));
+        DLOGE(TAG, "识别任务创建失败");
+        return ESP_ERR_NO_MEM;
     }
 
-    // ========== 资源清理 ==========
-    // 注意：由于主循环是无限循环，以下代码正常情况下不会执行
-    // 仅在程序异常退出时进行资源清理
-    ESP_LOGI(TAG, "正在清理系统资源...");
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+    request_multinet_load();
+#endif
+    return ESP_OK;
+}
+
+/**
+ * @brief 应用程序主入口函数
+ *
+ * 把初始化过程描述为依赖图：模型加载与I2S、GPIO等外设初始化互不依赖，
+ * 由app_main和另一核心上的辅助任务并行执行；全部就绪后启动识别任务。
+ */
+extern "C" void app_main(void)
+{
+    // 启动剖析：先输出上一次启动留下的记录，再开始记录本次启动
+    boot_trace_begin();
+    trace_init();
 
-    // 销毁唤醒词模型数据
-    if (model_data != NULL)
+    // 模型加载最耗时，排在最前面优先被执行者取走
+    InitGraph graph;
+    int models = graph.add("模型分区", init_step_models, NULL, 0);
+    int led = graph.add("LED", init_step_led, NULL, 0, true);
+    int commands = graph.add("命令管理器", init_step_commands, NULL, InitGraph::dep(led)); // 命令GPIO可能与LED相同
+    int mic = graph.add("麦克风(I2S RX)", init_step_microphone, NULL, 0);
+    int speaker = graph.add("音频播放(I2S TX)", init_step_speaker, NULL, 0);
+    int prompts = graph.add("提示音分区", init_step_prompts, NULL, 0, true);
+    int wake = graph.add("唤醒词模型", init_step_wakenet, NULL, InitGraph::dep(models));
+#if CONFIG_ZAPMYCO_LAZY_MULTINET
+    const char *multinet_step = "命令词加载任务";
+#else
+    const char *multinet_step = "命令词模型";
+#endif
+    int command_model = graph.add(multinet_step, init_step_multinet, NULL,
+                                  InitGraph::dep(wake) | InitGraph::dep(commands));
+    int capture = graph.add("采集任务", init_step_capture, NULL, InitGraph::dep(mic) | InitGraph::dep(wake));
+    int history = graph.add("预录音缓冲区", init_step_history, NULL, InitGraph::dep(wake));
+    int recognition = graph.add("识别任务", init_step_recognition, NULL,
+                                InitGraph::dep(capture) | InitGraph::dep(history) | InitGraph::dep(command_model) |
+                                InitGraph::dep(speaker) | InitGraph::dep(prompts) | InitGraph::dep(led));
+    if (recognition < 0)
     {
-        wakenet->destroy(model_data);
+        DLOGE(TAG, "初始化依赖图构建失败");
+        return;
     }
 
-    // 释放音频缓冲区内存
-    if (buffer != NULL)
+    init_runner_config_t runner_config = {
+        .core = INIT_HELPER_CORE,
+        .priority = INIT_HELPER_PRIORITY,
+        .stack_size = INIT_HELPER_STACK_SIZE,
+    };
+    esp_err_t ret = init_runner_run(&graph, &runner_config);
+    init_runner_report(graph);
+    if (ret != ESP_OK)
     {
-        free(buffer);
+        DLOGE(TAG, "系统初始化失败，语音助手未启动");
+        return;
     }
 
-    // 删除当前任务
-    vTaskDelete(NULL);
+    // 启动期间的日志直接输出，启动完成后改由低优先级任务输出
+    dlog_start();
+    DLOGI(TAG, "系统启动完成，等待唤醒词 '你好小智'...");
 }
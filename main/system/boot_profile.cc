@@ -0,0 +1,72 @@
+/**
+ * @file boot_profile.cc
+ * @brief 启动阶段剖析表实现
+ */
+
+#include "boot_profile.h"
+#include <cstring>
+
+static const uint32_t MAGIC = 0x46504258; // "XBPF"
+
+void BootProfile::reset(uint32_t boot_count) {
+    memset(this, 0, sizeof(*this));
+    magic_ = MAGIC;
+    boot_count_ = boot_count;
+    checksum_ = compute_checksum();
+}
+
+bool BootProfile::mark(const char *name, uint64_t now_us) {
+    if (count_ >= MAX_MARKS) {
+        return false;
+    }
+
+    mark_t &m = marks_[count_];
+    strncpy(m.name, name, NAME_MAX);
+    m.name[NAME_MAX] = '\0';
+    m.time_us = static_cast<uint32_t>(now_us);
+    count_++;
+    checksum_ = compute_checksum();
+    return true;
+}
+
+bool BootProfile::is_valid() const {
+    return magic_ == MAGIC && count_ <= MAX_MARKS && checksum_ == compute_checksum();
+}
+
+const char* BootProfile::name_at(size_t index) const {
+    return (index < count_) ? marks_[index].name : "";
+}
+
+uint32_t BootProfile::time_at(size_t index) const {
+    return (index < count_) ? marks_[index].time_us : 0;
+}
+
+uint32_t BootProfile::duration_at(size_t index) const {
+    if (index >= count_) {
+        return 0;
+    }
+    return (index == 0) ? marks_[0].time_us : marks_[index].time_us - marks_[index - 1].time_us;
+}
+
+uint32_t BootProfile::total_us() const {
+    return (count_ == 0) ? 0 : marks_[count_ - 1].time_us;
+}
+
+uint32_t BootProfile::compute_checksum() const {
+    // FNV-1a，覆盖表头（不含校验和本身）和已记录的时间点
+    uint32_t hash = 2166136261u;
+    auto feed = [&hash](const void *data, size_t len) {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < len; i++) {
+            hash = (hash ^ p[i]) * 16777619u;
+        }
+    };
+
+    feed(&magic_, sizeof(magic_));
+    feed(&boot_count_, sizeof(boot_count_));
+    feed(&count_, sizeof(count_));
+    if (count_ <= MAX_MARKS) {
+        feed(marks_, sizeof(mark_t) * count_);
+    }
+    return hash;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file boot_profile.h
+ * @brief 启动阶段剖析表
+ *
+ * 启动过程中按顺序记录带名称的时间点，每个时间点表示一个阶段结束，
+ * 阶段耗时为与上一个时间点的差值。表是固定大小的平凡类型，可以直接放在
+ * RTC_NOINIT 内存中跨复位保留；每次记录都会更新校验和，启动中途卡死或
+ * 复位时也能取回已经记录的部分。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 启动剖析表
+ *
+ * 没有构造函数，放在 RTC_NOINIT 内存时不会被启动代码清零，使用前需调用 reset()。
+ * 单线程写入。
+ */
+class BootProfile {
+public:
+    static const size_t MAX_MARKS = 24;     // 最多记录的时间点数
+    static const size_t NAME_MAX = 23;      // 时间点名称最大字节数
+
+    /**
+     * @brief 清空记录，开始新一次启动的剖析
+     * @param boot_count 启动序号
+     */
+    void reset(uint32_t boot_count);
+
+    /**
+     * @brief 记录一个时间点
+     * @param name 阶段名称，超长部分被截断
+     * @param now_us 当前时间（自启动起的微秒数）
+     * @return bool 表已满时返回false
+     */
+    bool mark(const char *name, uint64_t now_us);
+
+    /**
+     * @brief 表头和校验和是否有效（复位后内存内容未知，需先检查）
+     */
+    bool is_valid() const;
+
+    /**
+     * @brief 已记录的时间点数
+     */
+    size_t count() const { return count_; }
+
+    /**
+     * @brief 启动序号
+     */
+    uint32_t boot_count() const { return boot_count_; }
+
+    /**
+     * @brief 按索引取时间点名称
+     */
+    const char* name_at(size_t index) const;
+
+    /**
+     * @brief 按索引取时间点（自启动起的微秒数）
+     */
+    uint32_t time_at(size_t index) const;
+
+    /**
+     * @brief 按索引取阶段耗时（与上一时间点之差，第一个时间点为自启动起的时间）
+     */
+    uint32_t duration_at(size_t index) const;
+
+    /**
+     * @brief 最后一个时间点（微秒），没有记录时为0
+     */
+    uint32_t total_us() const;
+
+private:
+    typedef struct {
+        char name[NAME_MAX + 1];
+        uint32_t time_us;
+    } mark_t;
+
+    uint32_t magic_;
+    uint32_t boot_count_;
+    uint32_t count_;
+    uint32_t checksum_;
+    mark_t marks_[MAX_MARKS];
+
+    uint32_t compute_checksum() const;
+};
@@ -0,0 +1,78 @@
+/**
+ * @file boot_trace.cc
+ * @brief 启动阶段计时实现
+ */
+
+#include "boot_trace.h"
+
+extern "C" {
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+}
+
+static const char *TAG = "启动剖析";
+
+// 跨复位保留的本次启动剖析，以及 boot_trace_begin 时复制出的上一次启动剖析
+static RTC_NOINIT_ATTR BootProfile rtc_profile;
+static BootProfile last_profile;
+static bool last_valid = false;
+static portMUX_TYPE profile_lock = portMUX_INITIALIZER_UNLOCKED;  // 初始化步骤可能在两个核心上同时打点
+
+/**
+ * @brief 输出一份剖析
+ */
+static void print_profile(const char *title, const BootProfile &profile) {
+    uint32_t total_us = profile.total_us();
+    ESP_LOGI(TAG, "%s (第 %lu 次启动, 共 %lu.%lu ms):", title, (unsigned long)profile.boot_count(),
+             (unsigned long)(total_us / 1000), (unsigned long)(total_us % 1000 / 100));
+
+    for (size_t i = 0; i < profile.count(); i++) {
+        uint32_t time_us = profile.time_at(i);
+        uint32_t duration_us = profile.duration_at(i);
+        uint32_t permille = total_us ? (uint32_t)((uint64_t)duration_us * 1000 / total_us) : 0;
+        ESP_LOGI(TAG, "  %8lu.%lu ms  +%7lu.%lu ms %3lu.%lu%%  %s",
+                 (unsigned long)(time_us / 1000), (unsigned long)(time_us % 1000 / 100),
+                 (unsigned long)(duration_us / 1000), (unsigned long)(duration_us % 1000 / 100),
+                 (unsigned long)(permille / 10), (unsigned long)(permille % 10), profile.name_at(i));
+    }
+}
+
+void boot_trace_begin(void) {
+    esp_reset_reason_t reason = esp_reset_reason();
+    last_valid = (reason != ESP_RST_POWERON) && rtc_profile.is_valid();
+    uint32_t boot_count = 1;
+
+    if (last_valid) {
+        last_profile = rtc_profile;
+        boot_count = last_profile.boot_count() + 1;
+        ESP_LOGI(TAG, "复位原因: %d", (int)reason);
+        print_profile("上一次启动", last_profile);
+    }
+
+    rtc_profile.reset(boot_count);
+    boot_trace_mark("启动代码");
+}
+
+void boot_trace_mark(const char *name) {
+    // 在临界区内取时间：两个核心同时打点时，表中的时间点仍按记录顺序递增，阶段耗时不会为负
+    portENTER_CRITICAL(&profile_lock);
+    uint64_t now_us = (uint64_t)esp_timer_get_time();
+    bool recorded = rtc_profile.mark(name, now_us);
+    portEXIT_CRITICAL(&profile_lock);
+    if (!recorded) {
+        ESP_LOGW(TAG, "剖析表已满，丢弃时间点 '%s'", name);
+        return;
+    }
+    ESP_LOGD(TAG, "%s: %llu ms", name, (unsigned long long)(now_us / 1000));
+}
+
+void boot_trace_report(void) {
+    print_profile("本次启动", rtc_profile);
+}
+
+const BootProfile* boot_trace_last(void) {
+    return last_valid ? &last_profile : nullptr;
+}
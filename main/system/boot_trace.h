@@ -0,0 +1,37 @@
+/**
+ * @file boot_trace.h
+ * @brief 启动阶段计时
+ *
+ * 在 app_main 各初始化步骤之间打点，时间取自 esp_timer（从启动代码初始化
+ * esp_timer 起计时，不含二级引导程序）。剖析表放在 RTC_NOINIT 内存中，
+ * 软件复位、看门狗复位和异常重启后仍能取回上一次启动的剖析，
+ * 上电复位时内容无效，会被丢弃。打点可以在任意任务中进行。
+ */
+
+#pragma once
+
+#include "boot_profile.h"
+
+/**
+ * @brief 开始本次启动的剖析
+ *
+ * 在 app_main 开头调用：先保存并输出上一次启动留下的剖析，再清空表。
+ */
+void boot_trace_begin(void);
+
+/**
+ * @brief 记录一个启动阶段结束
+ * @param name 阶段名称
+ */
+void boot_trace_mark(const char *name);
+
+/**
+ * @brief 输出本次启动的剖析报告
+ */
+void boot_trace_report(void);
+
+/**
+ * @brief 上一次启动的剖析
+ * @return const BootProfile* 上一次启动没有留下有效剖析时返回nullptr
+ */
+const BootProfile* boot_trace_last(void);
@@ -0,0 +1,51 @@
+/**
+ * @file deferred_log.cc
+ * @brief 延迟格式化日志队列实现
+ */
+
+#include "deferred_log.h"
+
+static const uint32_t MASK = DEFERRED_LOG_QUEUE_LENGTH - 1;
+
+DeferredLogQueue::DeferredLogQueue() {
+    // 槽序号等于其可写入的位置；写入后为位置+1，可读；读出后加一圈，供下一轮写入
+    for (uint32_t i = 0; i < DEFERRED_LOG_QUEUE_LENGTH; i++) {
+        cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool DeferredLogQueue::push(const deferred_log_record_t &record) {
+    uint32_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    cell_t *cell;
+    while (1) {
+        cell = &cells_[pos & MASK];
+        int32_t diff = static_cast<int32_t>(cell->seq.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->record = record;
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+bool DeferredLogQueue::pop(deferred_log_record_t *out) {
+    cell_t *cell = &cells_[dequeue_pos_ & MASK];
+    int32_t diff = static_cast<int32_t>(cell->seq.load(std::memory_order_acquire) - (dequeue_pos_ + 1));
+    if (diff < 0) {
+        return false;
+    }
+
+    *out = cell->record;
+    cell->seq.store(dequeue_pos_ + DEFERRED_LOG_QUEUE_LENGTH, std::memory_order_release);
+    dequeue_pos_++;
+    return true;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file deferred_log.h
+ * @brief 延迟格式化日志队列
+ *
+ * 实时路径上只记录格式串指针和原始参数（每个参数 8 字节），格式化和串口输出
+ * 交给低优先级任务完成。参数类型在编译期确定，入队时一并记录对应的格式化函数，
+ * 出队后按原类型还原参数再调用 snprintf。
+ *
+ * 队列为有界多生产者、单消费者，生产者之间无锁（每个槽带序号，CAS 预留位置）；
+ * 队列满时丢弃并计数，不阻塞调用者。
+ *
+ * 字符串参数只记录指针：只能传入字面量或生命周期足够长的静态字符串，
+ * 临时缓冲区中的字符串请继续使用立即输出的日志。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef CONFIG_ZAPMYCO_DEFERRED_LOG_QUEUE_LENGTH
+#define DEFERRED_LOG_QUEUE_LENGTH CONFIG_ZAPMYCO_DEFERRED_LOG_QUEUE_LENGTH
+#else
+#define DEFERRED_LOG_QUEUE_LENGTH 32    // 队列长度（2的幂）
+#endif
+
+#define DEFERRED_LOG_MAX_ARGS 8         // 每条日志最多参数个数
+
+static_assert((DEFERRED_LOG_QUEUE_LENGTH & (DEFERRED_LOG_QUEUE_LENGTH - 1)) == 0, "延迟日志队列长度必须是2的幂");
+
+/**
+ * @brief 参数类别（每个参数 2 位，记录在 arg_types 中，供二进制编码使用）
+ */
+typedef enum {
+    DEFERRED_LOG_ARG_SIGNED = 0,    // 有符号整数、枚举、字符
+    DEFERRED_LOG_ARG_UNSIGNED = 1,  // 无符号整数、非字符串指针
+    DEFERRED_LOG_ARG_FLOAT = 2,     // 浮点数
+    DEFERRED_LOG_ARG_STRING = 3,    // 字符串指针
+} deferred_log_arg_type_t;
+
+/**
+ * @brief 按参数类型还原并格式化的函数
+ */
+typedef int (*deferred_log_formatter_t)(char *buf, size_t size, const char *format, const uint64_t *args);
+
+/**
+ * @brief 一条延迟日志
+ */
+typedef struct {
+    const char *tag;                        // 日志标签（须为静态字符串）
+    const char *format;                     // 格式串（须为静态字符串），令牌化时为nullptr
+    deferred_log_formatter_t formatter;     // 与参数类型对应的格式化函数
+    uint32_t token;                         // 格式串令牌（见 log_token.h），未令牌化时为0
+    uint32_t timestamp_ms;                  // 记录时的时间戳
+    uint16_t arg_types;                     // 各参数类别，第 i 个参数占 [2i, 2i+1] 位
+    uint8_t level;                          // 日志级别
+    uint8_t nargs;                          // 参数个数
+    uint64_t args[DEFERRED_LOG_MAX_ARGS];   // 原始参数
+} deferred_log_record_t;
+
+namespace deferred_log_detail {
+
+template <typename T>
+constexpr uint16_t arg_type() {
+    typedef typename std::remove_cv<typename std::remove_pointer<T>::type>::type pointee;
+    if constexpr (std::is_floating_point<T>::value) {
+        return DEFERRED_LOG_ARG_FLOAT;
+    } else if constexpr (std::is_pointer<T>::value) {
+        return std::is_same<pointee, char>::value ? DEFERRED_LOG_ARG_STRING : DEFERRED_LOG_ARG_UNSIGNED;
+    } else if constexpr (std::is_enum<T>::value) {
+        return std::is_signed<typename std::underlying_type<T>::type>::value ? DEFERRED_LOG_ARG_SIGNED
+                                                                              : DEFERRED_LOG_ARG_UNSIGNED;
+    } else {
+        return std::is_signed<T>::value ? DEFERRED_LOG_ARG_SIGNED : DEFERRED_LOG_ARG_UNSIGNED;
+    }
+}
+
+template <typename... Args>
+constexpr uint16_t arg_types() {
+    uint16_t types = 0;
+    int i = 0;
+    ((types |= static_cast<uint16_t>(arg_type<Args>() << (2 * i++))), ...);
+    (void)i;
+    return types;
+}
+
+template <typename T>
+inline uint64_t pack(T value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_pointer<T>::value || std::is_enum<T>::value,
+                  "延迟日志只支持整数、浮点数、枚举和指针参数");
+    if constexpr (std::is_floating_point<T>::value) {
+        double d = value;
+        uint64_t word;
+        memcpy(&word, &d, sizeof(word));
+        return word;
+    } else if constexpr (std::is_pointer<T>::value) {
+        return reinterpret_cast<uintptr_t>(value);
+    } else if constexpr (std::is_enum<T>::value) {
+        return static_cast<uint64_t>(static_cast<typename std::underlying_type<T>::type>(value));
+    } else {
+        return static_cast<uint64_t>(value);
+    }
+}
+
+template <typename T>
+inline T unpack(uint64_t word) {
+    if constexpr (std::is_floating_point<T>::value) {
+        double d;
+        memcpy(&d, &word, sizeof(d));
+        return static_cast<T>(d);
+    } else if constexpr (std::is_pointer<T>::value) {
+        return reinterpret_cast<T>(static_cast<uintptr_t>(word));
+    } else {
+        return static_cast<T>(word);
+    }
+}
+
+// 经由可变参数函数转发，参数按默认提升规则传入 vsnprintf
+inline int format_va(char *buf, size_t size, const char *format, ...) {
+    va_list ap;
+    va_start(ap, format);
+    int n = vsnprintf(buf, size, format, ap);
+    va_end(ap);
+    return n;
+}
+
+template <typename... Args, size_t... I>
+inline int format_with(char *buf, size_t size, const char *format, const uint64_t *args, std::index_sequence<I...>) {
+    return format_va(buf, size, format, unpack<Args>(args[I])...);
+}
+
+template <typename... Args>
+int format(char *buf, size_t size, const char *format, const uint64_t *args) {
+    return format_with<Args...>(buf, size, format, args, std::index_sequence_for<Args...>{});
+}
+
+} // namespace deferred_log_detail
+
+/**
+ * @brief 填写一条延迟日志（只复制指针和参数，不格式化）
+ */
+template <typename... Args>
+inline void deferred_log_capture(deferred_log_record_t *record, uint8_t level, const char *tag,
+                                 const char *format, uint32_t timestamp_ms, Args... args) {
+    static_assert(sizeof...(Args) <= DEFERRED_LOG_MAX_ARGS, "延迟日志参数过多");
+    record->tag = tag;
+    record->format = format;
+    record->formatter = &deferred_log_detail::format<typename std::decay<Args>::type...>;
+    record->token = 0;
+    record->timestamp_ms = timestamp_ms;
+    record->arg_types = deferred_log_detail::arg_types<typename std::decay<Args>::type...>();
+    record->level = level;
+    record->nargs = sizeof...(Args);
+    size_t i = 0;
+    ((record->args[i++] = deferred_log_detail::pack(args)), ...);
+    (void)i;
+}
+
+/**
+ * @brief 格式化一条延迟日志（令牌化的记录没有格式串，不能调用）
+ * @return int snprintf 的返回值
+ */
+inline int deferred_log_format(const deferred_log_record_t &record, char *buf, size_t size) {
+    return record.formatter(buf, size, record.format, record.args);
+}
+
+/**
+ * @brief 有界多生产者单消费者日志队列
+ */
+class DeferredLogQueue {
+public:
+    DeferredLogQueue();
+
+    DeferredLogQueue(const DeferredLogQueue&) = delete;
+    DeferredLogQueue& operator=(const DeferredLogQueue&) = delete;
+
+    /**
+     * @brief 入队（任意任务，无锁）
+     * @return bool 队列满时丢弃并返回false
+     */
+    bool push(const deferred_log_record_t &record);
+
+    /**
+     * @brief 出队（仅消费者任务）
+     * @return bool 队列为空或队首仍在写入时返回false
+     */
+    bool pop(deferred_log_record_t *out);
+
+    /**
+     * @brief 累计丢弃条数
+     */
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 累计入队条数（含已预留位置、尚在写入的记录）
+     */
+    uint32_t pushed() const { return enqueue_pos_.load(std::memory_order_acquire); }
+
+private:
+    struct cell_t {
+        std::atomic<uint32_t> seq;
+        deferred_log_record_t record;
+    };
+
+    cell_t cells_[DEFERRED_LOG_QUEUE_LENGTH];
+    std::atomic<uint32_t> enqueue_pos_{0};
+    uint32_t dequeue_pos_ = 0;
+    std::atomic<uint32_t> dropped_{0};
+};
@@ -0,0 +1,129 @@
+/**
+ * @file dlog.cc
+ * @brief 延迟日志输出任务
+ */
+
+#include "dlog.h"
+
+#if CONFIG_ZAPMYCO_DEFERRED_LOG
+
+#include <atomic>
+
+extern "C" {
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+}
+
+static const char *TAG = "延迟日志";
+
+// 输出任务配置：串口输出较慢，放在低优先级任务中
+#define DLOG_TASK_CORE 0
+#define DLOG_TASK_PRIORITY 1
+#define DLOG_TASK_STACK_SIZE 4096
+#define DLOG_FLUSH_INTERVAL_MS 20   // 无错误日志时的轮询间隔
+#define DLOG_LINE_SIZE 256          // 单条日志格式化后的最大长度
+
+static DeferredLogQueue queue;
+static TaskHandle_t dlog_task = NULL;
+static std::atomic<bool> started{false};
+static std::atomic<uint32_t> emitted{0};   // 已输出的条数（与队列入队位置同步计数）
+
+/**
+ * @brief 按 ESP_LOGx 的格式输出一条已格式化的日志
+ */
+static void emit_line(esp_log_level_t level, uint32_t timestamp_ms, const char *tag, const char *message) {
+    switch (level) {
+    case ESP_LOG_ERROR:
+        esp_log_write(level, tag, LOG_FORMAT(E, "%s"), timestamp_ms, tag, message);
+        break;
+    case ESP_LOG_WARN:
+        esp_log_write(level, tag, LOG_FORMAT(W, "%s"), timestamp_ms, tag, message);
+        break;
+    case ESP_LOG_INFO:
+        esp_log_write(level, tag, LOG_FORMAT(I, "%s"), timestamp_ms, tag, message);
+        break;
+    default:
+        esp_log_write(level, tag, LOG_FORMAT(D, "%s"), timestamp_ms, tag, message);
+        break;
+    }
+}
+
+static void emit_record(const deferred_log_record_t &record) {
+    if (record.format == nullptr) {
+        // 令牌化：帧编码后按 Base64 输出，标签和时间戳都在令牌表和帧中
+        uint8_t frame[LOG_TOKEN_MAX_FRAME];
+        char line[(LOG_TOKEN_MAX_FRAME + 2) / 3 * 4 + 1];
+        size_t len = log_token_encode(record, frame, sizeof(frame));
+        log_token_base64(frame, len, line);
+        esp_log_write(static_cast<esp_log_level_t>(record.level), record.tag, "ZL:%s\n", line);
+        return;
+    }
+
+    char line[DLOG_LINE_SIZE];
+    deferred_log_format(record, line, sizeof(line));
+    emit_line(static_cast<esp_log_level_t>(record.level), record.timestamp_ms, record.tag, line);
+}
+
+static void dlog_task_main(void *arg) {
+    uint32_t reported_drops = 0;
+    deferred_log_record_t record;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DLOG_FLUSH_INTERVAL_MS));
+
+        while (queue.pop(&record)) {
+            emit_record(record);
+            emitted.fetch_add(1, std::memory_order_release);
+        }
+
+        uint32_t drops = queue.dropped();
+        if (drops != reported_drops) {
+            ESP_LOGW(TAG, "⚠️  日志队列已满，丢弃 %lu 条（累计 %lu 条）",
+                     (unsigned long)(drops - reported_drops), (unsigned long)drops);
+            reported_drops = drops;
+        }
+    }
+}
+
+void dlog_start(void) {
+    BaseType_t ret = xTaskCreatePinnedToCore(dlog_task_main, "dlog", DLOG_TASK_STACK_SIZE, NULL,
+                                             DLOG_TASK_PRIORITY, &dlog_task, DLOG_TASK_CORE);
+    if (ret != pdPASS) {
+        ESP_LOGW(TAG, "输出任务创建失败，延迟日志改为直接输出");
+        dlog_task = NULL;
+        return;
+    }
+    started.store(true, std::memory_order_release);
+    ESP_LOGI(TAG, "✓ 延迟日志已开启: 队列 %d 条", DEFERRED_LOG_QUEUE_LENGTH);
+}
+
+void dlog_submit(const deferred_log_record_t *record) {
+    if (!started.load(std::memory_order_acquire)) {
+        emit_record(*record);
+        return;
+    }
+
+    if (queue.push(*record) && record->level == ESP_LOG_ERROR) {
+        // 错误日志尽快输出，其余等待下一次轮询
+        xTaskNotifyGive(dlog_task);
+    }
+}
+
+uint32_t dlog_dropped(void) {
+    return queue.dropped();
+}
+
+void dlog_sync(void) {
+    if (!started.load(std::memory_order_acquire)) {
+        return;     // 启动前的日志已直接输出
+    }
+
+    // 队列按入队顺序输出，已输出条数追上调用时的入队位置即全部输出
+    uint32_t target = queue.pushed();
+    while (static_cast<int32_t>(emitted.load(std::memory_order_acquire) - target) < 0) {
+        xTaskNotifyGive(dlog_task);
+        vTaskDelay(1);
+    }
+}
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file dlog.h
+ * @brief 延迟日志接口
+ *
+ * DLOGE/DLOGW/DLOGI/DLOGD 与 ESP_LOGx 用法相同，但调用处只把格式串指针和参数
+ * 放入队列（见 deferred_log.h），由低优先级任务格式化并输出到控制台。
+ * 用于识别、命令执行和播放等实时路径；字符串参数必须是静态字符串。
+ * 格式串在编译期按 printf 规则检查；低于 LOG_LOCAL_LEVEL 的调用在编译期去掉。
+ * 输出任务启动前的调用直接输出；关闭 CONFIG_ZAPMYCO_DEFERRED_LOG 时等同于 ESP_LOGx。
+ *
+ * 开启 CONFIG_ZAPMYCO_LOG_TOKENIZED 时格式串换成编译期令牌（见 log_token.h），
+ * 输出为 "ZL:" 加 Base64 帧的文本行，用 tools/log_tokens.py 和构建生成的
+ * log_tokens.json 还原。令牌表通过扫描源码生成，格式串必须直接写成字符串字面量。
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+
+extern "C" {
+#include "esp_log.h"
+}
+
+#if CONFIG_ZAPMYCO_DEFERRED_LOG
+
+#include "deferred_log.h"
+#include "log_token.h"
+
+/**
+ * @brief 启动输出任务
+ */
+void dlog_start(void);
+
+/**
+ * @brief 提交一条日志（任意任务，不阻塞）
+ */
+void dlog_submit(const deferred_log_record_t *record);
+
+/**
+ * @brief 队列满时累计丢弃的条数
+ */
+uint32_t dlog_dropped(void);
+
+/**
+ * @brief 等待此前提交的日志全部输出
+ *
+ * 释放日志参数引用的动态字符串之前调用（如替换命令表后释放旧快照）。
+ * 会阻塞，不能在实时路径和输出任务中调用。
+ */
+void dlog_sync(void);
+
+// 只用于编译期检查格式串，从不调用
+static inline void __attribute__((format(printf, 1, 2))) dlog_check_format(const char *format, ...) {}
+
+template <typename... Args>
+static inline void dlog_write(esp_log_level_t level, const char *tag, const char *format, Args... args) {
+    deferred_log_record_t record;
+    deferred_log_capture(&record, static_cast<uint8_t>(level), tag, format, esp_log_timestamp(), args...);
+    dlog_submit(&record);
+}
+
+template <typename... Args>
+static inline void dlog_write_token(esp_log_level_t level, const char *tag, uint32_t token, Args... args) {
+    deferred_log_record_t record;
+    deferred_log_capture(&record, static_cast<uint8_t>(level), tag, nullptr, esp_log_timestamp(), args...);
+    record.token = token;
+    dlog_submit(&record);
+}
+
+#if CONFIG_ZAPMYCO_LOG_TOKENIZED
+// 格式串只参与编译期计算，不进入固件
+#define DLOG_WRITE(level, letter, tag, format, ...) do {                                      \
+        constexpr uint32_t dlog_token = log_token(letter, format);                            \
+        dlog_write_token((level), (tag), dlog_token, ##__VA_ARGS__);                          \
+    } while (0)
+#else
+#define DLOG_WRITE(level, letter, tag, format, ...) dlog_write((level), (tag), (format), ##__VA_ARGS__)
+#endif
+
+#define DLOG_LEVEL(level, letter, tag, format, ...) do {                 \
+        if (LOG_LOCAL_LEVEL >= (level)) {                                \
+            if (0) {                                                     \
+                dlog_check_format(format, ##__VA_ARGS__);                \
+            }                                                            \
+            DLOG_WRITE(level, letter, tag, format, ##__VA_ARGS__);       \
+        }                                                                \
+    } while (0)
+
+#define DLOGE(tag, format, ...) DLOG_LEVEL(ESP_LOG_ERROR, 'E', tag, format, ##__VA_ARGS__)
+#define DLOGW(tag, format, ...) DLOG_LEVEL(ESP_LOG_WARN, 'W', tag, format, ##__VA_ARGS__)
+#define DLOGI(tag, format, ...) DLOG_LEVEL(ESP_LOG_INFO, 'I', tag, format, ##__VA_ARGS__)
+#define DLOGD(tag, format, ...) DLOG_LEVEL(ESP_LOG_DEBUG, 'D', tag, format, ##__VA_ARGS__)
+
+#else
+
+static inline void dlog_start(void) {}
+static inline uint32_t dlog_dropped(void) { return 0; }
+static inline void dlog_sync(void) {}
+
+#define DLOGE(tag, format, ...) ESP_LOGE(tag, format, ##__VA_ARGS__)
+#define DLOGW(tag, format, ...) ESP_LOGW(tag, format, ##__VA_ARGS__)
+#define DLOGI(tag, format, ...) ESP_LOGI(tag, format, ##__VA_ARGS__)
+#define DLOGD(tag, format, ...) ESP_LOGD(tag, format, ##__VA_ARGS__)
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file init_graph.cc
+ * @brief 启动初始化依赖图实现
+ */
+
+#include "init_graph.h"
+
+int InitGraph::add(const char *name, init_step_fn_t fn, void *arg, uint32_t deps, bool optional) {
+    // 只允许依赖已添加的步骤，保证无环
+    if (count_ >= MAX_STEPS || fn == nullptr || (deps >> count_) != 0) {
+        return -1;
+    }
+
+    init_step_t &s = steps_[count_];
+    s = {};
+    s.name = name;
+    s.fn = fn;
+    s.arg = arg;
+    s.deps = deps;
+    s.optional = optional;
+    s.state = INIT_STEP_PENDING;
+    s.cause = -1;
+    return static_cast<int>(count_++);
+}
+
+bool InitGraph::blocks_dependents(size_t index) const {
+    const init_step_t &s = steps_[index];
+    return s.state == INIT_STEP_SKIPPED || (s.state == INIT_STEP_FAILED && !s.optional);
+}
+
+int InitGraph::take_ready(int core, uint32_t now_us) {
+    for (size_t i = 0; i < count_; i++) {
+        init_step_t &s = steps_[i];
+        if (s.state != INIT_STEP_PENDING) {
+            continue;
+        }
+
+        bool ready = true;
+        for (size_t d = 0; d < i && ready; d++) {
+            if (s.deps & (1u << d)) {
+                ready = (steps_[d].state == INIT_STEP_DONE) ||
+                        (steps_[d].state == INIT_STEP_FAILED && steps_[d].optional);
+            }
+        }
+
+        if (ready) {
+            s.state = INIT_STEP_RUNNING;
+            s.core = core;
+            s.start_us = now_us;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void InitGraph::complete(int index, int status, uint32_t now_us) {
+    if (index < 0 || static_cast<size_t>(index) >= count_ || steps_[index].state != INIT_STEP_RUNNING) {
+        return;
+    }
+
+    init_step_t &s = steps_[index];
+    s.status = status;
+    s.end_us = now_us;
+    s.state = (status == 0) ? INIT_STEP_DONE : INIT_STEP_FAILED;
+    if (!blocks_dependents(index)) {
+        return;
+    }
+
+    // 依赖总是指向更小的索引，按顺序扫描一遍即可传递到间接依赖
+    for (size_t i = index + 1; i < count_; i++) {
+        init_step_t &t = steps_[i];
+        if (t.state != INIT_STEP_PENDING) {
+            continue;
+        }
+        for (size_t d = 0; d < i; d++) {
+            if ((t.deps & (1u << d)) && blocks_dependents(d)) {
+                t.state = INIT_STEP_SKIPPED;
+                t.cause = (steps_[d].state == INIT_STEP_SKIPPED) ? steps_[d].cause : static_cast<int>(d);
+                t.start_us = now_us;
+                t.end_us = now_us;
+                break;
+            }
+        }
+    }
+}
+
+bool InitGraph::finished() const {
+    for (size_t i = 0; i < count_; i++) {
+        if (steps_[i].state == INIT_STEP_PENDING || steps_[i].state == INIT_STEP_RUNNING) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool InitGraph::succeeded() const {
+    for (size_t i = 0; i < count_; i++) {
+        if (steps_[i].state != INIT_STEP_DONE && !(steps_[i].optional && steps_[i].state == INIT_STEP_FAILED)) {
+            return false;
+        }
+    }
+    return true;
+}
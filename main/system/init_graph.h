@@ -0,0 +1,120 @@
+/**
+ * @file init_graph.h
+ * @brief 启动初始化依赖图
+ *
+ * 把启动过程拆成带依赖关系的步骤，互不依赖的步骤可以由多个执行者并行完成。
+ * 依赖只能指向已添加的步骤，因此图天然无环。必需步骤失败时，直接或间接
+ * 依赖它的步骤都被跳过并记录根因；可选步骤失败不影响依赖它的步骤。
+ * 本模块不加锁，多个执行者共用时由调用者互斥（见 init_runner.cc）。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 初始化步骤函数
+ * @param arg 添加步骤时传入的参数
+ * @return int 0表示成功，其他值为错误码（ESP32 上即 esp_err_t）
+ */
+typedef int (*init_step_fn_t)(void *arg);
+
+/**
+ * @brief 步骤状态
+ */
+typedef enum {
+    INIT_STEP_PENDING = 0,  // 等待依赖完成
+    INIT_STEP_RUNNING,      // 正在执行
+    INIT_STEP_DONE,         // 成功
+    INIT_STEP_FAILED,       // 失败
+    INIT_STEP_SKIPPED,      // 因依赖失败而跳过
+} init_step_state_t;
+
+/**
+ * @brief 初始化步骤
+ */
+typedef struct {
+    const char *name;         // 步骤名称
+    init_step_fn_t fn;        // 步骤函数
+    void *arg;                // 步骤函数参数
+    uint32_t deps;            // 依赖步骤的位掩码
+    bool optional;            // 可选步骤：失败时依赖它的步骤照常执行
+    init_step_state_t state;  // 当前状态
+    int status;               // 步骤函数返回值
+    int core;                 // 执行该步骤的核心（或执行者编号）
+    uint32_t start_us;        // 开始时间（微秒）
+    uint32_t end_us;          // 结束时间（微秒）
+    int cause;                // 跳过时为导致跳过的失败步骤索引，否则为-1
+} init_step_t;
+
+/**
+ * @brief 启动初始化依赖图
+ */
+class InitGraph {
+public:
+    static const size_t MAX_STEPS = 16;     // 最多步骤数
+
+    InitGraph() = default;
+
+    /**
+     * @brief 依赖位掩码
+     * @param index add() 返回的步骤索引；无效索引（-1）会让依赖它的 add() 也失败
+     */
+    static uint32_t dep(int index) {
+        return (index >= 0 && index < static_cast<int>(MAX_STEPS)) ? (1u << index) : (1u << 31);
+    }
+
+    /**
+     * @brief 添加步骤
+     * @param name 步骤名称（需在图的生命周期内有效）
+     * @param fn 步骤函数
+     * @param arg 步骤函数参数
+     * @param deps 依赖步骤的位掩码，由 dep() 组合
+     * @param optional 是否为可选步骤
+     * @return int 步骤索引，表满或依赖了不存在的步骤时返回-1
+     */
+    int add(const char *name, init_step_fn_t fn, void *arg, uint32_t deps, bool optional = false);
+
+    /**
+     * @brief 取出一个依赖已满足的步骤并标记为执行中
+     * @param core 执行者所在核心
+     * @param now_us 当前时间（微秒）
+     * @return int 步骤索引，暂时没有可执行的步骤时返回-1
+     */
+    int take_ready(int core, uint32_t now_us);
+
+    /**
+     * @brief 报告步骤执行结果，失败时跳过依赖它的步骤
+     * @param index take_ready() 返回的步骤索引
+     * @param status 步骤函数返回值
+     * @param now_us 当前时间（微秒）
+     */
+    void complete(int index, int status, uint32_t now_us);
+
+    /**
+     * @brief 是否所有步骤都已结束（没有等待或执行中的步骤）
+     */
+    bool finished() const;
+
+    /**
+     * @brief 是否所有必需步骤都已成功
+     */
+    bool succeeded() const;
+
+    /**
+     * @brief 步骤数量
+     */
+    size_t count() const { return count_; }
+
+    /**
+     * @brief 按索引取步骤
+     */
+    const init_step_t& step(size_t index) const { return steps_[index]; }
+
+private:
+    init_step_t steps_[MAX_STEPS] = {};
+    size_t count_ = 0;
+
+    bool blocks_dependents(size_t index) const;
+};
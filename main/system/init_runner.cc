@@ -0,0 +1,169 @@
+/**
+ * @file init_runner.cc
+ * @brief 启动初始化依赖图执行器实现
+ */
+
+#include "init_runner.h"
+#include "boot_trace.h"
+
+extern "C" {
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+}
+
+static const char *TAG = "初始化";
+
+// 执行者数量：调用任务 + 一个辅助任务
+#define INIT_WORKER_COUNT 2
+
+/**
+ * @brief 一次执行的共享状态
+ */
+typedef struct {
+    InitGraph *graph;
+    SemaphoreHandle_t lock;                     // 保护 graph
+    SemaphoreHandle_t helper_done;              // 辅助任务退出信号
+    TaskHandle_t workers[INIT_WORKER_COUNT];    // 步骤结束时需要唤醒的执行者
+} init_run_t;
+
+static inline uint32_t now_us(void) {
+    return (uint32_t)esp_timer_get_time();
+}
+
+/**
+ * @brief 唤醒所有执行者重新检查可执行的步骤
+ */
+static void wake_workers(init_run_t *run) {
+    for (int i = 0; i < INIT_WORKER_COUNT; i++) {
+        if (run->workers[i] != NULL) {
+            xTaskNotifyGive(run->workers[i]);
+        }
+    }
+}
+
+/**
+ * @brief 执行者循环：反复取出可执行的步骤，直到图中所有步骤结束
+ *
+ * 没有可执行的步骤时等待其他执行者完成步骤后的通知。通知会累积，
+ * 检查与等待之间发出的通知不会丢失。
+ */
+static void run_worker(init_run_t *run) {
+    while (1) {
+        xSemaphoreTake(run->lock, portMAX_DELAY);
+        int index = run->graph->take_ready(xPortGetCoreID(), now_us());
+        bool finished = run->graph->finished();
+        xSemaphoreGive(run->lock);
+
+        if (index < 0) {
+            if (finished) {
+                return;
+            }
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        // 步骤函数和参数添加后不再修改，执行期间无需持锁
+        const init_step_t &step = run->graph->step(index);
+        int status = step.fn(step.arg);
+
+        xSemaphoreTake(run->lock, portMAX_DELAY);
+        run->graph->complete(index, status, now_us());
+        xSemaphoreGive(run->lock);
+
+        boot_trace_mark(step.name);
+        if (status != ESP_OK) {
+            ESP_LOGE(TAG, "步骤 '%s' 失败: %s", step.name, esp_err_to_name(status));
+        }
+        wake_workers(run);
+    }
+}
+
+static void helper_task(void *arg) {
+    init_run_t *run = static_cast<init_run_t *>(arg);
+
+    // 等调用任务登记完本任务句柄后再开始，执行者列表之后只读
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    run_worker(run);
+    xSemaphoreGive(run->helper_done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t init_runner_run(InitGraph *graph, const init_runner_config_t *config) {
+    init_run_t run = {};
+    run.graph = graph;
+    run.lock = xSemaphoreCreateMutex();
+    run.helper_done = xSemaphoreCreateBinary();
+    if (run.lock == NULL || run.helper_done == NULL) {
+        ESP_LOGE(TAG, "创建同步对象失败");
+        if (run.lock != NULL) {
+            vSemaphoreDelete(run.lock);
+        }
+        if (run.helper_done != NULL) {
+            vSemaphoreDelete(run.helper_done);
+        }
+        return ESP_ERR_NO_MEM;
+    }
+
+    run.workers[0] = xTaskGetCurrentTaskHandle();
+    TaskHandle_t helper = NULL;
+    BaseType_t ret = xTaskCreatePinnedToCore(helper_task, "init_helper", config->stack_size, &run,
+                                             config->priority, &helper, config->core);
+    if (ret != pdPASS) {
+        ESP_LOGW(TAG, "辅助任务创建失败，串行执行初始化步骤");
+    } else {
+        run.workers[1] = helper;
+        xTaskNotifyGive(helper);
+    }
+
+    run_worker(&run);
+
+    // 辅助任务仍可能在使用共享状态，等它退出后再释放
+    if (ret == pdPASS) {
+        xSemaphoreTake(run.helper_done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(run.helper_done);
+    vSemaphoreDelete(run.lock);
+
+    // 清掉执行期间累积的通知，调用任务之后的等待不受影响
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    return graph->succeeded() ? ESP_OK : ESP_FAIL;
+}
+
+void init_runner_report(const InitGraph &graph) {
+    static const char *const STATE_NAMES[] = {"等待", "执行中", "完成", "失败", "跳过"};
+
+    uint32_t first_us = UINT32_MAX;
+    uint32_t last_us = 0;
+    uint64_t busy_us = 0;
+    for (size_t i = 0; i < graph.count(); i++) {
+        const init_step_t &s = graph.step(i);
+        if (s.state == INIT_STEP_DONE || s.state == INIT_STEP_FAILED) {
+            first_us = (s.start_us < first_us) ? s.start_us : first_us;
+            last_us = (s.end_us > last_us) ? s.end_us : last_us;
+            busy_us += s.end_us - s.start_us;
+        }
+    }
+    uint32_t wall_us = (last_us > first_us) ? last_us - first_us : 0;
+
+    ESP_LOGI(TAG, "初始化步骤 (共 %lu ms, 串行执行需 %lu ms):",
+             (unsigned long)(wall_us / 1000), (unsigned long)(busy_us / 1000));
+    for (size_t i = 0; i < graph.count(); i++) {
+        const init_step_t &s = graph.step(i);
+        if (s.state == INIT_STEP_SKIPPED) {
+            ESP_LOGW(TAG, "  [%s] %s 因 '%s' 失败而跳过", STATE_NAMES[s.state], s.name,
+                     graph.step(s.cause).name);
+        } else if (s.state == INIT_STEP_FAILED) {
+            ESP_LOGE(TAG, "  [%s] %s 核心%d, %lu ms 开始, 耗时 %lu ms, %s%s", STATE_NAMES[s.state], s.name,
+                     s.core, (unsigned long)((s.start_us - first_us) / 1000),
+                     (unsigned long)((s.end_us - s.start_us) / 1000), esp_err_to_name(s.status),
+                     s.optional ? " (可选)" : "");
+        } else {
+            ESP_LOGI(TAG, "  [%s] %s 核心%d, %lu ms 开始, 耗时 %lu ms", STATE_NAMES[s.state], s.name,
+                     s.core, (unsigned long)((s.start_us - first_us) / 1000),
+                     (unsigned long)((s.end_us - s.start_us) / 1000));
+        }
+    }
+}
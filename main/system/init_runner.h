@@ -0,0 +1,42 @@
+/**
+ * @file init_runner.h
+ * @brief 在两个核心上执行启动初始化依赖图
+ *
+ * 调用任务本身和一个绑定到另一核心的辅助任务同时从图中取出依赖已满足的
+ * 步骤执行，例如从 Flash 加载模型的同时初始化 I2S 和 GPIO。
+ * 每个步骤结束时记入启动剖析（boot_trace），全部结束后输出各步骤的
+ * 核心、起止时间和结果，失败步骤及因此跳过的步骤会单独列出。
+ */
+
+#pragma once
+
+#include "init_graph.h"
+
+extern "C" {
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+}
+
+/**
+ * @brief 辅助任务配置
+ */
+typedef struct {
+    int core;               // 辅助任务所在核心（应与调用任务不同）
+    UBaseType_t priority;   // 辅助任务优先级
+    uint32_t stack_size;    // 辅助任务栈大小（字节），需满足最耗栈的步骤
+} init_runner_config_t;
+
+/**
+ * @brief 执行初始化依赖图，所有步骤结束后返回
+ * @param graph 初始化依赖图
+ * @param config 辅助任务配置
+ * @return esp_err_t 所有必需步骤成功返回ESP_OK；有必需步骤失败或跳过返回ESP_FAIL；
+ *         辅助任务创建失败时退化为在调用任务中串行执行
+ */
+esp_err_t init_runner_run(InitGraph *graph, const init_runner_config_t *config);
+
+/**
+ * @brief 输出各步骤的执行情况
+ * @param graph 已执行完毕的初始化依赖图
+ */
+void init_runner_report(const InitGraph &graph);
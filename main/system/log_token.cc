@@ -0,0 +1,114 @@
+/**
+ * @file log_token.cc
+ * @brief 日志令牌化帧编码实现
+ */
+
+#include "log_token.h"
+#include <cstring>
+
+static const char BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+ * @brief 写入一个 varint，空间不足时返回nullptr
+ */
+static uint8_t *put_varint(uint8_t *p, const uint8_t *end, uint64_t value) {
+    do {
+        if (p == end) {
+            return nullptr;
+        }
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        *p++ = value ? (byte | 0x80) : byte;
+    } while (value);
+    return p;
+}
+
+static uint8_t *put_bytes(uint8_t *p, const uint8_t *end, const void *data, size_t len) {
+    if (static_cast<size_t>(end - p) < len) {
+        return nullptr;
+    }
+    memcpy(p, data, len);
+    return p + len;
+}
+
+static uint8_t *put_arg(uint8_t *p, const uint8_t *end, uint16_t type, uint64_t word) {
+    switch (type) {
+    case DEFERRED_LOG_ARG_SIGNED: {
+        int64_t value = static_cast<int64_t>(word);
+        return put_varint(p, end, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+    case DEFERRED_LOG_ARG_FLOAT: {
+        double d;
+        memcpy(&d, &word, sizeof(d));
+        float f = static_cast<float>(d);
+        uint8_t le[4];
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        for (int i = 0; i < 4; i++) {
+            le[i] = static_cast<uint8_t>(bits >> (8 * i));
+        }
+        return put_bytes(p, end, le, sizeof(le));
+    }
+    case DEFERRED_LOG_ARG_STRING: {
+        const char *str = reinterpret_cast<const char *>(static_cast<uintptr_t>(word));
+        if (str == nullptr) {
+            str = "(null)";
+        }
+        size_t len = strnlen(str, LOG_TOKEN_MAX_STRING);
+        if (str[len] != '\0') {
+            // 截断时退到 UTF-8 字符边界，避免解码出半个汉字
+            while (len > 0 && (static_cast<uint8_t>(str[len]) & 0xc0) == 0x80) {
+                len--;
+            }
+        }
+        p = put_varint(p, end, len);
+        return p ? put_bytes(p, end, str, len) : nullptr;
+    }
+    default:
+        return put_varint(p, end, word);
+    }
+}
+
+size_t log_token_encode(const deferred_log_record_t &record, uint8_t *buf, size_t size) {
+    const uint8_t *end = buf + size;
+    uint8_t *p = buf;
+    if (size < 4) {
+        return 0;
+    }
+    for (int i = 0; i < 4; i++) {
+        *p++ = static_cast<uint8_t>(record.token >> (8 * i));
+    }
+
+    p = put_varint(p, end, record.timestamp_ms);
+    if (p != nullptr) {
+        p = put_varint(p, end, record.nargs | (static_cast<uint32_t>(record.arg_types) << 4));
+    }
+    for (int i = 0; i < record.nargs && p != nullptr; i++) {
+        p = put_arg(p, end, (record.arg_types >> (2 * i)) & 3, record.args[i]);
+    }
+    return p ? static_cast<size_t>(p - buf) : 0;
+}
+
+size_t log_token_base64(const uint8_t *in, size_t len, char *out) {
+    char *o = out;
+    size_t i = 0;
+    for (; i + 2 < len; i += 3) {
+        uint32_t v = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+        *o++ = BASE64[(v >> 18) & 63];
+        *o++ = BASE64[(v >> 12) & 63];
+        *o++ = BASE64[(v >> 6) & 63];
+        *o++ = BASE64[v & 63];
+    }
+    if (i < len) {
+        uint32_t v = in[i] << 16;
+        if (i + 1 < len) {
+            v |= in[i + 1] << 8;
+        }
+        *o++ = BASE64[(v >> 18) & 63];
+        *o++ = BASE64[(v >> 12) & 63];
+        *o++ = (i + 1 < len) ? BASE64[(v >> 6) & 63] : '=';
+        *o++ = '=';
+    }
+    *o = '\0';
+    return static_cast<size_t>(o - out);
+}
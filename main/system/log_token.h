@@ -0,0 +1,57 @@
+/**
+ * @file log_token.h
+ * @brief 日志令牌化
+ *
+ * 令牌化模式下日志调用处不再引用格式串，只记录格式串的 32 位令牌和参数，
+ * 格式串不进入固件。令牌在编译期计算：FNV-1a 32 位哈希，输入为级别字母
+ * （E/W/I/D）后接格式串的 UTF-8 字节。构建时 tools/log_tokens.py 扫描源码中的
+ * DLOGx 调用，用同样的算法生成令牌到格式串的对照表，并在主机上把二进制帧
+ * 还原为文本。
+ *
+ * 帧格式（小端）：
+ *     令牌 u32 | 时间戳（毫秒）varint | 参数描述 varint | 参数...
+ * 参数描述的低 4 位为参数个数，其后每个参数 2 位类别（deferred_log_arg_type_t）。
+ * 有符号整数为 zigzag varint，无符号整数为 varint，浮点数为 float32，
+ * 字符串为长度 varint 加 UTF-8 字节（超过 LOG_TOKEN_MAX_STRING 字节时在字符边界截断）。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "deferred_log.h"
+
+#define LOG_TOKEN_MAX_STRING 32     // 字符串参数最多编码的字节数
+#define LOG_TOKEN_MAX_FRAME (4 + 5 + 3 + DEFERRED_LOG_MAX_ARGS * (LOG_TOKEN_MAX_STRING + 2))
+
+/**
+ * @brief 计算格式串令牌（编译期）
+ * @param level 级别字母，'E'/'W'/'I'/'D'
+ * @param format 格式串
+ */
+constexpr uint32_t log_token(char level, const char *format) {
+    uint32_t hash = 2166136261u;
+    hash = (hash ^ static_cast<uint8_t>(level)) * 16777619u;
+    for (const char *p = format; *p != '\0'; p++) {
+        hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief 把一条令牌化的日志编码为二进制帧
+ * @param record 日志记录（token 有效）
+ * @param buf 输出缓冲区，至少 LOG_TOKEN_MAX_FRAME 字节
+ * @param size 缓冲区大小
+ * @return size_t 帧长度，缓冲区不足时返回0
+ */
+size_t log_token_encode(const deferred_log_record_t &record, uint8_t *buf, size_t size);
+
+/**
+ * @brief Base64 编码（用于把帧放进控制台文本行）
+ * @param in 输入数据
+ * @param len 输入长度
+ * @param out 输出缓冲区，至少 (len + 2) / 3 * 4 + 1 字节
+ * @return size_t 输出长度（不含结尾的 '\0'）
+ */
+size_t log_token_base64(const uint8_t *in, size_t len, char *out);
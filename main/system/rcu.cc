@@ -0,0 +1,24 @@
+/**
+ * @file rcu.cc
+ * @brief 读-拷贝-更新（RCU）宽限期实现
+ */
+
+#include "rcu.h"
+
+uint32_t RcuDomain::flip(void (*wait)(void)) {
+    // 发布指针、读者加计数和这里的读取都是顺序一致的：读者若读到旧指针，
+    // 其计数器加一必然先于这里的读取，不会漏等
+    uint32_t old_phase = phase_.fetch_add(1, std::memory_order_seq_cst) & 1;
+    uint32_t waits = 0;
+    while (readers_[old_phase].load(std::memory_order_seq_cst) != 0) {
+        wait();
+        waits++;
+    }
+    return waits;
+}
+
+uint32_t RcuDomain::synchronize(void (*wait)(void)) {
+    // 读完阶段后被抢占的读者可能记到任一计数器，两个计数器各等一次归零才算宽限期结束
+    uint32_t waits = flip(wait);
+    return waits + flip(wait);
+}
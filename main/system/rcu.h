@@ -0,0 +1,87 @@
+/**
+ * @file rcu.h
+ * @brief 读-拷贝-更新（RCU）宽限期
+ *
+ * 读者不加锁：进入读临界区时在当前阶段的计数器上加一，退出时减一，
+ * 临界区内读取的共享指针在退出前一直有效。写者先用原子操作发布新数据，
+ * 再调用 synchronize() 等待发布前进入的读者全部退出（宽限期），
+ * 然后才能释放旧数据。
+ *
+ * 计数器分两个阶段：synchronize() 先切换阶段，新读者记到另一个计数器，
+ * 旧计数器只减不增，持续有读者进入时写者也能等到归零；切换两次保证
+ * 读取阶段后被抢占、稍后才加计数的读者也被等到。
+ * 读者可以嵌套；写者之间需要由调用方串行。不能在读临界区内调用 synchronize()。
+ * 主机上的 rcu_test 在 ThreadSanitizer 构建中检查读者与写者之间的数据竞争。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief RCU 域（一组共享同一宽限期的数据）
+ */
+class RcuDomain {
+public:
+    RcuDomain() = default;
+
+    RcuDomain(const RcuDomain&) = delete;
+    RcuDomain& operator=(const RcuDomain&) = delete;
+
+    /**
+     * @brief 进入读临界区（任意任务，无锁，不阻塞）
+     * @return uint32_t 阶段，退出时传给 read_unlock()
+     */
+    uint32_t read_lock() {
+        uint32_t phase = phase_.load(std::memory_order_relaxed) & 1;
+        readers_[phase].fetch_add(1, std::memory_order_seq_cst);
+        return phase;
+    }
+
+    /**
+     * @brief 退出读临界区
+     * @param phase read_lock() 的返回值
+     */
+    void read_unlock(uint32_t phase) {
+        readers_[phase].fetch_sub(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief 等待宽限期结束：调用前进入的读临界区全部退出
+     *
+     * @param wait 读者未退出时调用一次，让出CPU（设备上为 vTaskDelay，主机上为 yield）
+     * @return uint32_t 调用 wait 的次数
+     */
+    uint32_t synchronize(void (*wait)(void));
+
+    /**
+     * @brief 已完成的宽限期数
+     */
+    uint32_t grace_periods() const { return phase_.load(std::memory_order_relaxed) / 2; }
+
+private:
+    std::atomic<uint32_t> phase_{0};            // 低位为当前阶段，每个宽限期加2
+    std::atomic<uint32_t> readers_[2] = {};     // 各阶段临界区内的读者数
+
+    /**
+     * @brief 切换阶段并等待上一阶段的读者全部退出
+     */
+    uint32_t flip(void (*wait)(void));
+};
+
+/**
+ * @brief 读临界区（RAII）
+ */
+class RcuReadGuard {
+public:
+    explicit RcuReadGuard(RcuDomain &domain) : domain_(domain), phase_(domain.read_lock()) {}
+    ~RcuReadGuard() { domain_.read_unlock(phase_); }
+
+    RcuReadGuard(const RcuReadGuard&) = delete;
+    RcuReadGuard& operator=(const RcuReadGuard&) = delete;
+
+private:
+    RcuDomain &domain_;
+    uint32_t phase_;
+};
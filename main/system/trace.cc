@@ -0,0 +1,96 @@
+/**
+ * @file trace.cc
+ * @brief 事件跟踪实现
+ */
+
+#include "trace.h"
+
+#if CONFIG_ZAPMYCO_TRACE
+
+extern "C" {
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+}
+
+static const char *TAG = "跟踪";
+
+// 转储任务配置：输出较慢，放在低优先级任务中，不阻塞识别任务
+#define TRACE_DUMP_TASK_CORE 0
+#define TRACE_DUMP_TASK_PRIORITY 1
+#define TRACE_DUMP_TASK_STACK_SIZE 3072
+
+// 全局可见，便于从核心转储或调试器中按符号导出
+trace_buffer_t zapmyco_trace_buffer;
+
+static TaskHandle_t dump_task = NULL;
+
+static const char *const EVENT_NAMES[TRACE_EVENT_COUNT] = {
+#define TRACE_EVENT_NAME(name) #name,
+    TRACE_EVENT_LIST(TRACE_EVENT_NAME)
+#undef TRACE_EVENT_NAME
+};
+
+/**
+ * @brief 以文本行输出整个缓冲区
+ *
+ * 每行以 ZTRACE 开头，混在其他日志中也能被解码脚本识别。
+ * 输出期间仍可继续写入，被覆盖的记录在读取时丢弃。
+ */
+static void dump_buffer(void) {
+    printf("ZTRACE-BEGIN %d %d %d\n", TRACE_VERSION, TRACE_MAX_CORES, TRACE_RING_CAPACITY);
+    for (int i = 0; i < TRACE_EVENT_COUNT; i++) {
+        printf("ZTRACE-EVENT %d %s\n", i, EVENT_NAMES[i]);
+    }
+
+    uint32_t total = 0;
+    for (int core = 0; core < TRACE_MAX_CORES; core++) {
+        const TraceRing &ring = zapmyco_trace_buffer.rings[core];
+        uint32_t head = ring.head();
+        for (uint32_t seq = ring.oldest(); seq != head; seq++) {
+            trace_entry_t entry;
+            if (!ring.read(seq, &entry)) {
+                continue;
+            }
+            printf("ZTRACE %d %lu %lu %c %u %lu\n", core, (unsigned long)entry.seq,
+                   (unsigned long)entry.timestamp_us, entry.type, entry.event, (unsigned long)entry.arg);
+            total++;
+        }
+    }
+    printf("ZTRACE-END %lu\n", (unsigned long)total);
+}
+
+static void trace_dump_task(void *arg) {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        dump_buffer();
+    }
+}
+
+void trace_init(void) {
+    trace_buffer_init(&zapmyco_trace_buffer);
+
+    BaseType_t ret = xTaskCreatePinnedToCore(trace_dump_task, "trace_dump", TRACE_DUMP_TASK_STACK_SIZE, NULL,
+                                             TRACE_DUMP_TASK_PRIORITY, &dump_task, TRACE_DUMP_TASK_CORE);
+    if (ret != pdPASS) {
+        ESP_LOGW(TAG, "转储任务创建失败，只能从核心转储中导出跟踪数据");
+        dump_task = NULL;
+    }
+    ESP_LOGI(TAG, "✓ 事件跟踪已开启: %d 核心 × %d 条记录", TRACE_MAX_CORES, TRACE_RING_CAPACITY);
+}
+
+void trace_emit(trace_type_t type, trace_event_id_t event, uint32_t arg) {
+    int core = xPortGetCoreID();
+    zapmyco_trace_buffer.rings[core].write(static_cast<uint8_t>(type), static_cast<uint16_t>(event), arg,
+                                           static_cast<uint32_t>(esp_timer_get_time()));
+}
+
+void trace_request_dump(void) {
+    if (dump_task != NULL) {
+        xTaskNotifyGive(dump_task);
+    }
+}
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * @file trace.h
+ * @brief 事件跟踪接口
+ *
+ * 在采集、检测、命令分发和播放路径上打点，记录到每核心的二进制环形缓冲区
+ * （见 trace_ring.h）。时间戳取自 esp_timer，两个核心的时间基准一致。
+ * 转储通过控制台输出文本行，或从核心转储中导出 zapmyco_trace_buffer，
+ * 再用 tools/trace_decode.py 转换为 Chrome/Perfetto 可打开的 JSON。
+ * 关闭 CONFIG_ZAPMYCO_TRACE 时所有宏为空操作。
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "trace_events.h"
+#include "trace_ring.h"
+
+#if CONFIG_ZAPMYCO_TRACE
+
+/**
+ * @brief 初始化跟踪缓冲区（在任何打点之前调用）
+ */
+void trace_init(void);
+
+/**
+ * @brief 记录一个事件（可在任务和中断中调用）
+ * @param type 事件类型
+ * @param event 事件编号
+ * @param arg 事件参数
+ */
+void trace_emit(trace_type_t type, trace_event_id_t event, uint32_t arg);
+
+/**
+ * @brief 请求在后台任务中把缓冲区内容输出到控制台
+ */
+void trace_request_dump(void);
+
+#define TRACE_BEGIN(event, arg) trace_emit(TRACE_TYPE_BEGIN, TRACE_EVENT_##event, (uint32_t)(arg))
+#define TRACE_END(event, arg) trace_emit(TRACE_TYPE_END, TRACE_EVENT_##event, (uint32_t)(arg))
+#define TRACE_INSTANT(event, arg) trace_emit(TRACE_TYPE_INSTANT, TRACE_EVENT_##event, (uint32_t)(arg))
+
+#else
+
+static inline void trace_init(void) {}
+static inline void trace_request_dump(void) {}
+
+#define TRACE_BEGIN(event, arg) do { } while (0)
+#define TRACE_END(event, arg) do { } while (0)
+#define TRACE_INSTANT(event, arg) do { } while (0)
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file trace_events.h
+ * @brief 跟踪事件定义
+ *
+ * 事件编号按列表顺序从 0 开始分配。tools/trace_decode.py 解析原始内存转储时
+ * 从本文件读取事件名称，新增事件请追加在末尾并保持每行一个 X(...)。
+ */
+
+#pragma once
+
+#define TRACE_EVENT_LIST(X)                                                      \
+    X(CAPTURE_READ)       /* 采集/feed 任务读取一帧 I2S 数据 */                    \
+    X(CAPTURE_OVERRUN)    /* 采集缓冲区满，丢弃一帧 */                             \
+    X(AFE_FEED)           /* 送入 AFE 一帧 */                                      \
+    X(AFE_FETCH)          /* 从 AFE 取出一帧（含等待） */                          \
+    X(WAKE_DETECT)        /* WakeNet 检测一帧 */                                   \
+    X(WAKE_TRIGGERED)     /* 检测到唤醒词，参数为帧序号 */                         \
+    X(COMMAND_DETECT)     /* MultiNet 识别一帧 */                                  \
+    X(COMMAND_RECOGNIZED) /* 识别出命令词，参数为命令ID */                         \
+    X(COMMAND_EXECUTE)    /* 执行命令，参数为命令ID */                             \
+    X(GPIO_SET)           /* 设置 LED 电平，参数为电平 */                          \
+    X(PLAY_SUBMIT)        /* 提交播放请求，参数为片段ID */                         \
+    X(PLAY_START)         /* 片段开始输出，参数为片段ID */                         \
+    X(PLAY_WRITE)         /* 向 I2S 写入一块音频，参数为字节数 */                  \
+    X(PLAY_IDLE)          /* 播放队列清空，停止输出 */                             \
+    X(COMMAND_SUBMIT)     /* 命令提交到执行器，参数为命令ID */
+
+/**
+ * @brief 跟踪事件编号
+ */
+typedef enum {
+#define TRACE_EVENT_ENUM(name) TRACE_EVENT_##name,
+    TRACE_EVENT_LIST(TRACE_EVENT_ENUM)
+#undef TRACE_EVENT_ENUM
+    TRACE_EVENT_COUNT
+} trace_event_id_t;
@@ -0,0 +1,60 @@
+/**
+ * @file trace_ring.cc
+ * @brief 二进制事件跟踪环形缓冲区实现
+ */
+
+#include "trace_ring.h"
+
+static const uint32_t MASK = TRACE_RING_CAPACITY - 1;
+
+void TraceRing::reset() {
+    head_.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < TRACE_RING_CAPACITY; i++) {
+        slots_[i].seq.store(0, std::memory_order_relaxed);
+        slots_[i].reserved = 0;
+    }
+}
+
+void TraceRing::write(uint8_t type, uint16_t event, uint32_t arg, uint32_t timestamp_us) {
+    uint32_t seq = head_.fetch_add(1, std::memory_order_relaxed);
+    slot_t &slot = slots_[seq & MASK];
+
+    slot.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp_us.store(timestamp_us, std::memory_order_relaxed);
+    slot.event.store(event, std::memory_order_relaxed);
+    slot.type.store(type, std::memory_order_relaxed);
+    slot.arg.store(arg, std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_release);
+}
+
+uint32_t TraceRing::oldest() const {
+    uint32_t head = this->head();
+    return (head > TRACE_RING_CAPACITY) ? head - TRACE_RING_CAPACITY : 0;
+}
+
+bool TraceRing::read(uint32_t seq, trace_entry_t *out) const {
+    const slot_t &slot = slots_[seq & MASK];
+
+    uint32_t before = slot.seq.load(std::memory_order_acquire);
+    out->seq = seq;
+    out->timestamp_us = slot.timestamp_us.load(std::memory_order_relaxed);
+    out->event = slot.event.load(std::memory_order_relaxed);
+    out->type = slot.type.load(std::memory_order_relaxed);
+    out->arg = slot.arg.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint32_t after = slot.seq.load(std::memory_order_relaxed);
+
+    return before == seq + 1 && after == before;
+}
+
+void trace_buffer_init(trace_buffer_t *buffer) {
+    buffer->magic = TRACE_MAGIC;
+    buffer->version = TRACE_VERSION;
+    buffer->record_size = 16;
+    buffer->capacity = TRACE_RING_CAPACITY;
+    buffer->cores = TRACE_MAX_CORES;
+    for (size_t i = 0; i < TRACE_MAX_CORES; i++) {
+        buffer->rings[i].reset();
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * @file trace_ring.h
+ * @brief 二进制事件跟踪环形缓冲区
+ *
+ * 每个核心一个固定大小的环形缓冲区，记录开始/结束/瞬时事件。写入无锁：
+ * 先用原子加法预留槽位，同一核心上被抢占的任务和中断也不会写到同一槽；
+ * 每个槽带写入序号，写入期间序号为0，读取方据此丢弃正在改写的记录。
+ * 缓冲区满后覆盖最旧的记录。
+ *
+ * trace_buffer_t 的内存布局固定（见 tools/trace_decode.py），可以从核心转储
+ * 或调试器中整块导出后在主机上解码（trace_decode_test 解码的就是主机测试写出的缓冲区）。
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef CONFIG_ZAPMYCO_TRACE_RING_RECORDS
+#define TRACE_RING_CAPACITY CONFIG_ZAPMYCO_TRACE_RING_RECORDS
+#else
+#define TRACE_RING_CAPACITY 256     // 每个核心的记录数（2的幂）
+#endif
+
+#define TRACE_MAX_CORES 2
+#define TRACE_MAGIC 0x4352545A      // "ZTRC"
+#define TRACE_VERSION 1
+
+static_assert((TRACE_RING_CAPACITY & (TRACE_RING_CAPACITY - 1)) == 0, "跟踪缓冲区记录数必须是2的幂");
+
+/**
+ * @brief 事件类型，取值与 Chrome trace 的 ph 字段一致
+ */
+typedef enum {
+    TRACE_TYPE_BEGIN = 'B',     // 区间开始
+    TRACE_TYPE_END = 'E',       // 区间结束
+    TRACE_TYPE_INSTANT = 'i',   // 瞬时事件
+} trace_type_t;
+
+/**
+ * @brief 读出的一条跟踪记录
+ */
+typedef struct {
+    uint32_t seq;           // 该核心上的写入序号
+    uint32_t timestamp_us;  // 时间戳（微秒，允许回绕）
+    uint16_t event;         // 事件编号
+    uint8_t type;           // 事件类型（trace_type_t）
+    uint32_t arg;           // 事件参数
+} trace_entry_t;
+
+/**
+ * @brief 单个核心的跟踪环形缓冲区
+ */
+class TraceRing {
+public:
+    /**
+     * @brief 清空缓冲区（没有写入方时调用）
+     */
+    void reset();
+
+    /**
+     * @brief 写入一条记录（可在任务和中断中调用）
+     */
+    void write(uint8_t type, uint16_t event, uint32_t arg, uint32_t timestamp_us);
+
+    /**
+     * @brief 下一条记录的写入序号
+     */
+    uint32_t head() const { return head_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 仍在缓冲区中的最旧记录序号
+     */
+    uint32_t oldest() const;
+
+    /**
+     * @brief 按序号读出一条记录
+     * @param seq 写入序号
+     * @param out 输出记录
+     * @return bool 记录已被覆盖、尚未写入或正在改写时返回false
+     */
+    bool read(uint32_t seq, trace_entry_t *out) const;
+
+private:
+    // 槽内字段用原子变量按 relaxed 访问，序号的 release/acquire 保证读到完整记录
+    struct slot_t {
+        std::atomic<uint32_t> seq;          // 写入序号+1，0 表示正在写入
+        std::atomic<uint32_t> timestamp_us;
+        std::atomic<uint16_t> event;
+        std::atomic<uint8_t> type;
+        uint8_t reserved;
+        std::atomic<uint32_t> arg;
+    };
+    static_assert(sizeof(slot_t) == 16, "跟踪记录布局与解码脚本不一致");
+
+    std::atomic<uint32_t> head_;
+    slot_t slots_[TRACE_RING_CAPACITY];
+};
+
+/**
+ * @brief 全部核心的跟踪缓冲区
+ */
+typedef struct {
+    uint32_t magic;             // TRACE_MAGIC
+    uint16_t version;           // TRACE_VERSION
+    uint16_t record_size;       // 每条记录的字节数
+    uint32_t capacity;          // 每个核心的记录数
+    uint32_t cores;             // 核心数
+    TraceRing rings[TRACE_MAX_CORES];
+} trace_buffer_t;
+
+/**
+ * @brief 初始化跟踪缓冲区表头并清空各核心的缓冲区
+ */
+void trace_buffer_init(trace_buffer_t *buffer);
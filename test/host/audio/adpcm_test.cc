@@ -0,0 +1,151 @@
+/**
+ * @file adpcm_test.cc
+ * @brief IMA-ADPCM 解码器的逐位比对和基准测试
+ *
+ * 用 tools/prompt_pack.py 把全部提示音和一段覆盖饱和、步长上下限的合成信号
+ * 编码为 IMA-ADPCM，再用脚本中的 Python 参考解码器解包为 WAV。固件解码器按
+ * 不同的块大小（含奇数字节）流式解码，输出必须与参考实现逐位一致。
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "audio/adpcm.h"
+#include "audio/prompt_bundle.h"
+#include "host_test.h"
+#include "wav_file.h"
+
+static const char *const VOICES[] = {
+    "byebye", "hilexin", "light_off", "light_on", "say_again", "welcome",
+};
+
+/**
+ * @brief 合成信号：满幅方波（预测值饱和）、静音（步长回到下限）、大幅噪声（步长上限）
+ */
+static std::vector<int16_t> synth_signal() {
+    std::vector<int16_t> samples;
+    for (int i = 0; i < 4000; i++) {
+        samples.push_back((i / 20) % 2 ? INT16_MIN : INT16_MAX);
+    }
+    samples.insert(samples.end(), 4000, 0);
+    uint32_t seed = 5;
+    for (int i = 0; i < 8001; i++) {    // 奇数个样本，编码器末尾补 0
+        seed = seed * 1664525u + 1013904223u;
+        samples.push_back(static_cast<int16_t>(seed >> 16));
+    }
+    return samples;
+}
+
+/**
+ * @brief 按给定块大小流式解码一个提示音
+ */
+static std::vector<int16_t> decode_chunked(const prompt_view_t &view, size_t chunk) {
+    std::vector<int16_t> out(view.len * 2);
+    adpcm_state_t state;
+    adpcm_reset(&state);
+    for (size_t offset = 0; offset < view.len; offset += chunk) {
+        size_t n = std::min(chunk, view.len - offset);
+        adpcm_decode(&state, view.data + offset, n, out.data() + offset * 2);
+    }
+    out.resize(view.samples);
+    return out;
+}
+
+static void test_bit_exact() {
+    std::string synth = host_temp_path("synth.wav");
+    CHECK(wav_write(synth, synth_signal()));
+
+    std::string args = "pack --codec ima-adpcm -o " + host_temp_path("prompts_adpcm.bin");
+    for (const char *name : VOICES) {
+        args += " " + repo_path((std::string("main/assets/voices/") + name + ".wav").c_str());
+    }
+    args += " " + synth + " > /dev/null";
+    CHECK_EQ(run_tool("prompt_pack.py", args), 0);
+    std::string extract_dir = host_temp_path("adpcm_ref");
+    CHECK_EQ(run_tool("prompt_pack.py", "extract " + host_temp_path("prompts_adpcm.bin") + " -d " + extract_dir), 0);
+
+    std::vector<uint8_t> blob;
+    CHECK(read_file(host_temp_path("prompts_adpcm.bin"), blob));
+    PromptBundle bundle;
+    CHECK(bundle.parse(blob.data(), blob.size()));
+    CHECK_EQ(bundle.count(), sizeof(VOICES) / sizeof(VOICES[0]) + 1);
+
+    for (size_t i = 0; i < bundle.count(); i++) {
+        char name[PromptBundle::NAME_MAX + 1];
+        CHECK(bundle.name_at(i, name));
+        prompt_view_t view = bundle.at(i);
+        CHECK_EQ(view.codec, 1);
+        CHECK_EQ(view.len, (view.samples + 1) / 2);
+
+        std::vector<int16_t> reference;
+        CHECK(wav_read(extract_dir + "/" + name + ".wav", reference));
+        CHECK_EQ(reference.size(), view.samples);
+
+        for (size_t chunk : {1u, 3u, 128u, 256u, 1000u}) {
+            std::vector<int16_t> decoded = decode_chunked(view, chunk);
+            size_t mismatch = 0;
+            while (mismatch < decoded.size() && decoded[mismatch] == reference[mismatch]) {
+                mismatch++;
+            }
+            if (mismatch != decoded.size()) {
+                printf("%s: 块大小 %zu 在第 %zu 个样本处不一致 (%d != %d)\n", name, chunk, mismatch,
+                       decoded[mismatch], reference[mismatch]);
+            }
+            CHECK_EQ(mismatch, decoded.size());
+        }
+    }
+}
+
+/**
+ * @brief 非法码流也不会让解码状态越界（步长索引始终在表内）
+ */
+static void test_state_bounds() {
+    std::vector<uint8_t> stream(4096);
+    uint32_t seed = 9;
+    for (uint8_t &b : stream) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(seed >> 24);
+    }
+    std::fill(stream.begin(), stream.begin() + 256, 0x77);  // 连续最大正码字：预测值和索引都到上限
+    std::fill(stream.begin() + 256, stream.begin() + 512, 0x00);
+
+    adpcm_state_t state;
+    adpcm_reset(&state);
+    std::vector<int16_t> out(stream.size() * 2);
+    for (size_t i = 0; i < stream.size(); i++) {
+        adpcm_decode(&state, &stream[i], 1, &out[i * 2]);
+        CHECK(state.index >= 0 && state.index <= 88);
+        CHECK(state.predictor >= INT16_MIN && state.predictor <= INT16_MAX);
+    }
+    CHECK_EQ(out[511], INT16_MAX);
+}
+
+static void bench_decode() {
+    std::vector<uint8_t> blob;
+    CHECK(read_file(host_temp_path("prompts_adpcm.bin"), blob));
+    PromptBundle bundle;
+    CHECK(bundle.parse(blob.data(), blob.size()));
+    prompt_view_t welcome = bundle.at(static_cast<size_t>(bundle.find("welcome")));
+
+    const int rounds = 50;
+    std::vector<int16_t> out(256);
+    uint64_t start = host_now_ns();
+    for (int r = 0; r < rounds; r++) {
+        adpcm_state_t state;
+        adpcm_reset(&state);
+        for (size_t offset = 0; offset < welcome.len; offset += 128) {
+            size_t n = std::min<size_t>(128, welcome.len - offset);
+            adpcm_decode(&state, welcome.data + offset, n, out.data());
+        }
+    }
+    double ns = static_cast<double>(host_now_ns() - start) / rounds;
+    printf("welcome (%u ms): 解码 %.0f us, 每样本 %.2f ns\n", PromptBundle::duration_ms(welcome), ns / 1000.0,
+           ns / welcome.samples);
+}
+
+int main() {
+    test_bit_exact();
+    test_state_bounds();
+    bench_decode();
+    return host_test_result("adpcm_test");
+}
@@ -0,0 +1,162 @@
+/**
+ * @file audio_history_test.cc
+ * @brief 音频历史环形缓冲区的主机测试
+ *
+ * 用仓库中的提示音 WAV 拼出"唤醒词 + 命令"的一段录音，逐帧写入历史缓冲区，
+ * 检查按序号取回的帧与原始录音逐位一致、被覆盖的帧不可取回，
+ * 以及唤醒触发后回灌窗口覆盖紧接着说出的命令开头。
+ */
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "audio/audio_history.h"
+#include "host_test.h"
+#include "wav_file.h"
+
+static const size_t FRAME_SAMPLES = 512;       // 唤醒词模型块大小（32 ms）
+static const uint32_t SAMPLE_RATE = 16000;
+static const uint32_t PREROLL_HISTORY_MS = 2000;
+static const uint32_t WAKE_REPLAY_MS = 480;
+static const uint32_t WAKE_LATENCY_FRAMES = 6; // 唤醒词说完到模型触发的帧数
+
+/**
+ * @brief 读取 WAV 并补零到整帧
+ */
+static std::vector<int16_t> load_frames(const char *name) {
+    std::vector<int16_t> samples;
+    uint32_t rate = 0;
+    bool ok = wav_read(repo_path(name), samples, &rate);
+    CHECK(ok);
+    CHECK_EQ(rate, SAMPLE_RATE);
+    samples.resize((samples.size() + FRAME_SAMPLES - 1) / FRAME_SAMPLES * FRAME_SAMPLES);
+    return samples;
+}
+
+static double frame_rms(const int16_t *frame) {
+    double sum = 0.0;
+    for (size_t i = 0; i < FRAME_SAMPLES; i++) {
+        sum += static_cast<double>(frame[i]) * frame[i];
+    }
+    return std::sqrt(sum / FRAME_SAMPLES);
+}
+
+static void test_init() {
+    std::vector<int16_t> storage(FRAME_SAMPLES * 4);
+    AudioHistory history;
+    CHECK(!history.is_ready());
+    CHECK(!history.init(nullptr, FRAME_SAMPLES, 4));
+    CHECK(!history.init(storage.data(), 0, 4));
+    CHECK(!history.init(storage.data(), FRAME_SAMPLES, 0));
+    CHECK(!history.is_ready());
+    CHECK(history.frame_at(0) == nullptr);
+
+    CHECK(history.init(storage.data(), FRAME_SAMPLES, 4));
+    CHECK(history.is_ready());
+    CHECK_EQ(history.total_frames(), 0);
+    CHECK_EQ(history.oldest_index(), 0);
+    CHECK(history.frame_at(0) == nullptr);
+}
+
+/**
+ * @brief 整段录音写入后，窗口内的帧逐位一致，窗口外的帧不可取回
+ */
+static void test_wav_roundtrip() {
+    std::vector<int16_t> audio = load_frames("main/assets/voices/welcome.wav");
+    size_t frames = audio.size() / FRAME_SAMPLES;
+    size_t capacity = PREROLL_HISTORY_MS * SAMPLE_RATE / 1000 / FRAME_SAMPLES;
+    CHECK(frames > capacity);
+
+    std::vector<int16_t> storage(FRAME_SAMPLES * capacity);
+    AudioHistory history;
+    CHECK(history.init(storage.data(), FRAME_SAMPLES, capacity));
+
+    for (size_t i = 0; i < frames; i++) {
+        CHECK_EQ(history.push(audio.data() + i * FRAME_SAMPLES), i);
+    }
+    CHECK_EQ(history.total_frames(), frames);
+    CHECK_EQ(history.oldest_index(), frames - capacity);
+
+    int mismatches = 0;
+    for (uint32_t index = 0; index < frames + 2; index++) {
+        const int16_t *frame = history.frame_at(index);
+        bool retained = index >= frames - capacity && index < frames;
+        CHECK_EQ(frame != nullptr, retained);
+        if (frame != nullptr) {
+            mismatches += memcmp(frame, audio.data() + index * FRAME_SAMPLES, FRAME_SAMPLES * sizeof(int16_t)) != 0;
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+/**
+ * @brief 唤醒词后紧接着说命令：回灌窗口覆盖命令的起音
+ */
+static void test_preroll_covers_command_onset() {
+    std::vector<int16_t> wake = load_frames("main/assets/voices/hilexin.wav");
+    std::vector<int16_t> command = load_frames("main/assets/voices/light_on.wav");
+
+    // 去掉唤醒词录音尾部的静音，模拟一口气说完
+    size_t wake_frames = wake.size() / FRAME_SAMPLES;
+    while (wake_frames > 0 && frame_rms(wake.data() + (wake_frames - 1) * FRAME_SAMPLES) < 100.0) {
+        wake_frames--;
+    }
+    std::vector<int16_t> audio(wake.begin(), wake.begin() + wake_frames * FRAME_SAMPLES);
+    audio.insert(audio.end(), command.begin(), command.end());
+
+    size_t onset = wake_frames;
+    while (onset < audio.size() / FRAME_SAMPLES && frame_rms(audio.data() + onset * FRAME_SAMPLES) < 100.0) {
+        onset++;
+    }
+    CHECK(onset < audio.size() / FRAME_SAMPLES);
+
+    size_t capacity = PREROLL_HISTORY_MS * SAMPLE_RATE / 1000 / FRAME_SAMPLES;
+    std::vector<int16_t> storage(FRAME_SAMPLES * capacity);
+    AudioHistory history;
+    CHECK(history.init(storage.data(), FRAME_SAMPLES, capacity));
+
+    uint32_t wake_index = static_cast<uint32_t>(wake_frames - 1 + WAKE_LATENCY_FRAMES);
+    for (uint32_t i = 0; i <= wake_index; i++) {
+        history.push(audio.data() + i * FRAME_SAMPLES);
+    }
+
+    // 与 main.cc 的 replay_preroll() 相同的窗口
+    uint32_t frame_ms = FRAME_SAMPLES * 1000 / SAMPLE_RATE;
+    uint32_t replay_frames = (WAKE_REPLAY_MS + frame_ms - 1) / frame_ms;
+    uint32_t first = (wake_index + 1 > replay_frames) ? wake_index + 1 - replay_frames : 0;
+    first = (first < history.oldest_index()) ? history.oldest_index() : first;
+    printf("唤醒词 %zu 帧, 命令起音在第 %zu 帧, 唤醒触发在第 %u 帧, 回灌 %u..%u\n",
+           wake_frames, onset, wake_index, first, wake_index);
+
+    CHECK(first <= onset);
+    for (uint32_t index = first; index <= wake_index; index++) {
+        const int16_t *frame = history.frame_at(index);
+        CHECK(frame != nullptr);
+        if (frame != nullptr) {
+            CHECK(memcmp(frame, audio.data() + index * FRAME_SAMPLES, FRAME_SAMPLES * sizeof(int16_t)) == 0);
+        }
+    }
+}
+
+static void bench_push() {
+    const size_t capacity = PREROLL_HISTORY_MS * SAMPLE_RATE / 1000 / FRAME_SAMPLES;
+    std::vector<int16_t> storage(FRAME_SAMPLES * capacity);
+    std::vector<int16_t> frame(FRAME_SAMPLES, 123);
+    AudioHistory history;
+    CHECK(history.init(storage.data(), FRAME_SAMPLES, capacity));
+
+    const int iterations = 200000;
+    uint64_t start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        history.push(frame.data());
+    }
+    printf("push: 每帧 %.0f ns\n", static_cast<double>(host_now_ns() - start) / iterations);
+}
+
+int main() {
+    test_init();
+    test_wav_roundtrip();
+    test_preroll_covers_command_onset();
+    bench_push();
+    return host_test_result("audio_history_test");
+}
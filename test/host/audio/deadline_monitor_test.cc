@@ -0,0 +1,239 @@
+/**
+ * @file deadline_monitor_test.cc
+ * @brief 逐帧实时预算监视的主机测试
+ *
+ * 用已知的负载序列检查直方图窗口统计（最小、平均、p99、最大按桶边界与逐帧
+ * 排序的参考值比较）、溢出桶、计数器回绕、告警与恢复的边沿和回差，以及写入方
+ * 持续记录时另一个线程读取快照得到的窗口统计始终自洽。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "audio/deadline_monitor.h"
+#include "host_test.h"
+
+static const uint32_t BUDGET = 1000000;     // 每千分比 1000 个周期
+
+static uint32_t next_random(uint32_t &seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+/**
+ * @brief 与逐帧排序后的参考值比较：统计值落在参考值所在的桶
+ */
+static void test_window_stats() {
+    static DeadlineMonitor monitor;
+    deadline_monitor_config_t config = DEADLINE_MONITOR_DEFAULT_CONFIG(BUDGET);
+    config.warn_headroom_permille = 0;
+    monitor.init(config);
+
+    deadline_snapshot_t prev, now;
+    uint32_t seed = 1;
+    for (int round = 0; round < 20; round++) {
+        monitor.snapshot(&prev);
+        size_t frames = 50 + next_random(seed) % 3000;
+        uint32_t spread = 100 + next_random(seed) % 1500;
+        std::vector<uint32_t> loads;
+        uint32_t misses = 0;
+        uint64_t load_sum = 0;
+        for (size_t i = 0; i < frames; i++) {
+            uint32_t load = 50 + next_random(seed) % spread;
+            CHECK_EQ(monitor.record(load * (BUDGET / 1000)), DEADLINE_EVENT_NONE);
+            loads.push_back(load);
+            load_sum += load;
+            misses += load > 1000;
+        }
+        monitor.snapshot(&now);
+        deadline_window_t w = DeadlineMonitor::window(prev, now);
+        std::sort(loads.begin(), loads.end());
+
+        auto bin_lower = [](uint32_t load) {
+            return std::min<uint32_t>(load / DEADLINE_HIST_BIN_PERMILLE, DEADLINE_HIST_BINS) * DEADLINE_HIST_BIN_PERMILLE;
+        };
+        auto bin_upper = [](uint32_t load) {
+            uint32_t bin = load / DEADLINE_HIST_BIN_PERMILLE;
+            return (bin >= DEADLINE_HIST_BINS) ? DEADLINE_HIST_BINS * DEADLINE_HIST_BIN_PERMILLE
+                                               : (bin + 1) * DEADLINE_HIST_BIN_PERMILLE;
+        };
+        CHECK_EQ(w.frames, frames);
+        CHECK_EQ(w.misses, misses);
+        CHECK_EQ(w.avg_permille, load_sum / frames);
+        CHECK_EQ(w.min_permille, loads.front() >= DEADLINE_HIST_BINS * DEADLINE_HIST_BIN_PERMILLE
+                                     ? bin_upper(loads.front()) : bin_lower(loads.front()));
+        CHECK_EQ(w.max_permille, bin_upper(loads.back()));
+        CHECK_EQ(w.p99_permille, bin_upper(loads[frames - frames / 100 - 1]));
+    }
+}
+
+/**
+ * @brief 超过 200% 的帧落入溢出桶，极大的周期数不会让负载计算溢出
+ */
+static void test_overflow_bucket() {
+    static DeadlineMonitor monitor;
+    monitor.init(DEADLINE_MONITOR_DEFAULT_CONFIG(BUDGET));
+    deadline_snapshot_t prev, now;
+    monitor.snapshot(&prev);
+    monitor.record(2500 * (BUDGET / 1000));
+    monitor.record(UINT32_MAX);
+    monitor.snapshot(&now);
+
+    CHECK_EQ(now.bins[DEADLINE_HIST_BINS], 2);
+    CHECK_EQ(now.max_cycles, UINT32_MAX);
+    deadline_window_t w = DeadlineMonitor::window(prev, now);
+    CHECK_EQ(w.misses, 2);
+    CHECK_EQ(w.min_permille, DEADLINE_HIST_BINS * DEADLINE_HIST_BIN_PERMILLE);
+    CHECK_EQ(w.max_permille, DEADLINE_HIST_BINS * DEADLINE_HIST_BIN_PERMILLE);
+
+    // 预算为 0（未初始化）时不记录
+    static DeadlineMonitor idle;
+    CHECK_EQ(idle.record(12345), DEADLINE_EVENT_NONE);
+    idle.snapshot(&now);
+    CHECK_EQ(now.frames, 0);
+}
+
+/**
+ * @brief 32 位计数器回绕后窗口统计仍正确
+ */
+static void test_counter_wrap() {
+    deadline_snapshot_t prev = {}, now = {};
+    for (size_t i = 0; i <= DEADLINE_HIST_BINS; i++) {
+        prev.bins[i] = UINT32_MAX - 5;
+        now.bins[i] = prev.bins[i];
+    }
+    now.bins[10] = prev.bins[10] + 90;      // 回绕到 84
+    now.bins[45] = prev.bins[45] + 10;
+    prev.frames = UINT32_MAX - 50;
+    now.frames = prev.frames + 100;
+    prev.misses = UINT32_MAX;
+    now.misses = prev.misses + 0;
+    prev.load_sum = UINT32_MAX - 1000;
+    now.load_sum = prev.load_sum + 90 * 210 + 10 * 910;
+
+    deadline_window_t w = DeadlineMonitor::window(prev, now);
+    CHECK_EQ(w.frames, 100);
+    CHECK_EQ(w.misses, 0);
+    CHECK_EQ(w.avg_permille, (90 * 210 + 10 * 910) / 100);
+    CHECK_EQ(w.min_permille, 200);
+    CHECK_EQ(w.p99_permille, 920);
+    CHECK_EQ(w.max_permille, 920);
+}
+
+/**
+ * @brief 持续高负载只告警一次，回落越过回差后只恢复一次；告警线附近抖动不反复告警
+ */
+static void test_warning_edges() {
+    static DeadlineMonitor monitor;
+    monitor.init(DEADLINE_MONITOR_DEFAULT_CONFIG(BUDGET));    // 告警线 800‰
+
+    int low = 0, ok = 0;
+    auto feed = [&](uint32_t load, int frames) {
+        for (int i = 0; i < frames; i++) {
+            deadline_event_t event = monitor.record(load * (BUDGET / 1000));
+            low += event == DEADLINE_EVENT_HEADROOM_LOW;
+            ok += event == DEADLINE_EVENT_HEADROOM_OK;
+        }
+    };
+    feed(500, 200);
+    CHECK_EQ(low + ok, 0);
+    // 单帧超时被平滑吸收
+    feed(1900, 1);
+    feed(500, 50);
+    CHECK_EQ(low, 0);
+
+    feed(900, 200);
+    CHECK_EQ(low, 1);
+    CHECK(monitor.smoothed_permille() > 850);
+    // 在告警线与回差之间抖动
+    for (int i = 0; i < 50; i++) {
+        feed(820, 5);
+        feed(770, 5);
+    }
+    CHECK_EQ(low, 1);
+    CHECK_EQ(ok, 0);
+
+    feed(300, 200);
+    CHECK_EQ(low, 1);
+    CHECK_EQ(ok, 1);
+
+    // 告警关闭时只统计
+    deadline_monitor_config_t config = DEADLINE_MONITOR_DEFAULT_CONFIG(BUDGET);
+    config.warn_headroom_permille = 0;
+    monitor.init(config);
+    feed(1500, 200);
+    CHECK_EQ(low, 1);
+    CHECK(monitor.smoothed_permille() > 1400);
+}
+
+/**
+ * @brief 写入方持续记录时，读取方每次得到的窗口统计都自洽，各窗口帧数之和等于总帧数
+ */
+static void test_concurrent_reader() {
+    static DeadlineMonitor monitor;
+    monitor.init(DEADLINE_MONITOR_DEFAULT_CONFIG(BUDGET));
+    const uint32_t frames = 500000;
+
+    static deadline_snapshot_t prev, now;
+    monitor.snapshot(&prev);
+    std::atomic<bool> done{false};
+    uint64_t windowed = 0;
+    int inconsistent = 0;
+    std::thread reader([&]() {
+        bool last = false;
+        while (!last) {
+            last = done.load(std::memory_order_acquire);
+            monitor.snapshot(&now);
+            deadline_window_t w = DeadlineMonitor::window(prev, now);
+            prev = now;
+            windowed += w.frames;
+            if (w.frames > 0 && (w.misses > w.frames || w.min_permille > w.p99_permille ||
+                                 w.p99_permille > w.max_permille)) {
+                inconsistent++;
+            }
+        }
+    });
+
+    uint32_t seed = 7;
+    for (uint32_t i = 0; i < frames; i++) {
+        monitor.record(next_random(seed) % (2 * BUDGET));
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    CHECK_EQ(inconsistent, 0);
+    CHECK_EQ(windowed, frames);
+}
+
+static void bench_record() {
+    static DeadlineMonitor monitor;
+    monitor.init(DEADLINE_MONITOR_DEFAULT_CONFIG(BUDGET));
+    const int iterations = 1000000;
+    uint32_t seed = 9;
+    uint64_t start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        monitor.record(next_random(seed) % BUDGET);
+    }
+    double record_ns = static_cast<double>(host_now_ns() - start) / iterations;
+
+    static deadline_snapshot_t prev, now;
+    monitor.snapshot(&prev);
+    start = host_now_ns();
+    for (int i = 0; i < 10000; i++) {
+        monitor.snapshot(&now);
+        DeadlineMonitor::window(prev, now);
+    }
+    printf("record: %.1f ns, snapshot+window: %.0f ns\n", record_ns,
+           static_cast<double>(host_now_ns() - start) / 10000);
+}
+
+int main() {
+    test_window_stats();
+    test_overflow_bucket();
+    test_counter_wrap();
+    test_warning_edges();
+    test_concurrent_reader();
+    bench_record();
+    return host_test_result("deadline_monitor_test");
+}
@@ -0,0 +1,253 @@
+/**
+ * @file frame_ring_test.cc
+ * @brief 音频帧环形缓冲区的主机测试和吞吐量基准
+ *
+ * 用合成帧（每帧带序号，其余样本由序号算出）在生产者、消费者两个线程间传递：
+ * - 消费者够快时帧按序号到达、内容完整；
+ * - 消费者慢时缓冲区满的帧被丢弃并计入 overruns，收到的帧仍然按序且完整，
+ *   序号的缺口数等于 overruns，frames_written + overruns 等于生产的帧数，
+ *   peak_fill 达到容量且不超过容量；
+ * - 最后测量两个线程间的吞吐量。
+ * 在 ZAPMYCO_HOST_SANITIZE=thread 的构建中检查数据竞争。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "audio/frame_ring.h"
+#include "host_test.h"
+
+static const size_t FRAME_SAMPLES = 512;    // 与 main.cc 的采集帧长一致
+static const size_t CAPACITY = 8;
+
+static int16_t sample_of(uint32_t seq, size_t i) {
+    return static_cast<int16_t>(seq * 2654435761u + i * 40503u);
+}
+
+static void fill_frame(int16_t *frame, uint32_t seq) {
+    frame[0] = static_cast<int16_t>(seq & 0xffff);
+    frame[1] = static_cast<int16_t>(seq >> 16);
+    for (size_t i = 2; i < FRAME_SAMPLES; i++) {
+        frame[i] = sample_of(seq, i);
+    }
+}
+
+/**
+ * @brief 检查帧内容，返回帧序号，内容损坏返回 UINT32_MAX
+ */
+static uint32_t check_frame(const int16_t *frame) {
+    uint32_t seq = static_cast<uint16_t>(frame[0]) | (static_cast<uint32_t>(static_cast<uint16_t>(frame[1])) << 16);
+    for (size_t i = 2; i < FRAME_SAMPLES; i++) {
+        if (frame[i] != sample_of(seq, i)) {
+            return UINT32_MAX;
+        }
+    }
+    return seq;
+}
+
+static void spin_ns(uint64_t ns) {
+    uint64_t start = host_now_ns();
+    while (host_now_ns() - start < ns) {
+    }
+}
+
+static void test_init() {
+    std::vector<int16_t> storage(FRAME_SAMPLES * CAPACITY);
+    FrameRing ring;
+    CHECK(!ring.init(nullptr, FRAME_SAMPLES, CAPACITY));
+    CHECK(!ring.init(storage.data(), 0, CAPACITY));
+    CHECK(!ring.init(storage.data(), FRAME_SAMPLES, 1));
+    CHECK(!ring.init(storage.data(), FRAME_SAMPLES, 6));
+    CHECK(ring.init(storage.data(), FRAME_SAMPLES, CAPACITY));
+    CHECK_EQ(ring.capacity(), CAPACITY);
+    CHECK_EQ(ring.frame_samples(), FRAME_SAMPLES);
+    CHECK(ring.acquire_read() == nullptr);
+}
+
+/**
+ * @brief 消费者完全停下时的计数：写满后每帧都记为 overrun
+ */
+static void test_full_single_thread() {
+    std::vector<int16_t> storage(FRAME_SAMPLES * CAPACITY);
+    FrameRing ring;
+    CHECK(ring.init(storage.data(), FRAME_SAMPLES, CAPACITY));
+    const uint32_t produced = 3 * CAPACITY + 1;
+    for (uint32_t seq = 0; seq < produced; seq++) {
+        int16_t *frame = ring.acquire_write();
+        if (frame == nullptr) {
+            ring.record_overrun();
+            continue;
+        }
+        fill_frame(frame, seq);
+        ring.commit_write();
+    }
+    frame_ring_stats_t stats = ring.get_stats();
+    CHECK_EQ(stats.frames_written, CAPACITY);
+    CHECK_EQ(stats.overruns, produced - CAPACITY);
+    CHECK_EQ(stats.peak_fill, CAPACITY);
+    CHECK_EQ(ring.size(), CAPACITY);
+
+    // 已排队的帧保持连续：读到的是最早的 CAPACITY 帧
+    for (uint32_t seq = 0; seq < CAPACITY; seq++) {
+        const int16_t *frame = ring.acquire_read();
+        CHECK(frame != nullptr);
+        if (frame != nullptr) {
+            CHECK_EQ(check_frame(frame), seq);
+            ring.release_read();
+        }
+    }
+    CHECK(ring.acquire_read() == nullptr);
+    CHECK_EQ(ring.get_stats().frames_read, CAPACITY);
+    CHECK_EQ(ring.get_stats().peak_fill, CAPACITY);
+}
+
+typedef struct {
+    uint32_t received;
+    uint32_t gaps;          // 序号缺口中的帧数（被丢弃的帧，含最后收到的帧之后的）
+    uint32_t errors;        // 内容损坏或乱序
+} consumer_result_t;
+
+/**
+ * @brief 生产者生产 frames 帧，缓冲区满时丢弃（与采集任务相同）；消费者每帧处理至少 consume_ns
+ * @param produce_ns 生产者每帧的间隔（模拟采集节奏），0 表示尽快生产
+ */
+static consumer_result_t run_threads(FrameRing *ring, uint32_t frames, uint64_t produce_ns, uint64_t consume_ns) {
+    std::atomic<bool> done{false};
+    consumer_result_t result = {0, 0, 0};
+    uint32_t expected = 0;
+
+    std::thread consumer([&]() {
+        while (true) {
+            const int16_t *frame = ring->acquire_read();
+            if (frame == nullptr) {
+                if (done.load(std::memory_order_acquire) && ring->size() == 0) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            uint32_t seq = check_frame(frame);
+            if (seq == UINT32_MAX || seq < expected) {
+                result.errors++;
+            } else {
+                result.gaps += seq - expected;
+                expected = seq + 1;
+            }
+            if (consume_ns > 0) {
+                // 处理期间让出CPU（识别任务等待模型时同样会被采集任务抢占）
+                std::this_thread::sleep_for(std::chrono::nanoseconds(consume_ns));
+            }
+            ring->release_read();
+            result.received++;
+        }
+    });
+
+    for (uint32_t seq = 0; seq < frames; seq++) {
+        int16_t *frame = ring->acquire_write();
+        if (frame == nullptr) {
+            ring->record_overrun();
+        } else {
+            fill_frame(frame, seq);
+            ring->commit_write();
+        }
+        if (produce_ns > 0) {
+            spin_ns(produce_ns);
+        }
+        std::this_thread::yield();  // 单核主机上也让两个线程交错执行
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    result.gaps += frames - expected;
+    return result;
+}
+
+static void test_fast_consumer() {
+    static const uint32_t FRAMES = 20000;
+    std::vector<int16_t> storage(FRAME_SAMPLES * CAPACITY);
+    FrameRing ring;
+    CHECK(ring.init(storage.data(), FRAME_SAMPLES, CAPACITY));
+    // 生产者有节奏地生产，消费者不做处理（单核主机上被抢占时仍可能丢帧，丢帧必须如实计数）
+    consumer_result_t result = run_threads(&ring, FRAMES, 2000, 0);
+    frame_ring_stats_t stats = ring.get_stats();
+    CHECK_EQ(result.errors, 0);
+    CHECK_EQ(stats.frames_written + stats.overruns, FRAMES);
+    CHECK_EQ(result.received, stats.frames_written);
+    CHECK_EQ(stats.frames_read, stats.frames_written);
+    CHECK_EQ(result.gaps, stats.overruns);
+    CHECK(stats.peak_fill >= 1 && stats.peak_fill <= CAPACITY);
+    printf("快速消费者: %u 帧, 丢弃 %u, 峰值占用 %u/%zu\n", FRAMES, stats.overruns, stats.peak_fill, CAPACITY);
+}
+
+static void test_slow_consumer() {
+    static const uint32_t FRAMES = 20000;
+    std::vector<int16_t> storage(FRAME_SAMPLES * CAPACITY);
+    FrameRing ring;
+    CHECK(ring.init(storage.data(), FRAME_SAMPLES, CAPACITY));
+    // 消费者每帧至少 20 us，生产者每帧 5 us：必然写满丢帧
+    consumer_result_t result = run_threads(&ring, FRAMES, 5000, 20000);
+    frame_ring_stats_t stats = ring.get_stats();
+    CHECK_EQ(result.errors, 0);
+    CHECK(stats.overruns > 0);
+    CHECK_EQ(stats.frames_written + stats.overruns, FRAMES);
+    CHECK_EQ(result.received, stats.frames_written);
+    CHECK_EQ(stats.frames_read, stats.frames_written);
+    CHECK_EQ(result.gaps, stats.overruns);
+    CHECK_EQ(stats.peak_fill, CAPACITY);
+    printf("慢速消费者: %u 帧, 写入 %u, 丢弃 %u, 峰值占用 %u/%zu\n", FRAMES, stats.frames_written, stats.overruns,
+           stats.peak_fill, CAPACITY);
+}
+
+/**
+ * @brief 两个线程间的吞吐量：生产者写满整帧，缓冲区满时等待而不丢帧；消费者检查首尾样本
+ */
+static void bench_throughput() {
+    static const uint32_t FRAMES = 200000;
+    std::vector<int16_t> storage(FRAME_SAMPLES * CAPACITY);
+    FrameRing ring;
+    CHECK(ring.init(storage.data(), FRAME_SAMPLES, CAPACITY));
+    std::atomic<uint32_t> errors{0};
+
+    uint64_t start = host_now_ns();
+    std::thread consumer([&]() {
+        for (uint32_t seq = 0; seq < FRAMES;) {
+            const int16_t *frame = ring.acquire_read();
+            if (frame == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+            errors += frame[0] != static_cast<int16_t>(seq) || frame[FRAME_SAMPLES - 1] != static_cast<int16_t>(seq);
+            ring.release_read();
+            seq++;
+        }
+    });
+    for (uint32_t seq = 0; seq < FRAMES;) {
+        int16_t *frame = ring.acquire_write();
+        if (frame == nullptr) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::fill_n(frame, FRAME_SAMPLES, static_cast<int16_t>(seq));
+        ring.commit_write();
+        seq++;
+    }
+    consumer.join();
+    double seconds = (host_now_ns() - start) / 1e9;
+
+    CHECK_EQ(errors.load(), 0);
+    CHECK_EQ(ring.get_stats().overruns, 0);
+    CHECK_EQ(ring.get_stats().frames_read, FRAMES);
+    // 16 kHz 单声道每秒 31.25 帧
+    printf("吞吐量: %.0f 帧/秒（%.0f MB/s，实时速率的 %.0f 倍）\n", FRAMES / seconds,
+           FRAMES * FRAME_SAMPLES * sizeof(int16_t) / seconds / 1e6, FRAMES / seconds / 31.25);
+}
+
+int main() {
+    test_init();
+    test_full_single_thread();
+    test_fast_consumer();
+    test_slow_consumer();
+    bench_throughput();
+    return host_test_result("frame_ring_test");
+}
@@ -0,0 +1,123 @@
+/**
+ * @file pcm_ramp_test.cc
+ * @brief 淡入淡出与归零衰减的主机测试
+ *
+ * 发送通道常开时，片段前后都是 DMA 自动填充的 0。这里把片段放在两段 0 之间，
+ * 检查淡入淡出后边界处的台阶（相邻样本之差）不超过 满幅/ramp，
+ * 按任意块大小分块处理与整段处理结果一致，pcm_ramp_needed() 为 false 的块
+ * 处理前后不变，以及取消时的衰减尾巴单调归零。
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "audio/pcm_ramp.h"
+#include "host_test.h"
+#include "wav_file.h"
+
+static const size_t RAMP = 160;     // 10 ms @ 16 kHz，与播放任务一致
+
+/**
+ * @brief 前后补零（模拟 DMA 自动填零）后片段边界处的台阶
+ */
+static int boundary_step(const std::vector<int16_t> &clip) {
+    return std::max(std::abs(static_cast<int>(clip.front())), std::abs(static_cast<int>(clip.back())));
+}
+
+/**
+ * @brief 满幅方波：没有淡入淡出时首尾台阶为满幅
+ */
+static void test_envelope_bounds_steps() {
+    std::vector<int16_t> clip(4000);
+    for (size_t i = 0; i < clip.size(); i++) {
+        clip[i] = (i / 400) % 2 ? INT16_MIN + 1 : INT16_MAX;
+    }
+    std::vector<int16_t> ramped = clip;
+    pcm_ramp_apply(ramped.data(), ramped.size(), 0, ramped.size(), RAMP);
+
+    CHECK_EQ(boundary_step(clip), INT16_MAX);
+    CHECK_EQ(boundary_step(ramped), 0);
+    // 首尾 RAMP 个样本内的台阶不超过 满幅/RAMP（向零取整再加 1）
+    int limit = INT16_MAX / static_cast<int>(RAMP) + 1;
+    for (size_t i = 1; i < RAMP; i++) {
+        CHECK(std::abs(ramped[i] - ramped[i - 1]) <= limit);
+        size_t j = ramped.size() - i;
+        CHECK(std::abs(ramped[j] - ramped[j - 1]) <= limit);
+    }
+    // 中间部分不受影响
+    for (size_t i = RAMP; i + RAMP < clip.size(); i++) {
+        CHECK_EQ(ramped[i], clip[i]);
+    }
+}
+
+/**
+ * @brief 分块处理与整段处理一致，不需要处理的块保持原样
+ */
+static void test_chunked_matches_whole() {
+    std::vector<int16_t> clip;
+    CHECK(wav_read(repo_path("main/assets/voices/light_on.wav"), clip));
+    std::vector<int16_t> whole = clip;
+    pcm_ramp_apply(whole.data(), whole.size(), 0, whole.size(), RAMP);
+
+    for (size_t chunk : {1u, 7u, 64u, 159u, 160u, 161u, 256u, 1000u}) {
+        std::vector<int16_t> chunked = clip;
+        int skipped = 0;
+        for (size_t pos = 0; pos < chunked.size(); pos += chunk) {
+            size_t count = std::min(chunk, chunked.size() - pos);
+            if (pcm_ramp_needed(pos, count, chunked.size(), RAMP)) {
+                pcm_ramp_apply(chunked.data() + pos, count, pos, chunked.size(), RAMP);
+            } else {
+                skipped++;
+            }
+        }
+        CHECK(chunked == whole);
+        CHECK(skipped > 0);
+    }
+
+    printf("light_on: 边界台阶 %d -> %d\n", boundary_step(clip), boundary_step(whole));
+    CHECK_EQ(boundary_step(whole), 0);
+}
+
+/**
+ * @brief 短于 2*ramp 的片段为三角形包络，首尾仍为 0
+ */
+static void test_short_clip() {
+    std::vector<int16_t> clip(101, 10000);
+    pcm_ramp_apply(clip.data(), clip.size(), 0, clip.size(), RAMP);
+    CHECK_EQ(clip.front(), 0);
+    CHECK_EQ(clip.back(), 0);
+    for (size_t i = 1; i <= 50; i++) {
+        CHECK(clip[i] >= clip[i - 1]);
+        CHECK_EQ(clip[i], clip[clip.size() - 1 - i]);
+    }
+    CHECK(pcm_ramp_needed(40, 20, 101, RAMP));
+    CHECK(!pcm_ramp_needed(0, 10, 101, 0));
+    CHECK(!pcm_ramp_needed(0, 0, 101, RAMP));
+}
+
+/**
+ * @brief 衰减尾巴从上一个样本单调归零，最后一个样本恰好为 0
+ */
+static void test_decay() {
+    for (int from : {INT16_MAX, INT16_MIN, 12345, -1, 1}) {
+        std::vector<int16_t> tail(RAMP);
+        pcm_ramp_decay(tail.data(), tail.size(), static_cast<int16_t>(from));
+        CHECK_EQ(tail.back(), 0);
+        CHECK(std::abs(from - tail[0]) <= std::abs(from) / static_cast<int>(RAMP) + 1);
+        for (size_t i = 1; i < tail.size(); i++) {
+            CHECK(std::abs(tail[i]) <= std::abs(tail[i - 1]));
+            CHECK(std::abs(tail[i] - tail[i - 1]) <= std::abs(from) / static_cast<int>(RAMP) + 1);
+        }
+    }
+    int16_t single = 0;
+    pcm_ramp_decay(&single, 1, 20000);
+    CHECK_EQ(single, 0);
+}
+
+int main() {
+    test_envelope_bounds_steps();
+    test_chunked_matches_whole();
+    test_short_clip();
+    test_decay();
+    return host_test_result("pcm_ramp_test");
+}
@@ -0,0 +1,363 @@
+/**
+ * @file playback_scheduler_test.cc
+ * @brief 提示音播放调度器的主机测试
+ *
+ * 用假的 I2S 输出端记录写入的样本和回调顺序，检查排队顺序、取消、
+ * 淡入淡出、写入失败和启动延迟；最后测量每块 pump() 的开销。
+ */
+
+#include <cstring>
+#include <vector>
+#include "audio/playback_scheduler.h"
+#include "host_test.h"
+
+static const size_t CHUNK_BYTES = 512;          // 与播放任务的DMA块大小一致
+static const size_t SCRATCH_SAMPLES = CHUNK_BYTES / sizeof(int16_t);
+
+/**
+ * @brief 假的 I2S 输出端
+ */
+class FakeSink : public PlaybackSink {
+public:
+    std::vector<int16_t> samples;           // 写入的全部样本
+    std::vector<playback_id_t> started;     // clip_started 的顺序
+    std::vector<size_t> write_sizes;
+    int idle_count = 0;
+    int fail_after = -1;                    // 写入这么多次后开始失败，-1 表示不失败
+    size_t max_write = 0;                   // 单次最多接受的字节数，0 表示不限
+    uint64_t first_write_ns = 0;
+
+    int write(const uint8_t *data, size_t len) override {
+        if (fail_after == 0) {
+            return -1;
+        }
+        if (fail_after > 0) {
+            fail_after--;
+        }
+        if (max_write > 0 && len > max_write) {
+            len = max_write;
+        }
+        if (first_write_ns == 0) {
+            first_write_ns = host_now_ns();
+        }
+        size_t start = samples.size();
+        samples.resize(start + len / sizeof(int16_t));
+        memcpy(samples.data() + start, data, len / sizeof(int16_t) * sizeof(int16_t));
+        write_sizes.push_back(len);
+        return static_cast<int>(len);
+    }
+
+    void idle() override { idle_count++; }
+
+    void clip_started(const playback_clip_t &clip) override { started.push_back(clip.id); }
+};
+
+struct event_record_t {
+    playback_id_t id;
+    playback_event_t event;
+};
+
+static std::vector<event_record_t> events;
+
+static void on_finished(playback_id_t id, playback_event_t event, void *user_ctx) {
+    (void)user_ctx;
+    events.push_back({id, event});
+}
+
+static playback_clip_t make_clip(playback_id_t id, const std::vector<int16_t> &pcm) {
+    playback_clip_t clip = {};
+    clip.id = id;
+    clip.data = reinterpret_cast<const uint8_t *>(pcm.data());
+    clip.len = pcm.size() * sizeof(int16_t);
+    clip.codec = PLAYBACK_CODEC_PCM16;
+    clip.callback = on_finished;
+    return clip;
+}
+
+static void run_until_idle(PlaybackScheduler &scheduler, FakeSink &sink) {
+    for (int guard = 0; guard < 100000 && scheduler.pump(sink, CHUNK_BYTES); guard++) {
+    }
+}
+
+/**
+ * @brief 片段按入队顺序完整播放，每个片段完成一次回调，最后空闲一次
+ */
+static void test_fifo_order() {
+    events.clear();
+    std::vector<int16_t> a(1000, 100), b(300, 200), c(2000, 300);
+    PlaybackScheduler scheduler;
+    FakeSink sink;
+
+    CHECK(scheduler.enqueue(make_clip(1, a)));
+    CHECK(scheduler.enqueue(make_clip(2, b)));
+    CHECK(scheduler.enqueue(make_clip(3, c)));
+    CHECK_EQ(scheduler.pending(), 3);
+    run_until_idle(scheduler, sink);
+
+    CHECK(!scheduler.busy());
+    CHECK_EQ(sink.idle_count, 1);
+    CHECK_EQ(sink.samples.size(), a.size() + b.size() + c.size());
+    CHECK_EQ(sink.samples[0], 100);
+    CHECK_EQ(sink.samples[a.size()], 200);
+    CHECK_EQ(sink.samples[a.size() + b.size()], 300);
+    CHECK_EQ(events.size(), 3);
+    for (size_t i = 0; i < events.size(); i++) {
+        CHECK_EQ(events[i].id, i + 1);
+        CHECK_EQ(events[i].event, PLAYBACK_EVENT_DONE);
+    }
+    CHECK(sink.started == std::vector<playback_id_t>({1, 2, 3}));
+    CHECK_EQ(scheduler.finished_count(), 3);
+
+    // 每块不超过 chunk_bytes，且片段之间不拼块
+    for (size_t len : sink.write_sizes) {
+        CHECK(len <= CHUNK_BYTES);
+    }
+
+    // 空闲后再 pump 不会重复通知
+    CHECK(!scheduler.pump(sink, CHUNK_BYTES));
+    CHECK_EQ(sink.idle_count, 1);
+}
+
+/**
+ * @brief 取消排队中的片段不影响其余片段的顺序
+ */
+static void test_cancel_pending() {
+    events.clear();
+    std::vector<int16_t> pcm(400, 1);
+    PlaybackScheduler scheduler;
+    FakeSink sink;
+
+    for (playback_id_t id = 1; id <= 4; id++) {
+        CHECK(scheduler.enqueue(make_clip(id, pcm)));
+    }
+    CHECK(scheduler.cancel(3));
+    CHECK(!scheduler.cancel(3));
+    CHECK(!scheduler.cancel(99));
+    CHECK_EQ(events.size(), 1);
+    CHECK_EQ(events[0].id, 3);
+    CHECK_EQ(events[0].event, PLAYBACK_EVENT_CANCELLED);
+
+    run_until_idle(scheduler, sink);
+    CHECK(sink.started == std::vector<playback_id_t>({1, 2, 4}));
+    CHECK_EQ(events.size(), 4);
+    CHECK_EQ(events[3].id, 4);
+}
+
+/**
+ * @brief 播放中途取消：写出衰减到 0 的尾巴后再进入空闲
+ */
+static void test_cancel_current_with_decay() {
+    events.clear();
+    std::vector<int16_t> pcm(16000, 8000);
+    std::vector<int16_t> scratch(SCRATCH_SAMPLES);
+    PlaybackScheduler scheduler;
+    scheduler.set_ramp(64, scratch.data(), scratch.size());
+    FakeSink sink;
+
+    CHECK(scheduler.enqueue(make_clip(7, pcm)));
+    for (int i = 0; i < 4; i++) {
+        CHECK(scheduler.pump(sink, CHUNK_BYTES));
+    }
+    CHECK_EQ(scheduler.current_id(), 7);
+    size_t before = sink.samples.size();
+    CHECK_EQ(sink.samples[0], 0);               // 淡入从 0 开始
+    CHECK_EQ(sink.samples[before - 1], 8000);   // 已过淡入区域
+
+    CHECK(scheduler.cancel(7));
+    CHECK_EQ(scheduler.current_id(), 0);
+    CHECK_EQ(events.size(), 1);
+    CHECK_EQ(events[0].event, PLAYBACK_EVENT_CANCELLED);
+
+    scheduler.stop_output(sink);
+    CHECK_EQ(sink.idle_count, 1);
+    CHECK_EQ(sink.samples.size(), before + 64);
+    CHECK_EQ(sink.samples.back(), 0);
+    for (size_t i = before + 1; i < sink.samples.size(); i++) {
+        CHECK(sink.samples[i] <= sink.samples[i - 1]);
+    }
+}
+
+/**
+ * @brief cancel_all 按顺序取消当前片段和全部排队片段
+ */
+static void test_cancel_all() {
+    events.clear();
+    std::vector<int16_t> pcm(4000, 5);
+    PlaybackScheduler scheduler;
+    FakeSink sink;
+
+    for (playback_id_t id = 1; id <= 3; id++) {
+        CHECK(scheduler.enqueue(make_clip(id, pcm)));
+    }
+    CHECK(scheduler.pump(sink, CHUNK_BYTES));
+    scheduler.cancel_all();
+    CHECK(!scheduler.busy());
+    CHECK_EQ(events.size(), 3);
+    for (size_t i = 0; i < events.size(); i++) {
+        CHECK_EQ(events[i].id, i + 1);
+        CHECK_EQ(events[i].event, PLAYBACK_EVENT_CANCELLED);
+    }
+}
+
+/**
+ * @brief 队列已满、空片段都拒绝入队
+ */
+static void test_queue_full() {
+    std::vector<int16_t> pcm(10, 1);
+    PlaybackScheduler scheduler;
+    for (size_t i = 0; i < PlaybackScheduler::MAX_PENDING; i++) {
+        CHECK(scheduler.enqueue(make_clip(static_cast<playback_id_t>(i + 1), pcm)));
+    }
+    CHECK(!scheduler.enqueue(make_clip(100, pcm)));
+
+    PlaybackScheduler empty;
+    playback_clip_t clip = make_clip(1, pcm);
+    clip.len = 0;
+    CHECK(!empty.enqueue(clip));
+    clip = make_clip(1, pcm);
+    clip.data = nullptr;
+    CHECK(!empty.enqueue(clip));
+}
+
+/**
+ * @brief 写入失败时片段以 FAILED 结束，继续播放下一个片段
+ */
+static void test_write_failure() {
+    events.clear();
+    std::vector<int16_t> pcm(2000, 9);
+    PlaybackScheduler scheduler;
+    FakeSink sink;
+    sink.fail_after = 2;
+
+    CHECK(scheduler.enqueue(make_clip(1, pcm)));
+    CHECK(scheduler.enqueue(make_clip(2, pcm)));
+    CHECK(scheduler.pump(sink, CHUNK_BYTES));
+    CHECK(scheduler.pump(sink, CHUNK_BYTES));
+    CHECK(scheduler.pump(sink, CHUNK_BYTES));   // 失败，切到片段 2
+    CHECK_EQ(events.size(), 1);
+    CHECK_EQ(events[0].id, 1);
+    CHECK_EQ(events[0].event, PLAYBACK_EVENT_FAILED);
+
+    sink.fail_after = -1;
+    run_until_idle(scheduler, sink);
+    CHECK_EQ(events.size(), 2);
+    CHECK_EQ(events[1].id, 2);
+    CHECK_EQ(events[1].event, PLAYBACK_EVENT_DONE);
+}
+
+/**
+ * @brief 输出端只接受部分数据时从断点继续，不丢样本（PCM 和 ADPCM）
+ */
+static void test_partial_write() {
+    std::vector<int16_t> pcm(3001);
+    for (size_t i = 0; i < pcm.size(); i++) {
+        pcm[i] = static_cast<int16_t>(i);
+    }
+    PlaybackScheduler scheduler;
+    FakeSink sink;
+    sink.max_write = 100;
+    CHECK(scheduler.enqueue(make_clip(1, pcm)));
+    run_until_idle(scheduler, sink);
+    CHECK(sink.samples == pcm);
+
+    // ADPCM：部分写入的结果与一次写完相同
+    std::vector<uint8_t> adpcm(1500);
+    for (size_t i = 0; i < adpcm.size(); i++) {
+        adpcm[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    std::vector<int16_t> scratch(SCRATCH_SAMPLES);
+    std::vector<int16_t> whole;
+    for (size_t max_write : {static_cast<size_t>(0), static_cast<size_t>(70)}) {
+        PlaybackScheduler adpcm_scheduler;
+        adpcm_scheduler.set_ramp(0, scratch.data(), scratch.size());
+        FakeSink adpcm_sink;
+        adpcm_sink.max_write = max_write;
+        playback_clip_t clip = {};
+        clip.id = 2;
+        clip.data = adpcm.data();
+        clip.len = adpcm.size();
+        clip.codec = PLAYBACK_CODEC_IMA_ADPCM;
+        CHECK(adpcm_scheduler.enqueue(clip));
+        run_until_idle(adpcm_scheduler, adpcm_sink);
+        CHECK_EQ(adpcm_sink.samples.size(), adpcm.size() * 2);
+        if (max_write == 0) {
+            whole = adpcm_sink.samples;
+        } else {
+            CHECK(adpcm_sink.samples == whole);
+        }
+    }
+}
+
+/**
+ * @brief 启动延迟：入队到第一块写出之间只有一次 pump
+ *
+ * 识别循环不等待播放，长片段（welcome 约 7 秒）排在后面的提示音
+ * 也只需等待前一片段剩余的块数。
+ */
+static void test_start_latency() {
+    std::vector<int16_t> welcome(231550 / sizeof(int16_t), 1000);
+    std::vector<int16_t> beep(800, 2000);
+    PlaybackScheduler scheduler;
+    FakeSink sink;
+
+    uint64_t enqueued = host_now_ns();
+    CHECK(scheduler.enqueue(make_clip(1, welcome)));
+    CHECK(scheduler.pump(sink, CHUNK_BYTES));
+    CHECK_EQ(sink.started.size(), 1);
+    printf("入队到首块写出: %.1f us\n", (sink.first_write_ns - enqueued) / 1000.0);
+
+    // 打断 welcome，新提示音在下一次 pump 开始
+    CHECK(scheduler.enqueue(make_clip(2, beep)));
+    scheduler.cancel(1);
+    CHECK(scheduler.pump(sink, CHUNK_BYTES));
+    CHECK_EQ(sink.started.size(), 2);
+    CHECK_EQ(sink.started[1], 2);
+}
+
+/**
+ * @brief 每块 pump() 的开销（PCM 带淡入淡出、ADPCM 解码）
+ */
+static void bench_pump() {
+    std::vector<int16_t> pcm(16000 * 7, 1234);
+    std::vector<uint8_t> adpcm(16000 * 7 / 2, 0x37);
+    std::vector<int16_t> scratch(SCRATCH_SAMPLES);
+
+    class NullSink : public PlaybackSink {
+    public:
+        int write(const uint8_t *data, size_t len) override { (void)data; return static_cast<int>(len); }
+        void idle() override {}
+    } sink;
+
+    for (int codec = 0; codec < 2; codec++) {
+        PlaybackScheduler scheduler;
+        scheduler.set_ramp(160, scratch.data(), scratch.size());
+        playback_clip_t clip = make_clip(1, pcm);
+        if (codec == PLAYBACK_CODEC_IMA_ADPCM) {
+            clip.data = adpcm.data();
+            clip.len = adpcm.size();
+            clip.codec = PLAYBACK_CODEC_IMA_ADPCM;
+        }
+        CHECK(scheduler.enqueue(clip));
+        uint64_t start = host_now_ns();
+        size_t chunks = 0;
+        while (scheduler.pump(sink, CHUNK_BYTES)) {
+            chunks++;
+        }
+        uint64_t elapsed = host_now_ns() - start;
+        printf("%s: %zu 块, 每块 %.0f ns\n", codec ? "ADPCM" : "PCM16", chunks,
+               chunks ? static_cast<double>(elapsed) / chunks : 0.0);
+    }
+}
+
+int main() {
+    test_fifo_order();
+    test_cancel_pending();
+    test_cancel_current_with_decay();
+    test_cancel_all();
+    test_queue_full();
+    test_write_failure();
+    test_partial_write();
+    test_start_latency();
+    bench_pump();
+    return host_test_result("playback_scheduler_test");
+}
@@ -0,0 +1,146 @@
+/**
+ * @file prompt_bundle_test.cc
+ * @brief 提示音包打包与解析的主机测试
+ *
+ * 用 tools/prompt_pack.py 打包仓库中的全部提示音，再用固件的 PromptBundle 解析：
+ * 名称、查找、元数据和 PCM 数据必须与 WAV 原文件一致，数据按 4 字节对齐；
+ * 截断和损坏的包必须被拒绝或仍保证所有视图在范围内。
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "audio/prompt_bundle.h"
+#include "host_test.h"
+#include "wav_file.h"
+
+static const char *const VOICES[] = {
+    "byebye", "custom", "hilexin", "light_off", "light_on", "say_again", "welcome",
+};
+static const size_t VOICE_COUNT = sizeof(VOICES) / sizeof(VOICES[0]);
+
+static std::string voice_path(const char *name) {
+    return repo_path((std::string("main/assets/voices/") + name + ".wav").c_str());
+}
+
+static std::string voice_args() {
+    std::string args;
+    for (const char *name : VOICES) {
+        args += " " + voice_path(name);
+    }
+    return args;
+}
+
+/**
+ * @brief 解析成功时，所有视图都必须落在包内
+ */
+static bool views_in_range(const PromptBundle &bundle, const uint8_t *base, size_t size) {
+    for (size_t i = 0; i < bundle.count(); i++) {
+        prompt_view_t view = bundle.at(i);
+        if (view.data < base || view.data + view.len > base + size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_pack_and_parse() {
+    std::string output = host_temp_path("prompts.bin");
+    CHECK_EQ(run_tool("prompt_pack.py", "pack -o " + output + voice_args() + " > /dev/null"), 0);
+
+    std::vector<uint8_t> blob;
+    CHECK(read_file(output, blob));
+    PromptBundle bundle;
+    CHECK(bundle.parse(blob.data(), blob.size()));
+    CHECK_EQ(bundle.count(), VOICE_COUNT);
+    CHECK_EQ(bundle.total_size(), blob.size());
+
+    for (size_t i = 0; i < VOICE_COUNT; i++) {
+        char name[PromptBundle::NAME_MAX + 1];
+        CHECK(bundle.name_at(i, name));
+        CHECK(strcmp(name, VOICES[i]) == 0);
+        CHECK_EQ(bundle.find(VOICES[i]), i);
+
+        std::vector<int16_t> pcm;
+        CHECK(wav_read(voice_path(VOICES[i]), pcm));
+        prompt_view_t view = bundle.at(i);
+        CHECK(view.data != nullptr);
+        CHECK_EQ((view.data - blob.data()) % 4, 0);
+        CHECK_EQ(view.codec, 0);
+        CHECK_EQ(view.sample_rate, 16000);
+        CHECK_EQ(view.samples, pcm.size());
+        CHECK_EQ(view.len, pcm.size() * sizeof(int16_t));
+        CHECK_EQ(view.gain_q8, 256);
+        CHECK_EQ(view.trim_head, 0);
+        CHECK_EQ(view.trim_tail, 0);
+        CHECK(view.len == 0 || memcmp(view.data, pcm.data(), view.len) == 0);
+        CHECK_EQ(PromptBundle::duration_ms(view), pcm.size() / 16);
+    }
+
+    CHECK_EQ(bundle.find("missing"), -1);
+    CHECK_EQ(bundle.find(""), -1);
+    CHECK(bundle.at(VOICE_COUNT).data == nullptr);
+    char name[PromptBundle::NAME_MAX + 1];
+    CHECK(!bundle.name_at(VOICE_COUNT, name));
+}
+
+static void test_corruption() {
+    std::vector<uint8_t> blob;
+    CHECK(read_file(host_temp_path("prompts.bin"), blob));
+    PromptBundle bundle;
+
+    // 头部和索引被截断时必须拒绝；数据被截断时 total_size 超出可访问范围，同样拒绝
+    for (size_t size = 0; size < blob.size(); size += (size < 512) ? 1 : 997) {
+        CHECK(!bundle.parse(blob.data(), size));
+    }
+    CHECK(!bundle.parse(nullptr, blob.size()));
+
+    // 头部和索引的每一位翻转：要么拒绝，要么所有视图仍在范围内
+    size_t index_end = 16 + 48 * VOICE_COUNT;
+    int rejected = 0;
+    for (size_t bit = 0; bit < index_end * 8; bit++) {
+        std::vector<uint8_t> corrupt = blob;
+        corrupt[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        if (bundle.parse(corrupt.data(), corrupt.size())) {
+            CHECK(views_in_range(bundle, corrupt.data(), corrupt.size()));
+        } else {
+            rejected++;
+        }
+    }
+    printf("头部/索引 %zu 位翻转, 拒绝 %d 次\n", index_end * 8, rejected);
+
+    // 版本不符
+    std::vector<uint8_t> old = blob;
+    old[4] = 1;
+    CHECK(!bundle.parse(old.data(), old.size()));
+}
+
+static void bench_find() {
+    std::vector<uint8_t> blob;
+    CHECK(read_file(host_temp_path("prompts.bin"), blob));
+    PromptBundle bundle;
+    CHECK(bundle.parse(blob.data(), blob.size()));
+
+    const int iterations = 200000;
+    int found = 0;
+    uint64_t start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        found += bundle.find(VOICES[i % VOICE_COUNT]) >= 0;
+    }
+    double find_ns = static_cast<double>(host_now_ns() - start) / iterations;
+    CHECK_EQ(found, iterations);
+
+    start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        bundle.parse(blob.data(), blob.size());
+    }
+    double parse_ns = static_cast<double>(host_now_ns() - start) / iterations;
+    printf("find: %.0f ns, parse: %.0f ns\n", find_ns, parse_ns);
+}
+
+int main() {
+    test_pack_and_parse();
+    test_corruption();
+    bench_find();
+    return host_test_result("prompt_bundle_test");
+}
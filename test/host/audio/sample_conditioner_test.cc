@@ -0,0 +1,237 @@
+/**
+ * @file sample_conditioner_test.cc
+ * @brief 采样调理内核的金标准向量测试和基准测试
+ *
+ * 主机上只有标量实现。golden 表中的输出是按头文件描述的处理顺序手算的，
+ * 在 ESP32-S3 上用同样的输入调用 sample_conditioner_process() 应得到同样的
+ * 结果（向量实现与标量实现逐位一致）；主机上另用 64 位闭式参考模型对全部
+ * int16 输入做穷举比对。
+ */
+
+#include <cstring>
+#include <vector>
+#include "audio/sample_conditioner.h"
+#include "host_test.h"
+
+static const size_t FRAME_SAMPLES = 512;    // 每次 bsp_get_feed_data() 的样本数
+static const int BENCH_FRAMES = 20000;
+
+/**
+ * @brief 闭式参考模型：逐次饱和加倍等价于一次乘以 2^g 后饱和
+ */
+static int16_t reference(int16_t x, int16_t dc, int gain_shift, int16_t hi, int16_t lo) {
+    int64_t v = static_cast<int64_t>(x) - dc;
+    v = (v > INT16_MAX) ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v);
+    v *= (1 << gain_shift);
+    v = (v > INT16_MAX) ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v);
+    v = (v > hi) ? hi : (v < lo ? lo : v);
+    return static_cast<int16_t>(v);
+}
+
+typedef struct {
+    int16_t in[8];
+    int16_t dc;
+    int gain_shift;
+    int16_t hi;
+    int16_t lo;
+    int16_t out[8];
+} golden_vector_t;
+
+static const golden_vector_t GOLDEN[] = {
+    // 恒等变换
+    {{0, 1, -1, 100, -100, 32767, -32768, 12345}, 0, 0, 32767, -32768,
+     {0, 1, -1, 100, -100, 32767, -32768, 12345}},
+    // 2 倍增益，饱和
+    {{0, 1, -1, 16383, 16384, -16384, -16385, 20000}, 0, 1, 32767, -32768,
+     {0, 2, -2, 32766, 32767, -32768, -32768, 32767}},
+    // 8 倍增益，饱和
+    {{4095, 4096, -4096, -4097, 1000, -1000, 3, -3}, 0, 3, 32767, -32768,
+     {32760, 32767, -32768, -32768, 8000, -8000, 24, -24}},
+    // 去直流时减法饱和
+    {{-32768, -32000, 0, 32767, 100, -100, 500, -500}, 500, 0, 32767, -32768,
+     {-32768, -32500, -500, 32267, -400, -600, 0, -1000}},
+    {{32767, 32000, 0, -32768, 100, -100, 500, -500}, -500, 0, 32767, -32768,
+     {32767, 32500, 500, -32268, 600, 400, 1000, 0}},
+    // 去直流 + 4 倍增益 + 限幅 [-20001, 20000]
+    {{1000, 6000, -4000, 200, 0, 7000, -7000, 100}, 100, 2, 20000, -20001,
+     {3600, 20000, -16400, 400, -400, 20000, -20001, 0}},
+};
+
+/**
+ * @brief 金标准向量：对齐缓冲区，单帧 8 个样本（向量实现恰好一块）
+ */
+static void test_golden_vectors() {
+    for (const golden_vector_t &g : GOLDEN) {
+        alignas(16) int16_t buffer[8];
+        memcpy(buffer, g.in, sizeof(buffer));
+        sample_condition_s16_ansi(buffer, 8, g.dc, g.gain_shift, g.hi, g.lo);
+        for (int i = 0; i < 8; i++) {
+            CHECK_EQ(buffer[i], g.out[i]);
+            CHECK_EQ(reference(g.in[i], g.dc, g.gain_shift, g.hi, g.lo), g.out[i]);
+        }
+    }
+}
+
+/**
+ * @brief 全部 int16 输入与参考模型逐位比对
+ */
+static void test_exhaustive() {
+    static const int16_t DCS[] = {0, 1, -1, 517, -517, 32767, -32768};
+    static const int16_t CLAMPS[] = {INT16_MAX, 20000, 1};
+    std::vector<int16_t> input(65536);
+    for (int i = 0; i < 65536; i++) {
+        input[i] = static_cast<int16_t>(i - 32768);
+    }
+
+    std::vector<int16_t> buffer(input.size());
+    int mismatches = 0;
+    for (int16_t dc : DCS) {
+        for (int gain = 0; gain <= 3; gain++) {
+            for (int16_t clamp : CLAMPS) {
+                int16_t lo = static_cast<int16_t>(-clamp - 1);
+                buffer = input;
+                sample_condition_s16_ansi(buffer.data(), buffer.size(), dc, gain, clamp, lo);
+                for (size_t i = 0; i < buffer.size(); i++) {
+                    mismatches += buffer[i] != reference(input[i], dc, gain, clamp, lo);
+                }
+            }
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+/**
+ * @brief process() 的配置截断、恒等快速路径和不对齐尾部
+ */
+static void test_process() {
+    sample_conditioner_config_t config = SAMPLE_CONDITIONER_DEFAULT_CONFIG();
+    sample_conditioner_t conditioner;
+
+    // 默认配置不改动数据
+    sample_conditioner_init(&conditioner, &config);
+    int16_t frame[13];
+    for (int i = 0; i < 13; i++) {
+        frame[i] = static_cast<int16_t>(i * 5000 - 30000);
+    }
+    int16_t copy[13];
+    memcpy(copy, frame, sizeof(frame));
+    sample_conditioner_process(&conditioner, frame, 13);
+    CHECK(memcmp(copy, frame, sizeof(frame)) == 0);
+
+    // 超范围的参数被截断
+    config.gain_shift = 9;
+    config.clamp_limit = -5;
+    config.dc_smoothing = 99;
+    sample_conditioner_init(&conditioner, &config);
+    CHECK_EQ(conditioner.config.gain_shift, 3);
+    CHECK_EQ(conditioner.config.clamp_limit, 1);
+    CHECK_EQ(conditioner.config.dc_smoothing, 15);
+
+    // 从第 1 个样本开始（不对齐）、长度不是 8 的倍数
+    config = SAMPLE_CONDITIONER_DEFAULT_CONFIG();
+    config.gain_shift = 1;
+    sample_conditioner_init(&conditioner, &config);
+    alignas(16) int16_t unaligned[20];
+    for (int i = 0; i < 20; i++) {
+        unaligned[i] = static_cast<int16_t>(i * 1500 - 15000);
+    }
+    sample_conditioner_process(&conditioner, unaligned + 1, 19);
+    CHECK_EQ(unaligned[0], -15000);
+    for (int i = 1; i < 20; i++) {
+        CHECK_EQ(unaligned[i], reference(static_cast<int16_t>(i * 1500 - 15000), 0, 1, INT16_MAX, INT16_MIN));
+    }
+}
+
+/**
+ * @brief 恒定直流偏置被逐帧估计并去除
+ */
+static void test_dc_removal() {
+    sample_conditioner_config_t config = SAMPLE_CONDITIONER_DEFAULT_CONFIG();
+    config.dc_removal = true;
+    config.dc_smoothing = 2;
+    sample_conditioner_t conditioner;
+    sample_conditioner_init(&conditioner, &config);
+
+    std::vector<int16_t> frame(FRAME_SAMPLES);
+    int32_t residual = 0;
+    for (int n = 0; n < 60; n++) {
+        for (size_t i = 0; i < frame.size(); i++) {
+            frame[i] = static_cast<int16_t>(-700 + ((i & 1) ? 300 : -300));
+        }
+        sample_conditioner_process(&conditioner, frame.data(), frame.size());
+        int32_t sum = 0;
+        for (int16_t s : frame) {
+            sum += s;
+        }
+        residual = sum / static_cast<int32_t>(frame.size());
+    }
+    CHECK(residual >= -1 && residual <= 1);
+    CHECK_EQ(frame[0], -300 + residual);
+}
+
+/**
+ * @brief 原 bsp_get_feed_data() 中的逐样本循环（2 倍增益 + 限幅），作为基准
+ */
+static void legacy_loop(int16_t *buffer, int samples) {
+    for (int i = 0; i < samples; i++) {
+        int32_t sample = static_cast<int32_t>(buffer[i]);
+        sample = sample * 2;
+        if (sample > 32767) {
+            sample = 32767;
+        }
+        if (sample < -32768) {
+            sample = -32768;
+        }
+        buffer[i] = static_cast<int16_t>(sample);
+    }
+}
+
+static void bench() {
+    alignas(16) int16_t frame[FRAME_SAMPLES];
+    uint32_t seed = 1;
+    for (size_t i = 0; i < FRAME_SAMPLES; i++) {
+        seed = seed * 1103515245u + 12345u;
+        frame[i] = static_cast<int16_t>(seed >> 16);
+    }
+
+    sample_conditioner_config_t config = SAMPLE_CONDITIONER_DEFAULT_CONFIG();
+    config.gain_shift = 1;
+    sample_conditioner_t conditioner;
+    sample_conditioner_init(&conditioner, &config);
+
+    alignas(16) int16_t work[FRAME_SAMPLES];
+    uint64_t start = host_now_ns();
+    for (int n = 0; n < BENCH_FRAMES; n++) {
+        memcpy(work, frame, sizeof(work));
+        legacy_loop(work, FRAME_SAMPLES);
+    }
+    double legacy_ns = static_cast<double>(host_now_ns() - start) / BENCH_FRAMES;
+
+    start = host_now_ns();
+    for (int n = 0; n < BENCH_FRAMES; n++) {
+        memcpy(work, frame, sizeof(work));
+        sample_conditioner_process(&conditioner, work, FRAME_SAMPLES);
+    }
+    double kernel_ns = static_cast<double>(host_now_ns() - start) / BENCH_FRAMES;
+
+    config.dc_removal = true;
+    sample_conditioner_init(&conditioner, &config);
+    start = host_now_ns();
+    for (int n = 0; n < BENCH_FRAMES; n++) {
+        memcpy(work, frame, sizeof(work));
+        sample_conditioner_process(&conditioner, work, FRAME_SAMPLES);
+    }
+    double dc_ns = static_cast<double>(host_now_ns() - start) / BENCH_FRAMES;
+
+    printf("每帧 %zu 样本: 原循环 %.0f ns, 标量内核 %.0f ns, 标量内核+去直流 %.0f ns\n",
+           FRAME_SAMPLES, legacy_ns, kernel_ns, dc_ns);
+}
+
+int main() {
+    test_golden_vectors();
+    test_exhaustive();
+    test_process();
+    test_dc_removal();
+    bench();
+    return host_test_result("sample_conditioner_test");
+}
@@ -0,0 +1,147 @@
+/**
+ * @file sample_convert_test.cc
+ * @brief 32 位 I2S 槽转 16 位样本的主机测试
+ *
+ * 按 INMP441 的格式合成 24 位左对齐在 32 位槽中的数据（低 8 位为 0），
+ * 检查各 shift 下的输出、饱和，以及与 16 位槽模式（shift=16）的一致性，
+ * 最后测量每帧转换的开销。
+ */
+
+#include <cmath>
+#include <vector>
+#include "audio/sample_conditioner.h"
+#include "host_test.h"
+
+static const size_t FRAME_SAMPLES = 512;
+static const int BENCH_FRAMES = 20000;
+
+/**
+ * @brief 24 位样本放入 32 位槽（左对齐）
+ */
+static int32_t slot_from_24(int32_t sample24) {
+    return static_cast<int32_t>(static_cast<uint32_t>(sample24) << 8);
+}
+
+static int16_t reference(int32_t slot, int shift) {
+    int64_t v = static_cast<int64_t>(slot) >> shift;
+    v = (v > INT16_MAX) ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v);
+    return static_cast<int16_t>(v);
+}
+
+/**
+ * @brief 边界值在每个 shift 下的输出
+ */
+static void test_edges() {
+    static const int32_t SAMPLES24[] = {
+        0, 1, -1, 127, 128, -128, -129, 255, 256, 0x7FFF, 0x8000, -0x8000, -0x8001,
+        0x7FFFFF, -0x800000, 0x123456, -0x123456,
+    };
+    const size_t count = sizeof(SAMPLES24) / sizeof(SAMPLES24[0]);
+    std::vector<int32_t> in(count);
+    for (size_t i = 0; i < count; i++) {
+        in[i] = slot_from_24(SAMPLES24[i]);
+    }
+
+    for (int shift = 8; shift <= 16; shift++) {
+        std::vector<int16_t> out(count);
+        sample_convert_s32_to_s16(in.data(), out.data(), count, shift);
+        for (size_t i = 0; i < count; i++) {
+            CHECK_EQ(out[i], reference(in[i], shift));
+        }
+    }
+
+    // shift=16 取最高 16 位：满幅不饱和，与 16 位槽模式读到的数据相同
+    std::vector<int16_t> out(count);
+    sample_convert_s32_to_s16(in.data(), out.data(), count, 16);
+    CHECK_EQ(out[13], 0x7FFF);      // 0x7FFFFF
+    CHECK_EQ(out[14], -0x8000);     // -0x800000
+    CHECK_EQ(out[15], 0x1234);
+    CHECK_EQ(out[16], -0x1235);     // 算术右移向负无穷取整
+    CHECK_EQ(out[1], 0);
+
+    // shift=8 保留全部 24 位，超出 int16 的样本饱和
+    sample_convert_s32_to_s16(in.data(), out.data(), count, 8);
+    CHECK_EQ(out[1], 1);
+    CHECK_EQ(out[9], 0x7FFF);
+    CHECK_EQ(out[10], INT16_MAX);   // 0x8000 饱和
+    CHECK_EQ(out[11], -0x8000);
+    CHECK_EQ(out[12], INT16_MIN);   // -0x8001 饱和
+}
+
+/**
+ * @brief 低电平正弦：shift 越小保留的低位越多，量化误差越小且不饱和
+ */
+static void test_sine_headroom() {
+    const double PI = 3.14159265358979323846;
+    std::vector<int32_t> in(16000);
+    for (size_t i = 0; i < in.size(); i++) {
+        // -48 dBFS、1 kHz，24 位精度
+        double v = std::sin(2.0 * PI * 1000.0 * i / 16000.0) * 0x7FFFFF / 251.2;
+        in[i] = slot_from_24(static_cast<int32_t>(std::lround(v)));
+    }
+
+    double prev_error = 1e30;
+    for (int shift = 16; shift >= 10; shift -= 2) {
+        std::vector<int16_t> out(in.size());
+        sample_convert_s32_to_s16(in.data(), out.data(), in.size(), shift);
+        double scale = std::ldexp(1.0, shift);
+        double error = 0.0;
+        int saturated = 0;
+        for (size_t i = 0; i < in.size(); i++) {
+            double exact = in[i] / scale;
+            error += (exact - out[i]) * (exact - out[i]) * scale * scale;
+            saturated += (out[i] == INT16_MAX || out[i] == INT16_MIN);
+        }
+        error = std::sqrt(error / in.size());
+        CHECK_EQ(saturated, 0);
+        CHECK(error < prev_error);  // 相对 32 位槽的量化误差随 shift 减小
+        prev_error = error;
+    }
+}
+
+/**
+ * @brief 全帧随机数据与参考模型比对
+ */
+static void test_random() {
+    std::vector<int32_t> in(FRAME_SAMPLES * 64);
+    uint32_t seed = 7;
+    for (int32_t &v : in) {
+        seed = seed * 1664525u + 1013904223u;
+        v = static_cast<int32_t>(seed & 0xFFFFFF00u);
+    }
+    int mismatches = 0;
+    for (int shift = 8; shift <= 16; shift++) {
+        std::vector<int16_t> out(in.size());
+        sample_convert_s32_to_s16(in.data(), out.data(), in.size(), shift);
+        for (size_t i = 0; i < in.size(); i++) {
+            mismatches += out[i] != reference(in[i], shift);
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+}
+
+static void bench() {
+    std::vector<int32_t> in(FRAME_SAMPLES);
+    std::vector<int16_t> out(FRAME_SAMPLES);
+    for (size_t i = 0; i < in.size(); i++) {
+        in[i] = slot_from_24(static_cast<int32_t>(i * 9973 % 0xFFFFFF) - 0x800000);
+    }
+
+    for (int shift : {16, 12}) {
+        uint64_t start = host_now_ns();
+        for (int n = 0; n < BENCH_FRAMES; n++) {
+            sample_convert_s32_to_s16(in.data(), out.data(), in.size(), shift);
+            __asm__ __volatile__("" : : "r"(out.data()) : "memory");
+        }
+        double ns = static_cast<double>(host_now_ns() - start) / BENCH_FRAMES;
+        printf("shift=%d: 每帧 %zu 样本 %.0f ns（%.2f ns/样本）\n", shift, FRAME_SAMPLES, ns, ns / FRAME_SAMPLES);
+    }
+}
+
+int main() {
+    test_edges();
+    test_sine_headroom();
+    test_random();
+    bench();
+    return host_test_result("sample_convert_test");
+}
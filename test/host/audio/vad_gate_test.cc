@@ -0,0 +1,232 @@
+/**
+ * @file vad_gate_test.cc
+ * @brief 语音门控的主机测试
+ *
+ * 把仓库中的提示音 WAV 插入合成的背景噪声中，逐帧送入门控，检查：
+ * - 纯噪声段绝大部分帧被跳过；在较强的稳定噪声中门控最终关闭
+ * - 每段语音都打开门控，且按 main.cc 的回灌规则，语音的每一帧都送入了唤醒词模型
+ * - 同一帧不会重复送入唤醒词模型（门控关闭后很快重新打开时也一样）
+ */
+
+#include <cmath>
+#include <vector>
+#include "audio/vad_gate.h"
+#include "host_test.h"
+#include "wav_file.h"
+
+static const size_t FRAME_SAMPLES = 512;
+static const uint32_t SAMPLE_RATE = 16000;
+static const uint32_t VAD_LOOKBACK_MS = 320;    // 与 main.cc 一致
+
+typedef struct {
+    size_t first;   // 语音段第一帧
+    size_t last;    // 语音段最后一帧（含）
+} segment_t;
+
+/**
+ * @brief 合成背景噪声（均匀分布，确定性）
+ */
+static void append_noise(std::vector<int16_t> &audio, size_t frames, int amplitude, uint32_t &seed) {
+    for (size_t i = 0; i < frames * FRAME_SAMPLES; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        audio.push_back(static_cast<int16_t>(static_cast<int32_t>(seed >> 16) % (amplitude + 1) - amplitude / 2));
+    }
+}
+
+/**
+ * @brief 在噪声上叠加一段语音，返回语音（去掉首尾静音后）所在的帧范围
+ */
+static segment_t append_speech(std::vector<int16_t> &audio, const char *name, int noise, uint32_t &seed) {
+    std::vector<int16_t> speech;
+    CHECK(wav_read(repo_path(name), speech));
+    speech.resize((speech.size() + FRAME_SAMPLES - 1) / FRAME_SAMPLES * FRAME_SAMPLES);
+
+    size_t base = audio.size() / FRAME_SAMPLES;
+    size_t frames = speech.size() / FRAME_SAMPLES;
+    segment_t segment = {SIZE_MAX, 0};
+    for (size_t f = 0; f < frames; f++) {
+        uint32_t energy = VadGate::frame_energy(speech.data() + f * FRAME_SAMPLES, FRAME_SAMPLES);
+        if (energy > 40000) {   // 约 -30 dBFS，明显的语音帧
+            segment.first = (segment.first == SIZE_MAX) ? base + f : segment.first;
+            segment.last = base + f;
+        }
+    }
+
+    size_t start = audio.size();
+    append_noise(audio, frames, noise, seed);
+    for (size_t i = 0; i < speech.size(); i++) {
+        int32_t v = audio[start + i] + speech[i];
+        audio[start + i] = static_cast<int16_t>(v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v));
+    }
+    return segment;
+}
+
+/**
+ * @brief 按 main.cc process_wakeup_frame() 的规则运行门控，统计每帧送入唤醒词模型的次数
+ */
+static std::vector<int> run_gate(const std::vector<int16_t> &audio, VadGate &gate, std::vector<bool> *opened_at) {
+    size_t frames = audio.size() / FRAME_SAMPLES;
+    uint32_t lookback = VAD_LOOKBACK_MS * SAMPLE_RATE / 1000 / FRAME_SAMPLES;
+    std::vector<int> fed(frames, 0);
+    uint32_t next_index = 0;
+
+    for (uint32_t index = 0; index < frames; index++) {
+        vad_gate_result_t result = gate.process(audio.data() + index * FRAME_SAMPLES, FRAME_SAMPLES);
+        if (opened_at != nullptr) {
+            opened_at->push_back(result == VAD_GATE_OPENED);
+        }
+        if (result == VAD_GATE_CLOSED) {
+            continue;
+        }
+        if (result == VAD_GATE_OPENED) {
+            uint32_t first = (index > lookback) ? index - lookback : 0;
+            first = (first < next_index) ? next_index : first;
+            for (uint32_t i = first; i < index; i++) {
+                fed[i]++;
+            }
+        }
+        fed[index]++;
+        next_index = index + 1;
+    }
+    return fed;
+}
+
+/**
+ * @brief 安静背景：语音帧全部送入，噪声帧绝大部分跳过，没有重复送入
+ */
+static void test_quiet_background() {
+    uint32_t seed = 1;
+    std::vector<int16_t> audio;
+    std::vector<segment_t> segments;
+    append_noise(audio, 60, 60, seed);
+    segments.push_back(append_speech(audio, "main/assets/voices/hilexin.wav", 60, seed));
+    append_noise(audio, 60, 60, seed);
+    segments.push_back(append_speech(audio, "main/assets/voices/light_on.wav", 60, seed));
+    append_noise(audio, 90, 60, seed);
+    segments.push_back(append_speech(audio, "main/assets/voices/byebye.wav", 60, seed));
+    append_noise(audio, 60, 60, seed);
+
+    VadGate gate;
+    gate.init(VAD_GATE_DEFAULT_CONFIG());
+    std::vector<bool> opened;
+    std::vector<int> fed = run_gate(audio, gate, &opened);
+
+    for (const segment_t &segment : segments) {
+        CHECK(segment.first < segment.last);
+        for (size_t f = segment.first; f <= segment.last; f++) {
+            CHECK_EQ(fed[f], 1);
+        }
+    }
+    int duplicates = 0;
+    for (int count : fed) {
+        duplicates += count > 1;
+    }
+    CHECK_EQ(duplicates, 0);
+
+    vad_gate_stats_t stats = gate.get_stats();
+    CHECK(stats.opens >= segments.size());
+    CHECK(stats.opens <= segments.size() * 3);
+    printf("安静背景: %zu 帧, 送入 %u, 跳过 %u, 打开 %u 次\n", fed.size(),
+           stats.frames_processed, stats.frames_skipped, stats.opens);
+    CHECK(stats.frames_skipped > stats.frames_processed);
+
+    // 最后的纯噪声段在拖尾结束后全部跳过
+    CHECK(!gate.is_open());
+    for (size_t f = fed.size() - 30; f < fed.size(); f++) {
+        CHECK_EQ(fed[f], 0);
+    }
+}
+
+/**
+ * @brief 较强的稳定噪声：门控打开期间噪声底慢速跟踪，最终关闭，之后语音仍能打开门控
+ */
+static void test_loud_background() {
+    uint32_t seed = 2;
+    const int noise = 1200;     // 均方值约 1.2e5，远高于 min_energy
+    // 白噪声过零率高，按清音判决（能量阈值减半），打开期间噪声底约 1100 帧后才追上
+    const size_t noise_frames = 1600;
+    std::vector<int16_t> audio;
+    append_noise(audio, noise_frames, noise, seed);
+    segment_t segment = append_speech(audio, "main/assets/voices/light_off.wav", noise, seed);
+    append_noise(audio, 100, noise, seed);
+
+    VadGate gate;
+    gate.init(VAD_GATE_DEFAULT_CONFIG());
+    std::vector<int> fed = run_gate(audio, gate, nullptr);
+
+    // 语音开头的回灌会送入噪声段末尾的几帧，不计入
+    size_t closed_at = 0;
+    for (size_t f = 0; f + VAD_LOOKBACK_MS * SAMPLE_RATE / 1000 / FRAME_SAMPLES < noise_frames; f++) {
+        closed_at = (fed[f] > 0) ? f + 1 : closed_at;
+    }
+    CHECK(closed_at > 0 && closed_at < 1400);
+    CHECK(gate.get_stats().noise_floor > 50000);
+
+    size_t covered = 0;
+    for (size_t f = segment.first; f <= segment.last; f++) {
+        covered += fed[f] > 0;
+    }
+    printf("强噪声背景: 噪声 %zu 帧后门控关闭, 语音 %zu 帧, 送入 %zu 帧, 噪声底 %u\n", closed_at,
+           segment.last - segment.first + 1, covered, gate.get_stats().noise_floor);
+    CHECK(covered * 10 >= (segment.last - segment.first + 1) * 9);
+}
+
+/**
+ * @brief 拖尾结束后很快重新打开：回灌从唤醒词模型已处理的下一帧开始
+ */
+static void test_reopen_during_hangover() {
+    vad_gate_config_t config = VAD_GATE_DEFAULT_CONFIG();
+    config.hangover_frames = 3;
+    VadGate gate;
+    gate.init(config);
+
+    std::vector<int16_t> loud(FRAME_SAMPLES), quiet(FRAME_SAMPLES, 0);
+    for (size_t i = 0; i < FRAME_SAMPLES; i++) {
+        loud[i] = static_cast<int16_t>((i & 8) ? 8000 : -8000);
+    }
+    // 活动 5 帧、静音 5 帧（拖尾 3 帧后关闭）、活动 3 帧
+    std::vector<int16_t> audio;
+    const std::vector<int16_t> *pattern[] = {&loud, &loud, &loud, &loud, &loud, &quiet, &quiet,
+                                             &quiet, &quiet, &quiet, &loud, &loud, &loud};
+    for (const std::vector<int16_t> *frame : pattern) {
+        audio.insert(audio.end(), frame->begin(), frame->end());
+    }
+
+    std::vector<bool> opened;
+    std::vector<int> fed = run_gate(audio, gate, &opened);
+    CHECK(opened[1]);
+    CHECK(opened[11]);
+    for (size_t f = 0; f < fed.size(); f++) {
+        CHECK(fed[f] <= 1);
+    }
+    // 第一次打开时送入 0..7 帧（含 3 帧拖尾），第二次打开只回灌关闭期间的 8..10 帧
+    for (size_t f = 0; f < fed.size(); f++) {
+        CHECK_EQ(fed[f], 1);
+    }
+}
+
+static void bench_process() {
+    std::vector<int16_t> frame(FRAME_SAMPLES);
+    uint32_t seed = 3;
+    for (int16_t &s : frame) {
+        seed = seed * 1664525u + 1013904223u;
+        s = static_cast<int16_t>(seed >> 16);
+    }
+    VadGate gate;
+    gate.init(VAD_GATE_DEFAULT_CONFIG());
+
+    const int iterations = 100000;
+    uint64_t start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        gate.process(frame.data(), frame.size());
+    }
+    printf("process: 每帧 %.0f ns\n", static_cast<double>(host_now_ns() - start) / iterations);
+}
+
+int main() {
+    test_quiet_background();
+    test_loud_background();
+    test_reopen_during_hangover();
+    bench_process();
+    return host_test_result("vad_gate_test");
+}
@@ -0,0 +1,163 @@
+/**
+ * @file command_arbiter_test.cc
+ * @brief 命令识别结果仲裁的回放测试
+ *
+ * 按 arbiter_sessions.txt 中录制的 N-best 识别结果序列逐条调用 decide()，
+ * 判定、命令ID、原因和连续未接受次数必须与记录一致；同一序列回放两次得到
+ * 完全相同的结果（不依赖时钟和随机数）。命令表通过 lookup_t 换成测试中固定的
+ * 表，不受内置命令表和命令清单变化的影响。另外用随机候选检查：被接受的命令
+ * 一定达到其门限，最佳候选不低于任何命令表中的候选。
+ */
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "commands/command_arbiter.h"
+#include "host_test.h"
+
+// 与内置命令表相同的门限，另加两个门限为 0 的命令
+static const command_entry_t TABLE[] = {
+    {308, "bang wo guan deng", "帮我关灯", COMMAND_ACTION_GPIO, 21, 0, "light_off", COMMAND_FLOW_CONTINUE, 1, 35, 10},
+    {309, "bang wo kai deng", "帮我开灯", COMMAND_ACTION_GPIO, 21, 1, "light_on", COMMAND_FLOW_CONTINUE, 1, 35, 10},
+    {314, "bai bai", "拜拜", COMMAND_ACTION_NONE, 0, 0, "byebye", COMMAND_FLOW_EXIT, 2, 25, 5},
+    {400, "ce shi yi", "测试一", COMMAND_ACTION_NONE, 0, 0, nullptr, COMMAND_FLOW_CONTINUE, 0, 0, 0},
+    {401, "ce shi er", "测试二", COMMAND_ACTION_NONE, 0, 0, nullptr, COMMAND_FLOW_CONTINUE, 0, 0, 0},
+};
+
+static int lookups = 0;
+
+static bool table_lookup(int id, command_entry_t *entry) {
+    lookups++;
+    for (const command_entry_t &e : TABLE) {
+        if (e.id == id) {
+            *entry = e;
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char *const VERDICT_NAMES[] = {"accept", "again", "ignore"};
+static const char *const REASON_KEYS[ARBITER_REASON_COUNT] = {"ok", "none", "low", "ambiguous"};
+
+/**
+ * @brief 回放一个录制文件
+ * @param trace 输出每条判定的完整内容，用于比较两次回放
+ * @return int 回放的判定数，文件无法读取返回-1
+ */
+static int replay(const std::string &path, std::string *trace) {
+    std::ifstream in(path);
+    if (!in) {
+        return -1;
+    }
+    CommandArbiter arbiter(2, table_lookup);
+    std::string line;
+    int line_no = 0, decisions = 0;
+    while (std::getline(in, line)) {
+        line_no++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (line == "wake") {
+            arbiter.reset();
+            continue;
+        }
+        if (line.compare(0, 8, "session ") == 0) {
+            arbiter = CommandArbiter(static_cast<uint8_t>(atoi(line.c_str() + 8)), table_lookup);
+            continue;
+        }
+
+        size_t arrow = line.find("=>");
+        CHECK(arrow != std::string::npos);
+        if (arrow == std::string::npos) {
+            continue;
+        }
+        std::vector<command_candidate_t> candidates;
+        std::istringstream input(line.substr(0, arrow));
+        std::string token;
+        while (input >> token) {
+            size_t colon = token.find(':');
+            std::string prob = token.substr(colon + 1);
+            candidates.push_back({atoi(token.c_str()), (prob == "nan") ? NAN : strtof(prob.c_str(), nullptr)});
+        }
+        std::istringstream expected(line.substr(arrow + 2));
+        std::string verdict, reason;
+        int id = -2;
+        int retries = -1;
+        expected >> verdict >> id >> reason >> retries;
+
+        arbiter_decision_t d = arbiter.decide(candidates.data(), candidates.size());
+        char result[160];
+        snprintf(result, sizeof(result), "%s %d %s %u | %.3f, 第二 %d %.3f", VERDICT_NAMES[d.verdict], d.command_id,
+                 REASON_KEYS[d.reason], d.retries, d.prob, d.runner_up_id, d.runner_up_prob);
+        *trace += result;
+        *trace += '\n';
+        decisions++;
+        if (verdict != VERDICT_NAMES[d.verdict] || id != d.command_id || reason != REASON_KEYS[d.reason] ||
+            retries != d.retries) {
+            printf("%s:%d: %s\n    结果: %s\n", path.c_str(), line_no, line.c_str(), result);
+            host_test_failures++;
+        }
+    }
+    return decisions;
+}
+
+/**
+ * @brief 随机候选下的不变量
+ */
+static void test_random_candidates() {
+    static const int IDS[] = {308, 309, 314, 400, 401, 999, -1};
+    static const int ITERATIONS = 200000;
+    CommandArbiter arbiter(2, table_lookup);
+    uint32_t seed = 1;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    int errors = 0;
+    for (int it = 0; it < ITERATIONS; it++) {
+        command_candidate_t candidates[CommandArbiter::MAX_CANDIDATES];
+        size_t count = next() % (CommandArbiter::MAX_CANDIDATES + 1);
+        for (size_t i = 0; i < count; i++) {
+            candidates[i] = {IDS[next() % 7], static_cast<float>(next() % 1001) / 1000.0f};
+        }
+        arbiter_decision_t d = arbiter.decide(candidates, count);
+        command_entry_t entry = {};
+        bool known = d.command_id != -1 && table_lookup(d.command_id, &entry);
+        errors += (d.verdict != ARBITER_IGNORE || d.reason != ARBITER_REASON_NO_CANDIDATE) && !known;
+        if (d.verdict == ARBITER_ACCEPT) {
+            long best = lroundf(d.prob * 1000);
+            errors += best < entry.min_confidence * 10;
+            errors += best - lroundf(d.runner_up_prob * 1000) < entry.min_margin * 10;
+            errors += d.retries != 0;
+        }
+        for (size_t i = 0; i < count && known; i++) {
+            command_entry_t other;
+            if (table_lookup(candidates[i].command_id, &other)) {
+                errors += lroundf(candidates[i].prob * 1000) > lroundf(d.prob * 1000);
+            }
+        }
+        if (it % 64 == 0) {
+            arbiter.reset();
+        }
+    }
+    CHECK_EQ(errors, 0);
+    CHECK_EQ(arbiter.get_count(ARBITER_ACCEPT) + arbiter.get_count(ARBITER_SAY_AGAIN) +
+             arbiter.get_count(ARBITER_IGNORE), ITERATIONS);
+}
+
+int main(int argc, char **argv) {
+    std::string path = (argc > 1) ? argv[1] : repo_path("test/host/commands/arbiter_sessions.txt");
+    std::string first, second;
+    int decisions = replay(path, &first);
+    CHECK(decisions > 0);
+    CHECK(lookups > 0);     // 门限经注入的查找函数取得
+    CHECK_EQ(replay(path, &second), decisions);
+    CHECK(first == second);
+    printf("回放 %d 次判定（%s）\n", decisions, path.c_str());
+
+    test_random_candidates();
+    return host_test_result("command_arbiter_test");
+}
@@ -0,0 +1,252 @@
+/**
+ * @file command_footprint_test.cc
+ * @brief 300 个命令时的内存占用和配置耗时
+ *
+ * 把 command_manifest_test 打包的 300 个命令的清单作为 commands 分区（按分区
+ * 大小用 0xFF 填充，与擦除后的 flash 一致），检查：
+ * - 清单不超过 partitions.csv 中 commands 分区的大小；
+ * - initialize() 映射并解析清单后命令表直接使用分区数据，不按命令分配内存，
+ *   只有默认命令词表的分配（字符区、记录和排序时的临时缓冲区）；
+ * - 清单能解析但 GPIO 无效（旧版打包工具接受的 22-25）时，initialize() 仍然
+ *   成功并使用内置命令表；
+ * - 命令词表的占用与每个命令词一个 std::string 的做法对比；
+ * - initialize() 和 configure_commands()（模拟的 MultiNet，300 个命令词）的耗时。
+ */
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "commands/command_manager.h"
+#include "commands/command_manifest.h"
+#include "esp_mn_mock.h"
+#include "esp_stubs.h"
+#include "host_test.h"
+
+static const size_t COMMANDS = 300;
+
+// ---- 统计堆分配 ----
+
+static bool counting = false;
+static size_t alloc_count = 0;
+static size_t alloc_bytes = 0;
+
+// 所有形式的 new/delete 都换成 malloc/free（stable_sort 的临时缓冲区用 nothrow
+// 版本），不内联，避免编译器在调用处把 new/delete 与 malloc/free 配对检查
+static void *counted_malloc(size_t size) noexcept {
+    if (counting) {
+        alloc_count++;
+        alloc_bytes += size;
+    }
+    return malloc(size > 0 ? size : 1);
+}
+
+__attribute__((noinline)) void *operator new(size_t size) {
+    void *p = counted_malloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+__attribute__((noinline)) void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+__attribute__((noinline)) void *operator new(size_t size, const std::nothrow_t &) noexcept {
+    return counted_malloc(size);
+}
+
+__attribute__((noinline)) void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+    return counted_malloc(size);
+}
+
+__attribute__((noinline)) void operator delete(void *p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, size_t) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void *p, const std::nothrow_t &) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void *p, const std::nothrow_t &) noexcept {
+    free(p);
+}
+
+static void count_begin() {
+    alloc_count = 0;
+    alloc_bytes = 0;
+    counting = true;
+}
+
+static void count_end() {
+    counting = false;
+}
+
+/**
+ * @brief 从 partitions.csv 读取分区大小（只支持 K/M 后缀和十六进制）
+ */
+static size_t partition_size(const char *name) {
+    std::vector<uint8_t> data;
+    if (!read_file(repo_path("partitions.csv"), data)) {
+        return 0;
+    }
+    std::string text(data.begin(), data.end());
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        std::string line = text.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        pos = (end == std::string::npos) ? text.size() : end + 1;
+        if (line.compare(0, strlen(name), name) != 0 || line[strlen(name)] != ',') {
+            continue;
+        }
+        // 名称, 类型, 子类型, 偏移, 大小
+        size_t field = 0;
+        for (int i = 0; i < 4 && field != std::string::npos; i++) {
+            field = line.find(',', field + 1);
+        }
+        if (field == std::string::npos) {
+            return 0;
+        }
+        char *suffix = nullptr;
+        size_t size = strtoul(line.c_str() + field + 1, &suffix, 0);
+        while (*suffix == ' ') {
+            suffix++;
+        }
+        return size * ((*suffix == 'K') ? 1024 : (*suffix == 'M') ? 1024 * 1024 : 1);
+    }
+    return 0;
+}
+
+typedef struct {
+    int id;
+    std::string phrase;
+} string_phrase_t;
+
+/**
+ * @brief 命令词表：每个命令词一个 std::string（改动前的做法）与字符区对比
+ */
+static void test_vocabulary_footprint() {
+    std::vector<command_entry_t> entries(COMMANDS);
+    for (size_t i = 0; i < COMMANDS; i++) {
+        CHECK(command_table_at(i, &entries[i]));
+    }
+
+    count_begin();
+    {
+        std::vector<string_phrase_t> phrases;
+        for (const command_entry_t &e : entries) {
+            phrases.push_back({e.id, e.pinyin});
+        }
+    }
+    count_end();
+    size_t old_count = alloc_count, old_bytes = alloc_bytes;
+
+    Vocabulary vocabulary;
+    count_begin();
+    size_t ignored = vocabulary.assign(COMMANDS, [&](size_t i) {
+        return vocabulary_phrase_t{entries[i].id, entries[i].pinyin};
+    });
+    count_end();
+    CHECK_EQ(ignored, 0);
+    CHECK_EQ(vocabulary.size(), COMMANDS);
+    // 字符区、记录，以及 stable_sort 的临时缓冲区（排序后释放）
+    CHECK(alloc_count <= 3);
+    CHECK(vocabulary.memory_usage() * 4 < old_bytes);
+
+    printf("命令词表（%zu 个）: std::string %zu 次分配 %zu 字节, 字符区 %zu 次分配 %zu 字节（保留 %zu 字节）\n",
+           COMMANDS, old_count, old_bytes, alloc_count, alloc_bytes, vocabulary.memory_usage());
+}
+
+/**
+ * @brief 把清单中第一条 GPIO 命令的引脚改成 22（ESP32-S3 上不存在），作为分区注册
+ */
+static void test_invalid_gpio_fallback(const std::vector<uint8_t> &image) {
+    static const size_t HEADER_SIZE = 16, ENTRY_SIZE = 24, ACTION = 2, GPIO = 5;
+    static std::vector<uint8_t> bad;    // 分区数据在测试结束前有效
+    bad = image;
+    size_t count = bad[6] | (bad[7] << 8);
+    size_t i = 0;
+    while (i < count && bad[HEADER_SIZE + ENTRY_SIZE * i + ACTION] != COMMAND_ACTION_GPIO) {
+        i++;
+    }
+    CHECK(i < count);
+    bad[HEADER_SIZE + ENTRY_SIZE * i + GPIO] = 22;
+    CommandManifest manifest;
+    CHECK(manifest.parse(bad.data(), bad.size()));  // 格式本身有效
+    esp_stubs_add_partition("bad_gpio", bad.data(), bad.size());
+
+    CHECK_EQ(CommandManager::get_instance()->initialize("bad_gpio"), ESP_OK);
+    CHECK(!command_table_from_manifest());
+    CHECK_EQ(command_table_size(), 3);
+}
+
+int main() {
+    std::vector<uint8_t> image;
+    CHECK(read_file(host_temp_path("commands_300.bin"), image));
+    size_t size = partition_size("commands");
+    CHECK(size > 0);
+    CHECK(image.size() <= size);
+    if (image.empty() || image.size() > size) {
+        return host_test_result("command_footprint_test");
+    }
+    size_t manifest_bytes = image.size();
+    image.resize(size, 0xff);
+    esp_stubs_add_partition("commands", image.data(), image.size());
+
+    test_invalid_gpio_fallback(image);
+
+    CommandManager *manager = CommandManager::get_instance();
+    count_begin();
+    uint64_t start = host_now_ns();
+    CHECK_EQ(manager->initialize("commands"), ESP_OK);
+    double init_us = (host_now_ns() - start) / 1000.0;
+    count_end();
+    CHECK(command_table_from_manifest());
+    CHECK_EQ(command_table_size(), COMMANDS);
+    // 命令表不复制，只有默认命令词表的分配（见 test_vocabulary_footprint）
+    CHECK(alloc_count <= 3);
+    size_t init_allocs = alloc_count, init_bytes = alloc_bytes;
+
+    // 表项中的字符串直接指向分区
+    command_entry_t entry;
+    CHECK(command_table_at(COMMANDS - 1, &entry));
+    CHECK(reinterpret_cast<const uint8_t *>(entry.pinyin) > image.data() &&
+          reinterpret_cast<const uint8_t *>(entry.pinyin) < image.data() + size);
+
+    test_vocabulary_footprint();
+
+    model_iface_data_t *model_data = esp_mn_mock_iface()->create("mn_mock", 6000);
+    const int rounds = 50;
+    esp_mn_mock_reset();
+    start = host_now_ns();
+    for (int r = 0; r < rounds; r++) {
+        manager->detach_commands();
+        CHECK_EQ(manager->configure_commands(esp_mn_mock_iface(), model_data), ESP_OK);
+    }
+    double configure_us = (host_now_ns() - start) / 1000.0 / rounds;
+    CHECK_EQ(esp_mn_mock_stats().adds, rounds * COMMANDS);
+    CHECK_EQ(esp_mn_mock_stats().updates, rounds);
+    CHECK_EQ(esp_mn_mock_model().size(), COMMANDS);
+    manager->detach_commands();
+    esp_mn_mock_iface()->destroy(model_data);
+
+    printf("%zu 个命令: 清单 %zu 字节（分区 %zu 字节，每个命令 %.1f 字节）, 复制成 command_entry_t 需 %zu 字节\n",
+           COMMANDS, manifest_bytes, size, static_cast<double>(manifest_bytes) / COMMANDS,
+           COMMANDS * sizeof(command_entry_t));
+    printf("initialize() %.1f us（%zu 次分配 %zu 字节）, configure_commands() %.1f us/次\n", init_us, init_allocs,
+           init_bytes, configure_us);
+    return host_test_result("command_footprint_test");
+}
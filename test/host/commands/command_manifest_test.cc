@@ -0,0 +1,401 @@
+/**
+ * @file command_manifest_test.cc
+ * @brief 命令清单解析的主机测试、模糊测试和吞吐量基准
+ *
+ * 用 tools/command_pack.py 打包 main/assets/commands.json 和生成的 300 个命令
+ * （上限）的清单，解析结果必须与 JSON 和内置命令表一致。对打包结果逐个截断、
+ * 逐位翻转并随机改写：解析要么拒绝，要么得到的每个表项都满足 parse() 承诺的
+ * 条件（字符串在清单内且以 '\0' 结尾、ID 递增、取值有效）。每个镜像放在大小
+ * 恰好的堆缓冲区中，越界读在 ASan 下会被发现。旧版（v1，20 字节表项）镜像
+ * 及其所有截断和单个位翻转都必须被拒绝。打包工具拒绝不能用作输出的 GPIO。
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "commands/command_manifest.h"
+#include "host_test.h"
+
+static const size_t HEADER_SIZE = 16;
+static const size_t ENTRY_SIZE = 24;
+static const size_t V1_ENTRY_SIZE = 20;
+static const int COMMANDS = 300;    // command_pack.py 的 MAX_COMMANDS
+
+/**
+ * @brief 生成第 i 个命令的拼音：小写字母音节，互不相同
+ */
+static std::string pinyin_of(int i) {
+    std::string s = "ming ling";
+    do {
+        s += ' ';
+        s += static_cast<char>('a' + i % 26);
+        s += "ao";
+        i /= 26;
+    } while (i > 0);
+    return s;
+}
+
+static int id_of(int i) {
+    return 1000 + 7 * i;
+}
+
+/**
+ * @brief 第 i 个命令的 GPIO：依次取 ESP32-S3 能用作输出的引脚（跳过不存在的 22-25）
+ */
+static int gpio_of(int i) {
+    int gpio = i % 45;
+    return (gpio >= 22) ? gpio + 4 : gpio;
+}
+
+static std::string write_large_json() {
+    std::string json = "{\"commands\": [\n";
+    for (int i = COMMANDS - 1; i >= 0; i--) {  // 乱序写入，打包时按ID排序
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "{\"id\": %d, \"pinyin\": \"%s\", \"description\": \"命令%d\", \"action\": \"%s\", "
+                 "\"gpio\": %d, \"level\": %d, %s\"flow\": \"%s\", \"priority\": %d, "
+                 "\"min_confidence\": %d, \"min_margin\": %d}%s\n",
+                 id_of(i), pinyin_of(i).c_str(), i, (i % 2) ? "gpio" : "none", gpio_of(i), (i / 2) % 2,
+                 (i % 3) ? "\"prompt\": \"light_on\", " : "", (i % 50 == 0) ? "exit" : "continue", i % 256,
+                 i % 101, (i * 7) % 101, i ? "," : "");
+        json += line;
+    }
+    json += "]}\n";
+    std::string path = host_temp_path("commands_300.json");
+    CHECK(write_file(path, json.data(), json.size()));
+    return path;
+}
+
+/**
+ * @brief 不能用作输出的 GPIO 不被打包
+ */
+static void test_invalid_gpio_rejected() {
+    for (int gpio : {21, 22, 25, 26, 48, 49}) {
+        char json[256];
+        snprintf(json, sizeof(json),
+                 "{\"commands\": [{\"id\": 1, \"pinyin\": \"kai deng\", \"description\": \"开灯\", "
+                 "\"action\": \"gpio\", \"gpio\": %d, \"level\": 1}]}\n", gpio);
+        std::string path = host_temp_path("commands_gpio.json");
+        CHECK(write_file(path, json, strlen(json)));
+        bool valid = gpio <= 21 || (gpio >= 26 && gpio <= 48);
+        int status = run_tool("command_pack.py", "pack -o " + host_temp_path("commands_gpio.bin") + " " + path +
+                                                 " > /dev/null 2>&1");
+        CHECK_EQ(status == 0, valid);
+    }
+}
+
+static std::vector<uint8_t> pack(const std::string &json, const char *name) {
+    std::string out = host_temp_path(name);
+    CHECK_EQ(run_tool("command_pack.py", "pack -o " + out + " " + json + " > /dev/null"), 0);
+    std::vector<uint8_t> image;
+    CHECK(read_file(out, image));
+    return image;
+}
+
+static bool parse_exact(const std::vector<uint8_t> &image, size_t size, CommandManifest *manifest) {
+    // 大小恰好的堆缓冲区：越界读在 ASan 下立即报错
+    std::unique_ptr<uint8_t[]> copy(new uint8_t[size > 0 ? size : 1]);
+    memcpy(copy.get(), image.data(), size);
+    bool ok = manifest->parse(copy.get(), size);
+    if (ok) {
+        // 表项引用 copy，释放前检查
+        for (size_t i = 0; i < manifest->count(); i++) {
+            command_entry_t entry;
+            manifest->at(i, &entry);
+            volatile size_t len = strlen(entry.pinyin) + strlen(entry.description) +
+                                  (entry.prompt ? strlen(entry.prompt) : 0);
+            (void)len;
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief parse() 接受的清单满足承诺的条件
+ */
+static bool manifest_consistent(const CommandManifest &manifest, size_t size) {
+    const uint8_t *base = manifest.data();
+    size_t strings = HEADER_SIZE + ENTRY_SIZE * manifest.count();
+    size_t total = manifest.total_size();
+    if (total > size || strings > total) {
+        return false;
+    }
+    auto string_ok = [&](const char *s) {
+        const uint8_t *p = reinterpret_cast<const uint8_t *>(s);
+        return p >= base + strings && p < base + total && *p != '\0' &&
+               memchr(p, '\0', base + total - p) != nullptr;
+    };
+    int last_id = -1;
+    for (size_t i = 0; i < manifest.count(); i++) {
+        command_entry_t entry;
+        if (!manifest.at(i, &entry) || entry.id <= last_id || entry.action >= COMMAND_ACTION_COUNT ||
+            entry.flow > COMMAND_FLOW_EXIT || entry.min_confidence > 100 || entry.min_margin > 100 ||
+            !string_ok(entry.pinyin) || !string_ok(entry.description) ||
+            (entry.prompt != nullptr && !string_ok(entry.prompt))) {
+            return false;
+        }
+        command_entry_t found;
+        if (!manifest.find(entry.id, &found) || found.pinyin != entry.pinyin) {
+            return false;
+        }
+        last_id = entry.id;
+    }
+    command_entry_t entry;
+    return !manifest.at(manifest.count(), &entry);
+}
+
+/**
+ * @brief 解析变异后的镜像：拒绝，或者结果一致
+ * @return bool 是否接受
+ */
+static bool parse_mutant(const std::vector<uint8_t> &image, int *inconsistent) {
+    std::unique_ptr<uint8_t[]> copy(new uint8_t[image.size()]);
+    memcpy(copy.get(), image.data(), image.size());
+    CommandManifest manifest;
+    if (!manifest.parse(copy.get(), image.size())) {
+        return false;
+    }
+    *inconsistent += !manifest_consistent(manifest, image.size());
+    return true;
+}
+
+/**
+ * @brief 按旧版 command_pack.py（格式版本 1，20 字节表项，无置信度门限）打包
+ */
+static std::vector<uint8_t> pack_v1(const CommandManifest &v2) {
+    size_t count = v2.count();
+    size_t strings = HEADER_SIZE + V1_ENTRY_SIZE * count;
+    std::vector<uint8_t> entries, pool;
+    std::map<std::string, uint32_t> offsets;  // 相同字符串只存一份
+    auto put32 = [](std::vector<uint8_t> *out, uint32_t v) {
+        for (int k = 0; k < 4; k++) {
+            out->push_back(static_cast<uint8_t>(v >> (8 * k)));
+        }
+    };
+    auto intern = [&](const char *s) -> uint32_t {
+        if (s == nullptr) {
+            return 0;
+        }
+        auto it = offsets.find(s);
+        if (it != offsets.end()) {
+            return it->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(strings + pool.size());
+        pool.insert(pool.end(), s, s + strlen(s) + 1);
+        offsets[s] = offset;
+        return offset;
+    };
+    for (size_t i = 0; i < count; i++) {
+        command_entry_t e;
+        v2.at(i, &e);
+        uint8_t fixed[8] = {static_cast<uint8_t>(e.id), static_cast<uint8_t>(e.id >> 8),
+                            static_cast<uint8_t>(e.action), static_cast<uint8_t>(e.flow), e.priority, e.gpio,
+                            e.level, 0};
+        entries.insert(entries.end(), fixed, fixed + sizeof(fixed));
+        put32(&entries, intern(e.pinyin));
+        put32(&entries, intern(e.description));
+        put32(&entries, intern(e.prompt));
+    }
+    std::vector<uint8_t> image = {'Z', 'C', 'M', 'D', 1, 0, static_cast<uint8_t>(count),
+                                  static_cast<uint8_t>(count >> 8)};
+    put32(&image, static_cast<uint32_t>(strings + pool.size()));
+    put32(&image, 0);
+    image.insert(image.end(), entries.begin(), entries.end());
+    image.insert(image.end(), pool.begin(), pool.end());
+    return image;
+}
+
+/**
+ * @brief commands.json 打包后与内置命令表一致（内置表不要求按ID排序）
+ */
+static void test_default_manifest(const std::vector<uint8_t> &image) {
+    CommandManifest manifest;
+    CHECK(manifest.parse(image.data(), image.size()));
+    CHECK_EQ(manifest.total_size(), image.size());
+    CHECK(manifest_consistent(manifest, image.size()));
+    CHECK_EQ(manifest.count(), command_table_size());
+    for (size_t i = 0; i < manifest.count(); i++) {
+        command_entry_t a, b;
+        CHECK(manifest.at(i, &a));
+        CHECK(command_table_find(a.id, &b));
+        CHECK(strcmp(a.pinyin, b.pinyin) == 0);
+        CHECK(strcmp(a.description, b.description) == 0);
+        CHECK((a.prompt == nullptr) == (b.prompt == nullptr));
+        CHECK(a.prompt == nullptr || strcmp(a.prompt, b.prompt) == 0);
+        CHECK_EQ(a.action, b.action);
+        CHECK_EQ(a.gpio, b.gpio);
+        CHECK_EQ(a.level, b.level);
+        CHECK_EQ(a.flow, b.flow);
+        CHECK_EQ(a.priority, b.priority);
+        CHECK_EQ(a.min_confidence, b.min_confidence);
+        CHECK_EQ(a.min_margin, b.min_margin);
+    }
+}
+
+static void test_large_manifest(const std::vector<uint8_t> &image) {
+    CommandManifest manifest;
+    CHECK(manifest.parse(image.data(), image.size()));
+    CHECK(manifest_consistent(manifest, image.size()));
+    CHECK_EQ(manifest.count(), COMMANDS);
+    for (int i = 0; i < COMMANDS; i++) {
+        command_entry_t e;
+        CHECK(manifest.find(id_of(i), &e));
+        CHECK(strcmp(e.pinyin, pinyin_of(i).c_str()) == 0);
+        CHECK_EQ(e.action, (i % 2) ? COMMAND_ACTION_GPIO : COMMAND_ACTION_NONE);
+        CHECK_EQ(e.gpio, (i % 2) ? gpio_of(i) : 0);
+        CHECK_EQ(e.flow, (i % 50 == 0) ? COMMAND_FLOW_EXIT : COMMAND_FLOW_CONTINUE);
+        CHECK_EQ(e.priority, i % 256);
+        CHECK_EQ(e.min_confidence, i % 101);
+        CHECK_EQ(e.min_margin, (i * 7) % 101);
+        CHECK_EQ(e.prompt != nullptr, (i % 3) != 0);
+        CHECK(!manifest.find(id_of(i) + 1, &e));
+    }
+    // 相同字符串只存一份
+    command_entry_t a, b;
+    CHECK(manifest.find(id_of(1), &a) && manifest.find(id_of(2), &b));
+    CHECK(a.prompt == b.prompt);
+}
+
+/**
+ * @brief 每个截断都被拒绝，把头部的总字节数改成截断长度后也被拒绝
+ */
+static void test_truncation(const std::vector<uint8_t> &image) {
+    int accepted = 0, inconsistent = 0;
+    for (size_t size = 0; size < image.size(); size++) {
+        CommandManifest manifest;
+        CHECK(!parse_exact(image, size, &manifest));
+        if (size >= HEADER_SIZE) {
+            std::vector<uint8_t> patched(image.begin(), image.begin() + size);
+            for (int k = 0; k < 4; k++) {
+                patched[8 + k] = static_cast<uint8_t>(size >> (8 * k));
+            }
+            accepted += parse_mutant(patched, &inconsistent);
+        }
+    }
+    CHECK_EQ(inconsistent, 0);
+    // 字符串区中每个字符串都被引用，截掉任何一段都被拒绝
+    CHECK_EQ(accepted, 0);
+}
+
+/**
+ * @brief 逐位翻转：魔数和版本号的翻转都被拒绝，接受的结果必须一致
+ */
+static void test_bit_flips(const std::vector<uint8_t> &image, int *accepted_out) {
+    int accepted = 0, inconsistent = 0, header_accepted = 0;
+    std::vector<uint8_t> mutant = image;
+    for (size_t byte = 0; byte < image.size(); byte++) {
+        for (int bit = 0; bit < 8; bit++) {
+            mutant[byte] ^= static_cast<uint8_t>(1u << bit);
+            bool ok = parse_mutant(mutant, &inconsistent);
+            accepted += ok;
+            header_accepted += ok && byte < 6;
+            mutant[byte] = image[byte];
+        }
+    }
+    CHECK_EQ(header_accepted, 0);
+    CHECK_EQ(inconsistent, 0);
+    *accepted_out = accepted;
+}
+
+static void test_random_mutations(const std::vector<uint8_t> &image, int iterations) {
+    std::mt19937 rng(22);
+    int inconsistent = 0;
+    for (int it = 0; it < iterations; it++) {
+        std::vector<uint8_t> mutant = image;
+        int writes = 1 + static_cast<int>(rng() % 8);
+        for (int w = 0; w < writes; w++) {
+            // 偏向头部和表项中的偏移字段
+            size_t limit = (rng() & 1) ? std::min<size_t>(image.size(), HEADER_SIZE + 4 * ENTRY_SIZE) : image.size();
+            mutant[rng() % limit] = static_cast<uint8_t>(rng());
+        }
+        if (rng() % 4 == 0) {
+            mutant.resize(rng() % (image.size() + 1));
+        }
+        parse_mutant(mutant, &inconsistent);
+    }
+    CHECK_EQ(inconsistent, 0);
+}
+
+/**
+ * @brief 旧版镜像、其所有截断和单个位翻转都被拒绝（版本 1 与 2 相差两位）
+ */
+static void test_v1_rejected(const CommandManifest &v2, size_t v2_size) {
+    std::vector<uint8_t> image = pack_v1(v2);
+    CHECK_EQ(image.size(), v2_size - (ENTRY_SIZE - V1_ENTRY_SIZE) * v2.count());
+    CommandManifest manifest;
+    int accepted = 0;
+    for (size_t size = 0; size <= image.size(); size++) {
+        accepted += parse_exact(image, size, &manifest);
+    }
+    std::vector<uint8_t> mutant = image;
+    for (size_t byte = 0; byte < image.size(); byte++) {
+        for (int bit = 0; bit < 8; bit++) {
+            mutant[byte] ^= static_cast<uint8_t>(1u << bit);
+            accepted += manifest.parse(mutant.data(), mutant.size());
+            mutant[byte] = image[byte];
+        }
+    }
+    CHECK_EQ(accepted, 0);
+    CHECK(manifest.data() == nullptr && manifest.count() == 0);
+}
+
+static void bench_parse(const std::vector<uint8_t> &image) {
+    CommandManifest manifest;
+    const int rounds = 2000;
+    uint64_t start = host_now_ns();
+    int ok = 0;
+    for (int r = 0; r < rounds; r++) {
+        ok += manifest.parse(image.data(), image.size());
+    }
+    double parse_us = (host_now_ns() - start) / 1000.0 / rounds;
+    CHECK_EQ(ok, rounds);
+
+    command_entry_t entry;
+    int found = 0;
+    const int lookups = 1000000;
+    start = host_now_ns();
+    for (int i = 0; i < lookups; i++) {
+        found += manifest.find(id_of(i % COMMANDS), &entry);
+    }
+    double find_ns = static_cast<double>(host_now_ns() - start) / lookups;
+    CHECK_EQ(found, lookups);
+
+    printf("%d 个命令的清单 %zu 字节: 解析 %.1f us/次 (%.0f MB/s), find %.1f ns/次\n", COMMANDS, image.size(),
+           parse_us, image.size() / parse_us, find_ns);
+}
+
+int main() {
+    std::vector<uint8_t> small = pack(repo_path("main/assets/commands.json"), "commands.bin");
+    std::vector<uint8_t> large = pack(write_large_json(), "commands_300.bin");
+    CHECK(!small.empty() && !large.empty());
+    if (small.empty() || large.empty()) {
+        return host_test_result("command_manifest_test");
+    }
+
+    test_default_manifest(small);
+    test_large_manifest(large);
+    test_invalid_gpio_rejected();
+
+    test_truncation(small);
+    test_truncation(large);
+    int small_flips = 0, large_flips = 0;
+    test_bit_flips(small, &small_flips);
+    test_bit_flips(large, &large_flips);
+    test_random_mutations(small, 200000);
+    test_random_mutations(large, 5000);
+    printf("单个位翻转后仍被接受（结果一致）: %d/%zu, %d/%zu\n", small_flips, small.size() * 8, large_flips,
+           large.size() * 8);
+
+    CommandManifest v2;
+    CHECK(v2.parse(large.data(), large.size()));
+    test_v1_rejected(v2, large.size());
+    CHECK(v2.parse(small.data(), small.size()));
+    test_v1_rejected(v2, small.size());
+
+    bench_parse(large);
+    return host_test_result("command_manifest_test");
+}
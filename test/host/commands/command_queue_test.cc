@@ -0,0 +1,234 @@
+/**
+ * @file command_queue_test.cc
+ * @brief 待执行命令队列的主机测试
+ *
+ * 检查按优先级出队、同优先级按提交顺序、提交序号回绕后的先后比较和队列满，
+ * 结束交互的命令先执行后只取消在它之后提交的命令，
+ * 再按 CommandExecutor 的用法（提交方和执行线程共用一把锁）在持续提交下
+ * 执行假命令，检查出队顺序并统计提交到开始执行的等待时间。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "commands/command_queue.h"
+#include "host_test.h"
+
+static command_job_t job(uint32_t ticket, int command_id, uint8_t priority) {
+    return command_job_t{ticket, command_id, priority, 0};
+}
+
+static std::vector<int> drain(CommandQueue *queue) {
+    std::vector<int> ids;
+    command_job_t out;
+    while (queue->pop(&out)) {
+        ids.push_back(out.command_id);
+    }
+    return ids;
+}
+
+static void test_priority_and_fifo() {
+    CommandQueue queue;
+    command_job_t out;
+    CHECK(!queue.pop(&out));
+
+    CHECK(queue.push(job(1, 10, 1)));
+    CHECK(queue.push(job(2, 20, 3)));
+    CHECK(queue.push(job(3, 11, 1)));
+    CHECK(queue.push(job(4, 30, 5)));
+    CHECK(queue.push(job(5, 21, 3)));
+    CHECK(queue.push(job(6, 12, 1)));
+    CHECK_EQ(queue.size(), 6);
+    CHECK((drain(&queue) == std::vector<int>{30, 20, 21, 10, 11, 12}));
+    CHECK_EQ(queue.size(), 0);
+
+    // 出队后中间留下的空位不影响后续顺序
+    CHECK(queue.push(job(7, 1, 0)));
+    CHECK(queue.push(job(8, 2, 2)));
+    CHECK(queue.push(job(9, 3, 0)));
+    CHECK(queue.pop(&out));
+    CHECK_EQ(out.command_id, 2);
+    CHECK_EQ(out.ticket, 8);
+    CHECK(queue.push(job(10, 4, 2)));
+    CHECK(queue.push(job(11, 5, 0)));
+    CHECK((drain(&queue) == std::vector<int>{4, 1, 3, 5}));
+}
+
+static void test_full_and_clear() {
+    CommandQueue queue;
+    for (size_t i = 0; i < CommandQueue::CAPACITY; i++) {
+        CHECK(queue.push(job(i + 1, static_cast<int>(i), 1)));
+    }
+    CHECK(!queue.push(job(100, 100, 9)));
+    CHECK_EQ(queue.size(), CommandQueue::CAPACITY);
+    CHECK_EQ(queue.clear(), CommandQueue::CAPACITY);
+    CHECK_EQ(queue.clear(), 0);
+    command_job_t out;
+    CHECK(!queue.pop(&out));
+}
+
+/**
+ * @brief 提交序号回绕（执行器跳过 0）后，同优先级仍按提交顺序出队
+ */
+static void test_ticket_wrap() {
+    static const uint32_t tickets[] = {0xfffffffdu, 0xfffffffeu, 0xffffffffu, 1, 2, 3};
+    // 各种入队顺序下都按提交序号出队
+    std::vector<size_t> order = {0, 1, 2, 3, 4, 5};
+    int permutations = 0;
+    do {
+        CommandQueue queue;
+        for (size_t i : order) {
+            CHECK(queue.push(job(tickets[i], static_cast<int>(i), 2)));
+        }
+        CHECK((drain(&queue) == std::vector<int>{0, 1, 2, 3, 4, 5}));
+        permutations++;
+    } while (std::next_permutation(order.begin(), order.end()));
+    CHECK_EQ(permutations, 720);
+
+    // 回绕后提交的高优先级命令仍然优先
+    CommandQueue queue;
+    CHECK(queue.push(job(0xffffffffu, 1, 1)));
+    CHECK(queue.push(job(1, 2, 4)));
+    CHECK(queue.push(job(2, 3, 1)));
+    CHECK((drain(&queue) == std::vector<int>{2, 1, 3}));
+}
+
+/**
+ * @brief 先说"开灯"再说"拜拜"：拜拜先执行，结束交互时开灯仍然执行，拜拜之后提交的命令被取消
+ *
+ * 与 main.cc 的处理一致：拜拜执行完成后 execute_exit_logic(拜拜的序号) 调用
+ * CommandExecutor::cancel_pending(序号)，即 clear_after()。
+ */
+static void test_exit_keeps_earlier_actions() {
+    static const int LIGHT_ON = 309, LIGHT_OFF = 308, BYE = 314;
+    for (uint32_t first : {1u, 0xfffffffeu}) {     // 含提交序号回绕
+        uint32_t t1 = first, t2 = t1 + 1, t3 = t2 + 1;
+        t2 = (t2 == 0) ? 1 : t2;
+        t3 = (t3 == 0) ? 1 : t3;
+        CommandQueue queue;
+        CHECK(queue.push(job(t1, LIGHT_ON, 1)));
+        CHECK(queue.push(job(t2, BYE, 2)));
+        command_job_t out;
+        CHECK(queue.pop(&out));
+        CHECK_EQ(out.command_id, BYE);
+        // 拜拜执行期间又识别出一条命令
+        CHECK(queue.push(job(t3, LIGHT_OFF, 1)));
+        CHECK_EQ(queue.clear_after(out.ticket), 1);
+        CHECK((drain(&queue) == std::vector<int>{LIGHT_ON}));
+    }
+
+    // 序号等于 ticket 的命令保留
+    CommandQueue queue;
+    CHECK(queue.push(job(5, 1, 0)));
+    CHECK(queue.push(job(6, 2, 0)));
+    CHECK(queue.push(job(7, 3, 0)));
+    CHECK_EQ(queue.clear_after(6), 1);
+    CHECK((drain(&queue) == std::vector<int>{1, 2}));
+}
+
+/**
+ * @brief 持续提交下执行假命令
+ *
+ * 提交线程按随机优先级连续提交，队列满时稍后重试；执行线程每条命令忙等一段
+ * 时间。每次出队的命令必须是出队时队列中优先级最高、其中最早提交的一条，
+ * 因此同优先级的命令按提交序号执行，且没有丢失或重复。
+ */
+static void test_dispatch_under_load() {
+    static const int JOBS = 20000;
+    static const int PRIORITIES = 4;
+    static const uint64_t RUN_NS = 2000;  // 假命令的执行时间
+    CommandQueue queue;
+    std::mutex lock;
+    std::atomic<bool> done{false};
+    std::vector<uint64_t> waits;
+    waits.reserve(JOBS);
+    int order_errors = 0, executed = 0;
+    std::vector<uint32_t> last_ticket(PRIORITIES, 0);
+    uint32_t rejected = 0;
+
+    std::thread executor([&]() {
+        while (true) {
+            command_job_t out;
+            bool got;
+            size_t ahead_higher = 0;    // 出队后队列中仍排着的更高优先级命令数
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                got = queue.pop(&out);
+                if (got) {
+                    CommandQueue copy = queue;
+                    command_job_t rest;
+                    while (copy.pop(&rest)) {
+                        ahead_higher += rest.priority > out.priority ||
+                                        (rest.priority == out.priority &&
+                                         static_cast<int32_t>(rest.ticket - out.ticket) < 0);
+                    }
+                }
+            }
+            if (!got) {
+                if (done.load(std::memory_order_acquire)) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (queue.size() == 0) {
+                        break;
+                    }
+                    continue;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            uint64_t start = host_now_ns();
+            waits.push_back(start - static_cast<uint64_t>(out.submitted_us));
+            order_errors += ahead_higher > 0;
+            order_errors += static_cast<int32_t>(out.ticket - last_ticket[out.priority]) <= 0 &&
+                            last_ticket[out.priority] != 0;
+            last_ticket[out.priority] = out.ticket;
+            while (host_now_ns() - start < RUN_NS) {
+            }
+            executed++;
+        }
+    });
+
+    uint32_t seed = 7;
+    uint32_t next_ticket = 0xffffffffu - JOBS / 2;  // 中途回绕
+    for (int i = 0; i < JOBS; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        command_job_t j = job(next_ticket, i, static_cast<uint8_t>((seed >> 16) % PRIORITIES));
+        while (true) {
+            j.submitted_us = static_cast<int64_t>(host_now_ns());
+            bool queued;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                queued = queue.push(j);
+            }
+            if (queued) {
+                break;
+            }
+            rejected++;
+            std::this_thread::yield();
+        }
+        next_ticket = (next_ticket + 1 == 0) ? 1 : next_ticket + 1;
+        if (i % 16 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    executor.join();
+
+    CHECK_EQ(executed, JOBS);
+    CHECK_EQ(order_errors, 0);
+    CHECK(rejected > 0);    // 确实出现过排满的情况
+    std::sort(waits.begin(), waits.end());
+    printf("%d 条假命令（每条 %.1f us）: 等待 p50 %.1f us, p99 %.1f us, 最大 %.1f us; 队列满重试 %lu 次\n",
+           JOBS, RUN_NS / 1000.0, waits[waits.size() / 2] / 1000.0, waits[waits.size() * 99 / 100] / 1000.0,
+           waits.back() / 1000.0, (unsigned long)rejected);
+}
+
+int main() {
+    test_priority_and_fifo();
+    test_full_and_clear();
+    test_ticket_wrap();
+    test_exit_keeps_earlier_actions();
+    test_dispatch_under_load();
+    return host_test_result("command_queue_test");
+}
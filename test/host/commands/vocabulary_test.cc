@@ -0,0 +1,335 @@
+/**
+ * @file vocabulary_test.cc
+ * @brief 命令词表差分和运行时更新的主机测试
+ *
+ * Vocabulary::diff() 的各类操作（新增、删除、修改、命令ID变化）以及随机词表
+ * 之间的差分：按顺序执行操作必须每步成功并得到目标表。CommandManager 对接
+ * 模拟的 MultiNet（stubs/esp_mn_mock.h），在每个操作上注入失败，检查
+ * apply_vocabulary() 回滚后记录的命令词与 esp_mn 命令词表一致，之后重试能收敛。
+ * 最后在 10、100、300 个命令词下比较清空重建与只提交差异的开销。
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "commands/command_manager.h"
+#include "esp_mn_mock.h"
+#include "host_test.h"
+
+extern "C" {
+#include "esp_log.h"
+}
+
+static const int IDS[] = {308, 309, 314};   // 内置命令表中的命令ID
+
+static Vocabulary make(std::initializer_list<vocabulary_phrase_t> phrases) {
+    Vocabulary v;
+    for (const vocabulary_phrase_t &p : phrases) {
+        CHECK(v.add(p.id, p.phrase));
+    }
+    return v;
+}
+
+static bool equal(const Vocabulary &a, const Vocabulary &b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a.at(i).id != b.at(i).id || strcmp(a.at(i).phrase, b.at(i).phrase) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 按顺序执行差分操作，每一步都必须成功
+ */
+static bool apply_ops(Vocabulary *v, const std::vector<vocabulary_op_t> &ops) {
+    bool ok = true;
+    for (const vocabulary_op_t &op : ops) {
+        switch (op.type) {
+        case VOCABULARY_OP_REMOVE:
+            ok = ok && v->find(op.old_phrase) == op.id && v->remove(op.old_phrase);
+            break;
+        case VOCABULARY_OP_MODIFY:
+            ok = ok && v->find(op.old_phrase) == op.id && v->modify(op.old_phrase, op.phrase);
+            break;
+        default:
+            ok = ok && v->add(op.id, op.phrase);
+            break;
+        }
+    }
+    return ok;
+}
+
+static std::string types_of(const std::vector<vocabulary_op_t> &ops) {
+    std::string s;
+    for (const vocabulary_op_t &op : ops) {
+        s += "RMA"[op.type];
+    }
+    return s;
+}
+
+// 覆盖四种变化：删除 zai jian，修改 da kai，新增 guan bi，bai bai 改属 309
+static const Vocabulary BASE = make({{308, "bang wo kai deng"}, {309, "bang wo guan deng"}, {314, "bai bai"},
+                                     {308, "da kai"}, {314, "zai jian"}});
+static const Vocabulary TARGET = make({{308, "bang wo kai deng"}, {309, "bang wo guan deng"}, {309, "bai bai"},
+                                       {308, "da kai deng"}, {309, "guan bi"}});
+
+static void test_diff_kinds() {
+    std::vector<vocabulary_op_t> ops;
+    BASE.diff(BASE, &ops);
+    CHECK(ops.empty());
+
+    BASE.diff(TARGET, &ops);
+    CHECK(types_of(ops) == "RRMAA");
+    int removed = 0, modified = 0, added = 0, moved_out = 0, moved_in = 0;
+    for (const vocabulary_op_t &op : ops) {
+        const char *old_phrase = (op.old_phrase != nullptr) ? op.old_phrase : "";
+        const char *phrase = (op.phrase != nullptr) ? op.phrase : "";
+        if (op.type == VOCABULARY_OP_REMOVE) {
+            removed += strcmp(old_phrase, "zai jian") == 0 && op.id == 314;
+            moved_out += strcmp(old_phrase, "bai bai") == 0 && op.id == 314;
+        } else if (op.type == VOCABULARY_OP_MODIFY) {
+            modified += strcmp(old_phrase, "da kai") == 0 && strcmp(phrase, "da kai deng") == 0 && op.id == 308;
+        } else {
+            added += strcmp(phrase, "guan bi") == 0 && op.id == 309;
+            moved_in += strcmp(phrase, "bai bai") == 0 && op.id == 309;
+        }
+    }
+    CHECK_EQ(removed, 1);
+    CHECK_EQ(modified, 1);
+    CHECK_EQ(added, 1);
+    CHECK_EQ(moved_out, 1);
+    CHECK_EQ(moved_in, 1);
+
+    Vocabulary v = BASE;
+    CHECK(apply_ops(&v, ops));
+    CHECK(equal(v, TARGET));
+
+    // 反方向，以及与空表之间
+    TARGET.diff(BASE, &ops);
+    v = TARGET;
+    CHECK(apply_ops(&v, ops));
+    CHECK(equal(v, BASE));
+    Vocabulary empty;
+    empty.diff(BASE, &ops);
+    CHECK(types_of(ops) == "AAAAA");
+    BASE.diff(empty, &ops);
+    CHECK(types_of(ops) == "RRRRR");
+
+    // 两个拼音交换命令ID
+    Vocabulary a = make({{308, "a"}, {309, "b"}});
+    Vocabulary b = make({{309, "a"}, {308, "b"}});
+    a.diff(b, &ops);
+    CHECK(types_of(ops) == "RRAA");
+    CHECK(apply_ops(&a, ops));
+    CHECK(equal(a, b));
+}
+
+static Vocabulary random_vocabulary(std::mt19937 *rng, int max_phrases, int pool) {
+    Vocabulary v;
+    int n = static_cast<int>((*rng)() % (max_phrases + 1));
+    for (int i = 0; i < n; i++) {
+        v.add(IDS[(*rng)() % 3], ("p" + std::to_string((*rng)() % pool)).c_str());
+    }
+    return v;
+}
+
+/**
+ * @brief 随机词表之间的差分：每步成功、结果一致；同一命令ID的删除和新增合并为修改
+ */
+static void test_diff_random() {
+    std::mt19937 rng(1);
+    std::vector<vocabulary_op_t> ops;
+    for (int iteration = 0; iteration < 5000; iteration++) {
+        Vocabulary from = random_vocabulary(&rng, 20, 30);
+        Vocabulary to = random_vocabulary(&rng, 20, 30);
+        from.diff(to, &ops);
+        Vocabulary v = from;
+        CHECK(apply_ops(&v, ops));
+        CHECK(equal(v, to));
+
+        // 没有可以合并的删除和新增：命令ID变化的拼音除外
+        std::vector<int> removed_ids, added_ids;
+        for (const vocabulary_op_t &op : ops) {
+            if (op.type == VOCABULARY_OP_REMOVE && to.find(op.old_phrase) < 0) {
+                removed_ids.push_back(op.id);
+            } else if (op.type == VOCABULARY_OP_ADD && from.find(op.phrase) < 0) {
+                added_ids.push_back(op.id);
+            }
+        }
+        for (int id : removed_ids) {
+            CHECK(std::find(added_ids.begin(), added_ids.end(), id) == added_ids.end());
+        }
+    }
+}
+
+static Vocabulary mock_vocabulary() {
+    Vocabulary v;
+    for (const esp_mn_mock_phrase_t &p : esp_mn_mock_commands()) {
+        CHECK(v.add(p.id, p.phrase.c_str()));
+    }
+    return v;
+}
+
+/**
+ * @brief CommandManager 记录的命令词与 esp_mn 命令词表一致
+ *
+ * 以 esp_mn 的实际内容为期望表更新：一致时不提交任何操作。
+ */
+static bool manager_in_sync(CommandManager *manager) {
+    Vocabulary actual = mock_vocabulary();
+    esp_mn_mock_reset();
+    esp_err_t ret = manager->update_commands(actual);
+    esp_mn_mock_stats_t stats = esp_mn_mock_stats();
+    return ret == ESP_OK && stats.adds + stats.removes + stats.modifies + stats.failures + stats.updates == 0;
+}
+
+static model_iface_data_t *model_data;
+
+static void test_manager_configure() {
+    CommandManager *manager = CommandManager::get_instance();
+    CHECK_EQ(manager->initialize("commands"), ESP_OK);
+    model_data = esp_mn_mock_iface()->create("mn_mock", 6000);
+
+    esp_mn_mock_reset();
+    CHECK_EQ(manager->configure_commands(esp_mn_mock_iface(), model_data), ESP_OK);
+    CHECK_EQ(esp_mn_mock_stats().adds, command_table_size());
+    CHECK_EQ(esp_mn_mock_stats().updates, 1);
+    CHECK_EQ(esp_mn_mock_model().size(), command_table_size());
+    CHECK(manager_in_sync(manager));
+
+    // 未知命令ID：整体拒绝，不提交
+    esp_mn_mock_reset();
+    CHECK_EQ(manager->update_commands(make({{308, "x"}, {9999, "y"}})), ESP_ERR_INVALID_ARG);
+    CHECK_EQ(esp_mn_mock_stats().adds + esp_mn_mock_stats().updates, 0);
+
+    // 模型释放期间只记录期望表，重新加载时生效
+    manager->detach_commands();
+    CHECK_EQ(manager->update_commands(TARGET), ESP_OK);
+    CHECK(esp_mn_mock_commands().empty());
+    esp_mn_mock_reset();
+    CHECK_EQ(manager->configure_commands(esp_mn_mock_iface(), model_data), ESP_OK);
+    CHECK(equal(mock_vocabulary(), TARGET));
+    CHECK_EQ(esp_mn_mock_stats().adds, TARGET.size());
+}
+
+/**
+ * @brief 在每个操作上注入失败：回滚后的记录与 esp_mn 一致，重试收敛到目标表
+ */
+static void test_manager_rollback() {
+    CommandManager *manager = CommandManager::get_instance();
+    std::vector<vocabulary_op_t> ops;
+    BASE.diff(TARGET, &ops);
+    esp_log_level_set("*", ESP_LOG_NONE);   // 注入的失败会输出错误日志
+
+    for (size_t k = 0; k < ops.size(); k++) {
+        CHECK_EQ(manager->update_commands(BASE), ESP_OK);
+        CHECK(equal(mock_vocabulary(), BASE));
+
+        esp_mn_mock_reset();
+        esp_mn_mock_fail_call(static_cast<int>(k));
+        CHECK_EQ(manager->update_commands(TARGET), ESP_FAIL);
+        CHECK(esp_mn_mock_stats().failures >= 1);    // 删除失败时同一拼音的新增也失败
+        CHECK(!equal(mock_vocabulary(), TARGET));
+        CHECK(manager_in_sync(manager));
+
+        CHECK_EQ(manager->update_commands(TARGET), ESP_OK);
+        CHECK(equal(mock_vocabulary(), TARGET));
+        CHECK(manager_in_sync(manager));
+    }
+
+    // 命令ID变化的拼音删除失败时，随后的新增也失败（拼音仍在）
+    CHECK_EQ(manager->update_commands(BASE), ESP_OK);
+    esp_mn_mock_reset();
+    esp_mn_mock_fail_phrase("bai bai");
+    CHECK_EQ(manager->update_commands(TARGET), ESP_FAIL);
+    CHECK_EQ(esp_mn_mock_stats().failures, 2);
+    CHECK_EQ(mock_vocabulary().find("bai bai"), 314);
+    CHECK(manager_in_sync(manager));
+
+    // 随机词表，随机失败的拼音
+    std::mt19937 rng(2);
+    for (int iteration = 0; iteration < 2000; iteration++) {
+        Vocabulary target = random_vocabulary(&rng, 20, 25);
+        esp_mn_mock_reset();
+        esp_mn_mock_fail_phrase(("p" + std::to_string(rng() % 25)).c_str());
+        manager->update_commands(target);
+        CHECK(manager_in_sync(manager));
+        CHECK_EQ(manager->update_commands(target), ESP_OK);
+        CHECK(equal(mock_vocabulary(), target));
+    }
+    esp_mn_mock_reset();
+    esp_log_level_set("*", ESP_LOG_WARN);
+}
+
+static Vocabulary numbered(int n, int changed) {
+    Vocabulary v;
+    for (int i = 0; i < n; i++) {
+        std::string phrase = "ming ling ci " + std::to_string(i) + (i == changed ? " xin" : "");
+        v.add(IDS[i % 3], phrase.c_str());
+    }
+    return v;
+}
+
+/**
+ * @brief 清空重建（原来的做法）与只提交差异的开销
+ */
+static void bench_update() {
+    CommandManager *manager = CommandManager::get_instance();
+    const int rounds = 20;
+    printf("%6s | %-30s | %-30s | %-22s\n", "命令词", "清空重建", "差分（改1个）", "差分（无变化）");
+    for (int n : {10, 100, 300}) {
+        Vocabulary base = numbered(n, -1);
+        Vocabulary changed = numbered(n, n / 2);
+
+        // 清空重建：释放命令词表后按期望表重新配置，每个命令词都提交一次
+        esp_mn_mock_reset();
+        uint64_t start = host_now_ns();
+        for (int r = 0; r < rounds; r++) {
+            manager->detach_commands();
+            manager->update_commands((r & 1) ? changed : base);
+            manager->configure_commands(esp_mn_mock_iface(), model_data);
+        }
+        double rebuild_us = (host_now_ns() - start) / 1000.0 / rounds;
+        esp_mn_mock_stats_t rebuild = esp_mn_mock_stats();
+        CHECK_EQ(rebuild.adds, rounds * base.size());
+        CHECK(equal(mock_vocabulary(), changed));
+
+        CHECK_EQ(manager->update_commands(base), ESP_OK);
+        esp_mn_mock_reset();
+        start = host_now_ns();
+        for (int r = 0; r < rounds; r++) {
+            manager->update_commands((r & 1) ? base : changed);
+        }
+        double diff_us = (host_now_ns() - start) / 1000.0 / rounds;
+        esp_mn_mock_stats_t diff = esp_mn_mock_stats();
+        CHECK_EQ(diff.modifies, rounds);
+        CHECK_EQ(diff.adds + diff.removes + diff.failures, 0);
+        CHECK(equal(mock_vocabulary(), base));
+
+        esp_mn_mock_reset();
+        start = host_now_ns();
+        for (int r = 0; r < rounds; r++) {
+            manager->update_commands(base);
+        }
+        double same_us = (host_now_ns() - start) / 1000.0 / rounds;
+        CHECK_EQ(esp_mn_mock_stats().updates, 0);
+
+        printf("%6d | %4u 次提交 %8.1f us/次 | %4u 次提交 %8.1f us/次 | 0 次提交 %8.1f us/次\n", n,
+               rebuild.adds / rounds, rebuild_us, diff.modifies / rounds, diff_us, same_us);
+    }
+}
+
+int main() {
+    test_diff_kinds();
+    test_diff_random();
+    test_manager_configure();
+    test_manager_rollback();
+    bench_update();
+    esp_mn_mock_iface()->destroy(model_data);
+    return host_test_result("vocabulary_test");
+}
@@ -0,0 +1,113 @@
+/**
+ * @file host_test.h
+ * @brief 主机测试公用的检查宏和计时函数
+ *
+ * 不引入测试框架：每个测试是一个可执行文件，CHECK 失败时打印位置并计数，
+ * main() 最后返回 host_test_result()，由 ctest 按退出码判定。
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+
+static int host_test_failures = 0;
+
+#define CHECK(cond) do {                                                        \
+        if (!(cond)) {                                                          \
+            printf("%s:%d: 检查失败: %s\n", __FILE__, __LINE__, #cond);         \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_EQ(a, b) do {                                                     \
+        long long check_a = (long long)(a);                                     \
+        long long check_b = (long long)(b);                                     \
+        if (check_a != check_b) {                                               \
+            printf("%s:%d: 检查失败: %s == %s (%lld != %lld)\n",                \
+                   __FILE__, __LINE__, #a, #b, check_a, check_b);               \
+            host_test_failures++;                                               \
+        }                                                                       \
+    } while (0)
+
+/**
+ * @brief 输出结果并返回进程退出码
+ */
+static inline int host_test_result(const char *name) {
+    if (host_test_failures > 0) {
+        printf("%s: %d 项检查失败\n", name, host_test_failures);
+        return 1;
+    }
+    printf("%s: 通过\n", name);
+    return 0;
+}
+
+/**
+ * @brief 单调时钟（纳秒）
+ */
+static inline uint64_t host_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief 仓库中文件的绝对路径
+ */
+static inline std::string repo_path(const char *relative) {
+    return std::string(ZAPMYCO_REPO_DIR) + "/" + relative;
+}
+
+/**
+ * @brief 测试输出文件的路径（ctest 在构建目录中运行测试）
+ */
+static inline std::string host_temp_path(const char *name) {
+    return std::string("host_test_") + name;
+}
+
+/**
+ * @brief 读取整个文件
+ * @return bool 文件不存在返回false
+ */
+static inline bool read_file(const std::string &path, std::vector<uint8_t> &data) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    data.clear();
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return true;
+}
+
+/**
+ * @brief 写入整个文件
+ */
+static inline bool write_file(const std::string &path, const void *data, size_t len) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    bool ok = fwrite(data, 1, len, f) == len;
+    return (fclose(f) == 0) && ok;
+}
+
+/**
+ * @brief 运行 tools/ 下的 Python 脚本
+ * @param script 脚本名，例如 "prompt_pack.py"
+ * @param args 参数（由 shell 解析）
+ * @return int 脚本退出码
+ */
+static inline int run_tool(const char *script, const std::string &args) {
+    std::string command = std::string(ZAPMYCO_PYTHON) + " " + repo_path("tools/") + script + " " + args;
+    int status = system(command.c_str());
+    return (status == -1) ? -1 : WEXITSTATUS(status);
+}
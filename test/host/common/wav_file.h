@@ -0,0 +1,91 @@
+/**
+ * @file wav_file.h
+ * @brief 读取测试用的 WAV 文件（16 位 PCM、单声道）
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 读取 16 位单声道 PCM WAV 文件
+ * @param path 文件路径
+ * @param samples 输出样本
+ * @param sample_rate 输出采样率，可为nullptr
+ * @return bool 文件不存在或格式不符返回false
+ */
+static inline bool wav_read(const std::string &path, std::vector<int16_t> &samples, uint32_t *sample_rate = nullptr) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == nullptr) {
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    if (data.size() < 12 || memcmp(data.data(), "RIFF", 4) != 0 || memcmp(data.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint16_t channels = 0;
+    uint16_t bits = 0;
+    uint32_t rate = 0;
+    for (size_t pos = 12; pos + 8 <= data.size();) {
+        uint32_t size;
+        memcpy(&size, data.data() + pos + 4, 4);
+        const uint8_t *body = data.data() + pos + 8;
+        if (pos + 8 + size > data.size()) {
+            return false;
+        }
+        if (memcmp(data.data() + pos, "fmt ", 4) == 0 && size >= 16) {
+            memcpy(&channels, body + 2, 2);
+            memcpy(&rate, body + 4, 4);
+            memcpy(&bits, body + 14, 2);
+        } else if (memcmp(data.data() + pos, "data", 4) == 0) {
+            if (channels != 1 || bits != 16) {
+                return false;
+            }
+            samples.resize(size / 2);
+            memcpy(samples.data(), body, samples.size() * 2);
+            if (sample_rate != nullptr) {
+                *sample_rate = rate;
+            }
+            return true;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    return false;
+}
+
+/**
+ * @brief 写入 16 位单声道 PCM WAV 文件
+ */
+static inline bool wav_write(const std::string &path, const std::vector<int16_t> &samples, uint32_t sample_rate = 16000) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        return false;
+    }
+    uint32_t data_size = static_cast<uint32_t>(samples.size() * 2);
+    uint32_t riff_size = 36 + data_size;
+    uint16_t format = 1;
+    uint16_t channels = 1;
+    uint32_t byte_rate = sample_rate * 2;
+    uint16_t block_align = 2;
+    uint16_t bits = 16;
+    uint32_t fmt_size = 16;
+
+    bool ok = fwrite("RIFF", 1, 4, f) == 4 && fwrite(&riff_size, 4, 1, f) == 1 && fwrite("WAVEfmt ", 1, 8, f) == 8 &&
+              fwrite(&fmt_size, 4, 1, f) == 1 && fwrite(&format, 2, 1, f) == 1 && fwrite(&channels, 2, 1, f) == 1 &&
+              fwrite(&sample_rate, 4, 1, f) == 1 && fwrite(&byte_rate, 4, 1, f) == 1 &&
+              fwrite(&block_align, 2, 1, f) == 1 && fwrite(&bits, 2, 1, f) == 1 && fwrite("data", 1, 4, f) == 4 &&
+              fwrite(&data_size, 4, 1, f) == 1 && fwrite(samples.data(), 2, samples.size(), f) == samples.size();
+    return (fclose(f) == 0) && ok;
+}
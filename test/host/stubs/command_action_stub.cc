@@ -0,0 +1,25 @@
+/**
+ * @file command_action_stub.cc
+ * @brief 命令动作（打桩，不操作 GPIO 和播放器）
+ *
+ * command_action_init_gpio() 按 ESP32-S3 的输出引脚检查命令表，与固件一致。
+ */
+
+#include "commands/command_action.h"
+#include "commands/command_manifest.h"
+
+esp_err_t command_action_execute(const command_entry_t *entry) {
+    return (entry != nullptr) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t command_action_init_gpio(const CommandManifest *manifest) {
+    command_entry_t entry;
+    CommandTableReadGuard guard;
+    for (size_t i = 0; (manifest != nullptr) ? manifest->at(i, &entry) : command_table_at(i, &entry); i++) {
+        // GPIO_IS_VALID_OUTPUT_GPIO：0-21、26-48
+        if (entry.action == COMMAND_ACTION_GPIO && (entry.gpio > 48 || (entry.gpio >= 22 && entry.gpio <= 25))) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+    return ESP_OK;
+}
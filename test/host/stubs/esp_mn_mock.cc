@@ -0,0 +1,212 @@
+/**
+ * @file esp_mn_mock.cc
+ * @brief 模拟的 MultiNet 模型和命令词表实现
+ */
+
+#include "esp_mn_mock.h"
+#include <cstring>
+
+struct model_iface_data_t {
+    esp_mn_results_t results;
+};
+
+static std::vector<esp_mn_mock_phrase_t> commands;
+static std::vector<esp_mn_mock_phrase_t> model;
+static bool allocated = false;
+static esp_mn_mock_stats_t stats;
+static std::string fail_phrase;
+static int fail_call = -1;
+static volatile uint32_t phoneme_sink;
+
+static int index_of(const char *phrase) {
+    for (size_t i = 0; i < commands.size(); i++) {
+        if (commands[i].phrase == phrase) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 是否注入失败（每次增删改调用一次）
+ */
+static bool inject_failure(const char *phrase) {
+    bool fail = (fail_call == 0) || (!fail_phrase.empty() && fail_phrase == phrase);
+    if (fail_call >= 0) {
+        fail_call--;
+    }
+    return fail;
+}
+
+static esp_err_t finish(esp_err_t ret, uint32_t *counter) {
+    if (ret == ESP_OK) {
+        (*counter)++;
+    } else {
+        stats.failures++;
+    }
+    return ret;
+}
+
+/**
+ * @brief 模拟字音转换的开销
+ */
+static void convert(const std::string &phrase) {
+    uint32_t hash = 0;
+    for (int pass = 0; pass < 64; pass++) {
+        for (char c : phrase) {
+            hash = hash * 31 + static_cast<uint8_t>(c) + pass;
+        }
+    }
+    phoneme_sink = hash;
+    stats.converted++;
+}
+
+extern "C" {
+
+esp_err_t esp_mn_commands_alloc(const esp_mn_iface_t *multinet, model_iface_data_t *model_data) {
+    if (multinet == nullptr || model_data == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    commands.clear();
+    model.clear();
+    allocated = true;
+    return ESP_OK;
+}
+
+void esp_mn_commands_free(void) {
+    commands.clear();
+    model.clear();
+    allocated = false;
+}
+
+esp_err_t esp_mn_commands_add(int command_id, const char *phrase) {
+    if (inject_failure(phrase)) {
+        return finish(ESP_FAIL, nullptr);
+    }
+    if (!allocated) {
+        return finish(ESP_ERR_INVALID_STATE, nullptr);
+    }
+    if (phrase == nullptr || phrase[0] == '\0' || strlen(phrase) > ESP_MN_MAX_PHRASE_LEN) {
+        return finish(ESP_ERR_INVALID_ARG, nullptr);
+    }
+    if (index_of(phrase) >= 0) {
+        return finish(ESP_ERR_INVALID_STATE, nullptr);
+    }
+    commands.push_back({command_id, phrase});
+    return finish(ESP_OK, &stats.adds);
+}
+
+esp_err_t esp_mn_commands_remove(const char *phrase) {
+    if (inject_failure(phrase)) {
+        return finish(ESP_FAIL, nullptr);
+    }
+    int index = index_of(phrase);
+    if (index < 0) {
+        return finish(ESP_ERR_INVALID_STATE, nullptr);
+    }
+    commands.erase(commands.begin() + index);
+    return finish(ESP_OK, &stats.removes);
+}
+
+esp_err_t esp_mn_commands_modify(const char *old_phrase, const char *new_phrase) {
+    if (inject_failure(new_phrase)) {
+        return finish(ESP_FAIL, nullptr);
+    }
+    int index = index_of(old_phrase);
+    if (index < 0 || index_of(new_phrase) >= 0) {
+        return finish(ESP_ERR_INVALID_STATE, nullptr);
+    }
+    if (new_phrase[0] == '\0' || strlen(new_phrase) > ESP_MN_MAX_PHRASE_LEN) {
+        return finish(ESP_ERR_INVALID_ARG, nullptr);
+    }
+    commands[index].phrase = new_phrase;
+    return finish(ESP_OK, &stats.modifies);
+}
+
+esp_err_t esp_mn_commands_clear(void) {
+    commands.clear();
+    return ESP_OK;
+}
+
+esp_mn_error_t *esp_mn_commands_update(void) {
+    stats.updates++;
+    model = commands;
+    for (const esp_mn_mock_phrase_t &p : model) {
+        convert(p.phrase);
+    }
+    return nullptr;
+}
+
+}
+
+static model_iface_data_t *mock_create(const char *model_name, int duration) {
+    (void)model_name;
+    (void)duration;
+    return new model_iface_data_t();
+}
+
+static int mock_get_samp_chunksize(model_iface_data_t *model_data) {
+    (void)model_data;
+    return 512;
+}
+
+static esp_mn_state_t mock_detect(model_iface_data_t *model_data, int16_t *samples) {
+    (void)model_data;
+    (void)samples;
+    return ESP_MN_STATE_DETECTING;
+}
+
+static esp_mn_results_t *mock_get_results(model_iface_data_t *model_data) {
+    return &model_data->results;
+}
+
+static void mock_destroy(model_iface_data_t *model_data) {
+    delete model_data;
+}
+
+static void mock_clean(model_iface_data_t *model_data) {
+    model_data->results = {};
+}
+
+static void mock_print_active_speech_commands(model_iface_data_t *model_data) {
+    (void)model_data;
+}
+
+esp_mn_iface_t *esp_mn_mock_iface(void) {
+    static esp_mn_iface_t iface = {
+        mock_create,
+        mock_get_samp_chunksize,
+        mock_detect,
+        mock_get_results,
+        mock_destroy,
+        mock_clean,
+        mock_print_active_speech_commands,
+    };
+    return &iface;
+}
+
+void esp_mn_mock_fail_phrase(const char *phrase) {
+    fail_phrase = (phrase != nullptr) ? phrase : "";
+}
+
+void esp_mn_mock_fail_call(int index) {
+    fail_call = index;
+}
+
+const std::vector<esp_mn_mock_phrase_t> &esp_mn_mock_commands(void) {
+    return commands;
+}
+
+const std::vector<esp_mn_mock_phrase_t> &esp_mn_mock_model(void) {
+    return model;
+}
+
+esp_mn_mock_stats_t esp_mn_mock_stats(void) {
+    return stats;
+}
+
+void esp_mn_mock_reset(void) {
+    stats = {};
+    fail_phrase.clear();
+    fail_call = -1;
+}
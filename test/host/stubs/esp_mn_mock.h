@@ -0,0 +1,75 @@
+/**
+ * @file esp_mn_mock.h
+ * @brief 模拟的 MultiNet 模型和命令词表，可以注入失败
+ *
+ * esp_mn_commands_* 按 esp-sr 的语义维护命令词表：新增已存在的拼音、删除或
+ * 修改不存在的拼音返回 ESP_ERR_INVALID_STATE；esp_mn_commands_update() 把
+ * 命令词表交给模型，对每个命令词做一次模拟的字音转换（耗时与拼音长度成正比）。
+ * 注入的失败返回 ESP_FAIL，命令词表不变。
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "esp_mn_iface.h"
+#include "esp_mn_speech_commands.h"
+}
+
+/**
+ * @brief 命令词
+ */
+typedef struct {
+    int id;
+    std::string phrase;
+} esp_mn_mock_phrase_t;
+
+/**
+ * @brief 调用计数
+ */
+typedef struct {
+    uint32_t adds;          // 成功的新增
+    uint32_t removes;       // 成功的删除
+    uint32_t modifies;      // 成功的修改
+    uint32_t failures;      // 失败的增删改（含注入的失败）
+    uint32_t updates;       // esp_mn_commands_update() 次数
+    uint32_t converted;     // 字音转换的命令词数
+} esp_mn_mock_stats_t;
+
+/**
+ * @brief 模拟的 MultiNet 接口（create/detect/get_results/clean/destroy/print_active_speech_commands）
+ */
+esp_mn_iface_t *esp_mn_mock_iface(void);
+
+/**
+ * @brief 新增、修改为或删除该拼音时失败（nullptr 取消）
+ */
+void esp_mn_mock_fail_phrase(const char *phrase);
+
+/**
+ * @brief 从现在起第 index 次增删改调用失败（从0开始，负数取消）
+ */
+void esp_mn_mock_fail_call(int index);
+
+/**
+ * @brief 命令词表的当前内容（按提交顺序）
+ */
+const std::vector<esp_mn_mock_phrase_t> &esp_mn_mock_commands(void);
+
+/**
+ * @brief 最近一次 esp_mn_commands_update() 交给模型的命令词
+ */
+const std::vector<esp_mn_mock_phrase_t> &esp_mn_mock_model(void);
+
+/**
+ * @brief 调用计数
+ */
+esp_mn_mock_stats_t esp_mn_mock_stats(void);
+
+/**
+ * @brief 清零调用计数，取消注入的失败
+ */
+void esp_mn_mock_reset(void);
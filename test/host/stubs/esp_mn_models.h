@@ -0,0 +1,10 @@
+/**
+ * @file esp_mn_models.h
+ * @brief esp-sr MultiNet 模型查找（打桩）
+ */
+
+#pragma once
+
+#include "esp_mn_iface.h"
+
+esp_mn_iface_t *esp_mn_handle_from_name(const char *model_name);
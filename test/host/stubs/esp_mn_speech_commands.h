@@ -0,0 +1,17 @@
+/**
+ * @file esp_mn_speech_commands.h
+ * @brief esp-sr 命令词表接口（打桩，实现见 esp_mn_mock.cc）
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "esp_mn_iface.h"
+
+esp_err_t esp_mn_commands_alloc(const esp_mn_iface_t *multinet, model_iface_data_t *model_data);
+void esp_mn_commands_free(void);
+esp_err_t esp_mn_commands_add(int command_id, const char *phrase);
+esp_err_t esp_mn_commands_remove(const char *phrase);
+esp_err_t esp_mn_commands_modify(const char *old_phrase, const char *new_phrase);
+esp_err_t esp_mn_commands_clear(void);
+esp_mn_error_t *esp_mn_commands_update(void);
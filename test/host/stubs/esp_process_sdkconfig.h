@@ -0,0 +1,9 @@
+/**
+ * @file esp_process_sdkconfig.h
+ * @brief esp-sr 从 sdkconfig 加载命令词（打桩）
+ */
+
+#pragma once
+
+#include "esp_mn_iface.h"
+#include "esp_mn_speech_commands.h"
@@ -0,0 +1,156 @@
+/**
+ * @file esp_stubs.cc
+ * @brief ESP-IDF 和 FreeRTOS 接口的主机实现（打桩）
+ */
+
+#include "esp_stubs.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <deque>
+
+extern "C" {
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+}
+
+static esp_log_level_t log_level = ESP_LOG_WARN;
+
+struct host_semaphore {
+    std::mutex mutex;
+};
+
+typedef struct {
+    esp_partition_t partition;
+    const void *data;
+} host_partition_t;
+
+static std::deque<host_partition_t> partitions;  // 添加后地址不变
+
+void esp_stubs_add_partition(const char *label, const void *data, size_t size) {
+    host_partition_t p = {};
+    p.partition.type = ESP_PARTITION_TYPE_DATA;
+    p.partition.size = static_cast<uint32_t>(size);
+    strncpy(p.partition.label, label, sizeof(p.partition.label) - 1);
+    p.data = data;
+    partitions.push_back(p);
+}
+
+extern "C" {
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_RESPONSE: return "ESP_ERR_INVALID_RESPONSE";
+    default: return "UNKNOWN ERROR";
+    }
+}
+
+void esp_log_level_set(const char *tag, esp_log_level_t level) {
+    (void)tag;  // 只支持 "*"
+    log_level = level;
+}
+
+uint32_t esp_log_timestamp(void) {
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) {
+    (void)tag;
+    if (level > log_level) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+int64_t esp_timer_get_time(void) {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+    (void)caps;
+    return malloc(size);
+}
+
+void heap_caps_free(void *ptr) {
+    free(ptr);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    (void)caps;
+    return 8 * 1024 * 1024;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label) {
+    (void)subtype;
+    for (const host_partition_t &p : partitions) {
+        if (p.partition.type == type && strcmp(p.partition.label, label) == 0) {
+            return &p.partition;
+        }
+    }
+    return nullptr;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t memory, const void **out_ptr,
+                             esp_partition_mmap_handle_t *out_handle) {
+    (void)memory;
+    for (size_t i = 0; i < partitions.size(); i++) {
+        if (&partitions[i].partition == partition) {
+            if (offset + size > partition->size) {
+                return ESP_ERR_INVALID_ARG;
+            }
+            *out_ptr = static_cast<const uint8_t *>(partitions[i].data) + offset;
+            *out_handle = static_cast<esp_partition_mmap_handle_t>(i + 1);
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t handle) {
+    (void)handle;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return new host_semaphore();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    (void)ticks;    // 测试中只用 portMAX_DELAY
+    semaphore->mutex.lock();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    semaphore->mutex.unlock();
+    return pdTRUE;
+}
+
+}
@@ -0,0 +1,15 @@
+/**
+ * @file esp_stubs.h
+ * @brief 打桩实现的测试接口
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief 添加一个数据分区，映射时直接返回 data（不复制，测试期间有效）
+ *
+ * 未添加的分区 esp_partition_find_first() 找不到。
+ */
+void esp_stubs_add_partition(const char *label, const void *data, size_t size);
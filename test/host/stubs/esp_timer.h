@@ -0,0 +1,18 @@
+/**
+ * @file esp_timer.h
+ * @brief ESP-IDF 高精度定时器（打桩，单调时钟）
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
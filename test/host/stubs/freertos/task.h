@@ -0,0 +1,18 @@
+/**
+ * @file task.h
+ * @brief FreeRTOS 任务接口（打桩，只含测试用到的部分）
+ */
+
+#pragma once
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vTaskDelay(TickType_t ticks);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,10 @@
+/**
+ * @file sdkconfig.h
+ * @brief 主机测试用的配置（打桩）
+ *
+ * 延迟日志关闭，DLOGx 等同于 ESP_LOGx，直接输出。
+ */
+
+#pragma once
+
+#define CONFIG_ZAPMYCO_DEFERRED_LOG 0
@@ -0,0 +1,118 @@
+/**
+ * @file boot_profile_test.cc
+ * @brief 启动剖析表的主机测试
+ *
+ * 检查记录、截断、表满、校验和（模拟 RTC_NOINIT 内存中的随机内容和位翻转），
+ * 以及多个线程像 boot_trace_mark() 一样在锁内取时间并打点时，阶段耗时不会为负。
+ */
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "host_test.h"
+#include "system/boot_profile.h"
+
+static void test_marks() {
+    BootProfile profile;
+    profile.reset(3);
+    CHECK(profile.is_valid());
+    CHECK_EQ(profile.count(), 0);
+    CHECK_EQ(profile.boot_count(), 3);
+    CHECK_EQ(profile.total_us(), 0);
+
+    CHECK(profile.mark("启动代码", 1200));
+    CHECK(profile.mark("模型加载", 350000));
+    CHECK(profile.mark("a_name_that_is_longer_than_the_limit", 351000));
+    CHECK(profile.is_valid());
+    CHECK_EQ(profile.count(), 3);
+    CHECK(strcmp(profile.name_at(0), "启动代码") == 0);
+    CHECK_EQ(strlen(profile.name_at(2)), BootProfile::NAME_MAX);
+    CHECK(strncmp(profile.name_at(2), "a_name_that_is_longer_than_the_limit", BootProfile::NAME_MAX) == 0);
+    CHECK_EQ(profile.duration_at(0), 1200);
+    CHECK_EQ(profile.duration_at(1), 348800);
+    CHECK_EQ(profile.duration_at(2), 1000);
+    CHECK_EQ(profile.total_us(), 351000);
+
+    // 越界访问返回空值
+    CHECK(strcmp(profile.name_at(3), "") == 0);
+    CHECK_EQ(profile.time_at(3), 0);
+    CHECK_EQ(profile.duration_at(3), 0);
+
+    // 表满
+    for (size_t i = profile.count(); i < BootProfile::MAX_MARKS; i++) {
+        CHECK(profile.mark("x", 400000 + i));
+    }
+    CHECK(!profile.mark("overflow", 999999));
+    CHECK_EQ(profile.count(), BootProfile::MAX_MARKS);
+    CHECK(profile.is_valid());
+}
+
+/**
+ * @brief 复位后 RTC_NOINIT 内存内容未知：随机内容和任意一位翻转都应判为无效
+ */
+static void test_checksum() {
+    alignas(BootProfile) uint8_t raw[sizeof(BootProfile)];
+    uint32_t seed = 11;
+    int accepted = 0;
+    for (int round = 0; round < 10000; round++) {
+        for (uint8_t &b : raw) {
+            seed = seed * 1664525u + 1013904223u;
+            b = static_cast<uint8_t>(seed >> 24);
+        }
+        accepted += reinterpret_cast<BootProfile *>(raw)->is_valid();
+    }
+    CHECK_EQ(accepted, 0);
+
+    BootProfile profile;
+    profile.reset(1);
+    profile.mark("启动代码", 1000);
+    profile.mark("外设", 2000);
+    // 只有表头和已记录的时间点受校验和保护
+    size_t covered = 16 + 2 * (BootProfile::NAME_MAX + 1 + sizeof(uint32_t));
+    int missed = 0;
+    for (size_t bit = 0; bit < covered * 8; bit++) {
+        BootProfile copy = profile;
+        reinterpret_cast<uint8_t *>(&copy)[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+        missed += copy.is_valid();
+    }
+    CHECK_EQ(missed, 0);
+}
+
+/**
+ * @brief 两个线程交替打点，时间在锁内读取，表中时间点单调不减
+ */
+static void test_concurrent_marks() {
+    BootProfile profile;
+    profile.reset(1);
+    std::mutex lock;
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&](const char *name) {
+        for (size_t i = 0; i < BootProfile::MAX_MARKS / 2; i++) {
+            std::lock_guard<std::mutex> guard(lock);
+            uint64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            profile.mark(name, now_us);
+        }
+    };
+    std::thread a(worker, "核心0");
+    std::thread b(worker, "核心1");
+    a.join();
+    b.join();
+
+    CHECK_EQ(profile.count(), BootProfile::MAX_MARKS);
+    CHECK(profile.is_valid());
+    for (size_t i = 1; i < profile.count(); i++) {
+        CHECK(profile.time_at(i) >= profile.time_at(i - 1));
+        CHECK(profile.duration_at(i) < 10000000u);  // 无符号差值回绕说明顺序错乱
+    }
+}
+
+int main() {
+    test_marks();
+    test_checksum();
+    test_concurrent_marks();
+    return host_test_result("boot_profile_test");
+}
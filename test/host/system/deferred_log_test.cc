@@ -0,0 +1,195 @@
+/**
+ * @file deferred_log_test.cc
+ * @brief 延迟格式化日志的主机测试和调用开销基准
+ *
+ * 检查各类参数经 8 字节字槽往返后格式化结果与直接 snprintf 一致、队列满时
+ * 丢弃计数、多个生产者各自的入队顺序，并比较实时路径上一条日志的开销：
+ * 改动前 ESP_LOGx 在调用方格式化并写出，改动后 DLOGx 只记录参数并入队。
+ */
+
+#include <atomic>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "host_test.h"
+#include "system/deferred_log.h"
+
+typedef enum { COLOR_RED = 3 } color_t;
+typedef enum : uint8_t { SMALL_BIG = 200 } small_t;
+
+static std::string format_record(const deferred_log_record_t &record) {
+    char buf[256];
+    deferred_log_format(record, buf, sizeof(buf));
+    return buf;
+}
+
+/**
+ * @brief 与直接调用 snprintf 的结果比较
+ */
+template <typename... Args>
+static void check_round_trip(const char *format, Args... args) {
+    char expected[256];
+    snprintf(expected, sizeof(expected), format, args...);
+    deferred_log_record_t record;
+    deferred_log_capture(&record, 3, "T", format, 0, args...);
+    if (format_record(record) != expected) {
+        printf("格式化不一致: \"%s\" != \"%s\"\n", format_record(record).c_str(), expected);
+    }
+    CHECK(format_record(record) == expected);
+    CHECK_EQ(record.nargs, sizeof...(Args));
+}
+
+static void test_format_round_trip() {
+    static const char *const name = "帮我开灯";
+    check_round_trip("plain 100%%");
+    check_round_trip("%d %d %d", 0, -5, INT32_MIN);
+    check_round_trip("%u %lu %zu", UINT32_MAX, 123456789UL, static_cast<size_t>(42));
+    check_round_trip("%lld %llu", -9000000000LL, 18000000000000000000ULL);
+    check_round_trip("%.2f %.3e %g", 0.125f, -1.5e-7, 3.0);
+    check_round_trip("%s='%s'", "str", name);
+    check_round_trip("%c %d %d %hd", 'x', true, COLOR_RED, static_cast<short>(-3));
+    check_round_trip("%u", SMALL_BIG);
+    check_round_trip("%p", reinterpret_cast<const void *>(0x1234));
+    check_round_trip("%d %d %d %d %d %d %d %s", 1, 2, 3, 4, 5, 6, 7, "八");
+
+    // 参数类别按位记录，供二进制编码使用
+    deferred_log_record_t record;
+    deferred_log_capture(&record, 3, "T", "%d %u %f %s", 0, -1, 1u, 0.5, "s");
+    CHECK_EQ(record.arg_types, DEFERRED_LOG_ARG_SIGNED | DEFERRED_LOG_ARG_UNSIGNED << 2 |
+                               DEFERRED_LOG_ARG_FLOAT << 4 | DEFERRED_LOG_ARG_STRING << 6);
+}
+
+static void test_drop_when_full() {
+    static DeferredLogQueue queue;
+    deferred_log_record_t record;
+    deferred_log_capture(&record, 3, "T", "%d", 0, 1);
+
+    int accepted = 0;
+    for (int i = 0; i < DEFERRED_LOG_QUEUE_LENGTH + 8; i++) {
+        accepted += queue.push(record);
+    }
+    CHECK_EQ(accepted, DEFERRED_LOG_QUEUE_LENGTH);
+    CHECK_EQ(queue.dropped(), 8);
+
+    deferred_log_record_t out;
+    int popped = 0;
+    while (queue.pop(&out)) {
+        popped++;
+    }
+    CHECK_EQ(popped, DEFERRED_LOG_QUEUE_LENGTH);
+    CHECK(queue.push(record));
+    CHECK_EQ(queue.dropped(), 8);
+}
+
+/**
+ * @brief 多个生产者同时入队：每个生产者的记录按入队顺序出队，无丢失
+ */
+static void test_multi_producer_order() {
+    static DeferredLogQueue queue;
+    const int producers = 3;
+    const int per_producer = 20000;
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            deferred_log_record_t record;
+            for (int i = 0; i < per_producer; i++) {
+                deferred_log_capture(&record, 3, "T", "%d %d", 0, i, p);
+                while (!queue.push(record)) {
+                    std::this_thread::yield();
+                }
+            }
+            finished++;
+        });
+    }
+
+    std::vector<int> last(producers, -1);
+    int received = 0, out_of_order = 0;
+    deferred_log_record_t out;
+    while (true) {
+        int done = finished.load();
+        if (!queue.pop(&out)) {
+            if (done == producers && !queue.pop(&out)) {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        int i = static_cast<int>(out.args[0]);
+        int p = static_cast<int>(out.args[1]);
+        out_of_order += (i != last[p] + 1);
+        last[p] = i;
+        received++;
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    CHECK_EQ(out_of_order, 0);
+    CHECK_EQ(received, producers * per_producer);
+}
+
+/**
+ * @brief 实时路径上一条日志的开销（以“检测到命令词”一行为例）
+ *
+ * 改动前：在调用方格式化并写出（设备上还要等待串口）；改动后：记录参数并入队，
+ * 队列满时只计数。
+ */
+static void bench_call_cost() {
+    static const char *const LINE = "I (%lu) %s: 🎯 检测到命令词: ID=%d, 置信度=%.2f, 命令='%s'\n";
+    static const char *const FORMAT = "🎯 检测到命令词: ID=%d, 置信度=%.2f, 命令='%s'";
+    static const char *const DESC = "帮我开灯";
+    const int iterations = 500000;
+    int fd = open("/dev/null", O_WRONLY);
+    CHECK(fd >= 0);
+    volatile int sink = 0;
+
+    uint64_t start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        char buf[256];
+        int n = snprintf(buf, sizeof(buf), LINE, (unsigned long)i, "主程序", i & 7, 0.93f, DESC);
+        sink = sink + static_cast<int>(write(fd, buf, n));
+    }
+    double immediate_ns = static_cast<double>(host_now_ns() - start) / iterations;
+    close(fd);
+
+    // 每次写满队列后（不计时）清空，只计成功入队
+    static DeferredLogQueue queue;
+    deferred_log_record_t out;
+    uint64_t queued_total = 0;
+    int rounds = iterations / DEFERRED_LOG_QUEUE_LENGTH;
+    for (int r = 0; r < rounds; r++) {
+        start = host_now_ns();
+        for (int k = 0; k < DEFERRED_LOG_QUEUE_LENGTH; k++) {
+            deferred_log_record_t record;
+            deferred_log_capture(&record, 3, "主程序", FORMAT, static_cast<uint32_t>(k), k & 7, 0.93f, DESC);
+            sink = sink + queue.push(record);
+        }
+        queued_total += host_now_ns() - start;
+        while (queue.pop(&out)) {
+        }
+    }
+    double queued_ns = static_cast<double>(queued_total) / (rounds * DEFERRED_LOG_QUEUE_LENGTH);
+
+    start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        deferred_log_record_t record;
+        deferred_log_capture(&record, 3, "主程序", FORMAT, static_cast<uint32_t>(i), i & 7, 0.93f, DESC);
+        sink = sink + queue.push(record);
+    }
+    double dropped_ns = static_cast<double>(host_now_ns() - start) / iterations;
+
+    printf("改动前 snprintf+write: %.0f ns/条, 改动后 入队: %.1f ns/条, 队列满丢弃: %.1f ns/条\n",
+           immediate_ns, queued_ns, dropped_ns);
+    // 设备上串口输出（115200 波特率约 87 us/字节）远大于主机上的 write()，这里只要求不慢于格式化
+    CHECK(queued_ns < immediate_ns);
+}
+
+int main() {
+    test_format_round_trip();
+    test_drop_when_full();
+    test_multi_producer_order();
+    bench_call_cost();
+    return host_test_result("deferred_log_test");
+}
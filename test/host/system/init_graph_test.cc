@@ -0,0 +1,311 @@
+/**
+ * @file init_graph_test.cc
+ * @brief 启动初始化依赖图的主机测试
+ *
+ * - add() 拒绝空函数、依赖尚未添加的步骤（包括自身）和无效索引 dep(-1)，表满时失败；
+ * - 必需步骤失败时，直接和间接依赖它的步骤都被跳过，cause 指向最初失败的步骤；
+ * - 可选步骤失败不阻塞依赖它的步骤，也不影响 succeeded()；
+ * - finished()/succeeded() 在执行过程中和结束后的取值；
+ * - 与 init_runner 相同的方式由两个线程在互斥锁下 take_ready()/complete()：
+ *   随机生成的图中每个步骤都在其依赖结束后才开始，最终状态与串行执行一致。
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "host_test.h"
+#include "system/init_graph.h"
+
+static int step_ok(void *) {
+    return 0;
+}
+
+static int step_fail(void *) {
+    return 0x103;   // ESP_ERR_INVALID_STATE
+}
+
+/**
+ * @brief 单个执行者串行执行，返回执行的步骤数
+ */
+static int run_serial(InitGraph *graph) {
+    int executed = 0;
+    uint32_t now = 0;
+    int index;
+    while ((index = graph->take_ready(0, ++now)) >= 0) {
+        const init_step_t &step = graph->step(index);
+        graph->complete(index, step.fn(step.arg), ++now);
+        executed++;
+    }
+    return executed;
+}
+
+static void test_add() {
+    InitGraph graph;
+    CHECK_EQ(graph.add("无依赖", step_ok, nullptr, 0), 0);
+    CHECK_EQ(graph.add("空函数", nullptr, nullptr, 0), -1);
+    CHECK_EQ(graph.add("依赖自身", step_ok, nullptr, InitGraph::dep(1)), -1);
+    CHECK_EQ(graph.add("依赖后面的步骤", step_ok, nullptr, InitGraph::dep(5)), -1);
+    CHECK_EQ(graph.add("依赖无效索引", step_ok, nullptr, InitGraph::dep(0) | InitGraph::dep(-1)), -1);
+    CHECK_EQ(graph.add("依赖越界索引", step_ok, nullptr, InitGraph::dep(InitGraph::MAX_STEPS)), -1);
+    CHECK_EQ(graph.count(), 1);
+
+    // add() 失败返回的 -1 传给 dep() 后，依赖它的 add() 也失败
+    int failed = graph.add("空函数", nullptr, nullptr, 0);
+    CHECK_EQ(graph.add("依赖失败的添加", step_ok, nullptr, InitGraph::dep(failed)), -1);
+
+    int first = graph.add("依赖已添加的步骤", step_ok, nullptr, InitGraph::dep(0));
+    CHECK_EQ(first, 1);
+    const init_step_t &s = graph.step(first);
+    CHECK_EQ(s.state, INIT_STEP_PENDING);
+    CHECK_EQ(s.deps, InitGraph::dep(0));
+    CHECK_EQ(s.cause, -1);
+    CHECK(!s.optional);
+
+    while (graph.count() < InitGraph::MAX_STEPS) {
+        CHECK(graph.add("填充", step_ok, nullptr, InitGraph::dep(graph.count() - 1)) >= 0);
+    }
+    CHECK_EQ(graph.add("表满", step_ok, nullptr, 0), -1);
+    CHECK_EQ(graph.count(), InitGraph::MAX_STEPS);
+
+    // 最后一步依赖 dep(15)，是 dep() 能表示的最大有效索引
+    CHECK_EQ(graph.step(InitGraph::MAX_STEPS - 1).deps, InitGraph::dep(InitGraph::MAX_STEPS - 2));
+    CHECK_EQ(run_serial(&graph), InitGraph::MAX_STEPS);
+    CHECK(graph.finished());
+    CHECK(graph.succeeded());
+}
+
+/**
+ * @brief 必需步骤失败：跳过沿依赖链传递，cause 指向根因
+ */
+static void test_skip_propagation() {
+    InitGraph graph;
+    int root = graph.add("模型分区", step_fail, nullptr, 0);
+    int other = graph.add("麦克风", step_ok, nullptr, 0);
+    int direct = graph.add("唤醒词模型", step_ok, nullptr, InitGraph::dep(root));
+    int indirect = graph.add("采集任务", step_ok, nullptr, InitGraph::dep(other) | InitGraph::dep(direct));
+    int deep = graph.add("识别任务", step_ok, nullptr, InitGraph::dep(indirect));
+    int independent = graph.add("音频播放", step_ok, nullptr, InitGraph::dep(other));
+    int second = graph.add("提示音分区", step_fail, nullptr, InitGraph::dep(other));
+    int both = graph.add("两个根因", step_ok, nullptr, InitGraph::dep(second) | InitGraph::dep(deep));
+    CHECK(both >= 0);
+
+    // 根因和两个独立步骤执行，其余跳过
+    CHECK_EQ(run_serial(&graph), 4);
+    CHECK(graph.finished());
+    CHECK(!graph.succeeded());
+
+    CHECK_EQ(graph.step(root).state, INIT_STEP_FAILED);
+    CHECK_EQ(graph.step(root).status, 0x103);
+    CHECK_EQ(graph.step(root).cause, -1);
+    CHECK_EQ(graph.step(other).state, INIT_STEP_DONE);
+    CHECK_EQ(graph.step(independent).state, INIT_STEP_DONE);
+    CHECK_EQ(graph.step(second).state, INIT_STEP_FAILED);
+    for (int index : {direct, indirect, deep}) {
+        const init_step_t &s = graph.step(index);
+        CHECK_EQ(s.state, INIT_STEP_SKIPPED);
+        CHECK_EQ(s.cause, root);
+        CHECK_EQ(s.start_us, s.end_us);
+    }
+    // 依赖两条失败链时，根因为先失败的那个
+    CHECK_EQ(graph.step(both).state, INIT_STEP_SKIPPED);
+    CHECK_EQ(graph.step(both).cause, root);
+}
+
+/**
+ * @brief 可选步骤失败：依赖它的步骤照常执行
+ */
+static void test_optional_failure() {
+    InitGraph graph;
+    int led = graph.add("LED", step_fail, nullptr, 0, true);
+    int commands = graph.add("命令管理器", step_ok, nullptr, InitGraph::dep(led));
+    int prompts = graph.add("提示音分区", step_fail, nullptr, 0, true);
+    int recognition = graph.add("识别任务", step_ok, nullptr,
+                                InitGraph::dep(commands) | InitGraph::dep(prompts) | InitGraph::dep(led));
+    CHECK(recognition >= 0);
+
+    CHECK_EQ(run_serial(&graph), 4);
+    CHECK(graph.finished());
+    CHECK(graph.succeeded());
+    CHECK_EQ(graph.step(led).state, INIT_STEP_FAILED);
+    CHECK_EQ(graph.step(prompts).state, INIT_STEP_FAILED);
+    CHECK_EQ(graph.step(commands).state, INIT_STEP_DONE);
+    CHECK_EQ(graph.step(recognition).state, INIT_STEP_DONE);
+    CHECK_EQ(graph.step(recognition).cause, -1);
+
+    // 可选步骤被跳过时仍然阻塞依赖它的步骤
+    InitGraph chain;
+    int root = chain.add("模型分区", step_fail, nullptr, 0);
+    int optional = chain.add("可选", step_ok, nullptr, InitGraph::dep(root), true);
+    int after = chain.add("依赖可选步骤", step_ok, nullptr, InitGraph::dep(optional));
+    CHECK_EQ(run_serial(&chain), 1);
+    CHECK_EQ(chain.step(optional).state, INIT_STEP_SKIPPED);
+    CHECK_EQ(chain.step(after).state, INIT_STEP_SKIPPED);
+    CHECK_EQ(chain.step(after).cause, root);
+    CHECK(!chain.succeeded());
+}
+
+/**
+ * @brief finished()/succeeded() 在执行过程中的取值
+ */
+static void test_finished_succeeded() {
+    InitGraph empty;
+    CHECK(empty.finished());
+    CHECK(empty.succeeded());
+    CHECK_EQ(empty.take_ready(0, 0), -1);
+
+    InitGraph graph;
+    int a = graph.add("a", step_ok, nullptr, 0);
+    int b = graph.add("b", step_ok, nullptr, InitGraph::dep(a));
+    CHECK(!graph.finished());
+    CHECK(!graph.succeeded());
+
+    CHECK_EQ(graph.take_ready(1, 10), a);
+    CHECK_EQ(graph.step(a).state, INIT_STEP_RUNNING);
+    CHECK_EQ(graph.step(a).core, 1);
+    CHECK_EQ(graph.step(a).start_us, 10);
+    // b 等待 a，暂时没有可执行的步骤，但图还没结束
+    CHECK_EQ(graph.take_ready(0, 11), -1);
+    CHECK(!graph.finished());
+
+    // 对未执行或越界的步骤报告结果被忽略
+    graph.complete(b, 0, 12);
+    graph.complete(-1, 0, 12);
+    graph.complete(InitGraph::MAX_STEPS, 0, 12);
+    CHECK_EQ(graph.step(b).state, INIT_STEP_PENDING);
+
+    graph.complete(a, 0, 20);
+    CHECK_EQ(graph.step(a).end_us, 20);
+    CHECK(!graph.finished());
+    CHECK_EQ(graph.take_ready(0, 21), b);
+    CHECK(!graph.finished());
+    CHECK(!graph.succeeded());
+    graph.complete(b, 0, 30);
+    CHECK(graph.finished());
+    CHECK(graph.succeeded());
+
+    // 重复报告不改变结果
+    graph.complete(b, 1, 40);
+    CHECK_EQ(graph.step(b).state, INIT_STEP_DONE);
+    CHECK_EQ(graph.step(b).end_us, 30);
+}
+
+// ---- 两个执行者 ----
+
+typedef struct {
+    int status;                     // 步骤函数返回值
+    uint32_t deps;
+    std::atomic<bool> *ended;       // 各步骤函数是否已返回
+    std::atomic<int> *errors;
+    std::atomic<int> *running;      // 正在执行的步骤数
+} thread_step_t;
+
+static int step_checked(void *arg) {
+    thread_step_t *t = static_cast<thread_step_t *>(arg);
+    // 依赖的步骤函数都已返回（被跳过的依赖会让本步骤也被跳过，不会执行到这里）
+    for (size_t d = 0; d < InitGraph::MAX_STEPS; d++) {
+        if ((t->deps & InitGraph::dep(d)) && !t->ended[d].load(std::memory_order_acquire)) {
+            (*t->errors)++;
+        }
+    }
+    int running = ++(*t->running);
+    *t->errors += running > 2;
+    std::this_thread::yield();
+    --(*t->running);
+    return t->status;
+}
+
+/**
+ * @brief 与 init_runner 相同：互斥锁保护图，没有可执行的步骤时等待其他执行者的通知
+ */
+static void run_worker(InitGraph *graph, std::mutex *lock, std::condition_variable *changed,
+                       std::atomic<uint32_t> *clock, std::atomic<bool> *ended, int core) {
+    std::unique_lock<std::mutex> guard(*lock);
+    while (true) {
+        int index = graph->take_ready(core, ++(*clock));
+        if (index < 0) {
+            if (graph->finished()) {
+                return;
+            }
+            changed->wait(guard);
+            continue;
+        }
+
+        guard.unlock();
+        const init_step_t &step = graph->step(index);
+        int status = step.fn(step.arg);
+        ended[index].store(true, std::memory_order_release);
+        guard.lock();
+
+        graph->complete(index, status, ++(*clock));
+        changed->notify_all();
+    }
+}
+
+static void test_two_workers() {
+    static const int ITERATIONS = 500;
+    uint32_t seed = 1;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    std::atomic<int> errors{0}, running{0};
+    int runs_with_failure = 0, steps_per_core[2] = {0, 0};
+
+    for (int it = 0; it < ITERATIONS; it++) {
+        InitGraph graph, serial;
+        thread_step_t steps[InitGraph::MAX_STEPS];
+        std::atomic<bool> ended[InitGraph::MAX_STEPS];
+        for (size_t i = 0; i < InitGraph::MAX_STEPS; i++) {
+            ended[i].store(false);
+            uint32_t deps = (next() & (InitGraph::dep(i) - 1)) & (next() | next());   // 平均约四分之一的前序步骤
+            bool optional = next() % 4 == 0;
+            int status = (next() % 12 == 0) ? 0x101 : 0;
+            steps[i] = {status, deps, ended, &errors, &running};
+            CHECK_EQ(graph.add("随机", step_checked, &steps[i], deps, optional), static_cast<int>(i));
+            CHECK_EQ(serial.add("随机", status ? step_fail : step_ok, nullptr, deps, optional), static_cast<int>(i));
+        }
+
+        std::mutex lock;
+        std::condition_variable changed;
+        std::atomic<uint32_t> clock{0};
+        std::thread helper(run_worker, &graph, &lock, &changed, &clock, ended, 1);
+        run_worker(&graph, &lock, &changed, &clock, ended, 0);
+        helper.join();
+        run_serial(&serial);
+
+        CHECK(graph.finished());
+        CHECK_EQ(graph.succeeded(), serial.succeeded());
+        runs_with_failure += !graph.succeeded();
+        for (size_t i = 0; i < InitGraph::MAX_STEPS; i++) {
+            const init_step_t &s = graph.step(i);
+            CHECK_EQ(s.state, serial.step(i).state);
+            if (s.state == INIT_STEP_SKIPPED) {
+                // 根因是失败的必需步骤；两个执行者下可能是任意一个先失败的根因
+                CHECK(s.cause >= 0 && graph.step(s.cause).state == INIT_STEP_FAILED && !graph.step(s.cause).optional);
+                CHECK(!ended[i].load());
+                continue;
+            }
+            CHECK(ended[i].load());
+            steps_per_core[s.core]++;
+            for (size_t d = 0; d < i; d++) {
+                if (s.deps & InitGraph::dep(d)) {
+                    CHECK(s.start_us > graph.step(d).end_us);
+                }
+            }
+        }
+    }
+    CHECK_EQ(errors.load(), 0);
+    CHECK(runs_with_failure > 0 && runs_with_failure < ITERATIONS);
+    printf("两个执行者: %d 张图, %d 张有必需步骤失败, 执行步骤 %d / %d\n", ITERATIONS, runs_with_failure,
+           steps_per_core[0], steps_per_core[1]);
+}
+
+int main() {
+    test_add();
+    test_skip_propagation();
+    test_optional_failure();
+    test_finished_succeeded();
+    test_two_workers();
+    return host_test_result("init_graph_test");
+}
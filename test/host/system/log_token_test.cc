@@ -0,0 +1,165 @@
+/**
+ * @file log_token_test.cc
+ * @brief 日志令牌化的往返测试
+ *
+ * 按固件令牌化 DLOGx 的路径（编译期令牌、log_token_encode、log_token_base64）
+ * 把本文件中的日志调用编码为 "ZL:" 帧，混入普通日志行；再用
+ * tools/log_tokens.py 扫描本文件生成令牌表并解码，结果必须与按 ESP32 的
+ * printf 语义（int/long/size_t 为 32 位）格式化的文本逐行一致。覆盖有符号
+ * （zigzag）、无符号、浮点、字符串以及超过 LOG_TOKEN_MAX_STRING 的截断。
+ */
+
+#include <climits>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "host_test.h"
+#include "system/log_token.h"
+
+static const char *TAG = "往返测试";
+static const char *OTHER_TAG = "播放器";
+
+static FILE *frames;
+static std::vector<std::string> expected;   // 解码后期望的各行
+static uint32_t timestamp_ms = 4000000000u;  // 接近 32 位上限，varint 占 5 字节
+
+/**
+ * @brief 编码一条令牌化日志并写出 ZL 行，同时记录直接格式化的期望文本
+ */
+template <typename... Args>
+static void emit(char letter, const char *tag, uint32_t token, const char *format, Args... args) {
+    deferred_log_record_t record;
+    deferred_log_capture(&record, 3, tag, nullptr, timestamp_ms, args...);
+    record.token = token;
+
+    uint8_t frame[LOG_TOKEN_MAX_FRAME];
+    char line[(LOG_TOKEN_MAX_FRAME + 2) / 3 * 4 + 1];
+    size_t len = log_token_encode(record, frame, sizeof(frame));
+    CHECK(len > 0);
+    log_token_base64(frame, len, line);
+    fprintf(frames, "I (%lu) dlog: ZL:%s\n", (unsigned long)timestamp_ms, line);
+
+    // 编码到偏小的缓冲区时整帧放弃
+    for (size_t size = 0; size < len; size++) {
+        CHECK_EQ(log_token_encode(record, frame, size), 0);
+    }
+
+    char text[512];
+    snprintf(text, sizeof(text), format, args...);
+    // 帧前的控制台前缀原样保留
+    std::string ts = std::to_string(timestamp_ms);
+    expected.push_back("I (" + ts + ") dlog: " + letter + " (" + ts + ") " + tag + ": " + text);
+    timestamp_ms += 1000;
+}
+
+// 写成可变参数形式，log_tokens.py 扫描时不会把宏定义当成日志调用
+#define HOST_DLOG(letter, tag, format, ...) emit(letter, tag, log_token(letter, format), format, ##__VA_ARGS__)
+#define DLOGE(...) HOST_DLOG('E', __VA_ARGS__)
+#define DLOGW(...) HOST_DLOG('W', __VA_ARGS__)
+#define DLOGI(...) HOST_DLOG('I', __VA_ARGS__)
+#define DLOGD(...) HOST_DLOG('D', __VA_ARGS__)
+
+static void plain(const char *line) {
+    fprintf(frames, "%s\n", line);
+    expected.push_back(line);
+}
+
+typedef enum { COLOR_NEGATIVE = -7, COLOR_RED = 3 } color_t;
+
+static void write_frames() {
+    plain("I (1200) 主程序: 普通日志原样输出");
+
+    // 有符号整数：zigzag varint
+    DLOGI(TAG, "有符号 %d %d %d %d", 0, -1, INT32_MIN, INT32_MAX);
+    DLOGD(TAG, "长整数 %lld %lld %+d [%5d] [%-5d]|", -9000000000LL, LLONG_MIN, 42, -7, 3);
+    DLOGW(TAG, "字符 %c 枚举 %d 布尔 %d 短整数 %hd", 'Z', COLOR_NEGATIVE, true, static_cast<short>(-300));
+
+    // 无符号整数：varint；32 位以内的 %x/%u 按 ESP32 的 int 宽度输出
+    DLOGI(TAG, "无符号 %u %lu %zu %llu", UINT32_MAX, 5ul, static_cast<size_t>(42), ULLONG_MAX);
+    DLOGI(TAG, "十六进制 %x %08X %#x %o %llx", 0xbeefu, 255u, 16u, 8u, 0x123456789abcdefULL);
+    DLOGI(TAG, "负数按无符号输出 %x %u %hx %hhu", -1, -2, -1, 300);
+    DLOGI(TAG, "无符号按有符号输出 %d", 0xfffffffeu);
+    DLOGI(TAG, "指针 %p", reinterpret_cast<const void *>(0x3fc91234));
+
+    // 浮点数：float32
+    DLOGI(TAG, "🎯 检测到命令词: ID=%d, 置信度=%.2f, 命令='%s'", 2, 0.93f, "帮我开灯");
+    DLOGI(TAG, "浮点 %f %.3e %g %+.1f [%8.3f]", 0.5, -1.5e-7f, 1024.0, -2.25, 3.125);
+
+    // 字符串：长度 varint + UTF-8；%% 不消耗参数
+    DLOGE(OTHER_TAG, "播放失败: %s (%d%%)", "ESP_ERR_TIMEOUT", 100);
+    DLOGI(TAG, "宽度 [%-6s] [%6s] [%.2s]", "ab", "cd", "efgh");
+    DLOGI(TAG, "空字符串 [%s]", "");
+    DLOGI(TAG, "恰好上限 %s", "0123456789abcdef0123456789ABCDEF");
+    DLOGI(TAG, "八个参数 %d %u %.1f %s %d %u %.1f %s", -1, 2u, 3.5, "四", -5, 6u, 7.5, "八");
+
+    // 超过 LOG_TOKEN_MAX_STRING 字节的字符串截断，且不截在 UTF-8 字符中间
+    DLOGI(TAG, "截断 %s|", "0123456789abcdef0123456789ABCDEF-overflow");
+    expected.back() = expected.back().substr(0, expected.back().find("截断 ") + strlen("截断 ")) +
+                      "0123456789abcdef0123456789ABCDEF|";
+    DLOGW(TAG, "截断中文 %s|", "命令词识别超时请再说一遍好吗");
+    expected.back() = expected.back().substr(0, expected.back().find("截断中文 ") + strlen("截断中文 ")) +
+                      "命令词识别超时请再说|";    // 10 个汉字 30 字节，第 11 个放不下
+
+    DLOGW(TAG, "escape \"quoted\" tab\tend "
+               "concat %d", 9);
+    plain("W (9999) 其他: 含有 ZL 字样但不是帧的行 ZL:");
+}
+
+static void test_round_trip() {
+    std::string frames_path = host_temp_path("log_frames.log");
+    std::string table_path = host_temp_path("log_tokens.json");
+    std::string decoded_path = host_temp_path("log_decoded.log");
+    frames = fopen(frames_path.c_str(), "w");
+    CHECK(frames != nullptr);
+    if (frames == nullptr) {
+        return;
+    }
+    write_frames();
+    fclose(frames);
+
+    CHECK_EQ(run_tool("log_tokens.py", "table -o " + table_path + " " +
+                      repo_path("test/host/system/log_token_test.cc") + " > /dev/null"), 0);
+    CHECK_EQ(run_tool("log_tokens.py", "decode --table " + table_path + " " + frames_path + " > " + decoded_path), 0);
+
+    std::vector<uint8_t> data;
+    CHECK(read_file(decoded_path, data));
+    std::vector<std::string> lines;
+    std::string current;
+    for (uint8_t c : data) {
+        if (c == '\n') {
+            lines.push_back(current);
+            current.clear();
+        } else {
+            current.push_back(static_cast<char>(c));
+        }
+    }
+    CHECK_EQ(lines.size(), expected.size());
+    for (size_t i = 0; i < lines.size() && i < expected.size(); i++) {
+        if (lines[i] != expected[i]) {
+            printf("第 %zu 行不一致:\n  解码: %s\n  期望: %s\n", i + 1, lines[i].c_str(), expected[i].c_str());
+        }
+        CHECK(lines[i] == expected[i]);
+    }
+}
+
+static void test_base64() {
+    static const struct {
+        const char *in;
+        const char *out;
+    } cases[] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"},
+    };
+    for (const auto &c : cases) {
+        char out[16];
+        size_t len = log_token_base64(reinterpret_cast<const uint8_t *>(c.in), strlen(c.in), out);
+        CHECK_EQ(len, strlen(c.out));
+        CHECK(strcmp(out, c.out) == 0);
+    }
+}
+
+int main() {
+    test_base64();
+    test_round_trip();
+    return host_test_result("log_token_test");
+}
@@ -0,0 +1,452 @@
+/**
+ * @file rcu_test.cc
+ * @brief RCU 宽限期和命令表整体替换的压力测试及读者延迟基准
+ *
+ * - 宽限期：读者停在读临界区内时 synchronize() 不返回，读者退出后才返回；
+ * - RcuDomain 压力：多个读者在 RcuReadGuard 内（偶尔嵌套、偶尔让出CPU模拟被
+ *   抢占）反复读取共享快照，写者不断发布新快照、等待宽限期、改写并释放旧快照。
+ *   读者看到的快照必须完整，且不会看到比上一次更旧的快照；
+ * - 命令表压力：同样的读写方式作用于 command_table_publish()/synchronize()，
+ *   每一代清单的描述中带代号。读临界区内先取出的表项，其字符串在临界区
+ *   结束前保持不变（即使其间已发布新清单），后续查询不会看到更旧的一代；
+ * - 基准：command_table_find() 在空闲和写者持续替换时的单次延迟，
+ *   与用互斥锁保护清单指针的做法对比。
+ *
+ * 旧快照释放前先填充无效数据，普通构建下读到已释放的快照也会被发现；
+ * 在 ZAPMYCO_HOST_SANITIZE=address / thread 的构建中分别检查释放后使用和数据竞争。
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "commands/command_manifest.h"
+#include "commands/command_table.h"
+#include "host_test.h"
+#include "system/rcu.h"
+
+static const int READERS = 3;
+static const int COMMANDS = 64;
+static const char GENERATION_TAG[] = "G00000000";   // 描述中的代号占位，按代改写
+
+static void yield_wait(void) {
+    std::this_thread::yield();
+}
+
+/**
+ * @brief 读者循环：等待开始信号后反复调用 read(reader, n)，直到 done 置位
+ */
+template <typename F>
+static std::vector<std::thread> start_readers(int count, const std::atomic<bool> &go, const std::atomic<bool> &done,
+                                              F read) {
+    std::vector<std::thread> threads;
+    for (int r = 0; r < count; r++) {
+        threads.emplace_back([&go, &done, read, r]() mutable {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (uint32_t n = 0; !done.load(std::memory_order_acquire); n++) {
+                read(r, n);
+            }
+        });
+    }
+    return threads;
+}
+
+// ---- RcuDomain ----
+
+typedef struct {
+    uint32_t generation;
+    uint32_t values[32];    // 均为 generation 的函数，读者据此检查快照完整
+} snapshot_t;
+
+static uint32_t snapshot_value(uint32_t generation, size_t i) {
+    return generation * 2654435761u + static_cast<uint32_t>(i);
+}
+
+static snapshot_t *make_snapshot(uint32_t generation) {
+    snapshot_t *s = new snapshot_t;
+    s->generation = generation;
+    for (size_t i = 0; i < 32; i++) {
+        s->values[i] = snapshot_value(generation, i);
+    }
+    return s;
+}
+
+static void free_snapshot(snapshot_t *s) {
+    memset(s, 0xa5, sizeof(*s));
+    delete s;
+}
+
+static bool snapshot_intact(const snapshot_t *s) {
+    for (size_t i = 0; i < 32; i++) {
+        if (s->values[i] != snapshot_value(s->generation, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 读者停在临界区内时宽限期不结束
+ */
+static void test_grace_period_waits() {
+    RcuDomain domain;
+    std::atomic<snapshot_t *> current{make_snapshot(1)};
+    std::atomic<bool> entered{false}, release{false}, synchronized{false};
+
+    std::thread reader([&]() {
+        RcuReadGuard guard(domain);
+        const snapshot_t *s = current.load(std::memory_order_seq_cst);
+        entered.store(true, std::memory_order_release);
+        while (!release.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        // 写者已发布新快照并在等待，旧快照仍然有效
+        CHECK(snapshot_intact(s));
+        CHECK_EQ(s->generation, 1);
+    });
+    while (!entered.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    uint32_t waits = 0;
+    std::thread writer([&]() {
+        snapshot_t *old = current.exchange(make_snapshot(2), std::memory_order_seq_cst);
+        waits = domain.synchronize(yield_wait);
+        synchronized.store(true, std::memory_order_release);
+        free_snapshot(old);
+    });
+
+    // 读者不退出，写者一直等
+    uint64_t start = host_now_ns();
+    while (host_now_ns() - start < 20 * 1000 * 1000) {
+        std::this_thread::yield();
+    }
+    CHECK(!synchronized.load(std::memory_order_acquire));
+    release.store(true, std::memory_order_release);
+    reader.join();
+    writer.join();
+    CHECK(synchronized.load(std::memory_order_acquire));
+    CHECK(waits > 0);
+    CHECK_EQ(domain.grace_periods(), 1);
+
+    // 没有读者时立即返回
+    CHECK_EQ(domain.synchronize(yield_wait), 0);
+    free_snapshot(current.load());
+}
+
+static void test_domain_stress() {
+    static const uint32_t GENERATIONS = 3000;
+    RcuDomain domain;
+    std::atomic<snapshot_t *> current{make_snapshot(0)};
+    std::atomic<bool> go{false}, done{false};
+    std::atomic<int> errors{0};
+    std::atomic<long> reads{0};
+    std::vector<uint32_t> last_seen(READERS, 0);
+
+    std::vector<std::thread> readers = start_readers(READERS, go, done, [&](int r, uint32_t n) {
+        RcuReadGuard guard(domain);
+        const snapshot_t *s = current.load(std::memory_order_seq_cst);
+        uint32_t generation = s->generation;
+        errors += generation < last_seen[r];
+        last_seen[r] = generation;
+        if (n % 8 == 0) {
+            std::this_thread::yield();  // 在临界区内被抢占
+        }
+        if (n % 5 == 0) {
+            // 嵌套的临界区可能看到更新的快照，外层的快照仍然有效
+            RcuReadGuard inner(domain);
+            const snapshot_t *t = current.load(std::memory_order_seq_cst);
+            errors += !snapshot_intact(t) || t->generation < generation;
+        }
+        // 快照在临界区结束前没有被释放、改写或重新分配给新的一代
+        errors += !snapshot_intact(s) || s->generation != generation;
+        reads++;
+    });
+
+    uint32_t total_waits = 0;
+    go.store(true, std::memory_order_release);
+    for (uint32_t g = 1; g <= GENERATIONS; g++) {
+        snapshot_t *old = current.exchange(make_snapshot(g), std::memory_order_seq_cst);
+        total_waits += domain.synchronize(yield_wait);
+        free_snapshot(old);
+        if (g % 4 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread &t : readers) {
+        t.join();
+    }
+    free_snapshot(current.load());
+
+    CHECK_EQ(errors.load(), 0);
+    CHECK_EQ(domain.grace_periods(), GENERATIONS);
+    CHECK(reads.load() > 0);
+    printf("RcuDomain: %u 次替换, %ld 次读取, 等待读者 %u 次\n", GENERATIONS, reads.load(), total_waits);
+}
+
+// ---- 命令表 ----
+
+/**
+ * @brief 命令清单模板：command_pack.py 打包，描述为 "G00000000 <id>"
+ */
+static std::vector<uint8_t> pack_template() {
+    std::string json = "{\"commands\": [\n";
+    for (int i = 0; i < COMMANDS; i++) {
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "{\"id\": %d, \"pinyin\": \"ming ling %c%c\", \"description\": \"%s %d\", "
+                 "\"action\": \"none\"}%s\n",
+                 100 + i, 'a' + i % 26, 'a' + i / 26, GENERATION_TAG, 100 + i, (i + 1 < COMMANDS) ? "," : "");
+        json += line;
+    }
+    json += "]}\n";
+    std::string json_path = host_temp_path("rcu_commands.json");
+    std::string out = host_temp_path("rcu_commands.bin");
+    CHECK(write_file(json_path, json.data(), json.size()));
+    CHECK_EQ(run_tool("command_pack.py", "pack -o " + out + " " + json_path + " > /dev/null"), 0);
+    std::vector<uint8_t> image;
+    CHECK(read_file(out, image));
+    return image;
+}
+
+typedef struct {
+    CommandManifest manifest;
+    uint8_t *data;          // 大小恰好的堆缓冲区，越界和释放后读取在 ASan 下可见
+    size_t size;
+} manifest_snapshot_t;
+
+/**
+ * @brief 复制模板并把所有描述中的代号改成 generation
+ */
+static manifest_snapshot_t *make_manifest(const std::vector<uint8_t> &image, uint32_t generation) {
+    manifest_snapshot_t *s = new manifest_snapshot_t;
+    s->size = image.size();
+    s->data = new uint8_t[s->size];
+    memcpy(s->data, image.data(), s->size);
+    char tag[sizeof(GENERATION_TAG)];
+    snprintf(tag, sizeof(tag), "G%08u", generation % 100000000u);
+    const size_t len = sizeof(GENERATION_TAG) - 1;
+    for (uint8_t *p = s->data; p + len <= s->data + s->size; p++) {
+        if (memcmp(p, GENERATION_TAG, len) == 0) {
+            memcpy(p, tag, len);
+        }
+    }
+    bool ok = s->manifest.parse(s->data, s->size);
+    CHECK(ok);
+    return s;
+}
+
+static void free_manifest(const CommandManifest *manifest) {
+    if (manifest == nullptr) {
+        return;
+    }
+    // manifest 是 manifest_snapshot_t 的第一个成员
+    const manifest_snapshot_t *s = reinterpret_cast<const manifest_snapshot_t *>(manifest);
+    memset(s->data, 0xa5, s->size);
+    delete[] s->data;
+    delete s;
+}
+
+/**
+ * @brief 从表项的描述中取出代号，描述损坏或与 ID 不符返回 -1
+ */
+static long entry_generation(const command_entry_t &entry) {
+    unsigned generation;
+    int id;
+    if (sscanf(entry.description, "G%8u %d", &generation, &id) != 2 || id != entry.id) {
+        return -1;
+    }
+    char pinyin[32];
+    snprintf(pinyin, sizeof(pinyin), "ming ling %c%c", 'a' + (id - 100) % 26, 'a' + (id - 100) / 26);
+    return strcmp(pinyin, entry.pinyin) == 0 ? static_cast<long>(generation) : -1;
+}
+
+static void test_command_table_stress(const std::vector<uint8_t> &image) {
+    static const uint32_t GENERATIONS = 1000;
+    CHECK(command_table_publish(&make_manifest(image, 0)->manifest) == nullptr);
+    std::atomic<bool> go{false}, done{false};
+    std::atomic<int> errors{0};
+    std::atomic<long> reads{0};
+    std::vector<long> last_seen(READERS, 0);
+
+    std::vector<std::thread> readers = start_readers(READERS, go, done, [&](int r, uint32_t n) {
+        CommandTableReadGuard guard;
+        command_entry_t entry;
+        int id = 100 + static_cast<int>((n * 37 + r * 11) % (COMMANDS + 4));
+        bool found = command_table_find(id, &entry);
+        if (id >= 100 + COMMANDS) {
+            errors += found;
+            return;
+        }
+        long generation = found ? entry_generation(entry) : -1;
+        errors += generation < last_seen[r];
+        last_seen[r] = std::max(generation, last_seen[r]);
+        if (n % 8 == 0) {
+            std::this_thread::yield();
+        }
+        // 后续查询各自取当前快照，可能来自更新的一代
+        command_entry_t later;
+        for (size_t i = n % 13; command_table_at(i, &later); i += 13) {
+            errors += entry_generation(later) < generation;
+        }
+        errors += command_table_size() != COMMANDS;
+        // 临界区结束前，先前取出的字符串仍然完整
+        errors += entry_generation(entry) != generation;
+        reads++;
+    });
+
+    uint32_t total_waits = 0;
+    uint64_t worst_grace_ns = 0;
+    go.store(true, std::memory_order_release);
+    for (uint32_t g = 1; g <= GENERATIONS; g++) {
+        manifest_snapshot_t *next = make_manifest(image, g);
+        uint64_t start = host_now_ns();
+        const CommandManifest *old = command_table_publish(&next->manifest);
+        total_waits += command_table_synchronize(yield_wait);
+        worst_grace_ns = std::max(worst_grace_ns, host_now_ns() - start);
+        free_manifest(old);
+        if (g % 4 == 0) {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread &t : readers) {
+        t.join();
+    }
+    // 换回内置命令表
+    free_manifest(command_table_publish(nullptr));
+    command_table_synchronize(yield_wait);
+    CHECK(!command_table_from_manifest());
+
+    CHECK_EQ(errors.load(), 0);
+    CHECK(reads.load() > 0);
+    printf("命令表: %u 次替换, %ld 次读取, 等待读者 %u 次, 最长宽限期 %.1f us\n", GENERATIONS,
+           reads.load(), total_waits, worst_grace_ns / 1000.0);
+}
+
+// ---- 读者延迟基准 ----
+
+typedef struct {
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t max;
+} latency_t;
+
+/**
+ * @brief READERS 个读者持续调用 find，每 16 次记录一次单次延迟
+ * @param writer 为 true 时另一个线程持续替换清单
+ */
+template <typename Find, typename Replace>
+static latency_t measure(Find find, Replace replace, bool writer, uint32_t *replacements) {
+    std::atomic<bool> go{false}, done{false};
+    std::vector<std::vector<uint32_t>> samples(READERS);
+    for (std::vector<uint32_t> &s : samples) {
+        s.reserve(1 << 16);
+    }
+    std::vector<std::thread> readers = start_readers(READERS, go, done, [&](int r, uint32_t n) {
+        int id = 100 + static_cast<int>((n * 37 + r * 11) % COMMANDS);
+        uint64_t start = host_now_ns();
+        find(id);
+        uint64_t elapsed = host_now_ns() - start;
+        if (n % 16 == 0 && samples[r].size() < samples[r].capacity()) {
+            samples[r].push_back(static_cast<uint32_t>(elapsed));
+        }
+    });
+
+    go.store(true, std::memory_order_release);
+    uint32_t count = 0;
+    uint64_t start = host_now_ns();
+    while (host_now_ns() - start < 200 * 1000 * 1000) {
+        if (writer) {
+            replace(count++);
+        }
+        std::this_thread::yield();
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread &t : readers) {
+        t.join();
+    }
+    *replacements = count;
+
+    std::vector<uint32_t> all;
+    for (const std::vector<uint32_t> &s : samples) {
+        all.insert(all.end(), s.begin(), s.end());
+    }
+    std::sort(all.begin(), all.end());
+    if (all.empty()) {
+        return latency_t{0, 0, 0};
+    }
+    return latency_t{all[all.size() / 2], all[all.size() * 99 / 100], all.back()};
+}
+
+static void bench_reader_latency(const std::vector<uint8_t> &image) {
+    command_table_publish(&make_manifest(image, 0)->manifest);
+    auto rcu_find = [](int id) {
+        command_entry_t entry;
+        volatile bool found = command_table_find(id, &entry);    // 防止查询被优化掉
+        (void)found;
+    };
+    auto rcu_replace = [&](uint32_t g) {
+        manifest_snapshot_t *next = make_manifest(image, g);
+        const CommandManifest *old = command_table_publish(&next->manifest);
+        command_table_synchronize(yield_wait);
+        free_manifest(old);
+    };
+
+    // 对比：读者和写者共用一把互斥锁
+    std::mutex lock;
+    const CommandManifest *locked = &make_manifest(image, 0)->manifest;
+    auto mutex_find = [&](int id) {
+        command_entry_t entry;
+        std::lock_guard<std::mutex> guard(lock);
+        volatile bool found = locked->find(id, &entry);
+        (void)found;
+    };
+    auto mutex_replace = [&](uint32_t g) {
+        manifest_snapshot_t *next = make_manifest(image, g);
+        const CommandManifest *old;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            old = locked;
+            locked = &next->manifest;
+        }
+        free_manifest(old);
+    };
+
+    uint32_t n;
+    latency_t rcu_idle = measure(rcu_find, rcu_replace, false, &n);
+    latency_t rcu_busy = measure(rcu_find, rcu_replace, true, &n);
+    uint32_t rcu_replacements = n;
+    latency_t mutex_idle = measure(mutex_find, mutex_replace, false, &n);
+    latency_t mutex_busy = measure(mutex_find, mutex_replace, true, &n);
+
+    free_manifest(command_table_publish(nullptr));
+    command_table_synchronize(yield_wait);
+    free_manifest(locked);
+
+    printf("command_table_find 读者延迟（%d 个读者，%d 个命令）:\n", READERS, COMMANDS);
+    printf("  RCU    空闲 p50 %lu ns, p99 %lu ns, 最大 %lu ns; 持续替换（%u 次）p50 %lu ns, p99 %lu ns, 最大 %lu ns\n",
+           (unsigned long)rcu_idle.p50, (unsigned long)rcu_idle.p99, (unsigned long)rcu_idle.max, rcu_replacements,
+           (unsigned long)rcu_busy.p50, (unsigned long)rcu_busy.p99, (unsigned long)rcu_busy.max);
+    printf("  互斥锁 空闲 p50 %lu ns, p99 %lu ns, 最大 %lu ns; 持续替换（%u 次）p50 %lu ns, p99 %lu ns, 最大 %lu ns\n",
+           (unsigned long)mutex_idle.p50, (unsigned long)mutex_idle.p99, (unsigned long)mutex_idle.max, n,
+           (unsigned long)mutex_busy.p50, (unsigned long)mutex_busy.p99, (unsigned long)mutex_busy.max);
+}
+
+int main() {
+    test_grace_period_waits();
+    test_domain_stress();
+    std::vector<uint8_t> image = pack_template();
+    CHECK(!image.empty());
+    if (!image.empty()) {
+        test_command_table_stress(image);
+        bench_reader_latency(image);
+    }
+    return host_test_result("rcu_test");
+}
@@ -0,0 +1,203 @@
+/**
+ * @file trace_ring_test.cc
+ * @brief 事件跟踪环形缓冲区的主机测试
+ *
+ * 每个核心两个写入线程（模拟同一核心上互相抢占的任务）交替写入开始/结束/瞬时
+ * 事件，共用的时钟从接近 2^32 处开始，在缓冲区保留的最后一段记录中回绕。
+ * 写入期间另一个线程持续读取，读到的记录必须完整。写完后按固件的格式输出
+ * 原始缓冲区镜像和 ZTRACE 日志，交给 tools/trace_decode.py 解码；配对和时间戳
+ * 展开由 test/host/tools/trace_decode_test.py 检查。
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "host_test.h"
+#include "system/trace_events.h"
+#include "system/trace_ring.h"
+
+static const int ITERATIONS = 5000;         // 每个写入线程的开始/结束对数
+static const int INSTANT_EVERY = 100;       // 第一个线程每隔多少对写一个瞬时事件
+static const uint32_t STEP_US = 7;          // 每条记录的时钟步长
+static const uint32_t WRAP_BEFORE_END = TRACE_RING_CAPACITY / 2;    // 回绕点距末尾的记录数
+
+// 每个核心上两个线程各用一种事件，配对不依赖线程交错的顺序
+static const uint16_t THREAD_EVENTS[2] = {TRACE_EVENT_WAKE_DETECT, TRACE_EVENT_COMMAND_DETECT};
+
+static trace_buffer_t buffer;
+
+/**
+ * @brief 参数的低 8 位是时间戳的低 8 位，读取方据此发现拼接自两次写入的记录
+ */
+static uint32_t make_arg(uint32_t index, uint32_t timestamp_us) {
+    return (index << 8) | (timestamp_us & 0xff);
+}
+
+static bool entry_consistent(const trace_entry_t &entry) {
+    if ((entry.arg & 0xff) != (entry.timestamp_us & 0xff)) {
+        return false;
+    }
+    if (entry.type == TRACE_TYPE_INSTANT) {
+        return entry.event == TRACE_EVENT_WAKE_TRIGGERED;
+    }
+    return (entry.type == TRACE_TYPE_BEGIN || entry.type == TRACE_TYPE_END) &&
+           (entry.event == THREAD_EVENTS[0] || entry.event == THREAD_EVENTS[1]);
+}
+
+static void writer(TraceRing *ring, std::atomic<uint32_t> *clock, int thread, const std::atomic<bool> *go) {
+    uint16_t event = THREAD_EVENTS[thread];
+    while (!go->load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < ITERATIONS; i++) {
+        if (i % 64 == 0) {
+            std::this_thread::yield();  // 单核主机上也让各线程交错执行
+        }
+        uint32_t ts = clock->fetch_add(STEP_US);
+        ring->write(TRACE_TYPE_BEGIN, event, make_arg(i, ts), ts);
+        ts = clock->fetch_add(STEP_US);
+        ring->write(TRACE_TYPE_END, event, make_arg(i, ts), ts);
+        if (thread == 0 && i % INSTANT_EVERY == 0) {
+            ts = clock->fetch_add(STEP_US);
+            ring->write(TRACE_TYPE_INSTANT, TRACE_EVENT_WAKE_TRIGGERED, make_arg(i, ts), ts);
+        }
+    }
+}
+
+/**
+ * @brief 多线程写入，同时读取；返回读到的不完整记录数
+ */
+static int fill_buffer() {
+    trace_buffer_init(&buffer);
+    const uint32_t writes = 2 * 2 * ITERATIONS + (ITERATIONS + INSTANT_EVERY - 1) / INSTANT_EVERY;
+    std::atomic<uint32_t> clocks[TRACE_MAX_CORES];
+    for (int core = 0; core < TRACE_MAX_CORES; core++) {
+        // 错开两个核心的时钟，两者都在最后 WRAP_BEFORE_END 条记录附近回绕
+        clocks[core] = 0u - (writes - WRAP_BEFORE_END) * STEP_US - core * 3;
+    }
+
+    std::atomic<bool> go{false};
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<uint32_t> reads{0};
+    std::thread reader([&]() {
+        go.store(true, std::memory_order_release);
+        while (!done.load(std::memory_order_acquire)) {
+            for (int core = 0; core < TRACE_MAX_CORES; core++) {
+                const TraceRing &ring = buffer.rings[core];
+                uint32_t head = ring.head();
+                for (uint32_t seq = ring.oldest(); seq != head; seq++) {
+                    trace_entry_t entry;
+                    if (ring.read(seq, &entry)) {
+                        torn += !entry_consistent(entry) || entry.seq != seq;
+                        reads++;
+                    }
+                }
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int core = 0; core < TRACE_MAX_CORES; core++) {
+        for (int thread = 0; thread < 2; thread++) {
+            writers.emplace_back(writer, &buffer.rings[core], &clocks[core], thread, &go);
+        }
+    }
+    for (std::thread &t : writers) {
+        t.join();
+    }
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    for (int core = 0; core < TRACE_MAX_CORES; core++) {
+        CHECK_EQ(buffer.rings[core].head(), writes);
+        CHECK_EQ(buffer.rings[core].oldest(), writes - TRACE_RING_CAPACITY);
+    }
+    CHECK(reads.load() > 0);
+    return torn.load();
+}
+
+/**
+ * @brief 写入结束后缓冲区中保留的全部记录都可读且完整，时钟在其中回绕
+ */
+static void check_retained() {
+    for (int core = 0; core < TRACE_MAX_CORES; core++) {
+        const TraceRing &ring = buffer.rings[core];
+        int wrapped = 0;
+        uint32_t prev_ts = 0;
+        for (uint32_t seq = ring.oldest(); seq != ring.head(); seq++) {
+            trace_entry_t entry;
+            CHECK(ring.read(seq, &entry));
+            CHECK(entry_consistent(entry));
+            if (seq != ring.oldest() && entry.timestamp_us < prev_ts && prev_ts - entry.timestamp_us > 0x80000000u) {
+                wrapped++;
+            }
+            prev_ts = entry.timestamp_us;
+        }
+        CHECK_EQ(wrapped, 1);
+        // 尚未写入的序号读取失败
+        trace_entry_t entry;
+        CHECK(!ring.read(ring.head(), &entry));
+    }
+}
+
+/**
+ * @brief 按 trace.cc dump_buffer() 的格式输出 ZTRACE 日志，前后混有其他日志
+ */
+static bool write_log(const std::string &path) {
+    static const char *const NAMES[] = {
+#define TRACE_EVENT_NAME(name) #name,
+        TRACE_EVENT_LIST(TRACE_EVENT_NAME)
+#undef TRACE_EVENT_NAME
+    };
+    FILE *f = fopen(path.c_str(), "w");
+    if (f == nullptr) {
+        return false;
+    }
+    fprintf(f, "I (1234) 主程序: 交互结束\n");
+    fprintf(f, "ZTRACE-BEGIN %d %d %d\n", TRACE_VERSION, TRACE_MAX_CORES, TRACE_RING_CAPACITY);
+    for (int i = 0; i < TRACE_EVENT_COUNT; i++) {
+        fprintf(f, "ZTRACE-EVENT %d %s\n", i, NAMES[i]);
+    }
+    uint32_t total = 0;
+    for (int core = 0; core < TRACE_MAX_CORES; core++) {
+        const TraceRing &ring = buffer.rings[core];
+        for (uint32_t seq = ring.oldest(); seq != ring.head(); seq++) {
+            trace_entry_t entry;
+            if (ring.read(seq, &entry)) {
+                fprintf(f, "ZTRACE %d %lu %lu %c %u %lu\n", core, (unsigned long)entry.seq,
+                        (unsigned long)entry.timestamp_us, entry.type, entry.event, (unsigned long)entry.arg);
+                total++;
+            }
+        }
+    }
+    fprintf(f, "ZTRACE-END %lu\n", (unsigned long)total);
+    fprintf(f, "I (1240) 主程序: 等待唤醒词\n");
+    return fclose(f) == 0;
+}
+
+static void bench_write() {
+    TraceRing &ring = buffer.rings[0];
+    const int iterations = 1000000;
+    uint64_t start = host_now_ns();
+    for (int i = 0; i < iterations; i++) {
+        ring.write(TRACE_TYPE_INSTANT, TRACE_EVENT_PLAY_WRITE, i, i);
+    }
+    printf("write: %.1f ns\n", static_cast<double>(host_now_ns() - start) / iterations);
+}
+
+int main() {
+    CHECK_EQ(fill_buffer(), 0);
+    check_retained();
+
+    std::string image = host_temp_path("trace.bin");
+    std::string log = host_temp_path("trace.log");
+    CHECK(write_file(image, &buffer, sizeof(buffer)));
+    CHECK(write_log(log));
+    CHECK_EQ(run_tool("trace_decode.py", image + " -o " + host_temp_path("trace_raw.json") + " > /dev/null"), 0);
+    CHECK_EQ(run_tool("trace_decode.py", log + " -o " + host_temp_path("trace_log.json") + " > /dev/null"), 0);
+
+    bench_write();
+    return host_test_result("trace_ring_test");
+}
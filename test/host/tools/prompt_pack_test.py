@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tools/prompt_pack.py 的测试
+
+用仓库中的提示音检查首尾静音裁剪、响度归一化、打包/解包往返，
+以及 --partition-size 超出时不写出文件。
+
+用法：
+    prompt_pack_test.py <仓库根目录>
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+import unittest
+
+REPO = os.path.abspath(sys.argv.pop(1) if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), "../../.."))
+TOOL = os.path.join(REPO, "tools", "prompt_pack.py")
+VOICES = os.path.join(REPO, "main", "assets", "voices")
+sys.path.insert(0, os.path.join(REPO, "tools"))
+
+import prompt_pack  # noqa: E402
+
+
+class Options:
+    """与命令行默认值相同的处理选项"""
+    trim = True
+    trim_threshold = 64
+    trim_margin_ms = 20
+    normalize = True
+    rms_dbfs = -20.0
+    peak_dbfs = -1.0
+
+
+def voice_paths():
+    return sorted(os.path.join(VOICES, name) for name in os.listdir(VOICES) if name.endswith(".wav"))
+
+
+def run_tool(*args):
+    return subprocess.run([sys.executable, TOOL] + list(args), stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+
+
+class TrimTest(unittest.TestCase):
+    def test_trim_keeps_margin_and_only_drops_silence(self):
+        options = Options()
+        options.normalize = False
+        margin = options.trim_margin_ms * prompt_pack.SAMPLE_RATE // 1000
+        for path in voice_paths():
+            samples = prompt_pack.to_samples(prompt_pack.read_wav(path))
+            record = prompt_pack.prepare(prompt_pack.prompt_name(path), prompt_pack.to_pcm(samples), options)
+            head, tail = record["trim_head"], record["trim_tail"]
+            with self.subTest(path=os.path.basename(path)):
+                self.assertEqual(head + record["samples"] + tail, len(samples))
+                # 裁掉的部分全是静音
+                dropped = samples[:head] + samples[len(samples) - tail:]
+                self.assertTrue(all(abs(s) <= options.trim_threshold for s in dropped))
+                # 保留部分的首尾恰好留出 margin 个样本的余量（除非原文件本身不够长）
+                kept = samples[head:len(samples) - tail]
+                loud = [i for i, s in enumerate(kept) if abs(s) > options.trim_threshold]
+                self.assertTrue(loud)
+                self.assertEqual(loud[0], min(margin, loud[0] + head))
+                self.assertEqual(len(kept) - 1 - loud[-1], min(margin, len(kept) - 1 - loud[-1] + tail))
+
+    def test_trim_shortens_assets(self):
+        before = 0
+        after = 0
+        for path in voice_paths():
+            pcm = prompt_pack.read_wav(path)
+            record = prompt_pack.prepare(prompt_pack.prompt_name(path), pcm, Options())
+            before += len(pcm) // 2
+            after += record["samples"]
+        print("裁剪: %d ms -> %d ms" % (before * 1000 // prompt_pack.SAMPLE_RATE,
+                                      after * 1000 // prompt_pack.SAMPLE_RATE))
+        self.assertLess(after, before)
+
+    def test_silence_only_is_not_trimmed_away(self):
+        self.assertEqual(prompt_pack.trim_silence([0] * 100, 64, 10), (0, 0))
+        self.assertEqual(prompt_pack.trim_silence([0] * 50 + [1000] + [0] * 50, 64, 10), (40, 40))
+        self.assertEqual(prompt_pack.trim_silence([1000] + [0] * 5, 64, 10), (0, 0))
+
+
+class NormalizeTest(unittest.TestCase):
+    def test_peak_limit(self):
+        limit = 32768.0 * 10 ** (Options.peak_dbfs / 20)
+        for path in voice_paths():
+            record = prompt_pack.prepare(prompt_pack.prompt_name(path), prompt_pack.read_wav(path), Options())
+            with self.subTest(path=os.path.basename(path)):
+                self.assertLessEqual(record["peak"], limit + 1)
+                self.assertEqual(record["peak"], max(abs(s) for s in prompt_pack.to_samples(record["pcm"])))
+
+
+class PackTest(unittest.TestCase):
+    def test_round_trip(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            for codec in sorted(prompt_pack.CODECS):
+                output = os.path.join(tmp, "prompts_%s.bin" % codec)
+                result = run_tool("pack", "-o", output, "--codec", codec, "--trim", "--normalize", *voice_paths())
+                self.assertEqual(result.returncode, 0, result.stderr)
+                with open(output, "rb") as f:
+                    prompts = prompt_pack.unpack(f.read())
+                self.assertEqual([p["name"] for p in prompts],
+                                 [prompt_pack.prompt_name(path) for path in voice_paths()])
+                for prompt, path in zip(prompts, voice_paths()):
+                    record = prompt_pack.prepare(prompt["name"], prompt_pack.read_wav(path), Options())
+                    self.assertEqual(prompt["offset"] % prompt_pack.ALIGN, 0)
+                    self.assertEqual(prompt["samples"], record["samples"])
+                    self.assertEqual(prompt["trim_head"], record["trim_head"])
+                    self.assertEqual(prompt["trim_tail"], record["trim_tail"])
+                    self.assertEqual(prompt["gain_q8"], record["gain_q8"])
+                    decoded = prompt_pack.decode(prompt["payload"], prompt["codec"])[:prompt["samples"] * 2]
+                    if codec == "pcm":
+                        self.assertEqual(decoded, record["pcm"])
+                    else:
+                        self.assertEqual(len(decoded), len(record["pcm"]))
+
+    def test_partition_size_exceeded_writes_nothing(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            output = os.path.join(tmp, "prompts.bin")
+            result = run_tool("pack", "-o", output, "--partition-size", "0x1000", *voice_paths())
+            self.assertEqual(result.returncode, 1)
+            self.assertIn("超过分区大小", result.stderr.decode("utf-8"))
+            self.assertFalse(os.path.exists(output))
+
+            result = run_tool("pack", "-o", output, "--partition-size", "0x200000", *voice_paths())
+            self.assertEqual(result.returncode, 0, result.stderr)
+            self.assertTrue(os.path.exists(output))
+
+    def test_duplicate_and_long_names_rejected(self):
+        path = voice_paths()[0]
+        result = run_tool("pack", "-o", os.devnull, path, path)
+        self.assertEqual(result.returncode, 1)
+        with self.assertRaises(ValueError):
+            prompt_pack.prompt_name("/tmp/" + "x" * (prompt_pack.NAME_MAX + 1) + ".wav")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+tools/trace_decode.py 的测试
+
+解码 trace_ring_test 写出的多线程跟踪数据（原始缓冲区镜像和 ZTRACE 日志），
+检查开始/结束配对、32 位时间戳回绕的展开，以及两种输入解码结果一致；
+另用构造的记录检查多次回绕、嵌套区间和未配对记录的计数。
+
+用法：
+    trace_decode_test.py <仓库根目录> <trace_ring_test 的运行目录>
+"""
+
+import json
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+import unittest
+
+REPO = os.path.abspath(sys.argv.pop(1) if len(sys.argv) > 1 else os.path.join(os.path.dirname(__file__), "../../.."))
+DATA = os.path.abspath(sys.argv.pop(1) if len(sys.argv) > 1 else os.getcwd())
+TOOL = os.path.join(REPO, "tools", "trace_decode.py")
+sys.path.insert(0, os.path.join(REPO, "tools"))
+
+import trace_decode  # noqa: E402
+
+# 与 trace_ring_test.cc 一致
+THREAD_EVENTS = ("WAKE_DETECT", "COMMAND_DETECT")
+INSTANT_EVENT = "WAKE_TRIGGERED"
+STEP_US = 7
+
+
+def load_image():
+    with open(os.path.join(DATA, "host_test_trace.bin"), "rb") as f:
+        blob = f.read()
+    names = dict(enumerate(trace_decode.load_event_names(trace_decode.DEFAULT_EVENTS)))
+    return names, trace_decode.parse_raw(blob)
+
+
+def load_log():
+    with open(os.path.join(DATA, "host_test_trace.log"), "r", encoding="utf-8") as f:
+        return trace_decode.parse_text(f.read())
+
+
+def record(seq, ts, rtype, event, arg=0):
+    return {"seq": seq, "ts": ts, "type": rtype, "event": event, "arg": arg}
+
+
+class MultiThreadTraceTest(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls.names, cls.cores = load_image()
+        cls.raw = {core: [dict(r) for r in records] for core, records in cls.cores.items()}
+        cls.events, cls.dropped = trace_decode.to_chrome(cls.names, cls.cores)
+
+    def test_image_header_and_retained_records(self):
+        self.assertEqual(sorted(self.raw), [0, 1])
+        for core, records in self.raw.items():
+            seqs = [r["seq"] for r in records]
+            # 写入结束后才导出，保留的记录连续且都有效
+            self.assertEqual(seqs, list(range(seqs[0], seqs[0] + len(seqs))))
+            self.assertGreater(len(records), 100)
+
+    def test_raw_timestamps_wrap(self):
+        for core, records in self.raw.items():
+            ts = [r["ts"] for r in sorted(records, key=lambda r: r["seq"])]
+            wraps = sum(1 for a, b in zip(ts, ts[1:]) if a - b > 0x80000000)
+            self.assertEqual(wraps, 1, "核心%d" % core)
+
+    def test_spans_pair_begin_with_matching_end(self):
+        spans = [e for e in self.events if e["ph"] == "X"]
+        self.assertTrue(spans)
+        for e in spans:
+            with self.subTest(span=e):
+                self.assertIn(e["name"], THREAD_EVENTS)
+                # 参数高位是写入线程的迭代序号，低 8 位是时间戳的低 8 位
+                self.assertEqual(e["args"]["begin"] >> 8, e["args"]["end"] >> 8)
+                # 展开后时长为正且很短；回绕处理错误时会差出 2^32
+                self.assertGreater(e["dur"], 0)
+                self.assertLess(e["dur"], 1 << 20)
+                self.assertEqual(e["dur"] % STEP_US, 0)
+                self.assertEqual((e["args"]["end"] - e["args"]["begin"]) & 0xff, e["dur"] & 0xff)
+
+    def test_every_retained_pair_is_emitted(self):
+        for core, records in self.raw.items():
+            spans = [e for e in self.events if e["ph"] == "X" and e["pid"] == core]
+            instants = [e for e in self.events if e["ph"] == "i" and e["pid"] == core]
+            edges = sum(1 for r in records if r["type"] in "BE")
+            self.assertEqual(len(instants), sum(1 for r in records if r["type"] == "i"))
+            self.assertTrue(all(e["name"] == INSTANT_EVENT for e in instants))
+            # 只有最旧处开始记录已被覆盖的结束记录配不上，每个写入线程最多一条
+            self.assertLessEqual(edges - 2 * len(spans), len(THREAD_EVENTS))
+        self.assertLessEqual(self.dropped, 2 * len(THREAD_EVENTS))
+
+    def test_unwrapped_timeline_is_monotonic(self):
+        for core in self.raw:
+            tracks = {}
+            for e in self.events:
+                if e["ph"] in "Xi" and e["pid"] == core:
+                    tracks.setdefault(e["tid"], []).append(e["ts"])
+            for tid, ts in tracks.items():
+                self.assertEqual(ts, sorted(ts), "核心%d 轨道%d" % (core, tid))
+            # 整段时间线不超过写入的记录数乘以步长，回绕前后是连续的
+            all_ts = [t for ts in tracks.values() for t in ts]
+            self.assertLess(max(all_ts) - min(all_ts), len(self.raw[core]) * STEP_US * 2)
+
+    def test_log_matches_image(self):
+        names, cores = load_log()
+        self.assertEqual(names, self.names)
+        self.assertEqual(cores, self.raw)
+
+    def test_cli_outputs(self):
+        with open(os.path.join(DATA, "host_test_trace_raw.json"), encoding="utf-8") as f:
+            raw = json.load(f)["traceEvents"]
+        with open(os.path.join(DATA, "host_test_trace_log.json"), encoding="utf-8") as f:
+            log = json.load(f)["traceEvents"]
+        self.assertEqual(raw, log)
+        self.assertEqual(raw, self.events)
+
+
+class SyntheticTraceTest(unittest.TestCase):
+    def test_multiple_wraps(self):
+        ts = 0xfffffff0
+        records = []
+        for seq in range(12):
+            records.append(record(seq, ts & 0xffffffff, "B" if seq % 2 == 0 else "E", 0))
+            ts += 0x60000000    # 每两条记录跨过一次 2^32 附近
+        events, dropped = trace_decode.to_chrome({0: "A"}, {0: records})
+        spans = [e for e in events if e["ph"] == "X"]
+        self.assertEqual(dropped, 0)
+        self.assertEqual(len(spans), 6)
+        self.assertTrue(all(e["dur"] == 0x60000000 for e in spans))
+        self.assertEqual([e["ts"] for e in spans], [i * 0xc0000000 for i in range(6)])
+
+    def test_nested_spans_and_unpaired_records(self):
+        records = [
+            record(0, 100, "E", 1),     # 开始记录已被覆盖
+            record(1, 110, "B", 1, 1),
+            record(2, 120, "B", 1, 2),  # 同一事件嵌套
+            record(3, 125, "B", 2),
+            record(4, 130, "E", 1, 2),
+            record(5, 135, "E", 2),
+            record(6, 140, "E", 1, 1),
+            record(7, 150, "B", 1),     # 仍在进行
+        ]
+        events, dropped = trace_decode.to_chrome({}, {0: records})
+        spans = sorted((e["ts"], e["dur"], e["tid"], e["args"]["begin"]) for e in events if e["ph"] == "X")
+        self.assertEqual(dropped, 2)
+        self.assertEqual(spans, [(10, 30, 1, 1), (20, 10, 1, 2), (25, 10, 2, 0)])
+
+    def test_records_sorted_by_seq_before_pairing(self):
+        records = [record(3, 40, "E", 0), record(2, 10, "B", 0)]
+        events, dropped = trace_decode.to_chrome({0: "A"}, {0: records})
+        self.assertEqual(dropped, 0)
+        self.assertEqual([e["dur"] for e in events if e["ph"] == "X"], [30])
+
+    def test_truncated_image_is_rejected(self):
+        with open(os.path.join(DATA, "host_test_trace.bin"), "rb") as f:
+            blob = f.read()
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "short.bin")
+            with open(path, "wb") as f:
+                f.write(blob[:len(blob) // 2])
+            result = subprocess.run([sys.executable, TOOL, path], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        self.assertEqual(result.returncode, 1)
+        self.assertIn("文件太短".encode("utf-8"), result.stderr)
+
+    def test_header_version_mismatch(self):
+        blob = struct.pack("<IHHII", trace_decode.MAGIC, trace_decode.VERSION + 1, 16, 4, 1) + bytes(4 + 4 * 16)
+        with self.assertRaises(ValueError):
+            trace_decode.parse_raw(blob)
+
+
+if __name__ == "__main__":
+    unittest.main()
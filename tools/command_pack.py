@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+命令清单编译工具
+
+把 JSON 描述的语音命令编译成紧凑的二进制清单，烧录到 commands 数据分区。
+固件启动时 mmap 该分区，不分配内存直接解析成命令表（main/commands/command_manifest.cc）。
+新增命令只需在 main/assets/commands.json 中加一项，不用改代码。
+
+JSON 格式：
+    {"commands": [
+        {"id": 309, "pinyin": "bang wo kai deng", "description": "帮我开灯",
+         "action": "gpio", "gpio": 21, "level": 1, "prompt": "light_on",
+         "flow": "continue", "priority": 1, "min_confidence": 35, "min_margin": 10},
+        ...
+    ]}
+    action    none（只播放提示音）或 gpio（设置 GPIO 电平），默认 none
+    gpio      action 为 gpio 时的引脚，必须能用作输出（ESP32-S3：0-21、26-48）
+    prompt    提示音包中的名称（见 tools/prompt_pack.py），省略表示不播放
+    flow      continue（继续等待命令）或 exit（结束本轮交互），默认 continue
+    priority  0-255，排队时数值大的先执行，默认 0
+    min_confidence  0-100，识别置信度（百分比）低于此值时请用户再说一遍，默认 0
+    min_margin      0-100，领先第二候选命令不足此值（百分点）时请用户再说一遍，默认 0
+
+文件格式（小端）：
+    头部 16 字节:   magic "ZCMD" | version u16 | count u16 | total_size u32 | reserved u32
+    命令 24 字节/项（按 id 升序）:
+                    id u16 | action u8 | flow u8 | priority u8 | gpio u8 | level u8
+                    | min_confidence u8 | min_margin u8 | reserved u8[3]
+                    | pinyin u32 | description u32 | prompt u32
+    字符串区:       以 '\\0' 结尾的 UTF-8 字符串，相同字符串只存一份
+
+字符串字段为相对清单起始的偏移，prompt 为 0 表示不播放。
+
+用法：
+    command_pack.py pack -o commands.bin [--partition-size 0x8000] main/assets/commands.json
+    command_pack.py list commands.bin
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC = b"ZCMD"
+VERSION = 2
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<HBBBBBBB3xIII")
+MAX_COMMANDS = 300          # MultiNet 命令词数量上限
+PHRASE_MAX = 63             # ESP_MN_MAX_PHRASE_LEN
+PROMPT_NAME_MAX = 19        # 与 tools/prompt_pack.py 的 NAME_MAX 一致
+# ESP32-S3 能用作输出的 GPIO：0-21、26-48（22-25 不存在），与固件中的
+# GPIO_IS_VALID_OUTPUT_GPIO 一致
+OUTPUT_GPIOS = frozenset(range(0, 22)) | frozenset(range(26, 49))
+
+ACTIONS = {"none": 0, "gpio": 1}
+FLOWS = {"continue": 0, "exit": 1}
+PINYIN_RE = re.compile(r"^[a-z]+( [a-z]+)*$")
+
+
+def check_command(cmd):
+    """检查一条命令，返回规范化后的字典"""
+    where = "命令 %s" % cmd.get("id", "?")
+    cid = cmd.get("id")
+    if not isinstance(cid, int) or not 0 <= cid <= 0xFFFF:
+        raise ValueError("%s: id 必须是 0-65535 的整数" % where)
+
+    pinyin = cmd.get("pinyin", "")
+    if not PINYIN_RE.match(pinyin) or len(pinyin) > PHRASE_MAX:
+        raise ValueError("%s: pinyin 必须是空格分隔的小写拼音，最长 %d 字节" % (where, PHRASE_MAX))
+    description = cmd.get("description", "")
+    if not description:
+        raise ValueError("%s: 缺少 description" % where)
+
+    action = cmd.get("action", "none")
+    if action not in ACTIONS:
+        raise ValueError("%s: action 只能是 %s" % (where, "/".join(ACTIONS)))
+    gpio = cmd.get("gpio", 0)
+    level = cmd.get("level", 0)
+    if action == "gpio" and (not isinstance(gpio, int) or gpio not in OUTPUT_GPIOS or level not in (0, 1)):
+        raise ValueError("%s: gpio 必须是 0-21 或 26-48（可用作输出的引脚），level 必须是 0 或 1" % where)
+
+    prompt = cmd.get("prompt")
+    if prompt is not None and (not prompt or len(prompt.encode("utf-8")) > PROMPT_NAME_MAX):
+        raise ValueError("%s: prompt 名称最长 %d 字节" % (where, PROMPT_NAME_MAX))
+
+    flow = cmd.get("flow", "continue")
+    if flow not in FLOWS:
+        raise ValueError("%s: flow 只能是 %s" % (where, "/".join(FLOWS)))
+    priority = cmd.get("priority", 0)
+    if not isinstance(priority, int) or not 0 <= priority <= 255:
+        raise ValueError("%s: priority 必须是 0-255" % where)
+    for key in ("min_confidence", "min_margin"):
+        value = cmd.get(key, 0)
+        if not isinstance(value, int) or not 0 <= value <= 100:
+            raise ValueError("%s: %s 必须是 0-100" % (where, key))
+
+    return {"id": cid, "pinyin": pinyin, "description": description, "action": action,
+            "gpio": gpio if action == "gpio" else 0, "level": level if action == "gpio" else 0,
+            "prompt": prompt, "flow": flow, "priority": priority,
+            "min_confidence": cmd.get("min_confidence", 0), "min_margin": cmd.get("min_margin", 0)}
+
+
+def load_manifest(path):
+    with open(path, "r", encoding="utf-8") as f:
+        doc = json.load(f)
+    commands = [check_command(cmd) for cmd in doc.get("commands", [])]
+    if not commands:
+        raise ValueError("%s: 没有命令" % path)
+    if len(commands) > MAX_COMMANDS:
+        raise ValueError("%s: %d 个命令，超过上限 %d" % (path, len(commands), MAX_COMMANDS))
+
+    for key in ("id", "pinyin"):
+        seen = set()
+        for cmd in commands:
+            if cmd[key] in seen:
+                raise ValueError("%s: %s 重复: %s" % (path, key, cmd[key]))
+            seen.add(cmd[key])
+    return sorted(commands, key=lambda c: c["id"])
+
+
+def pack(commands):
+    strings_start = HEADER.size + ENTRY.size * len(commands)
+    pool = bytearray()
+    offsets = {}
+
+    def intern(text):
+        if text is None:
+            return 0
+        if text not in offsets:
+            offsets[text] = strings_start + len(pool)
+            pool.extend(text.encode("utf-8") + b"\0")
+        return offsets[text]
+
+    entries = bytearray()
+    for cmd in commands:
+        entries += ENTRY.pack(cmd["id"], ACTIONS[cmd["action"]], FLOWS[cmd["flow"]], cmd["priority"],
+                              cmd["gpio"], cmd["level"], cmd["min_confidence"], cmd["min_margin"],
+                              intern(cmd["pinyin"]), intern(cmd["description"]), intern(cmd["prompt"]))
+
+    total = strings_start + len(pool)
+    return HEADER.pack(MAGIC, VERSION, len(commands), total, 0) + bytes(entries) + bytes(pool)
+
+
+def read_string(blob, offset):
+    end = blob.index(b"\0", offset)
+    return blob[offset:end].decode("utf-8")
+
+
+def unpack(blob):
+    magic, version, count, total, _ = HEADER.unpack_from(blob)
+    if magic != MAGIC or version != VERSION or total > len(blob):
+        raise ValueError("不是有效的命令清单")
+    actions = {v: k for k, v in ACTIONS.items()}
+    flows = {v: k for k, v in FLOWS.items()}
+    commands = []
+    for i in range(count):
+        cid, action, flow, priority, gpio, level, min_confidence, min_margin, pinyin, desc, prompt = \
+            ENTRY.unpack_from(blob, HEADER.size + ENTRY.size * i)
+        commands.append({"id": cid, "pinyin": read_string(blob, pinyin), "description": read_string(blob, desc),
+                         "action": actions[action], "gpio": gpio, "level": level,
+                         "prompt": read_string(blob, prompt) if prompt else None,
+                         "flow": flows[flow], "priority": priority,
+                         "min_confidence": min_confidence, "min_margin": min_margin})
+    return commands
+
+
+def cmd_pack(args):
+    commands = load_manifest(args.manifest)
+    blob = pack(commands)
+    if args.partition_size is not None and len(blob) > args.partition_size:
+        raise ValueError("命令清单 %d 字节，超过分区大小 %d 字节" % (len(blob), args.partition_size))
+    with open(args.output, "wb") as f:
+        f.write(blob)
+    print("命令清单: %d 个命令, %d 字节 -> %s" % (len(commands), len(blob), args.output))
+
+
+def cmd_list(args):
+    with open(args.manifest, "rb") as f:
+        blob = f.read()
+    for cmd in unpack(blob):
+        action = "gpio%d=%d" % (cmd["gpio"], cmd["level"]) if cmd["action"] == "gpio" else "-"
+        print("%5d  %-24s %-12s %-10s %-12s %-8s p%d  >=%d%% +%d" % (
+            cmd["id"], cmd["pinyin"], cmd["description"], action, cmd["prompt"] or "-", cmd["flow"], cmd["priority"],
+            cmd["min_confidence"], cmd["min_margin"]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="命令清单编译工具")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("pack", help="把 JSON 命令清单编译为二进制")
+    p.add_argument("manifest")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--partition-size", type=lambda v: int(v, 0), help="分区大小，超出时报错")
+    p.set_defaults(func=cmd_pack)
+
+    p = sub.add_parser("list", help="列出二进制命令清单的内容")
+    p.add_argument("manifest")
+    p.set_defaults(func=cmd_list)
+
+    args = parser.parse_args()
+    try:
+        args.func(args)
+    except (ValueError, OSError) as e:
+        print("错误: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
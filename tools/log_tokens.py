@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+令牌化日志工具
+
+固件开启 CONFIG_ZAPMYCO_LOG_TOKENIZED 后，DLOGx 日志的格式串在编译期换成
+32 位令牌，不再编译进固件，串口只输出 "ZL:" 开头的 Base64 二进制帧
+（见 main/system/log_token.h）。本工具负责两件事：
+
+    table   扫描源码中的 DLOGx 调用，按固件相同的算法计算令牌，生成令牌表
+            （构建时自动执行，输出 build/log_tokens.json）。不同格式串的令牌
+            冲突时报错退出。
+    decode  读取控制台日志（可以混有普通日志），把 ZL 行还原为
+            "I (时间戳) 标签: 内容" 的文本，其他行原样输出。
+
+令牌：FNV-1a 32 位，输入为级别字母（E/W/I/D）后接格式串的 UTF-8 字节。
+
+帧格式（小端）：
+    令牌 u32 | 时间戳（毫秒）varint | 参数描述 varint | 参数...
+    参数描述低 4 位为参数个数，其后每个参数 2 位类别：
+        0 有符号整数（zigzag varint）  1 无符号整数（varint）
+        2 浮点数（float32）            3 字符串（长度 varint + UTF-8 字节）
+
+用法：
+    log_tokens.py table -o build/log_tokens.json main/*.cc main/*/*.cc
+    idf.py monitor | log_tokens.py decode --table build/log_tokens.json
+    log_tokens.py decode --table build/log_tokens.json monitor.log
+"""
+
+import argparse
+import base64
+import binascii
+import json
+import re
+import struct
+import sys
+
+TABLE_VERSION = 1
+FRAME_PREFIX = "ZL:"
+
+CALL_RE = re.compile(r"\bDLOG([EWID])\s*\(\s*(\w+)\s*,\s*")
+STRING_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"\s*')
+TAG_RE = re.compile(r'\bstatic\s+const\s+char\s*\*\s*(?:const\s+)?(\w+)\s*=\s*"((?:[^"\\\n]|\\.)*)"')
+SPEC_RE = re.compile(r"%([-+ #0]*)(\d+)?(?:\.(\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXeEfFgGcsp%])")
+FRAME_RE = re.compile(FRAME_PREFIX + r"([A-Za-z0-9+/]+={0,2})")
+
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "\\": "\\", '"': '"', "'": "'", "0": "\0"}
+
+
+def fnv1a(data):
+    h = 2166136261
+    for b in data:
+        h = ((h ^ b) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def token_of(level, fmt):
+    return fnv1a(level.encode("ascii") + fmt.encode("utf-8"))
+
+
+def unescape(literal):
+    """C 字符串字面量转义（只处理日志中会用到的几种）"""
+    out = []
+    i = 0
+    while i < len(literal):
+        c = literal[i]
+        if c == "\\" and i + 1 < len(literal):
+            nxt = literal[i + 1]
+            if nxt not in ESCAPES:
+                raise ValueError("不支持的转义 \\%s" % nxt)
+            out.append(ESCAPES[nxt])
+            i += 2
+        else:
+            out.append(c)
+            i += 1
+    return "".join(out)
+
+
+def strip_comments(text):
+    """去掉注释，保留字符串和换行（行号不变）"""
+    def repl(m):
+        s = m.group(0)
+        return s if s.startswith('"') else re.sub(r"[^\n]", " ", s)
+    return re.sub(r'"(?:[^"\\\n]|\\.)*"|//[^\n]*|/\*.*?\*/', repl, text, flags=re.S)
+
+
+def scan_file(path):
+    """返回 [(级别, 标签, 格式串, 行号)]"""
+    with open(path, "r", encoding="utf-8") as f:
+        text = strip_comments(f.read())
+    tags = {name: unescape(value) for name, value in TAG_RE.findall(text)}
+
+    sites = []
+    for m in CALL_RE.finditer(text):
+        line = text.count("\n", 0, m.start()) + 1
+        pos = m.end()
+        parts = []
+        while True:
+            s = STRING_RE.match(text, pos)
+            if not s:
+                break
+            parts.append(unescape(s.group(1)))
+            pos = s.end()
+        if not parts or text[pos] not in ",)":
+            raise ValueError("%s:%d: DLOG 格式串必须是字符串字面量" % (path, line))
+        tag = tags.get(m.group(2), m.group(2))
+        sites.append((m.group(1), tag, "".join(parts), line))
+    return sites
+
+
+def build_table(paths):
+    tokens = {}
+    for path in paths:
+        if not path.endswith((".c", ".cc", ".cpp", ".h")):
+            continue
+        for level, tag, fmt, line in scan_file(path):
+            token = token_of(level, fmt)
+            key = "%08x" % token
+            entry = tokens.setdefault(key, {"level": level, "format": fmt, "sites": []})
+            if entry["level"] != level or entry["format"] != fmt:
+                raise ValueError("令牌冲突 %s: %r 与 %r，请修改其中一个格式串" % (key, entry["format"], fmt))
+            entry["sites"].append({"file": path, "line": line, "tag": tag})
+    return {"version": TABLE_VERSION, "tokens": dict(sorted(tokens.items()))}
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("帧被截断")
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, pos
+
+
+def parse_frame(data):
+    """返回 (令牌, 时间戳, [参数])"""
+    if len(data) < 4:
+        raise ValueError("帧被截断")
+    token = struct.unpack_from("<I", data)[0]
+    timestamp, pos = read_varint(data, 4)
+    desc, pos = read_varint(data, pos)
+    args = []
+    for i in range(desc & 0xF):
+        kind = (desc >> (4 + 2 * i)) & 3
+        if kind == 0:
+            v, pos = read_varint(data, pos)
+            args.append((v >> 1) ^ -(v & 1))
+        elif kind == 1:
+            v, pos = read_varint(data, pos)
+            args.append(v)
+        elif kind == 2:
+            if pos + 4 > len(data):
+                raise ValueError("帧被截断")
+            args.append(struct.unpack_from("<f", data, pos)[0])
+            pos += 4
+        else:
+            n, pos = read_varint(data, pos)
+            if pos + n > len(data):
+                raise ValueError("帧被截断")
+            args.append(data[pos:pos + n].decode("utf-8", errors="replace"))
+            pos += n
+    return token, timestamp, args
+
+
+# 整数转换按长度修饰符截取位宽；其余（int/long/size_t）按 ESP32 的 32 位
+INT_BITS = {"hh": 8, "h": 16, "ll": 64, "j": 64}
+
+
+def to_width(value, length, signed):
+    """按 C 的整数宽度和符号解释参数（帧中的整数是提升后的 64 位值）"""
+    bits = INT_BITS.get(length, 32)
+    value &= (1 << bits) - 1
+    if signed and value >> (bits - 1):
+        value -= 1 << bits
+    return value
+
+
+def format_message(fmt, args):
+    """按 printf 规则格式化（参数类别由帧给出，整数位宽由长度修饰符决定）"""
+    it = iter(args)
+
+    def repl(m):
+        flags, width, prec, length, conv = m.groups()
+        if conv == "%":
+            return "%"
+        value = next(it, None)
+        if value is None:
+            return "<缺少参数>"
+        spec = "%" + flags + (width or "") + ("." + prec if prec is not None else "")
+        if conv == "p":
+            return (spec + "s") % ("0x%x" % value)
+        if conv in "diu":
+            return (spec + "d") % to_width(int(value), length, conv != "u")
+        if conv in "oxX":
+            return (spec + conv) % to_width(int(value), length, False)
+        if conv == "c":
+            return (spec + "c") % chr(int(value) & 0xFF)
+        if conv == "s":
+            return (spec + "s") % value
+        return (spec + conv) % float(value)
+
+    return SPEC_RE.sub(repl, fmt)
+
+
+def decode_line(line, tokens):
+    """还原一行中的 ZL 帧，无法解码时原样返回"""
+    m = FRAME_RE.search(line)
+    if not m:
+        return line
+    try:
+        token, timestamp, args = parse_frame(base64.b64decode(m.group(1), validate=True))
+    except (ValueError, binascii.Error):
+        return line
+    entry = tokens.get("%08x" % token)
+    if entry is None:
+        return "%s<未知令牌 %08x, 参数 %s>" % (line[:m.start()], token, args)
+    # 同一格式串出现在多个标签下时全部列出
+    tags = sorted({site["tag"] for site in entry["sites"]})
+    return "%s%s (%d) %s: %s" % (line[:m.start()], entry["level"], timestamp, "|".join(tags),
+                                 format_message(entry["format"], args))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="令牌化日志工具")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p_table = sub.add_parser("table", help="扫描源码生成令牌表")
+    p_table.add_argument("sources", nargs="+", help="源文件")
+    p_table.add_argument("-o", "--output", required=True, help="输出的令牌表 JSON")
+
+    p_decode = sub.add_parser("decode", help="把控制台日志中的 ZL 帧还原为文本")
+    p_decode.add_argument("input", nargs="?", help="控制台日志，省略时读标准输入")
+    p_decode.add_argument("--table", required=True, help="构建生成的令牌表（build/log_tokens.json）")
+    args = parser.parse_args()
+
+    if args.command == "table":
+        try:
+            table = build_table(args.sources)
+        except ValueError as e:
+            print("错误: %s" % e, file=sys.stderr)
+            return 1
+        with open(args.output, "w", encoding="utf-8") as f:
+            json.dump(table, f, ensure_ascii=False, indent=1)
+        print("令牌表: %d 个格式串 -> %s" % (len(table["tokens"]), args.output))
+        return 0
+
+    with open(args.table, "r", encoding="utf-8") as f:
+        table = json.load(f)
+    if table.get("version") != TABLE_VERSION:
+        print("错误: 令牌表版本 %s 不支持" % table.get("version"), file=sys.stderr)
+        return 1
+    tokens = table["tokens"]
+
+    stream = open(args.input, "r", encoding="utf-8", errors="replace") if args.input else sys.stdin
+    try:
+        for line in stream:
+            sys.stdout.write(decode_line(line.rstrip("\n"), tokens) + "\n")
+            sys.stdout.flush()
+    finally:
+        if args.input:
+            stream.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
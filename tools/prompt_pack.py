@@ -0,0 +1,401 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+提示音打包工具
+
+把 16kHz、单声道、16 位的 WAV 提示音打包成一个带索引的二进制文件，
+烧录到 prompts 数据分区。固件通过 esp_partition_mmap 映射该分区，
+按提示音 ID 直接取得 (指针, 长度)，不再把 PCM 编译进应用程序。
+
+打包前可选的处理（按顺序）：
+    --trim       裁掉首尾低于阈值的静音，保留少量余量
+    --normalize  按有效部分的 RMS 统一响度，峰值不超过 --peak-dbfs
+
+文件格式（小端）：
+    头部 16 字节:   magic "ZPRM" | version u16 | count u16 | total_size u32 | reserved u32
+    索引 48 字节/项: name char[20] | offset u32 | length u32 | sample_rate u16 | codec u16
+                    | samples u32 | peak u16 | gain_q8 u16 | trim_head u32 | trim_tail u32
+    数据:           各提示音数据，按 4 字节对齐
+
+samples 为解码后的样本数，peak 为处理后的峰值，gain_q8 为响度归一化增益
+（256 表示 1 倍），trim_head/trim_tail 为首尾裁掉的样本数。
+
+codec 0 为 16 位 PCM；codec 1 为 IMA-ADPCM（4:1），码流无分块头，
+状态从 predictor=0、index=0 开始，每字节先低 4 位后高 4 位，
+与固件 main/audio/adpcm.cc 的解码器逐位一致。
+
+用法：
+    prompt_pack.py pack -o prompts.bin [--codec ima-adpcm] welcome.wav light_on.wav ...
+    prompt_pack.py analyze --trim --normalize welcome.wav light_on.wav ...
+    prompt_pack.py list prompts.bin
+    prompt_pack.py extract prompts.bin -d out_dir
+    prompt_pack.py import-header welcome.h -o welcome.wav
+"""
+
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+import wave
+
+MAGIC = b"ZPRM"
+VERSION = 2
+HEADER = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<20sIIHHIHHII")
+NAME_MAX = 19
+ALIGN = 4
+SAMPLE_RATE = 16000
+
+CODEC_PCM = 0
+CODEC_IMA_ADPCM = 1
+CODECS = {"pcm": CODEC_PCM, "ima-adpcm": CODEC_IMA_ADPCM}
+
+ADPCM_STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767,
+]
+ADPCM_INDEX = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def align_up(value, align=ALIGN):
+    return (value + align - 1) & ~(align - 1)
+
+
+def read_wav(path):
+    """读取 WAV 文件，返回 PCM 数据，格式不符时报错"""
+    with wave.open(path, "rb") as wav:
+        if wav.getnchannels() != 1 or wav.getsampwidth() != 2:
+            raise ValueError("%s: 需要单声道 16 位 PCM" % path)
+        if wav.getframerate() != SAMPLE_RATE:
+            raise ValueError("%s: 采样率为 %d Hz，需要 %d Hz" % (path, wav.getframerate(), SAMPLE_RATE))
+        return wav.readframes(wav.getnframes())
+
+
+def write_wav(path, pcm, sample_rate=SAMPLE_RATE):
+    with wave.open(path, "wb") as wav:
+        wav.setnchannels(1)
+        wav.setsampwidth(2)
+        wav.setframerate(sample_rate)
+        wav.writeframes(pcm)
+
+
+def adpcm_step(predictor, index, nibble):
+    """按码字更新解码状态，返回 (predictor, index)"""
+    step = ADPCM_STEPS[index]
+    diff = step >> 3
+    if nibble & 4:
+        diff += step
+    if nibble & 2:
+        diff += step >> 1
+    if nibble & 1:
+        diff += step >> 2
+    predictor = predictor - diff if nibble & 8 else predictor + diff
+    predictor = max(-32768, min(32767, predictor))
+    index = max(0, min(88, index + ADPCM_INDEX[nibble]))
+    return predictor, index
+
+
+def adpcm_encode(pcm):
+    """16 位 PCM 编码为 IMA-ADPCM，样本数为奇数时补一个 0"""
+    samples = list(struct.unpack("<%dh" % (len(pcm) // 2), pcm[:len(pcm) // 2 * 2]))
+    if len(samples) % 2:
+        samples.append(0)
+
+    predictor, index = 0, 0
+    nibbles = []
+    for sample in samples:
+        diff = sample - predictor
+        nibble = 0
+        if diff < 0:
+            nibble = 8
+            diff = -diff
+        step = ADPCM_STEPS[index]
+        if diff >= step:
+            nibble |= 4
+            diff -= step
+        step >>= 1
+        if diff >= step:
+            nibble |= 2
+            diff -= step
+        step >>= 1
+        if diff >= step:
+            nibble |= 1
+        # 用解码器的结果更新状态，保证编解码两端一致
+        predictor, index = adpcm_step(predictor, index, nibble)
+        nibbles.append(nibble)
+    return bytes(nibbles[i] | (nibbles[i + 1] << 4) for i in range(0, len(nibbles), 2))
+
+
+def adpcm_decode(data):
+    """IMA-ADPCM 解码为 16 位 PCM（参考实现）"""
+    predictor, index = 0, 0
+    samples = []
+    for byte in data:
+        for nibble in (byte & 0x0F, byte >> 4):
+            predictor, index = adpcm_step(predictor, index, nibble)
+            samples.append(predictor)
+    return struct.pack("<%dh" % len(samples), *samples)
+
+
+def decode(payload, codec):
+    if codec == CODEC_PCM:
+        return payload
+    if codec == CODEC_IMA_ADPCM:
+        return adpcm_decode(payload)
+    raise ValueError("未知的编码 %d" % codec)
+
+
+def to_samples(pcm):
+    return list(struct.unpack("<%dh" % (len(pcm) // 2), pcm[:len(pcm) // 2 * 2]))
+
+
+def to_pcm(samples):
+    return struct.pack("<%dh" % len(samples), *samples)
+
+
+def dbfs(level):
+    return 20 * math.log10(level / 32768.0) if level > 0 else float("-inf")
+
+
+def trim_silence(samples, threshold, margin):
+    """返回 (head, tail)：首尾可以裁掉的样本数，保留 margin 个样本的余量"""
+    loud = [i for i, s in enumerate(samples) if abs(s) > threshold]
+    if not loud:
+        return 0, 0
+    head = max(0, loud[0] - margin)
+    tail = max(0, len(samples) - 1 - loud[-1] - margin)
+    return head, tail
+
+
+def normalize_gain(samples, rms_dbfs, peak_dbfs):
+    """返回 Q8 增益：有效部分 RMS 达到 rms_dbfs，且峰值不超过 peak_dbfs"""
+    if not samples:
+        return 256
+    peak = max(abs(s) for s in samples)
+    rms = math.sqrt(sum(s * s for s in samples) / len(samples))
+    if peak == 0 or rms == 0:
+        return 256
+    gain = min(32768.0 * 10 ** (rms_dbfs / 20) / rms, 32768.0 * 10 ** (peak_dbfs / 20) / peak)
+    # 向下取整，量化后的增益不会让峰值超过上限
+    return max(1, min(0xFFFF, int(math.floor(gain * 256))))
+
+
+def prepare(name, pcm, args):
+    """按命令行选项裁剪、归一化一个提示音，返回打包用的记录"""
+    samples = to_samples(pcm)
+    head, tail = 0, 0
+    if args.trim:
+        margin = args.trim_margin_ms * SAMPLE_RATE // 1000
+        head, tail = trim_silence(samples, args.trim_threshold, margin)
+        samples = samples[head:len(samples) - tail]
+
+    gain_q8 = 256
+    if args.normalize:
+        gain_q8 = normalize_gain(samples, args.rms_dbfs, args.peak_dbfs)
+        samples = [max(-32768, min(32767, (s * gain_q8 + 128) >> 8)) for s in samples]
+
+    return {
+        "name": name,
+        "pcm": to_pcm(samples),
+        "samples": len(samples),
+        "peak": max([abs(s) for s in samples] + [0]),
+        "gain_q8": gain_q8,
+        "trim_head": head,
+        "trim_tail": tail,
+    }
+
+
+def describe(record, rate=SAMPLE_RATE):
+    return "%-12s %6d ms  峰值 %6.1f dBFS  增益 %5.2f  裁剪 前 %4d ms / 后 %4d ms" % (
+        record["name"], record["samples"] * 1000 // rate, dbfs(record["peak"]), record["gain_q8"] / 256.0,
+        record["trim_head"] * 1000 // rate, record["trim_tail"] * 1000 // rate)
+
+
+def prompt_name(path):
+    name = os.path.splitext(os.path.basename(path))[0]
+    if len(name.encode("utf-8")) > NAME_MAX:
+        raise ValueError("%s: 名称超过 %d 字节" % (path, NAME_MAX))
+    return name
+
+
+def pack(records, codec=CODEC_PCM):
+    """records 为 prepare() 返回的记录列表，返回打包后的字节串"""
+    names = [record["name"] for record in records]
+    if len(set(names)) != len(names):
+        raise ValueError("提示音名称重复")
+
+    data_offset = align_up(HEADER.size + ENTRY.size * len(records))
+    index = b""
+    data = b""
+    for record in records:
+        pcm = record["pcm"]
+        payload = adpcm_encode(pcm) if codec == CODEC_IMA_ADPCM else pcm
+        offset = data_offset + len(data)
+        index += ENTRY.pack(record["name"].encode("utf-8"), offset, len(payload), SAMPLE_RATE, codec,
+                            record["samples"], record["peak"], record["gain_q8"],
+                            record["trim_head"], record["trim_tail"])
+        data += payload + b"\0" * (align_up(len(payload)) - len(payload))
+
+    total = data_offset + len(data)
+    header = HEADER.pack(MAGIC, VERSION, len(records), total, 0)
+    padding = b"\0" * (data_offset - HEADER.size - len(index))
+    return header + index + padding + data
+
+
+def unpack(blob):
+    """解析打包文件，返回索引项字典列表（含 payload），格式错误时报错"""
+    if len(blob) < HEADER.size:
+        raise ValueError("文件过短")
+    magic, version, count, total, _ = HEADER.unpack_from(blob, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("不是有效的提示音包")
+    if total > len(blob) or HEADER.size + ENTRY.size * count > total:
+        raise ValueError("提示音包被截断")
+
+    prompts = []
+    for i in range(count):
+        fields = ENTRY.unpack_from(blob, HEADER.size + ENTRY.size * i)
+        raw_name, offset, length, rate, codec, samples, peak, gain_q8, head, tail = fields
+        if offset + length > total:
+            raise ValueError("第 %d 项超出文件范围" % i)
+        prompts.append({
+            "name": raw_name.split(b"\0", 1)[0].decode("utf-8"),
+            "offset": offset,
+            "payload": blob[offset:offset + length],
+            "rate": rate,
+            "codec": codec,
+            "samples": samples,
+            "peak": peak,
+            "gain_q8": gain_q8,
+            "trim_head": head,
+            "trim_tail": tail,
+        })
+    return prompts
+
+
+def parse_c_array(text):
+    """解析旧版 xxd 风格的 C 数组头文件，返回字节串"""
+    body = re.search(r"\[\]\s*=\s*\{(.*?)\}", text, re.S)
+    if body is None:
+        raise ValueError("未找到数组定义")
+    return bytes(int(value, 16) for value in re.findall(r"0x[0-9a-fA-F]{2}", body.group(1)))
+
+
+def load_records(args):
+    return [prepare(prompt_name(path), read_wav(path), args) for path in args.inputs]
+
+
+def cmd_pack(args):
+    records = load_records(args)
+    blob = pack(records, CODECS[args.codec])
+    if args.partition_size is not None and len(blob) > args.partition_size:
+        # 先检查再写出，失败时不会留下超出分区的文件
+        raise ValueError("提示音包 %d 字节，超过分区大小 %d 字节" % (len(blob), args.partition_size))
+    with open(args.output, "wb") as f:
+        f.write(blob)
+    pcm_total = sum(len(record["pcm"]) for record in records)
+    print("%s: %d 个提示音 (%s), PCM %d 字节, 文件 %d 字节" %
+          (args.output, len(records), args.codec, pcm_total, len(blob)))
+    return 0
+
+
+def cmd_analyze(args):
+    before = 0
+    after = 0
+    for path in args.inputs:
+        pcm = read_wav(path)
+        record = prepare(prompt_name(path), pcm, args)
+        before += len(pcm) // 2
+        after += record["samples"]
+        print(describe(record))
+    print("合计 %d ms -> %d ms" % (before * 1000 // SAMPLE_RATE, after * 1000 // SAMPLE_RATE))
+    return 0
+
+
+def cmd_list(args):
+    with open(args.bundle, "rb") as f:
+        prompts = unpack(f.read())
+    names = {value: key for key, value in CODECS.items()}
+    for index, prompt in enumerate(prompts):
+        print("%2d  offset=0x%06x  %7d 字节  %-9s  %s" %
+              (index, prompt["offset"], len(prompt["payload"]),
+               names.get(prompt["codec"], "codec=%d" % prompt["codec"]), describe(prompt, prompt["rate"])))
+    return 0
+
+
+def cmd_extract(args):
+    with open(args.bundle, "rb") as f:
+        prompts = unpack(f.read())
+    os.makedirs(args.dir, exist_ok=True)
+    for prompt in prompts:
+        pcm = decode(prompt["payload"], prompt["codec"])[:prompt["samples"] * 2]
+        write_wav(os.path.join(args.dir, prompt["name"] + ".wav"), pcm, prompt["rate"])
+    return 0
+
+
+def cmd_import_header(args):
+    with open(args.header, "r") as f:
+        pcm = parse_c_array(f.read())
+    if len(pcm) % 2:
+        pcm = pcm[:-1]
+    write_wav(args.output, pcm)
+    print("%s: %d 字节 PCM" % (args.output, len(pcm)))
+    return 0
+
+
+def add_process_arguments(p):
+    p.add_argument("--trim", action="store_true", help="裁掉首尾静音")
+    p.add_argument("--trim-threshold", type=int, default=64, help="静音阈值（样本绝对值），默认 64")
+    p.add_argument("--trim-margin-ms", type=int, default=20, help="裁剪后保留的余量，默认 20ms")
+    p.add_argument("--normalize", action="store_true", help="统一响度")
+    p.add_argument("--rms-dbfs", type=float, default=-20.0, help="目标 RMS，默认 -20 dBFS")
+    p.add_argument("--peak-dbfs", type=float, default=-1.0, help="峰值上限，默认 -1 dBFS")
+    p.add_argument("inputs", nargs="+")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="提示音打包工具")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("pack", help="把 WAV 文件打包成提示音包")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--partition-size", type=lambda v: int(v, 0), help="分区大小，超出时报错")
+    p.add_argument("--codec", choices=sorted(CODECS), default="pcm", help="提示音编码")
+    add_process_arguments(p)
+    p.set_defaults(func=cmd_pack)
+
+    p = sub.add_parser("analyze", help="只显示裁剪和归一化的结果，不生成文件")
+    add_process_arguments(p)
+    p.set_defaults(func=cmd_analyze)
+
+    p = sub.add_parser("list", help="列出提示音包内容")
+    p.add_argument("bundle")
+    p.set_defaults(func=cmd_list)
+
+    p = sub.add_parser("extract", help="把提示音包解包为 WAV 文件")
+    p.add_argument("bundle")
+    p.add_argument("-d", "--dir", required=True)
+    p.set_defaults(func=cmd_extract)
+
+    p = sub.add_parser("import-header", help="把旧版 C 数组头文件转换为 WAV")
+    p.add_argument("header")
+    p.add_argument("-o", "--output", required=True)
+    p.set_defaults(func=cmd_import_header)
+
+    args = parser.parse_args()
+    try:
+        return args.func(args)
+    except (OSError, ValueError, wave.Error) as e:
+        print("错误: %s" % e, file=sys.stderr)
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+跟踪数据解码工具
+
+把固件事件跟踪缓冲区（main/system/trace_ring.h）的转储转换为 Chrome trace
+JSON，可在 chrome://tracing 或 https://ui.perfetto.dev 中打开。
+
+支持两种输入，自动识别：
+    文本  控制台日志。固件以 ZTRACE 开头的行输出缓冲区内容，可以混有其他日志，
+          事件名称随转储一起输出。
+    原始  从核心转储或调试器中整块导出的 zapmyco_trace_buffer，例如
+          (gdb) dump binary value trace.bin zapmyco_trace_buffer
+          事件名称从 main/system/trace_events.h 读取。
+
+原始格式（小端）：
+    头部 16 字节:   magic u32 ("ZTRC") | version u16 | record_size u16 | capacity u32 | cores u32
+    每个核心:       head u32 | capacity 条记录
+    记录 16 字节:   seq u32（写入序号+1，0 表示正在写入）| timestamp_us u32 | event u16
+                    | type u8（'B'/'E'/'i'）| reserved u8 | arg u32
+
+每个核心是一个进程，每种事件一条轨道。同一核心上同一事件的开始/结束配对为
+一个区间；配对不上的开始或结束（被覆盖或仍在进行）会被丢弃并计数。
+时间戳为 32 位微秒，按写入顺序展开回绕。
+
+用法：
+    trace_decode.py monitor.log -o trace.json
+    trace_decode.py trace.bin -o trace.json --summary
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x4352545A
+VERSION = 1
+HEADER = struct.Struct("<IHHII")
+HEAD = struct.Struct("<I")
+RECORD = struct.Struct("<IIHBBI")
+DEFAULT_EVENTS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              "..", "main", "system", "trace_events.h")
+
+
+def load_event_names(path):
+    """按 TRACE_EVENT_LIST 中 X(...) 的顺序分配事件编号"""
+    with open(path, "r", encoding="utf-8") as f:
+        text = f.read()
+    start = text.find("#define TRACE_EVENT_LIST")
+    if start < 0:
+        raise ValueError("%s 中没有 TRACE_EVENT_LIST" % path)
+    body = []
+    for line in text[start:].splitlines():
+        body.append(line)
+        if not line.rstrip().endswith("\\"):
+            break
+    return re.findall(r"\bX\((\w+)\)", "\n".join(body))
+
+
+def parse_text(text):
+    """解析控制台日志中的 ZTRACE 行，返回 (事件名称, {核心: [记录]})"""
+    names = {}
+    cores = {}
+    found = False
+    for line in text.splitlines():
+        pos = line.find("ZTRACE")
+        if pos < 0:
+            continue
+        fields = line[pos:].split()
+        tag = fields[0]
+        if tag == "ZTRACE-BEGIN":
+            # 以最后一次转储为准
+            found = True
+            names = {}
+            cores = {}
+        elif tag == "ZTRACE-EVENT" and len(fields) >= 3:
+            names[int(fields[1])] = fields[2]
+        elif tag == "ZTRACE" and len(fields) >= 7:
+            core, seq, ts = int(fields[1]), int(fields[2]), int(fields[3])
+            cores.setdefault(core, []).append({
+                "seq": seq, "ts": ts, "type": fields[4], "event": int(fields[5]), "arg": int(fields[6]),
+            })
+    if not found:
+        raise ValueError("输入中没有 ZTRACE-BEGIN")
+    return names, cores
+
+
+def parse_raw(blob):
+    """解析原始缓冲区镜像，返回 {核心: [记录]}"""
+    if len(blob) < HEADER.size:
+        raise ValueError("文件太短")
+    magic, version, record_size, capacity, ncores = HEADER.unpack_from(blob, 0)
+    if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+        raise ValueError("不是跟踪缓冲区镜像 (magic=0x%08x version=%d)" % (magic, version))
+    ring_size = HEAD.size + capacity * RECORD.size
+    if len(blob) < HEADER.size + ncores * ring_size:
+        raise ValueError("文件太短: 需要 %d 字节" % (HEADER.size + ncores * ring_size))
+
+    cores = {}
+    for core in range(ncores):
+        base = HEADER.size + core * ring_size
+        head, = HEAD.unpack_from(blob, base)
+        first = max(0, head - capacity)
+        records = []
+        for seq in range(first, head):
+            slot = base + HEAD.size + (seq % capacity) * RECORD.size
+            stored, ts, event, rtype, _, arg = RECORD.unpack_from(blob, slot)
+            if stored != ((seq + 1) & 0xffffffff):
+                continue    # 已被覆盖或正在写入
+            records.append({"seq": seq, "ts": ts, "type": chr(rtype), "event": event, "arg": arg})
+        cores[core] = records
+    return cores
+
+
+def unwrap(records):
+    """按写入顺序展开 32 位微秒时间戳的回绕"""
+    records.sort(key=lambda r: r["seq"])
+    offset = 0
+    prev = None
+    for r in records:
+        if prev is not None and r["ts"] + 0x80000000 < prev:
+            offset += 1 << 32
+        prev = r["ts"]
+        r["ts"] += offset
+
+
+def to_chrome(names, cores):
+    """转换为 Chrome trace 事件列表，返回 (事件, 丢弃的记录数)"""
+    for records in cores.values():
+        unwrap(records)
+    all_ts = [r["ts"] for records in cores.values() for r in records]
+    base = min(all_ts) if all_ts else 0
+
+    events = []
+    dropped = 0
+    for core, records in sorted(cores.items()):
+        events.append({"name": "process_name", "ph": "M", "pid": core, "args": {"name": "核心%d" % core}})
+        used = set()
+        open_spans = {}
+        for r in records:
+            name = names.get(r["event"], "event_%d" % r["event"])
+            ts = r["ts"] - base
+            used.add(r["event"])
+            if r["type"] == "B":
+                open_spans.setdefault(r["event"], []).append(r)
+            elif r["type"] == "E":
+                stack = open_spans.get(r["event"])
+                if not stack:
+                    dropped += 1
+                    continue
+                begin = stack.pop()
+                events.append({"name": name, "ph": "X", "pid": core, "tid": r["event"],
+                               "ts": begin["ts"] - base, "dur": r["ts"] - begin["ts"],
+                               "args": {"begin": begin["arg"], "end": r["arg"]}})
+            else:
+                events.append({"name": name, "ph": "i", "s": "t", "pid": core, "tid": r["event"],
+                               "ts": ts, "args": {"arg": r["arg"]}})
+        dropped += sum(len(stack) for stack in open_spans.values())
+        for event in sorted(used):
+            events.append({"name": "thread_name", "ph": "M", "pid": core, "tid": event,
+                           "args": {"name": names.get(event, "event_%d" % event)}})
+            events.append({"name": "thread_sort_index", "ph": "M", "pid": core, "tid": event,
+                           "args": {"sort_index": event}})
+    return events, dropped
+
+
+def print_summary(events):
+    stats = {}
+    for e in events:
+        if e["ph"] == "X":
+            s = stats.setdefault((e["pid"], e["name"]), [0, 0, 0])
+            s[0] += 1
+            s[1] += e["dur"]
+            s[2] = max(s[2], e["dur"])
+        elif e["ph"] == "i":
+            stats.setdefault((e["pid"], e["name"]), [0, 0, 0])[0] += 1
+    for (core, name), (count, total, peak) in sorted(stats.items()):
+        if total or peak:
+            print("核心%d  %-20s %6d 次  平均 %8.1f us  最大 %8d us" % (core, name, count, total / count, peak))
+        else:
+            print("核心%d  %-20s %6d 次" % (core, name, count))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="跟踪数据解码工具")
+    parser.add_argument("input", help="控制台日志或原始缓冲区镜像")
+    parser.add_argument("-o", "--output", help="输出的 Chrome trace JSON 文件")
+    parser.add_argument("--events", default=DEFAULT_EVENTS, help="事件定义头文件（解码原始镜像时使用）")
+    parser.add_argument("--summary", action="store_true", help="输出各事件的次数和耗时统计")
+    args = parser.parse_args()
+
+    try:
+        with open(args.input, "rb") as f:
+            blob = f.read()
+        if len(blob) >= 4 and struct.unpack_from("<I", blob)[0] == MAGIC:
+            names = dict(enumerate(load_event_names(args.events)))
+            cores = parse_raw(blob)
+        else:
+            names, cores = parse_text(blob.decode("utf-8", errors="replace"))
+
+        events, dropped = to_chrome(names, cores)
+        count = sum(len(records) for records in cores.values())
+        print("%d 条记录, %d 个核心, 丢弃 %d 条未配对记录" % (count, len(cores), dropped))
+        if args.output:
+            with open(args.output, "w", encoding="utf-8") as f:
+                json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, f, ensure_ascii=False)
+            print("已写入 %s" % args.output)
+        if args.summary:
+            print_summary(events)
+    except (OSError, ValueError, struct.error) as e:
+        print("错误: %s" % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())